@@ -0,0 +1,174 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Host side benchmark for the aggregation of small records.
+ *
+ * Runs WCON_Drivers/Aggregation/Aggregation.c against an emulated transmit function on a
+ * virtual clock and reports the samples/s for small sensor samples, transmitted one by one
+ * and aggregated. The emulated transmission time consists of the UART transfer of the
+ * request, the time on air and the UART transfer of the confirmation.
+ *
+ * Build and run on the host:
+ *   gcc -O2 -I../../WCON_Drivers -o aggregation_benchmark aggregation_benchmark.c
+ *   ./aggregation_benchmark [uart baudrate] [rf bitrate] [max payload length]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* skip the platform header, the benchmark provides the platform functions on a virtual clock */
+#define GLOBAL_H_INCLUDED
+uint32_t WE_GetTick();
+void WE_Delay(uint16_t sleepForMs);
+
+#include "Aggregation/Aggregation.c"
+
+#define SAMPLE_COUNT      10000
+#define UART_CMD_OVERHEAD 5     /* STX, CMD, LEN, CS (and second length byte) */
+#define UART_CNF_LENGTH   5
+#define RF_OVERHEAD       16    /* preamble, sync word, length, address header, CRC */
+#define MODULE_LATENCY_US 500
+
+static uint64_t nowUs = 0;
+static uint32_t uartBaudrate = 115200;
+static uint32_t rfBitrate = 100000;
+static uint16_t payloadLength = 224;
+
+static uint32_t transmissions = 0;
+static uint32_t samplesReceived = 0;
+static uint32_t samplesCorrupted = 0;
+static bool aggregated = false;
+
+/* platform functions used by the aggregation */
+uint32_t WE_GetTick()
+{
+    return (uint32_t)(nowUs / 1000);
+}
+
+void WE_Delay(uint16_t sleepForMs)
+{
+    nowUs += (uint64_t)sleepForMs * 1000;
+}
+
+static void CheckSample(uint8_t* data, uint16_t length)
+{
+    uint32_t index = 0;
+    memcpy(&index, data, sizeof(index));
+    if ((length < sizeof(index)) || (index != samplesReceived) || (data[length - 1] != (uint8_t)(index * 3)))
+    {
+        samplesCorrupted++;
+    }
+    samplesReceived++;
+}
+
+/* emulated ProteusE_Transmit: the payload is looped back to the receiving side */
+static bool EmulatedTransmit(uint8_t* payload, uint16_t length)
+{
+    uint64_t duration = 0;
+    duration += (uint64_t)(length + UART_CMD_OVERHEAD) * 10 * 1000000 / uartBaudrate;
+    duration += (uint64_t)(length + RF_OVERHEAD) * 8 * 1000000 / rfBitrate;
+    duration += MODULE_LATENCY_US;
+    duration += (uint64_t)UART_CNF_LENGTH * 10 * 1000000 / uartBaudrate;
+    nowUs += duration;
+    transmissions++;
+
+    if (!aggregated || !Aggregation_HandleRx(payload, length))
+    {
+        CheckSample(payload, length);
+    }
+    return true;
+}
+
+static void EmulatedRxCallback(uint8_t* data, uint16_t length)
+{
+    CheckSample(data, length);
+}
+
+static void Run(uint16_t sampleLength)
+{
+    uint8_t sample[AGGREGATION_BUFFER_SIZE];
+    uint64_t elapsed[2];
+    uint32_t frames[2];
+    int mode = 0;
+    uint32_t n = 0;
+
+    for (mode = 0; mode < 2; mode++)
+    {
+        aggregated = (mode == 1);
+        transmissions = 0;
+        samplesReceived = 0;
+        Aggregation_Init(EmulatedTransmit, payloadLength, 100, EmulatedRxCallback);
+
+        uint64_t start = nowUs;
+        for (n = 0; n < SAMPLE_COUNT; n++)
+        {
+            memset(sample, 0, sampleLength);
+            memcpy(sample, &n, sizeof(n));
+            sample[sampleLength - 1] = (uint8_t)(n * 3);
+            if (aggregated)
+            {
+                Aggregation_Add(sample, sampleLength);
+                Aggregation_Process();
+            }
+            else
+            {
+                EmulatedTransmit(sample, sampleLength);
+            }
+        }
+        Aggregation_Flush();
+        elapsed[mode] = nowUs - start;
+        frames[mode] = transmissions;
+
+        if (samplesReceived != SAMPLE_COUNT)
+        {
+            samplesCorrupted++;
+        }
+    }
+
+    printf("%6u  %16.0f  %17.0f  %13u  %14u\n", sampleLength,
+           (double)SAMPLE_COUNT * 1000000 / (double)elapsed[0],
+           (double)SAMPLE_COUNT * 1000000 / (double)elapsed[1],
+           frames[0], frames[1]);
+}
+
+int main(int argc, char* argv[])
+{
+    static const uint16_t sampleLengths[] = { 6, 8, 16, 32, 64 };
+    int i = 0;
+
+    if (argc > 1) uartBaudrate = strtoul(argv[1], NULL, 0);
+    if (argc > 2) rfBitrate = strtoul(argv[2], NULL, 0);
+    if (argc > 3) payloadLength = strtoul(argv[3], NULL, 0);
+    if ((payloadLength < 80) || (payloadLength > AGGREGATION_BUFFER_SIZE))
+    {
+        printf("max payload length must be in range 80..%u\n", AGGREGATION_BUFFER_SIZE);
+        return 1;
+    }
+
+    printf("%u samples, UART %u baud, RF %u bit/s, max payload %u bytes\n",
+           SAMPLE_COUNT, uartBaudrate, rfBitrate, payloadLength);
+    printf("sample  single [samples/s]  aggregated [samples/s]  single frames  aggregated frames\n");
+
+    for (i = 0; i < (int)(sizeof(sampleLengths) / sizeof(sampleLengths[0])); i++)
+    {
+        Run(sampleLengths[i]);
+    }
+
+    if (samplesCorrupted != 0)
+    {
+        printf("error: %u samples lost or corrupted\n", samplesCorrupted);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,349 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Host side emulator for the automatic channel selection.
+ *
+ * Runs WCON_Drivers/ChannelSelection/ChannelSelection.c against an emulated radio on a virtual
+ * clock. The module keeps its state in static variables, so each scenario runs it in one role
+ * and the emulator plays the other side of the network using the documented message formats.
+ *
+ * The emulator checks that
+ * - the coordinator moves the network away from a busy channel and announces the switch,
+ * - the coordinator answers the search of a lost node with a beacon, or with the announcement
+ *   while a switch is pending,
+ * - a node follows a switch announcement,
+ * - a node that missed all announcements finds the coordinator on each of the candidate channels,
+ *   and reports the time needed for the recovery, and
+ * - a node on a lossy link stays with the coordinator.
+ *
+ * Build and run on the host:
+ *   gcc -O2 -I../../WCON_Drivers -o channel_selection_emulator channel_selection_emulator.c
+ *   ./channel_selection_emulator [data interval in ms] [loss in per mille]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* skip the platform header, the emulator provides the platform functions on a virtual clock */
+#define GLOBAL_H_INCLUDED
+uint32_t WE_GetTick();
+void WE_Delay(uint16_t sleepForMs);
+
+#include "ChannelSelection/ChannelSelection.c"
+
+#define CHANNEL_COUNT    4
+#define FRAME_TIME_US    2000       /* UART transfer, time on air and confirmation of a frame */
+#define LATENCY_US       3000       /* until the answer of the peer is received */
+#define BUSY_RSSI        -50
+#define BUSY_FAIL        600        /* per mille of the transmissions failing on the busy channel */
+#define INTERFERENCE_US  10000      /* interval of the frames of the other network on the busy channel */
+#define TIME_LIMIT_US    (120ULL * 1000000)
+#define RECOVERY_LIMIT_MS (CHANNELSELECTION_LOST_TX_FAILURES * dataIntervalMs + 2 * CHANNEL_COUNT * CHANNELSELECTION_SCAN_DWELL)
+#define LOSSY_FRAMES     10000
+
+static const uint8_t channels[CHANNEL_COUNT] = { 5, 15, 25, 35 };
+
+static uint64_t nowUs = 0;
+static uint32_t dataIntervalMs = 100;
+static uint32_t lossPerMille = 100;
+static uint32_t randomState = 1;
+
+/* emulated radio */
+static uint8_t radioChannel = 0;
+static int busyChannel = -1;
+static uint64_t nextInterferenceUs = 0;
+
+/* emulated peer: the coordinator in the node scenarios, the node in the coordinator scenarios */
+static uint8_t peerChannel = 0;
+static bool answerPending = false;
+static uint64_t answerAt = 0;
+static uint8_t answer[MSG_BEACON_LENGTH];
+
+/* frames transmitted by the module */
+static uint32_t switchFrames = 0;
+static uint8_t lastFrame[MSG_SWITCH_LENGTH];
+static uint16_t lastFrameLength = 0;
+
+/* platform functions used by the channel selection */
+uint32_t WE_GetTick()
+{
+    return (uint32_t)(nowUs / 1000);
+}
+
+static void Interference(void)
+{
+    if ((radioChannel == busyChannel) && (nowUs >= nextInterferenceUs))
+    {
+        nextInterferenceUs = nowUs + INTERFERENCE_US;
+        ChannelSelection_ReportRx(BUSY_RSSI, false);
+    }
+}
+
+/* frames of the other network are received while the module is waiting */
+void WE_Delay(uint16_t sleepForMs)
+{
+    uint64_t end = nowUs + (uint64_t)sleepForMs * 1000;
+    while (nowUs < end)
+    {
+        nowUs += 1000;
+        Interference();
+    }
+}
+
+static uint32_t Random(void)
+{
+    randomState = randomState * 1103515245 + 12345;
+    return (randomState >> 16) & 0x7FFF;
+}
+
+static bool EmulatedSetChannel(uint8_t channel)
+{
+    nowUs += FRAME_TIME_US;
+    radioChannel = channel;
+    return true;
+}
+
+/* the emulated coordinator answers searches on its channel with a beacon */
+static bool EmulatedTransmit(uint8_t* payload, uint16_t length)
+{
+    nowUs += FRAME_TIME_US;
+    memcpy(lastFrame, payload, (length < sizeof(lastFrame)) ? length : sizeof(lastFrame));
+    lastFrameLength = length;
+
+    if ((length == MSG_SWITCH_LENGTH) && (payload[0] == MSG_SWITCH))
+    {
+        switchFrames++;
+    }
+    if ((role == ChannelSelection_Role_Node) && (length == 1) && (payload[0] == MSG_SEARCH) && (radioChannel == peerChannel))
+    {
+        answer[0] = MSG_BEACON;
+        answer[1] = peerChannel;
+        answerAt = nowUs + LATENCY_US;
+        answerPending = true;
+    }
+    return (radioChannel != busyChannel) || ((Random() % 1000) >= BUSY_FAIL);
+}
+
+/* the answer is only received if the node is still listening on the channel of the coordinator */
+static void DeliverAnswer(void)
+{
+    if (answerPending && (nowUs >= answerAt))
+    {
+        answerPending = false;
+        if (radioChannel == peerChannel)
+        {
+            ChannelSelection_HandleRx(answer, sizeof(answer));
+        }
+    }
+}
+
+static const ChannelSelection_Interface_t emulatedInterface = { EmulatedSetChannel, EmulatedTransmit };
+
+static void Reset(ChannelSelection_Role_t role_, uint8_t channel)
+{
+    radioChannel = channel;
+    peerChannel = channel;
+    busyChannel = -1;
+    answerPending = false;
+    switchFrames = 0;
+    lastFrameLength = 0;
+    randomState = 1;
+    ChannelSelection_Init(role_, channels, CHANNEL_COUNT, channel, &emulatedInterface);
+}
+
+/* data frame of the application, acknowledged by the coordinator if it is on the same channel */
+static void SendData(void)
+{
+    nowUs += FRAME_TIME_US;
+    ChannelSelection_ReportTx((radioChannel == peerChannel) && ((Random() % 1000) >= lossPerMille));
+}
+
+/* run the main loop of the module and send data every dataIntervalMs until done() or the time limit */
+static bool Run(bool (*done)(void), uint64_t limitUs)
+{
+    uint64_t start = nowUs;
+    uint64_t nextData = nowUs;
+    while (!done())
+    {
+        if (nowUs - start >= limitUs)
+        {
+            return false;
+        }
+        if (nowUs >= nextData)
+        {
+            nextData += (uint64_t)dataIntervalMs * 1000;
+            SendData();
+        }
+        Interference();
+        DeliverAnswer();
+        ChannelSelection_Process();
+        nowUs += 1000;
+    }
+    return true;
+}
+
+static bool SwitchAnnounced(void)
+{
+    return switchFrames > 0;
+}
+
+static bool CoordinatorSwitched(void)
+{
+    return (switchFrames > 0) && !switchPending;
+}
+
+static bool NodeOnPeerChannel(void)
+{
+    return (ChannelSelection_GetChannel() == peerChannel) && !ChannelSelection_IsScanning() && !switchPending;
+}
+
+/* coordinator on a busy channel: it has to move to a free channel and announce it */
+static bool RunCoordinatorSwitch(void)
+{
+    bool ok = true;
+    uint16_t cost = 0;
+
+    Reset(ChannelSelection_Role_Coordinator, channels[0]);
+    busyChannel = channels[0];
+    uint64_t start = nowUs;
+    ok = Run(CoordinatorSwitched, TIME_LIMIT_US);
+    uint32_t elapsed = (uint32_t)((nowUs - start) / 1000);
+    ok = ok && (ChannelSelection_GetChannel() != channels[0]) && (radioChannel == ChannelSelection_GetChannel());
+    ok = ok && (switchFrames == CHANNELSELECTION_SWITCH_REPEAT);
+    ok = ok && ChannelSelection_GetCost(channels[0], &cost) && (cost >= CHANNELSELECTION_HYSTERESIS);
+
+    printf("coordinator leaves busy channel %u (cost %u): channel %u after %u ms, %u announcements: %s\n",
+           channels[0], cost, ChannelSelection_GetChannel(), elapsed, switchFrames, ok ? "ok" : "failed");
+    return ok;
+}
+
+/* coordinator answers a search with a beacon, and with the announcement while a switch is pending */
+static bool RunCoordinatorAnswer(void)
+{
+    uint8_t search = MSG_SEARCH;
+    bool beaconOk = false;
+    bool announcementOk = false;
+
+    Reset(ChannelSelection_Role_Coordinator, channels[1]);
+    ChannelSelection_HandleRx(&search, 1);
+    ChannelSelection_Process();
+    beaconOk = (lastFrameLength == MSG_BEACON_LENGTH) && (lastFrame[0] == MSG_BEACON) && (lastFrame[1] == channels[1]);
+
+    Reset(ChannelSelection_Role_Coordinator, channels[1]);
+    busyChannel = channels[1];
+    if (Run(SwitchAnnounced, TIME_LIMIT_US))
+    {
+        ChannelSelection_HandleRx(&search, 1);
+        ChannelSelection_Process();
+        announcementOk = (lastFrameLength == MSG_SWITCH_LENGTH) && (lastFrame[0] == MSG_SWITCH) &&
+                         (lastFrame[2] == switchChannel) && (switchFrames == CHANNELSELECTION_SWITCH_REPEAT + 1);
+    }
+
+    printf("coordinator answers search: beacon %s, pending switch %s\n", beaconOk ? "ok" : "failed", announcementOk ? "ok" : "failed");
+    return beaconOk && announcementOk;
+}
+
+/* node receives the announcement */
+static bool RunNodeFollow(void)
+{
+    uint8_t msg[MSG_SWITCH_LENGTH] = { MSG_SWITCH, 1, channels[2], (uint8_t)CHANNELSELECTION_SWITCH_DELAY, (uint8_t)(CHANNELSELECTION_SWITCH_DELAY >> 8) };
+
+    Reset(ChannelSelection_Role_Node, channels[0]);
+    ChannelSelection_HandleRx(msg, sizeof(msg));
+    peerChannel = channels[2];
+    uint64_t start = nowUs;
+    bool ok = Run(NodeOnPeerChannel, TIME_LIMIT_US);
+    uint32_t elapsed = (uint32_t)((nowUs - start) / 1000);
+    ok = ok && (radioChannel == channels[2]) && (elapsed >= CHANNELSELECTION_SWITCH_DELAY);
+
+    printf("node follows announcement: channel %u after %u ms: %s\n", ChannelSelection_GetChannel(), elapsed, ok ? "ok" : "failed");
+    return ok;
+}
+
+/* node missed all announcements, the coordinator is found by scanning */
+static bool RunNodeRecovery(void)
+{
+    bool ok = true;
+    int i = 0;
+
+    for (i = 0; i < CHANNEL_COUNT; i++)
+    {
+        Reset(ChannelSelection_Role_Node, channels[0]);
+        peerChannel = channels[i];
+        uint64_t start = nowUs;
+        bool found = Run(NodeOnPeerChannel, TIME_LIMIT_US);
+        uint32_t elapsed = (uint32_t)((nowUs - start) / 1000);
+        found = found && (radioChannel == channels[i]) && (elapsed <= RECOVERY_LIMIT_MS);
+
+        printf("node lost coordinator, coordinator on channel %2u: found after %5u ms: %s\n", channels[i], elapsed, found ? "ok" : "failed");
+        ok = ok && found;
+    }
+    return ok;
+}
+
+/* node on a lossy link to the coordinator, rare scans are allowed, but it has to stay on the channel */
+static bool RunNodeLossy(void)
+{
+    uint32_t scans = 0;
+    bool wasScanning = false;
+    uint32_t i = 0;
+
+    Reset(ChannelSelection_Role_Node, channels[1]);
+    for (i = 0; i < LOSSY_FRAMES; i++)
+    {
+        uint64_t next = nowUs + (uint64_t)dataIntervalMs * 1000;
+        SendData();
+        while (nowUs < next)
+        {
+            DeliverAnswer();
+            ChannelSelection_Process();
+            nowUs += 1000;
+        }
+        if (ChannelSelection_IsScanning() && !wasScanning)
+        {
+            scans++;
+        }
+        wasScanning = ChannelSelection_IsScanning();
+    }
+    bool ok = Run(NodeOnPeerChannel, TIME_LIMIT_US) && (radioChannel == channels[1]);
+
+    printf("node on lossy link (%.1f%% loss): %u scans in %u frames, channel %u: %s\n",
+           lossPerMille / 10.0, scans, LOSSY_FRAMES, ChannelSelection_GetChannel(), ok ? "ok" : "failed");
+    return ok;
+}
+
+int main(int argc, char* argv[])
+{
+    bool ok = true;
+
+    if (argc > 1) dataIntervalMs = strtoul(argv[1], NULL, 0);
+    if (argc > 2) lossPerMille = strtoul(argv[2], NULL, 0);
+
+    printf("%u candidate channels, data every %u ms, scan dwell %u ms, lost after %u failed transmissions\n",
+           CHANNEL_COUNT, dataIntervalMs, CHANNELSELECTION_SCAN_DWELL, CHANNELSELECTION_LOST_TX_FAILURES);
+
+    ok = RunCoordinatorSwitch() && ok;
+    ok = RunCoordinatorAnswer() && ok;
+    ok = RunNodeFollow() && ok;
+
+    /* recovery on a clean link, the loss only applies to the lossy link scenario */
+    uint32_t loss = lossPerMille;
+    lossPerMille = 0;
+    ok = RunNodeRecovery() && ok;
+    lossPerMille = loss;
+    ok = RunNodeLossy() && ok;
+
+    return ok ? 0 : 1;
+}
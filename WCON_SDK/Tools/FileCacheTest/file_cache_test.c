@@ -0,0 +1,347 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Host side test for the RAM block cache of ATFile_ReadCached().
+ *
+ * Runs WCON_Drivers/Calypso/Calypso.c and ATCommands/ATFile.c with the block cache enabled
+ * (ATFILE_CACHE_SIZE, 4 blocks of ATFILE_CACHE_BLOCK_SIZE bytes) against an emulated Calypso module.
+ * The emulated module answers the AT+file* commands sent via WE_UART_Transmit() by feeding the
+ * response lines to WE_UART_HandleRxByte(), like the UART RX interrupt of the platform.
+ *
+ * The test checks that
+ * - the first read of a file is read from the module (AT+fileRead) and repeated reads are served
+ *   from the cache without any AT+fileRead command,
+ * - the least recently used block is evicted when the cache is full,
+ * - writing (ATFile_Open() for writing, ATFile_Write(), ATFile_Close()), deleting a file and a
+ *   restart of the module (startup event) invalidate the cached blocks, so that no stale data is returned.
+ *
+ * Build and run on the host:
+ *   gcc -O2 -I../../WCON_Drivers -o file_cache_test file_cache_test.c
+ *   ./file_cache_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* skip the platform header, the test provides the platform functions on a virtual clock */
+#define GLOBAL_H_INCLUDED
+typedef int WE_FlowControl_t;
+typedef int WE_Parity_t;
+typedef enum WE_Pin_Level_t { WE_Pin_Level_Low, WE_Pin_Level_High } WE_Pin_Level_t;
+typedef enum WE_Pin_Type_t { WE_Pin_Type_Output, WE_Pin_Type_Input } WE_Pin_Type_t;
+typedef struct WE_Pin_t { void *port; uint32_t pin; WE_Pin_Type_t type; } WE_Pin_t;
+#define GPIOA NULL
+#define GPIOB NULL
+#define GPIO_PIN_0 0x0001
+#define GPIO_PIN_1 0x0002
+#define GPIO_PIN_7 0x0080
+#define GPIO_PIN_8 0x0100
+#define GPIO_PIN_9 0x0200
+#define GPIO_PIN_10 0x0400
+uint32_t WE_GetTick();
+uint32_t WE_GetTickMicroseconds();
+void WE_Delay(uint16_t sleepForMs);
+void WE_DelayMicroseconds(uint32_t sleepForUsec);
+bool WE_InitPins(WE_Pin_t pins[], uint8_t numPins);
+bool WE_SetPin(WE_Pin_t pin, WE_Pin_Level_t out);
+WE_Pin_Level_t WE_GetPinLevel(WE_Pin_t pin);
+void WE_UART_Init(uint32_t baudrate, WE_FlowControl_t flowControl, WE_Parity_t par, bool dma);
+void WE_UART_DeInit();
+void WE_UART_Transmit(const uint8_t *data, uint16_t length);
+void WE_UART_HandleRxByte(uint8_t receivedByte);
+
+#define ATFILE_CACHE_SIZE 1024
+
+#include "Calypso/Calypso.c"
+#include "Calypso/ATCommands/ATCommands.c"
+#include "Calypso/ATCommands/ATFile.c"
+
+#define FILE_COUNT      2
+#define FILE_MAX_SIZE   2048
+#define LINE_MAX_LENGTH 4096
+
+typedef struct EmulatedFile_t
+{
+    const char *name;
+    bool exists;
+    uint32_t size;
+    char data[FILE_MAX_SIZE];
+} EmulatedFile_t;
+
+static uint64_t nowUs = 0;
+
+static EmulatedFile_t files[FILE_COUNT] = { { "user/a.txt" }, { "user/b.txt" } };
+static char commandLine[LINE_MAX_LENGTH];
+static uint32_t commandLength = 0;
+
+static uint32_t fileReadCommands = 0;
+static uint32_t fileGetInfoCommands = 0;
+static bool ok = true;
+
+/* platform functions used by the driver */
+uint32_t WE_GetTick() { return (uint32_t)(nowUs / 1000); }
+uint32_t WE_GetTickMicroseconds() { return (uint32_t) nowUs; }
+void WE_Delay(uint16_t sleepForMs) { nowUs += (uint64_t) sleepForMs * 1000; }
+void WE_DelayMicroseconds(uint32_t sleepForUsec) { nowUs += sleepForUsec; }
+bool WE_InitPins(WE_Pin_t pins[], uint8_t numPins) { (void) pins; (void) numPins; return true; }
+bool WE_SetPin(WE_Pin_t pin, WE_Pin_Level_t out) { (void) pin; (void) out; return true; }
+WE_Pin_Level_t WE_GetPinLevel(WE_Pin_t pin) { (void) pin; return WE_Pin_Level_Low; }
+void WE_UART_Init(uint32_t baudrate, WE_FlowControl_t flowControl, WE_Parity_t par, bool dma) { (void) baudrate; (void) flowControl; (void) par; (void) dma; }
+void WE_UART_DeInit() {}
+
+static void ModuleSend(const char *line)
+{
+    while (*line != '\0')
+    {
+        WE_UART_HandleRxByte((uint8_t) *line++);
+    }
+    WE_UART_HandleRxByte('\r');
+    WE_UART_HandleRxByte('\n');
+}
+
+static EmulatedFile_t *FindFile(const char *name, size_t nameLength)
+{
+    for (int i = 0; i < FILE_COUNT; i++)
+    {
+        if (strlen(files[i].name) == nameLength && 0 == strncmp(files[i].name, name, nameLength))
+        {
+            return &files[i];
+        }
+    }
+    return NULL;
+}
+
+static EmulatedFile_t *FileByID(uint32_t fileID)
+{
+    return (fileID >= 1 && fileID <= FILE_COUNT) ? &files[fileID - 1] : NULL;
+}
+
+/* emulated module: handles a complete command line */
+static void ModuleHandleCommand(char *command)
+{
+    static char response[LINE_MAX_LENGTH];
+    char *args = strchr(command, '=');
+    if (NULL == args)
+    {
+        ModuleSend("ERROR:unknown command,-1");
+        return;
+    }
+    args++;
+    size_t nameLength = strcspn(args, ",");
+    EmulatedFile_t *file = NULL;
+
+    if (0 == strncmp(command, "AT+fileOpen=", 12))
+    {
+        file = FindFile(args, nameLength);
+        bool create = (NULL != strstr(args + nameLength, "CREATE"));
+        if (NULL == file || (!file->exists && !create))
+        {
+            ModuleSend("ERROR:file not found,-11");
+            return;
+        }
+        if (create && !file->exists)
+        {
+            file->exists = true;
+            file->size = 0;
+        }
+        sprintf(response, "+fileopen:%d,0", (int)(file - files) + 1);
+        ModuleSend(response);
+    }
+    else if (0 == strncmp(command, "AT+fileGetInfo=", 15))
+    {
+        fileGetInfoCommands++;
+        file = FindFile(args, nameLength);
+        if (NULL == file || !file->exists)
+        {
+            ModuleSend("ERROR:file not found,-11");
+            return;
+        }
+        sprintf(response, "+filegetinfo:OPEN_WRITE,%u,%u,0,%u,1", file->size, FILE_MAX_SIZE, FILE_MAX_SIZE);
+        ModuleSend(response);
+    }
+    else if (0 == strncmp(command, "AT+fileRead=", 12))
+    {
+        unsigned fileID, offset, format, length;
+        fileReadCommands++;
+        if (4 != sscanf(args, "%u,%u,%u,%u", &fileID, &offset, &format, &length) ||
+                NULL == (file = FileByID(fileID)) || format != Calypso_DataFormat_Base64)
+        {
+            ModuleSend("ERROR:invalid arguments,-1");
+            return;
+        }
+        if (offset > file->size)
+        {
+            offset = file->size;
+        }
+        if (length > file->size - offset)
+        {
+            length = file->size - offset;
+        }
+        uint32_t encodedLength = Calypso_GetBase64EncBufSize(length);
+        int n = sprintf(response, "+fileread:1,%u,", encodedLength - 1);
+        Calypso_EncodeBase64((uint8_t *) file->data + offset, length, (uint8_t *) response + n, &encodedLength);
+        ModuleSend(response);
+    }
+    else if (0 == strncmp(command, "AT+fileWrite=", 13))
+    {
+        unsigned fileID, offset, format, length;
+        int n = 0;
+        if (4 != sscanf(args, "%u,%u,%u,%u,%n", &fileID, &offset, &format, &length, &n) ||
+                NULL == (file = FileByID(fileID)) || format != Calypso_DataFormat_Binary ||
+                offset + length > FILE_MAX_SIZE)
+        {
+            ModuleSend("ERROR:invalid arguments,-1");
+            return;
+        }
+        memcpy(file->data + offset, args + n, length);
+        if (offset + length > file->size)
+        {
+            file->size = offset + length;
+        }
+        sprintf(response, "+filewrite:%u", length);
+        ModuleSend(response);
+    }
+    else if (0 == strncmp(command, "AT+fileDel=", 11))
+    {
+        file = FindFile(args, nameLength);
+        if (NULL == file || !file->exists)
+        {
+            ModuleSend("ERROR:file not found,-11");
+            return;
+        }
+        file->exists = false;
+        file->size = 0;
+    }
+    else if (0 != strncmp(command, "AT+fileClose=", 13))
+    {
+        ModuleSend("ERROR:unknown command,-1");
+        return;
+    }
+
+    ModuleSend("OK");
+}
+
+void WE_UART_Transmit(const uint8_t *data, uint16_t length)
+{
+    for (uint16_t i = 0; i < length; i++)
+    {
+        if (commandLength < LINE_MAX_LENGTH - 1)
+        {
+            commandLine[commandLength++] = (char) data[i];
+        }
+        if (commandLength >= 2 && commandLine[commandLength - 2] == '\r' && commandLine[commandLength - 1] == '\n')
+        {
+            commandLine[commandLength - 2] = '\0';
+            commandLength = 0;
+            nowUs += 1000;
+            ModuleHandleCommand(commandLine);
+        }
+    }
+}
+
+static void Check(bool condition, const char *description)
+{
+    printf("%-72s %s\n", description, condition ? "ok" : "FAILED");
+    if (!condition)
+    {
+        ok = false;
+    }
+}
+
+/* reads via the cache and compares with the emulated file, returns the number of AT+fileRead commands */
+static uint32_t ReadAndCompare(EmulatedFile_t *file, uint16_t offset, uint16_t length, bool *dataOk)
+{
+    static char data[FILE_MAX_SIZE + 1];
+    uint16_t bytesRead = 0;
+    uint32_t reads = fileReadCommands;
+
+    bool ret = ATFile_ReadCached(file->name, offset, length, data, &bytesRead);
+
+    uint16_t expected = (offset >= file->size) ? 0 : ((file->size - offset < length) ? file->size - offset : length);
+    *dataOk = ret && bytesRead == expected && 0 == memcmp(data, file->data + offset, expected) && data[bytesRead] == '\0';
+    return fileReadCommands - reads;
+}
+
+static void FillFile(EmulatedFile_t *file, uint32_t size, char seed)
+{
+    file->exists = true;
+    file->size = size;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        file->data[i] = (char)('a' + (seed + i) % 26);
+    }
+}
+
+int main(void)
+{
+    bool dataOk = false;
+    uint32_t hits = 0, misses = 0;
+    uint32_t fileID = 0, secureToken = 0;
+    uint16_t bytesWritten = 0;
+    EmulatedFile_t *a = &files[0];
+    EmulatedFile_t *b = &files[1];
+
+    Calypso_Init(921600, 0, 0, NULL, NULL);
+
+    FillFile(a, 600, 0);
+    FillFile(b, 300, 7);
+
+    printf("cache: %u blocks of %u bytes\n", ATFILE_CACHE_BLOCK_COUNT, ATFILE_CACHE_BLOCK_SIZE);
+
+    /* first read: 3 blocks (256 + 256 + 88 bytes) from the module */
+    Check(3 == ReadAndCompare(a, 0, 600, &dataOk) && dataOk && 1 == fileGetInfoCommands,
+          "first read of a.txt is read from the module (3 blocks)");
+    ATFile_GetCacheStatistics(&hits, &misses);
+    Check(0 == hits && 3 == misses, "statistics: 0 hits, 3 misses");
+
+    /* repeated reads are served from the cache */
+    Check(0 == ReadAndCompare(a, 0, 600, &dataOk) && dataOk && 1 == fileGetInfoCommands,
+          "repeated read of a.txt is served from the cache");
+    Check(0 == ReadAndCompare(a, 250, 20, &dataOk) && dataOk, "read across a block boundary is served from the cache");
+    Check(0 == ReadAndCompare(a, 590, 100, &dataOk) && dataOk, "read beyond the end of the file is truncated");
+    ATFile_GetCacheStatistics(&hits, &misses);
+    Check(6 == hits && 3 == misses, "statistics: 6 hits, 3 misses");
+
+    /* b.txt needs 2 blocks - the least recently used block of a.txt (block 0) is evicted */
+    Check(2 == ReadAndCompare(b, 0, 300, &dataOk) && dataOk, "read of b.txt evicts one block of a.txt");
+    Check(0 == ReadAndCompare(a, 256, 344, &dataOk) && dataOk, "blocks 1 and 2 of a.txt are still cached");
+    Check(1 == ReadAndCompare(a, 0, 10, &dataOk) && dataOk, "evicted block 0 of a.txt is read again");
+
+    /* writing invalidates the cached blocks of the file, the other file stays cached */
+    Check(ATFile_Open(a->name, ATFile_OpenFlags_Write, ATFILE_FILE_MIN_SIZE, &fileID, &secureToken) &&
+          ATFile_Write(fileID, 300, Calypso_DataFormat_Binary, false, 5, "WRITE", &bytesWritten) &&
+          ATFile_Close(fileID, NULL, NULL),
+          "write to a.txt");
+    Check(3 == ReadAndCompare(a, 0, 600, &dataOk) && dataOk && 0 == memcmp(a->data + 300, "WRITE", 5),
+          "a.txt is read from the module after writing (new data)");
+    Check(0 == ReadAndCompare(a, 0, 600, &dataOk) && dataOk, "a.txt is cached again");
+
+    /* deleting the file invalidates the cache, reading fails instead of returning stale data */
+    ReadAndCompare(b, 0, 300, &dataOk);
+    uint32_t getInfoCommands = fileGetInfoCommands;
+    Check(ATFile_Delete(b->name, 0), "delete b.txt");
+    Check(0 == ReadAndCompare(b, 0, 300, &dataOk) && !dataOk && getInfoCommands + 1 == fileGetInfoCommands,
+          "read of the deleted b.txt fails (file info is requested again)");
+
+    /* a restart of the module invalidates the whole cache */
+    ReadAndCompare(a, 0, 600, &dataOk);
+    ModuleSend("+eventstartup:0,0,0,0");
+    Check(3 == ReadAndCompare(a, 0, 600, &dataOk) && dataOk, "a.txt is read from the module after a restart");
+
+    ATFile_GetCacheStatistics(&hits, &misses);
+    printf("statistics: %u hits, %u misses, %u AT+fileRead commands\n", hits, misses, fileReadCommands);
+
+    printf("%s\n", ok ? "all tests passed" : "error: tests failed");
+    return ok ? 0 : 1;
+}
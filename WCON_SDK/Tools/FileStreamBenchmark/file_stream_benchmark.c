@@ -0,0 +1,512 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Host side benchmark for the Calypso file streaming API.
+ *
+ * Runs WCON_Drivers/Calypso/Calypso_FileStream.c against an emulated Calypso module on a
+ * virtual clock and reports the throughput for reading and writing a 64 KB file, compared to
+ * a loop of ATFile_Read()/ATFile_Write() calls (Base64, chunk size ATFILE_FILE_MAX_CHUNK_SIZE).
+ * The application is assumed to spend a fixed time per byte processing (reading) or
+ * producing (writing) the data.
+ *
+ * The emulated command duration consists of the UART transfer of the request (8e1), the
+ * module's processing time, the UART transfer of the response and the driver's polling
+ * interval (5 ms) and minimum command interval (3 ms).
+ *
+ * Build and run on the host:
+ *   gcc -O2 -I../../WCON_Drivers -o file_stream_benchmark file_stream_benchmark.c
+ *   ./file_stream_benchmark [uart baudrate] [application time per byte in ns]
+ *
+ * Without the application time argument, a range of application speeds (0 to 50000 ns/byte) is run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* skip the platform header, the benchmark provides the platform and driver functions on a virtual clock */
+#define GLOBAL_H_INCLUDED
+typedef int WE_FlowControl_t;
+typedef int WE_Parity_t;
+typedef int WE_Pin_Level_t;
+typedef struct WE_Pin_t { int pin; } WE_Pin_t;
+uint32_t WE_GetTick();
+uint32_t WE_GetTickMicroseconds();
+
+#include "Calypso/Calypso_FileStream.c"
+
+#define FILE_SIZE               (64 * 1024)
+#define UART_BITS_PER_BYTE      11      /* start, 8 data, parity, stop */
+#define MODULE_READ_LATENCY_US  2000    /* assumed processing time of AT+fileRead */
+#define MODULE_WRITE_LATENCY_US 6000    /* assumed processing time of AT+fileWrite (flash write) */
+#define MODULE_OTHER_LATENCY_US 2000    /* assumed processing time of other commands */
+#define POLL_INTERVAL_US        5000    /* Calypso_waitTimeStepUsec */
+#define MIN_COMMAND_INTERVAL_US 3000    /* Calypso_minCommandIntervalUsec */
+#define RESPONSE_MAX_LENGTH     2048
+
+static uint64_t nowUs = 0;
+static uint32_t uartBaudrate = 921600;
+static uint32_t appNsPerByte = 0;
+
+static uint8_t fileContent[FILE_SIZE];          /* content of the emulated module file */
+static uint8_t sourceData[FILE_SIZE];           /* data written by the application */
+
+static char response[RESPONSE_MAX_LENGTH];
+static char defaultResponseBuffer[RESPONSE_MAX_LENGTH];  /* emulated AT_commandBuffer */
+static char *responseBuffer = defaultResponseBuffer;     /* buffer receiving the response of the pending request */
+static size_t responseBufferSize = sizeof(defaultResponseBuffer);
+static char *nextResponseBuffer = defaultResponseBuffer; /* set by Calypso_SetResponseBuffer() */
+static size_t nextResponseBufferSize = sizeof(defaultResponseBuffer);
+static uint64_t responseReadyUs = 0;
+static uint64_t lastConfirmUs = 0;
+static bool responsePending = false;
+
+static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/* platform functions */
+uint32_t WE_GetTick()
+{
+    return (uint32_t)(nowUs / 1000);
+}
+
+uint32_t WE_GetTickMicroseconds()
+{
+    return (uint32_t)nowUs;
+}
+
+static uint64_t UartTimeUs(uint32_t bytes)
+{
+    return (uint64_t)bytes * UART_BITS_PER_BYTE * 1000000 / uartBaudrate;
+}
+
+static void ApplicationTime(uint32_t bytes)
+{
+    nowUs += (uint64_t)bytes * appNsPerByte / 1000;
+}
+
+/* Base64 and argument helpers used by the stream (same semantics as in Calypso.c) */
+uint32_t Calypso_GetBase64EncBufSize(uint32_t inputLength)
+{
+    return (4 * ((inputLength + 2) / 3)) + 1;
+}
+
+uint32_t Calypso_GetBase64DecBufSize(uint8_t *inputData, uint32_t inputLength)
+{
+    uint32_t size = (inputLength / 4) * 3;
+    if (inputLength >= 2 && inputData[inputLength - 1] == '=') size--;
+    if (inputLength >= 2 && inputData[inputLength - 2] == '=') size--;
+    return size + 1;
+}
+
+bool Calypso_EncodeBase64(uint8_t *inputData, uint32_t inputLength, uint8_t *outputData, uint32_t *outputLength)
+{
+    uint32_t i, j;
+    for (i = 0, j = 0; i < inputLength; i += 3)
+    {
+        uint32_t v = (uint32_t)inputData[i] << 16;
+        if (i + 1 < inputLength) v |= (uint32_t)inputData[i + 1] << 8;
+        if (i + 2 < inputLength) v |= inputData[i + 2];
+        outputData[j++] = base64Chars[(v >> 18) & 0x3F];
+        outputData[j++] = base64Chars[(v >> 12) & 0x3F];
+        outputData[j++] = (i + 1 < inputLength) ? base64Chars[(v >> 6) & 0x3F] : '=';
+        outputData[j++] = (i + 2 < inputLength) ? base64Chars[v & 0x3F] : '=';
+    }
+    outputData[j] = 0;
+    *outputLength = j + 1;
+    return true;
+}
+
+bool Calypso_DecodeBase64(uint8_t *inputData, uint32_t inputLength, uint8_t *outputData, uint32_t *outputLength)
+{
+    uint32_t i, j, k;
+    if (inputLength % 4 != 0)
+    {
+        return false;
+    }
+    *outputLength = Calypso_GetBase64DecBufSize(inputData, inputLength);
+    for (i = 0, j = 0; i < inputLength; i += 4)
+    {
+        uint32_t v = 0;
+        for (k = 0; k < 4; k++)
+        {
+            const char *p = strchr(base64Chars, inputData[i + k]);
+            v = (v << 6) | ((inputData[i + k] == '=' || p == NULL) ? 0 : (uint32_t)(p - base64Chars));
+        }
+        if (j < *outputLength - 1) outputData[j++] = (v >> 16) & 0xFF;
+        if (j < *outputLength - 1) outputData[j++] = (v >> 8) & 0xFF;
+        if (j < *outputLength - 1) outputData[j++] = v & 0xFF;
+    }
+    outputData[j] = 0;
+    return true;
+}
+
+bool Calypso_AppendArgumentString(char *pOutString, const char *pInArgument, char delimiter)
+{
+    strcat(pOutString, pInArgument);
+    if (delimiter != CALYPSO_STRING_TERMINATE)
+    {
+        size_t length = strlen(pOutString);
+        pOutString[length] = delimiter;
+        pOutString[length + 1] = '\0';
+    }
+    return true;
+}
+
+bool Calypso_AppendArgumentInt(char *pOutString, uint32_t pInValue, uint16_t intFlags, char delimiter)
+{
+    char temp[12];
+    (void)intFlags;
+    sprintf(temp, "%u", pInValue);
+    return Calypso_AppendArgumentString(pOutString, temp, delimiter);
+}
+
+bool Calypso_GetNextArgumentInt(char **pInArguments, void *pOutInt, uint16_t intFlags, char delimiter)
+{
+    uint32_t value = strtoul(*pInArguments, pInArguments, 10);
+    if (**pInArguments != delimiter)
+    {
+        return false;
+    }
+    (*pInArguments)++;
+    switch (intFlags & CALYPSO_INTFLAGS_SIZE)
+    {
+    case CALYPSO_INTFLAGS_SIZE8: *(uint8_t*)pOutInt = (uint8_t)value; break;
+    case CALYPSO_INTFLAGS_SIZE16: *(uint16_t*)pOutInt = (uint16_t)value; break;
+    default: *(uint32_t*)pOutInt = value; break;
+    }
+    return true;
+}
+
+uint32_t Calypso_GetTimeout(Calypso_Timeout_t type)
+{
+    (void)type;
+    return 5000;
+}
+
+/* emulated module: executes the command and schedules the response */
+static void EmulateCommand(const char *command, const uint8_t *data, uint16_t dataLength)
+{
+    uint32_t fileID, offset, format, length;
+    uint32_t latencyUs = MODULE_OTHER_LATENCY_US;
+
+    if (nowUs < lastConfirmUs + MIN_COMMAND_INTERVAL_US)
+    {
+        nowUs = lastConfirmUs + MIN_COMMAND_INTERVAL_US;
+    }
+    nowUs += UartTimeUs(strlen(command) + dataLength + ((dataLength > 0) ? 2 : 0));
+
+    response[0] = '\0';
+    if (4 == sscanf(command, "AT+fileRead=%u,%u,%u,%u", &fileID, &offset, &format, &length))
+    {
+        uint32_t encodedLength = 0;
+        int n = sprintf(response, "+fileread:%u,%u,", format, Calypso_GetBase64EncBufSize(length) - 1);
+        Calypso_EncodeBase64(&fileContent[offset], length, (uint8_t*)response + n, &encodedLength);
+        latencyUs = MODULE_READ_LATENCY_US;
+    }
+    else if (4 == sscanf(command, "AT+fileWrite=%u,%u,%u,%u", &fileID, &offset, &format, &length))
+    {
+        const char *payload = (const char*)data;
+        if (NULL == data)
+        {
+            /* data argument is part of the command string */
+            payload = strrchr(command, ',') + 1;
+        }
+        if (format == Calypso_DataFormat_Base64)
+        {
+            uint32_t decodedLength = 0;
+            uint8_t decoded[RESPONSE_MAX_LENGTH];
+            Calypso_DecodeBase64((uint8_t*)payload, length, decoded, &decodedLength);
+            memcpy(&fileContent[offset], decoded, decodedLength - 1);
+            length = decodedLength - 1;
+        }
+        else
+        {
+            memcpy(&fileContent[offset], payload, length);
+        }
+        sprintf(response, "+filewrite:%u", length);
+        latencyUs = MODULE_WRITE_LATENCY_US;
+    }
+
+    responseReadyUs = nowUs + latencyUs + UartTimeUs(strlen(response) + 2 + 4); /* response line and "OK\r\n" */
+    responsePending = true;
+
+    /* like the driver, the response is written to the selected buffer by the RX interrupt, which may happen
+     * at any time before Calypso_WaitForConfirm() is called - emulate the worst case (immediately) */
+    responseBuffer = nextResponseBuffer;
+    responseBufferSize = nextResponseBufferSize;
+    nextResponseBuffer = defaultResponseBuffer;
+    nextResponseBufferSize = sizeof(defaultResponseBuffer);
+    if ((NULL != responseBuffer) && (responseBufferSize > 0))
+    {
+        strncpy(responseBuffer, response, responseBufferSize - 1);
+        responseBuffer[responseBufferSize - 1] = '\0';
+    }
+}
+
+bool Calypso_SendRequest(char *data)
+{
+    EmulateCommand(data, NULL, 0);
+    return true;
+}
+
+bool Calypso_SendRequestWithData(char *command, const uint8_t *data, uint16_t dataLength)
+{
+    EmulateCommand(command, data, dataLength);
+    return true;
+}
+
+void Calypso_SetResponseBuffer(char *buffer, size_t size)
+{
+    nextResponseBuffer = buffer;
+    nextResponseBufferSize = (NULL == buffer) ? 0 : size;
+}
+
+bool Calypso_WaitForConfirm(uint32_t maxTimeMs, Calypso_CNFStatus_t expectedStatus, char *pOutResponse)
+{
+    (void)maxTimeMs;
+    (void)expectedStatus;
+    if (!responsePending)
+    {
+        return false;
+    }
+    if (nowUs < responseReadyUs)
+    {
+        /* the driver polls the confirmation status */
+        uint64_t waitUs = responseReadyUs - nowUs;
+        nowUs += ((waitUs + POLL_INTERVAL_US - 1) / POLL_INTERVAL_US) * POLL_INTERVAL_US;
+    }
+    responsePending = false;
+    lastConfirmUs = nowUs;
+    if ((NULL != pOutResponse) && (NULL != responseBuffer) && (pOutResponse != responseBuffer))
+    {
+        memmove(pOutResponse, responseBuffer, strlen(responseBuffer) + 1);
+    }
+    return true;
+}
+
+static void EmulateShortCommand(void)
+{
+    Calypso_SendRequest("AT+fileOpen=\"/user/benchmark.bin\",1,65536\r\n");
+    Calypso_WaitForConfirm(0, Calypso_CNFStatus_Success, NULL);
+}
+
+bool ATFile_GetInfo(const char *fileName, uint32_t secureToken, ATFile_FileInfo_t *fileInfo)
+{
+    (void)fileName;
+    (void)secureToken;
+    EmulateShortCommand();
+    memset(fileInfo, 0, sizeof(*fileInfo));
+    fileInfo->size = FILE_SIZE;
+    return true;
+}
+
+bool ATFile_Open(const char *fileName, uint32_t options, uint32_t fileSize, uint32_t *fileID, uint32_t *secureToken)
+{
+    (void)fileName;
+    (void)options;
+    (void)fileSize;
+    EmulateShortCommand();
+    *fileID = 1;
+    *secureToken = 0;
+    return true;
+}
+
+bool ATFile_Close(uint32_t fileID, char *certFileName, char *signature)
+{
+    (void)fileID;
+    (void)certFileName;
+    (void)signature;
+    EmulateShortCommand();
+    return true;
+}
+
+/* ATFile_Read() loop: request, wait, decode, process */
+static bool ReadBaseline(void)
+{
+    static char commandBuffer[RESPONSE_MAX_LENGTH];
+    static char data[ATFILE_FILE_MAX_CHUNK_SIZE + 1];
+    uint32_t offset;
+
+    EmulateShortCommand();
+    for (offset = 0; offset < FILE_SIZE; offset += ATFILE_FILE_MAX_CHUNK_SIZE)
+    {
+        uint32_t length = FILE_SIZE - offset;
+        uint32_t decodedLength = 0;
+        char *p;
+        if (length > ATFILE_FILE_MAX_CHUNK_SIZE) length = ATFILE_FILE_MAX_CHUNK_SIZE;
+
+        sprintf(commandBuffer, "AT+fileRead=1,%u,1,%u\r\n", offset, length);
+        Calypso_SendRequest(commandBuffer);
+        Calypso_WaitForConfirm(0, Calypso_CNFStatus_Success, commandBuffer);
+        p = strrchr(commandBuffer, ',') + 1;
+        Calypso_DecodeBase64((uint8_t*)p, strlen(p), (uint8_t*)data, &decodedLength);
+        if ((decodedLength - 1 != length) || (0 != memcmp(data, &fileContent[offset], length)))
+        {
+            return false;
+        }
+        ApplicationTime(length);
+    }
+    EmulateShortCommand();
+    return true;
+}
+
+/* ATFile_Write() loop with Base64 encoding: produce, encode, request, wait */
+static bool WriteBaseline(void)
+{
+    static char commandBuffer[RESPONSE_MAX_LENGTH];
+    const uint32_t chunkSize = (((ATFILE_FILE_MAX_CHUNK_SIZE - 1) * 3) / 4) - 2;
+    uint32_t offset;
+
+    memset(fileContent, 0, sizeof(fileContent));
+    EmulateShortCommand();
+    for (offset = 0; offset < FILE_SIZE; offset += chunkSize)
+    {
+        uint32_t length = FILE_SIZE - offset;
+        uint32_t encodedLength = 0;
+        int n;
+        if (length > chunkSize) length = chunkSize;
+
+        ApplicationTime(length);
+        n = sprintf(commandBuffer, "AT+fileWrite=1,%u,1,%u,", offset, Calypso_GetBase64EncBufSize(length) - 1);
+        Calypso_EncodeBase64(&sourceData[offset], length, (uint8_t*)commandBuffer + n, &encodedLength);
+        strcat(commandBuffer, "\r\n");
+        Calypso_SendRequest(commandBuffer);
+        Calypso_WaitForConfirm(0, Calypso_CNFStatus_Success, commandBuffer);
+    }
+    EmulateShortCommand();
+    return 0 == memcmp(fileContent, sourceData, FILE_SIZE);
+}
+
+static bool ReadStream(uint16_t *chunkSize)
+{
+    Calypso_FileStream_Statistics_t statistics;
+    uint32_t fileSize = 0;
+    uint32_t offset = 0;
+    const uint8_t *data;
+    uint16_t length;
+
+    if (!Calypso_FileStream_OpenRead("/user/benchmark.bin", &fileSize))
+    {
+        return false;
+    }
+    while (Calypso_FileStream_ReadChunk(&data, &length) && length > 0)
+    {
+        if (0 != memcmp(data, &fileContent[offset], length))
+        {
+            return false;
+        }
+        offset += length;
+        ApplicationTime(length);
+    }
+    Calypso_FileStream_GetStatistics(&statistics);
+    *chunkSize = statistics.chunkSize;
+    return Calypso_FileStream_Close() && offset == fileSize;
+}
+
+static bool WriteStream(uint16_t *chunkSize)
+{
+    Calypso_FileStream_Statistics_t statistics;
+    const uint32_t blockSize = 1500;
+    uint32_t offset;
+
+    memset(fileContent, 0, sizeof(fileContent));
+    if (!Calypso_FileStream_OpenWrite("/user/benchmark.bin", FILE_SIZE))
+    {
+        return false;
+    }
+    for (offset = 0; offset < FILE_SIZE; offset += blockSize)
+    {
+        uint32_t length = FILE_SIZE - offset;
+        if (length > blockSize) length = blockSize;
+
+        ApplicationTime(length);
+        if (!Calypso_FileStream_Write(&sourceData[offset], length))
+        {
+            return false;
+        }
+    }
+    Calypso_FileStream_GetStatistics(&statistics);
+    *chunkSize = statistics.chunkSize;
+    return Calypso_FileStream_Close() && 0 == memcmp(fileContent, sourceData, FILE_SIZE);
+}
+
+static double KBytesPerSecond(uint64_t elapsedUs)
+{
+    return (double)FILE_SIZE / 1024 * 1000000 / (double)elapsedUs;
+}
+
+/* runs all four transfers at the current application speed and prints one line */
+static bool RunBenchmark(void)
+{
+    uint64_t start;
+    uint16_t readChunkSize = 0;
+    uint16_t writeChunkSize = 0;
+    double readBaseline, readStream, writeBaseline, writeStream;
+
+    memcpy(fileContent, sourceData, FILE_SIZE);
+
+    start = nowUs;
+    if (!ReadBaseline()) { printf("error: ATFile_Read() loop returned wrong data\n"); return false; }
+    readBaseline = KBytesPerSecond(nowUs - start);
+
+    start = nowUs;
+    if (!ReadStream(&readChunkSize)) { printf("error: stream read returned wrong data\n"); return false; }
+    readStream = KBytesPerSecond(nowUs - start);
+
+    start = nowUs;
+    if (!WriteBaseline()) { printf("error: ATFile_Write() loop wrote wrong data\n"); return false; }
+    writeBaseline = KBytesPerSecond(nowUs - start);
+
+    start = nowUs;
+    if (!WriteStream(&writeChunkSize)) { printf("error: stream write wrote wrong data\n"); return false; }
+    writeStream = KBytesPerSecond(nowUs - start);
+
+    printf("%8u  %14.1f  %12.1f  %15.1f  %13.1f  %11u\n",
+           appNsPerByte, readBaseline, readStream, writeBaseline, writeStream, readChunkSize);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    static const uint32_t appSpeeds[] = { 0, 1000, 2000, 5000, 10000, 20000, 50000 };
+    uint32_t i;
+
+    if (argc > 1) uartBaudrate = strtoul(argv[1], NULL, 0);
+
+    srand(1);
+    for (i = 0; i < FILE_SIZE; i++)
+    {
+        /* binary content including '\0', '\r' and '\n' */
+        sourceData[i] = (uint8_t)rand();
+    }
+
+    printf("%u byte file, UART %u baud, throughput in KB/s\n", FILE_SIZE, uartBaudrate);
+    printf(" ns/byte  read ATFile loop   read stream  write ATFile loop   write stream  chunk size\n");
+
+    if (argc > 2)
+    {
+        appNsPerByte = strtoul(argv[2], NULL, 0);
+        return RunBenchmark() ? 0 : 1;
+    }
+
+    /* the benefit of the stream depends on how fast the application consumes or produces the data */
+    for (i = 0; i < sizeof(appSpeeds) / sizeof(appSpeeds[0]); i++)
+    {
+        appNsPerByte = appSpeeds[i];
+        if (!RunBenchmark())
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Host side loopback emulator for the proprietary radio fragmentation layer.
+ *
+ * Runs WCON_Drivers/ProprietaryRadio/Fragmentation.c against an emulated Transmit_Extended
+ * function on a virtual clock and reports the goodput for 4 KB messages at different
+ * packet loss rates. The emulated transmission time consists of the UART transfer of the
+ * request, the time on air and the UART transfer of the confirmation.
+ *
+ * Build and run on the host:
+ *   gcc -O2 -I../../WCON_Drivers -o fragmentation_emulator fragmentation_emulator.c
+ *   ./fragmentation_emulator [uart baudrate] [rf bitrate] [cnf poll step in ms]
+ *
+ * A cnf poll step of 5 ms emulates the previous driver, which polled for the confirmation every 5 ms.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* skip the platform header, the emulator provides the platform functions on a virtual clock */
+#define GLOBAL_H_INCLUDED
+uint32_t WE_GetTick();
+void WE_Delay(uint16_t sleepForMs);
+
+#include "ProprietaryRadio/Fragmentation.c"
+
+#define MESSAGE_LENGTH  4096
+#define MESSAGE_COUNT   20
+#define UART_CMD_OVERHEAD 7     /* STX, CMD, LEN, channel, net id, address, CS (address mode 2) */
+#define UART_CNF_LENGTH   5
+#define RF_OVERHEAD       16    /* preamble, sync word, length, address header, CRC */
+#define MODULE_LATENCY_US 500
+
+static uint64_t nowUs = 0;
+static uint32_t uartBaudrate = 115200;
+static uint32_t rfBitrate = 100000;
+static uint32_t cnfStepMs = 0;
+static uint32_t lossPerMille = 0;
+static uint32_t randomState = 1;
+
+static uint32_t transmissions = 0;
+static uint32_t messagesReceived = 0;
+static uint32_t messagesCorrupted = 0;
+static uint8_t message[MESSAGE_LENGTH];
+
+/* platform functions used by the fragmentation layer */
+uint32_t WE_GetTick()
+{
+    return (uint32_t)(nowUs / 1000);
+}
+
+void WE_Delay(uint16_t sleepForMs)
+{
+    nowUs += (uint64_t)sleepForMs * 1000;
+}
+
+static uint32_t Random(void)
+{
+    randomState = randomState * 1103515245 + 12345;
+    return (randomState >> 16) & 0x7FFF;
+}
+
+/* emulated TarvosIII_Transmit_Extended: the packet is looped back to the receiving side */
+static bool EmulatedTransmit(uint8_t* payload, uint8_t length, uint8_t channel, uint8_t dest_network_id, uint8_t dest_address_lsb, uint8_t dest_address_msb)
+{
+    uint64_t duration = 0;
+    duration += (uint64_t)(length + UART_CMD_OVERHEAD) * 10 * 1000000 / uartBaudrate;
+    duration += (uint64_t)(length + RF_OVERHEAD) * 8 * 1000000 / rfBitrate;
+    duration += MODULE_LATENCY_US;
+    duration += (uint64_t)UART_CNF_LENGTH * 10 * 1000000 / uartBaudrate;
+    if (cnfStepMs > 0)
+    {
+        /* confirmation is only detected at the next poll */
+        uint64_t step = (uint64_t)cnfStepMs * 1000;
+        duration = ((duration + step - 1) / step) * step;
+    }
+    nowUs += duration;
+    transmissions++;
+
+    if ((Random() % 1000) >= lossPerMille)
+    {
+        Fragmentation_HandleRx(payload, length, dest_network_id, dest_address_lsb, dest_address_msb);
+    }
+    return true;
+}
+
+static void EmulatedRxCallback(uint8_t* data, uint16_t length, uint8_t src_network_id, uint8_t src_address_lsb, uint8_t src_address_msb)
+{
+    messagesReceived++;
+    if ((length != MESSAGE_LENGTH) || (memcmp(data, message, length) != 0))
+    {
+        messagesCorrupted++;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    static const uint32_t losses[] = { 0, 10, 50, 100, 200 };
+    int i = 0;
+    int n = 0;
+
+    if (argc > 1) uartBaudrate = strtoul(argv[1], NULL, 0);
+    if (argc > 2) rfBitrate = strtoul(argv[2], NULL, 0);
+    if (argc > 3) cnfStepMs = strtoul(argv[3], NULL, 0);
+
+    for (i = 0; i < MESSAGE_LENGTH; i++)
+    {
+        message[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    printf("%u x %u byte messages, UART %u baud, RF %u bit/s, cnf poll step %u ms\n",
+           MESSAGE_COUNT, MESSAGE_LENGTH, uartBaudrate, rfBitrate, cnfStepMs);
+    printf("loss   goodput [kbit/s]   ms/message   packets/message   failed\n");
+
+    for (i = 0; i < (int)(sizeof(losses) / sizeof(losses[0])); i++)
+    {
+        uint32_t failed = 0;
+        lossPerMille = losses[i];
+        transmissions = 0;
+        messagesReceived = 0;
+        messagesCorrupted = 0;
+        randomState = 1;
+        Fragmentation_Init(130, EmulatedTransmit, EmulatedRxCallback);
+
+        uint64_t start = nowUs;
+        for (n = 0; n < MESSAGE_COUNT; n++)
+        {
+            message[0] = (uint8_t)n;
+            if (!Fragmentation_Send(message, MESSAGE_LENGTH, 0x01, 0x02, 0xFF))
+            {
+                failed++;
+            }
+            Fragmentation_Process();
+        }
+        uint64_t elapsed = nowUs - start;
+
+        printf("%4.1f%%  %17.1f  %11.1f  %16.1f  %7u\n",
+               lossPerMille / 10.0,
+               (double)(MESSAGE_COUNT - failed) * MESSAGE_LENGTH * 8 * 1000 / (double)elapsed,
+               (double)elapsed / 1000 / MESSAGE_COUNT,
+               (double)transmissions / MESSAGE_COUNT,
+               failed);
+        if (messagesCorrupted != 0)
+        {
+            printf("error: %u corrupted messages\n", messagesCorrupted);
+            return 1;
+        }
+    }
+    return 0;
+}
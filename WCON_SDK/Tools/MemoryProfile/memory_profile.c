@@ -0,0 +1,83 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Host side memory profile report for the Calypso driver.
+ *
+ * Prints the static RAM used by WCON_Drivers/Calypso/Calypso.c for the memory profile selected
+ * at build time (CALYPSO_MEMORY_PROFILE, see Calypso.h) as returned by Calypso_GetMemoryReport(),
+ * together with the resulting limits (socket payload size, size of HTTP response bodies).
+ *
+ * Sizes of the buffer arena are exact, the size of the other static state (pin configuration)
+ * may differ slightly on the target due to the host's pointer size. The platform's UART DMA
+ * receive buffer (WE_DMA_RX_BUFFER_SIZE, see global.h) is not included.
+ *
+ * Build and run on the host (one build per profile):
+ *   for p in 0 1 2; do
+ *     gcc -O2 -DCALYPSO_MEMORY_PROFILE=$p -I../../WCON_Drivers -o memory_profile memory_profile.c && ./memory_profile
+ *   done
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* skip the platform header, the report provides the platform functions (unused) */
+#define GLOBAL_H_INCLUDED
+typedef int WE_FlowControl_t;
+typedef int WE_Parity_t;
+typedef enum WE_Pin_Level_t { WE_Pin_Level_Low, WE_Pin_Level_High } WE_Pin_Level_t;
+typedef enum WE_Pin_Type_t { WE_Pin_Type_Output, WE_Pin_Type_Input } WE_Pin_Type_t;
+typedef struct WE_Pin_t { void *port; uint32_t pin; WE_Pin_Type_t type; } WE_Pin_t;
+#define GPIOA NULL
+#define GPIOB NULL
+#define GPIO_PIN_0 0x0001
+#define GPIO_PIN_1 0x0002
+#define GPIO_PIN_7 0x0080
+#define GPIO_PIN_8 0x0100
+#define GPIO_PIN_9 0x0200
+#define GPIO_PIN_10 0x0400
+uint32_t WE_GetTick() { return 0; }
+uint32_t WE_GetTickMicroseconds() { return 0; }
+void WE_Delay(uint16_t sleepForMs) { (void) sleepForMs; }
+void WE_DelayMicroseconds(uint32_t sleepForUsec) { (void) sleepForUsec; }
+bool WE_InitPins(WE_Pin_t pins[], uint8_t numPins) { (void) pins; (void) numPins; return true; }
+bool WE_SetPin(WE_Pin_t pin, WE_Pin_Level_t out) { (void) pin; (void) out; return true; }
+WE_Pin_Level_t WE_GetPinLevel(WE_Pin_t pin) { (void) pin; return WE_Pin_Level_Low; }
+void WE_UART_Init(uint32_t baudrate, WE_FlowControl_t flowControl, WE_Parity_t par, bool dma) { (void) baudrate; (void) flowControl; (void) par; (void) dma; }
+void WE_UART_DeInit() {}
+void WE_UART_Transmit(const uint8_t *data, uint16_t length) { (void) data; (void) length; }
+
+#include "Calypso/Calypso.c"
+#include "Calypso/ATCommands/ATCommands.c"
+#include "Calypso/ATCommands/ATFile.c"
+#include "Calypso/ATCommands/ATHTTP.h"
+
+static const char *profileNames[] = {"default", "small", "tiny"};
+
+int main(void)
+{
+    Calypso_MemoryReport_t report;
+    Calypso_GetMemoryReport(&report);
+
+    printf("Calypso memory profile \"%s\" (CALYPSO_MEMORY_PROFILE=%u)\n", profileNames[report.profile], report.profile);
+    printf("  RX line buffer            %6zu bytes\n", report.lineBufferSize);
+    printf("  command / response buffer %6zu bytes\n", report.commandBufferSize);
+    printf("  buffer arena              %6zu bytes\n", report.arenaSize);
+    printf("  event queue               %6zu bytes\n", report.eventQueueSize);
+    printf("  other static state        %6zu bytes\n", report.stateSize);
+    printf("  total                     %6zu bytes\n", report.totalSize);
+    printf("  max. socket payload       %6u bytes\n", (unsigned) CALYPSO_MAX_PAYLOAD_SIZE);
+    printf("  ATHTTP_ResponseBody_t     %6zu bytes (allocated by caller)\n", sizeof(ATHTTP_ResponseBody_t));
+
+    return 0;
+}
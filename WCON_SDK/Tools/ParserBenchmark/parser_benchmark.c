@@ -0,0 +1,426 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Host side benchmark for the Calypso response argument parser.
+ *
+ * Parses captured Calypso responses and events (scan entry, IPv4 acquired event, device time,
+ * host lookup) using the view based tokenizer of WCON_Drivers/Calypso/Calypso.c and using a copy
+ * of the previous tokenizer, which determined the length of the remaining response for each
+ * argument and copied each argument to a temporary string before converting it. Both parsers
+ * process the same argument lists and must return the same values. The socket receive event is
+ * parsed by ATEvent_ParseSocketRcvdEvent(), which references the payload in the event text, and
+ * by a copy of the previous version of that function, which copied the payload to the event
+ * structure. Reports the time per parsed response for both implementations.
+ *
+ * Build and run on the host:
+ *   gcc -O2 -I../../WCON_Drivers -o parser_benchmark parser_benchmark.c
+ *   ./parser_benchmark [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* skip the platform header, the benchmark provides the platform functions (unused) */
+#define GLOBAL_H_INCLUDED
+typedef int WE_FlowControl_t;
+typedef int WE_Parity_t;
+typedef enum WE_Pin_Level_t { WE_Pin_Level_Low, WE_Pin_Level_High } WE_Pin_Level_t;
+typedef enum WE_Pin_Type_t { WE_Pin_Type_Output, WE_Pin_Type_Input } WE_Pin_Type_t;
+typedef struct WE_Pin_t { void *port; uint32_t pin; WE_Pin_Type_t type; } WE_Pin_t;
+#define GPIOA NULL
+#define GPIOB NULL
+#define GPIO_PIN_0 0x0001
+#define GPIO_PIN_1 0x0002
+#define GPIO_PIN_7 0x0080
+#define GPIO_PIN_8 0x0100
+#define GPIO_PIN_9 0x0200
+#define GPIO_PIN_10 0x0400
+uint32_t WE_GetTick() { return 0; }
+uint32_t WE_GetTickMicroseconds() { return 0; }
+void WE_Delay(uint16_t sleepForMs) { (void) sleepForMs; }
+void WE_DelayMicroseconds(uint32_t sleepForUsec) { (void) sleepForUsec; }
+bool WE_InitPins(WE_Pin_t pins[], uint8_t numPins) { (void) pins; (void) numPins; return true; }
+bool WE_SetPin(WE_Pin_t pin, WE_Pin_Level_t out) { (void) pin; (void) out; return true; }
+WE_Pin_Level_t WE_GetPinLevel(WE_Pin_t pin) { (void) pin; return WE_Pin_Level_Low; }
+void WE_UART_Init(uint32_t baudrate, WE_FlowControl_t flowControl, WE_Parity_t par, bool dma) { (void) baudrate; (void) flowControl; (void) par; (void) dma; }
+void WE_UART_DeInit() {}
+void WE_UART_Transmit(const uint8_t *data, uint16_t length) { (void) data; (void) length; }
+
+#include "Calypso/Calypso.c"
+#include "Calypso/ATCommands/ATCommands.c"
+#include "Calypso/ATCommands/ATFile.c"
+#include "Calypso/ATCommands/ATWLAN.c"
+#include "Calypso/ATCommands/ATSocket.c"
+#include "Calypso/ATCommands/ATEvent.c"
+
+#define DEFAULT_ITERATIONS 100000
+
+/* previous tokenizer (strlen() per argument, temporary copy, strtol()) */
+static bool Legacy_StringToInt(void *number, const char *inString, uint16_t intFlags)
+{
+    bool hex = (0 == strncmp(inString, "0x", 2)) || ((intFlags & CALYPSO_INTFLAGS_NOTATION_HEX) != 0);
+    if ((intFlags & CALYPSO_INTFLAGS_SIGNED) != 0)
+    {
+        long longNr = strtol(inString, NULL, hex ? 16 : 10);
+        if ((intFlags & CALYPSO_INTFLAGS_SIZE8) != 0) { *((int8_t*) number) = longNr; }
+        else if ((intFlags & CALYPSO_INTFLAGS_SIZE16) != 0) { *((int16_t*) number) = longNr; }
+        else if ((intFlags & CALYPSO_INTFLAGS_SIZE32) != 0) { *((int32_t*) number) = longNr; }
+    }
+    else
+    {
+        unsigned long longNr = strtoul(inString, NULL, hex ? 16 : 10);
+        if ((intFlags & CALYPSO_INTFLAGS_SIZE8) != 0) { *((uint8_t*) number) = longNr; }
+        else if ((intFlags & CALYPSO_INTFLAGS_SIZE16) != 0) { *((uint16_t*) number) = longNr; }
+        else if ((intFlags & CALYPSO_INTFLAGS_SIZE32) != 0) { *((uint32_t*) number) = longNr; }
+    }
+    return true;
+}
+
+static bool Legacy_GetNextArgumentString(char **pInArguments, char *pOutArgument, char delimiter, uint16_t maxLength)
+{
+    size_t argumentLength = 0;
+    size_t inputStringLength = strlen(*pInArguments);
+
+    while (true)
+    {
+        if (argumentLength > maxLength - 1)
+        {
+            return false;
+        }
+        else if (((*pInArguments)[argumentLength] == delimiter))
+        {
+            memcpy(pOutArgument, *pInArguments, argumentLength);
+            pOutArgument[argumentLength] = '\0';
+            if (argumentLength > 0 || **pInArguments != '\0')
+            {
+                *pInArguments = &((*pInArguments)[argumentLength + 1]);
+            }
+            return true;
+        }
+        else if (argumentLength > inputStringLength)
+        {
+            return false;
+        }
+        argumentLength++;
+    }
+}
+
+static bool Legacy_GetNextArgumentInt(char **pInArguments, void *pOutArgument, uint16_t intFlags, char delimiter)
+{
+    char tempString[12];
+    Legacy_GetNextArgumentString(pInArguments, tempString, delimiter, sizeof(tempString));
+    return Legacy_StringToInt(pOutArgument, tempString, intFlags);
+}
+
+static bool Legacy_GetNextArgumentEnum(char **pInArguments, uint8_t *pOutArgument, const char *stringList[], uint8_t numStrings, uint16_t maxStringLength, char delimiter)
+{
+    char tempString[maxStringLength];
+    if (!Legacy_GetNextArgumentString(pInArguments, tempString, delimiter, sizeof(tempString)))
+    {
+        return false;
+    }
+    bool ok;
+    *pOutArgument = Calypso_FindString(stringList, numStrings, tempString, 0, &ok);
+    return ok;
+}
+
+/* argument lists of the captured responses */
+typedef enum FieldType_t
+{
+    FieldType_String,
+    FieldType_Int,
+    FieldType_Enum
+} FieldType_t;
+
+typedef struct Field_t
+{
+    FieldType_t type;
+    uint16_t intFlags;          /* FieldType_Int */
+    const char **strings;       /* FieldType_Enum */
+    uint8_t numStrings;
+    uint16_t maxLength;         /* buffer size (strings), max. string length (enums) */
+    char delimiter;
+} Field_t;
+
+typedef struct Capture_t Capture_t;
+typedef bool (*Parser_t)(const Capture_t *capture, char *line, uint32_t *checksum);
+
+struct Capture_t
+{
+    const char *name;
+    const char *line;
+    const Field_t *fields;
+    uint8_t numFields;
+    Parser_t parseLegacy;       /* parsers for responses which are not described by an argument list */
+    Parser_t parseViews;
+};
+
+#define U8  (CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC)
+#define S8  (CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_SIGNED | CALYPSO_INTFLAGS_NOTATION_DEC)
+#define U16 (CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC)
+
+static const Field_t wlanScanFields[] =
+{
+    {FieldType_String, 0, NULL, 0, ATWLAN_SSID_MAX_LENGTH, ','},
+    {FieldType_String, 0, NULL, 0, ATWLAN_BSSID_LENGTH, ','},
+    {FieldType_Int, S8, NULL, 0, 0, ','},
+    {FieldType_Int, U8, NULL, 0, 0, ','},
+    {FieldType_Enum, 0, ATWLAN_ScanSecurityTypeStrings, ATWLAN_ScanSecurityType_NumberOfValues, 32, ','},
+    {FieldType_Int, U8, NULL, 0, 0, ','},
+    {FieldType_Enum, 0, ATWLAN_ScanCipherStrings, ATWLAN_ScanCipherType_NumberOfValues, 32, ','},
+    {FieldType_Enum, 0, ATWLAN_ScanKeyMgmntStrings, ATWLAN_ScanKeyManagementType_NumberOfValues, 32, '\0'},
+};
+
+static const Field_t ip4AcquiredFields[] =
+{
+    {FieldType_String, 0, NULL, 0, 20, ','},
+    {FieldType_String, 0, NULL, 0, 20, ','},
+    {FieldType_String, 0, NULL, 0, 20, ','},
+    {FieldType_String, 0, NULL, 0, 20, '\0'},
+};
+
+static const Field_t deviceTimeFields[] =
+{
+    {FieldType_Int, U8, NULL, 0, 0, ','},
+    {FieldType_Int, U8, NULL, 0, 0, ','},
+    {FieldType_Int, U8, NULL, 0, 0, ','},
+    {FieldType_Int, U8, NULL, 0, 0, ','},
+    {FieldType_Int, U8, NULL, 0, 0, ','},
+    {FieldType_Int, U16, NULL, 0, 0, '\0'},
+};
+
+static const Field_t hostByNameFields[] =
+{
+    {FieldType_String, 0, NULL, 0, AT_MAX_HOST_NAME_LENGTH, ','},
+    {FieldType_String, 0, NULL, 0, AT_MAX_IP_ADDRESS_LENGTH, '\0'},
+};
+
+static char socketRcvdLine[1500];
+
+static bool ParseSocketRcvdLegacy(const Capture_t *capture, char *line, uint32_t *checksum);
+static bool ParseSocketRcvdViews(const Capture_t *capture, char *line, uint32_t *checksum);
+
+static const Capture_t captures[] =
+{
+    {"wlanscan entry", "WE-Office-5G,a0:b1:c2:d3:e4:f5,-54,36,WPA2,0,CCMP,PSK", wlanScanFields, 8, NULL, NULL},
+    {"socket rcvd event (1400 bytes)", socketRcvdLine, NULL, 0, ParseSocketRcvdLegacy, ParseSocketRcvdViews},
+    {"ipv4_acquired event", "ipv4_acquired,192.168.178.37,192.168.178.1,192.168.178.1", ip4AcquiredFields, 4, NULL, NULL},
+    {"device time", "14,32,5,18,10,2026", deviceTimeFields, 6, NULL, NULL},
+    {"host by name", "www.we-online.com,145.253.79.38", hostByNameFields, 2, NULL, NULL},
+};
+
+#define NUM_CAPTURES (sizeof(captures) / sizeof(captures[0]))
+
+static char stringBuffer[1500];
+
+static uint32_t Checksum(uint32_t sum, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *) data;
+    for (size_t i = 0; i < length; i++)
+    {
+        sum = sum * 31 + bytes[i];
+    }
+    return sum;
+}
+
+static bool ParseLegacy(const Capture_t *capture, char *line, uint32_t *checksum)
+{
+    char *pArguments = line;
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < capture->numFields; i++)
+    {
+        const Field_t *field = &capture->fields[i];
+        uint32_t value = 0;
+        uint8_t enumValue = 0;
+        bool ok = false;
+        switch (field->type)
+        {
+        case FieldType_String:
+            ok = Legacy_GetNextArgumentString(&pArguments, stringBuffer, field->delimiter, field->maxLength);
+            sum = Checksum(sum, stringBuffer, strlen(stringBuffer));
+            break;
+        case FieldType_Int:
+            ok = Legacy_GetNextArgumentInt(&pArguments, &value, field->intFlags, field->delimiter);
+            sum = Checksum(sum, &value, sizeof(value));
+            break;
+        case FieldType_Enum:
+            ok = Legacy_GetNextArgumentEnum(&pArguments, &enumValue, field->strings, field->numStrings, field->maxLength, field->delimiter);
+            sum = Checksum(sum, &enumValue, sizeof(enumValue));
+            break;
+        }
+        if (!ok)
+        {
+            return false;
+        }
+    }
+    *checksum = sum;
+    return true;
+}
+
+static bool ParseViews(const Capture_t *capture, char *line, uint32_t *checksum)
+{
+    char *pArguments = line;
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < capture->numFields; i++)
+    {
+        const Field_t *field = &capture->fields[i];
+        uint32_t value = 0;
+        uint8_t enumValue = 0;
+        bool ok = false;
+        switch (field->type)
+        {
+        case FieldType_String:
+            ok = Calypso_GetNextArgumentString(&pArguments, stringBuffer, field->delimiter, field->maxLength);
+            sum = Checksum(sum, stringBuffer, strlen(stringBuffer));
+            break;
+        case FieldType_Int:
+            ok = Calypso_GetNextArgumentInt(&pArguments, &value, field->intFlags, field->delimiter);
+            sum = Checksum(sum, &value, sizeof(value));
+            break;
+        case FieldType_Enum:
+            ok = Calypso_GetNextArgumentEnum(&pArguments, &enumValue, field->strings, field->numStrings, field->maxLength, field->delimiter);
+            sum = Checksum(sum, &enumValue, sizeof(enumValue));
+            break;
+        }
+        if (!ok)
+        {
+            return false;
+        }
+    }
+    *checksum = sum;
+    return true;
+}
+
+/* checksum of the payload length and both ends of the payload (a checksum of the whole payload would dominate the measurement) */
+static uint32_t PayloadChecksum(uint32_t sum, const char *data, uint16_t length)
+{
+    sum = Checksum(sum, &length, sizeof(length));
+    sum = Checksum(sum, data, (length < 16) ? length : 16);
+    return (length < 16) ? sum : Checksum(sum, data + length - 16, 16);
+}
+
+/* previous ATEvent_ParseSocketRcvdEvent() (without Base64 decoding), copied the payload to the event */
+static bool ParseSocketRcvdLegacy(const Capture_t *capture, char *line, uint32_t *checksum)
+{
+    static struct
+    {
+        uint8_t socketID;
+        uint8_t format;
+        uint16_t length;
+        char data[CALYPSO_MAX_PAYLOAD_SIZE];
+    } rcvdEvent;
+
+    char *pArguments = line;
+    (void) capture;
+
+    if (!Legacy_GetNextArgumentInt(&pArguments, &rcvdEvent.socketID, U8, CALYPSO_ARGUMENT_DELIM) ||
+            !Legacy_GetNextArgumentInt(&pArguments, &rcvdEvent.format, U8, CALYPSO_ARGUMENT_DELIM) ||
+            !Legacy_GetNextArgumentInt(&pArguments, &rcvdEvent.length, U16, CALYPSO_ARGUMENT_DELIM) ||
+            (rcvdEvent.length >= sizeof(rcvdEvent.data) - 1) ||
+            !Legacy_GetNextArgumentString(&pArguments, rcvdEvent.data, CALYPSO_STRING_TERMINATE, sizeof(rcvdEvent.data)))
+    {
+        return false;
+    }
+
+    uint32_t sum = Checksum(0, &rcvdEvent.socketID, sizeof(rcvdEvent.socketID));
+    sum = Checksum(sum, &rcvdEvent.format, sizeof(rcvdEvent.format));
+    *checksum = PayloadChecksum(sum, rcvdEvent.data, rcvdEvent.length);
+    return true;
+}
+
+static bool ParseSocketRcvdViews(const Capture_t *capture, char *line, uint32_t *checksum)
+{
+    ATEvent_SocketRcvd_t rcvdEvent;
+    char *pArguments = line;
+    (void) capture;
+
+    if (!ATEvent_ParseSocketRcvdEvent(&pArguments, false, &rcvdEvent))
+    {
+        return false;
+    }
+
+    uint32_t sum = Checksum(0, &rcvdEvent.socketID, sizeof(rcvdEvent.socketID));
+    sum = Checksum(sum, &rcvdEvent.format, sizeof(rcvdEvent.format));
+    *checksum = PayloadChecksum(sum, rcvdEvent.data.data, rcvdEvent.data.length);
+    return true;
+}
+
+static double NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+static double Measure(Parser_t parse, const Capture_t *capture, char *line, uint32_t iterations)
+{
+    uint32_t checksum;
+    double t0 = NowNs();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        if (!parse(capture, line, &checksum))
+        {
+            return -1;
+        }
+    }
+    return (NowNs() - t0) / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    if (argc > 1)
+    {
+        iterations = (uint32_t) atoi(argv[1]);
+    }
+
+    /* socket receive event with 1400 bytes of (ASCII) payload */
+    int offset = sprintf(socketRcvdLine, "3,0,1400,");
+    for (int i = 0; i < 1400; i++)
+    {
+        socketRcvdLine[offset + i] = 'a' + (i % 26);
+    }
+
+    printf("%-32s %12s %12s %8s\n", "response", "legacy [ns]", "views [ns]", "speedup");
+
+    static char line[sizeof(socketRcvdLine) + 1];
+    bool ok = true;
+    for (size_t i = 0; i < NUM_CAPTURES; i++)
+    {
+        const Capture_t *capture = &captures[i];
+        memset(line, 0, sizeof(line));
+        strcpy(line, capture->line);
+
+        Parser_t parseLegacy = (NULL != capture->parseLegacy) ? capture->parseLegacy : ParseLegacy;
+        Parser_t parseViews = (NULL != capture->parseViews) ? capture->parseViews : ParseViews;
+
+        uint32_t legacyChecksum = 0;
+        uint32_t viewsChecksum = 0;
+        if (!parseLegacy(capture, line, &legacyChecksum) ||
+                !parseViews(capture, line, &viewsChecksum) ||
+                (legacyChecksum != viewsChecksum))
+        {
+            printf("%-32s parsed values differ\n", capture->name);
+            ok = false;
+            continue;
+        }
+
+        double legacyNs = Measure(parseLegacy, capture, line, iterations);
+        double viewsNs = Measure(parseViews, capture, line, iterations);
+        printf("%-32s %12.1f %12.1f %7.2fx\n", capture->name, legacyNs, viewsNs, legacyNs / viewsNs);
+    }
+
+    return ok ? 0 : 1;
+}
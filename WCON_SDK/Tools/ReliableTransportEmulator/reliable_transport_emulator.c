@@ -0,0 +1,292 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Host side loopback emulator for the Thyone-I reliable transport.
+ *
+ * Runs WCON_Drivers/ThyoneI/ReliableTransport.c against an emulated ThyoneI_TransmitUnicastExtended
+ * function on a virtual clock. Every frame sent to the peer address is looped back as if it had been
+ * received from that address after a fixed one-way latency, so the same instance acts as sender and
+ * receiver of the stream (data frames are handled by the receive direction of the peer, the returned
+ * acknowledgements by its transmit direction).
+ *
+ * The emulator
+ * - transfers a stream of packets at different packet loss rates and checks that all packets are
+ *   delivered once and in order, and
+ * - checks that a peer whose reception is still in progress is not replaced when more than
+ *   RELIABLETRANSPORT_MAX_PEERS peers are active.
+ *
+ * Build and run on the host:
+ *   gcc -O2 -I../../WCON_Drivers -o reliable_transport_emulator reliable_transport_emulator.c
+ *   ./reliable_transport_emulator [uart baudrate] [one-way latency in us]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* skip the platform header, the emulator provides the platform functions on a virtual clock */
+#define GLOBAL_H_INCLUDED
+uint32_t WE_GetTick();
+void WE_Delay(uint16_t sleepForMs);
+
+#include "ThyoneI/ReliableTransport.c"
+
+#define PACKET_COUNT      500
+#define PACKET_LENGTH     RELIABLETRANSPORT_MAX_PAYLOAD_LENGTH
+#define PEER_ADDRESS      0x12345678
+#define UART_CMD_OVERHEAD 9     /* STX, CMD, LEN (2), address (4), CS */
+#define UART_CNF_LENGTH   5
+#define IN_FLIGHT_LENGTH  64
+#define TIME_LIMIT_US     (600ULL * 1000000)
+
+typedef struct InFlightFrame_t
+{
+    uint64_t deliverAt;
+    uint32_t address;
+    uint16_t length;
+    uint8_t data[FRAME_LENGTH];
+} InFlightFrame_t;
+
+static uint64_t nowUs = 0;
+static uint32_t uartBaudrate = 115200;
+static uint32_t latencyUs = 3000;
+static uint32_t lossPerMille = 0;
+static uint32_t randomState = 1;
+static bool loopback = true;
+
+static InFlightFrame_t inFlight[IN_FLIGHT_LENGTH];
+static uint32_t inFlightCount = 0;
+
+static uint32_t transmissions = 0;
+static uint32_t packetsReceived = 0;
+static uint32_t packetsWrong = 0;
+
+/* last sequence number delivered per address in the peer replacement test */
+static uint32_t deliveredAddress[16];
+static uint8_t deliveredValue[16];
+static uint32_t deliveredCount = 0;
+
+/* platform functions used by the reliable transport */
+uint32_t WE_GetTick()
+{
+    return (uint32_t)(nowUs / 1000);
+}
+
+void WE_Delay(uint16_t sleepForMs)
+{
+    nowUs += (uint64_t)sleepForMs * 1000;
+}
+
+static uint32_t Random(void)
+{
+    randomState = randomState * 1103515245 + 12345;
+    return (randomState >> 16) & 0x7FFF;
+}
+
+static void FillPacket(uint8_t* packet, uint32_t index)
+{
+    int i = 0;
+    for (i = 0; i < PACKET_LENGTH; i++)
+    {
+        packet[i] = (uint8_t)(index * 13 + i);
+    }
+}
+
+/* emulated ThyoneI_TransmitUnicastExtended: the frame is looped back after the one-way latency */
+static bool EmulatedTransmit(uint32_t address, uint8_t* payloadP, uint16_t length)
+{
+    nowUs += (uint64_t)(length + UART_CMD_OVERHEAD + UART_CNF_LENGTH) * 10 * 1000000 / uartBaudrate;
+    transmissions++;
+
+    if (!loopback || ((Random() % 1000) < lossPerMille) || (inFlightCount >= IN_FLIGHT_LENGTH))
+    {
+        return true;
+    }
+
+    InFlightFrame_t* frame = &inFlight[inFlightCount++];
+    frame->deliverAt = nowUs + latencyUs;
+    frame->address = address;
+    frame->length = length;
+    memcpy(frame->data, payloadP, length);
+    return true;
+}
+
+/* hand all frames whose latency expired to the transport, like the RX interrupt of the driver */
+static void DeliverFrames(void)
+{
+    uint32_t i = 0;
+    while (i < inFlightCount)
+    {
+        if (inFlight[i].deliverAt <= nowUs)
+        {
+            ReliableTransport_HandleRx(inFlight[i].data, inFlight[i].length, inFlight[i].address);
+            memmove(&inFlight[i], &inFlight[i + 1], (inFlightCount - i - 1) * sizeof(InFlightFrame_t));
+            inFlightCount--;
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+static void StreamRxCallback(uint8_t* data, uint16_t length, uint32_t sourceAddress)
+{
+    static uint8_t expected[PACKET_LENGTH];
+
+    FillPacket(expected, packetsReceived);
+    if ((sourceAddress != PEER_ADDRESS) || (length != PACKET_LENGTH) || (memcmp(data, expected, length) != 0))
+    {
+        packetsWrong++;
+    }
+    packetsReceived++;
+}
+
+static void ReplacementRxCallback(uint8_t* data, uint16_t length, uint32_t sourceAddress)
+{
+    if (deliveredCount < sizeof(deliveredValue))
+    {
+        deliveredAddress[deliveredCount] = sourceAddress;
+        deliveredValue[deliveredCount] = data[0];
+        deliveredCount++;
+    }
+}
+
+/* transfer PACKET_COUNT packets at the current loss rate, returns false if the stream is incomplete */
+static bool RunStream(void)
+{
+    static uint8_t packet[PACKET_LENGTH];
+    uint32_t sent = 0;
+
+    ReliableTransport_Init(EmulatedTransmit, StreamRxCallback);
+    inFlightCount = 0;
+    transmissions = 0;
+    packetsReceived = 0;
+    packetsWrong = 0;
+    randomState = 1;
+    loopback = true;
+
+    uint64_t start = nowUs;
+    while ((packetsReceived < PACKET_COUNT) && (nowUs - start < TIME_LIMIT_US))
+    {
+        if (sent < PACKET_COUNT)
+        {
+            FillPacket(packet, sent);
+            if (ReliableTransport_Send(PEER_ADDRESS, packet, PACKET_LENGTH))
+            {
+                sent++;
+                continue;
+            }
+        }
+        DeliverFrames();
+        ReliableTransport_Process();
+        nowUs += 100;
+    }
+
+    uint64_t elapsed = nowUs - start;
+
+    printf("%4.1f%%  %17.1f  %16.2f  %11u  %7u\n",
+           lossPerMille / 10.0,
+           (double)packetsReceived * PACKET_LENGTH * 8 * 1000 / (double)elapsed,
+           (double)transmissions / PACKET_COUNT,
+           ReliableTransport_GetRTO(PEER_ADDRESS),
+           PACKET_COUNT - packetsReceived);
+    return (packetsReceived == PACKET_COUNT) && (packetsWrong == 0);
+}
+
+/* inject a data frame as if it had been received from address */
+static void InjectData(uint32_t address, uint8_t type, uint8_t seq)
+{
+    uint8_t frame[RELIABLETRANSPORT_HEADER_LENGTH + 1];
+    frame[0] = type;
+    frame[1] = seq;
+    frame[2] = seq;
+    ReliableTransport_HandleRx(frame, sizeof(frame), address);
+    ReliableTransport_Process();
+}
+
+static bool Delivered(uint32_t index, uint32_t address, uint8_t seq)
+{
+    return (deliveredCount > index) && (deliveredAddress[index] == address) && (deliveredValue[index] == seq);
+}
+
+/* more peers than RELIABLETRANSPORT_MAX_PEERS, the peers with a gap in their stream must not be replaced */
+static bool RunPeerReplacement(void)
+{
+    bool ok = true;
+    uint32_t i = 0;
+
+    ReliableTransport_Init(EmulatedTransmit, ReplacementRxCallback);
+    loopback = false;
+    deliveredCount = 0;
+
+    /* peers 1..MAX_PEERS: first packet delivered, third one waits for the missing second one */
+    for (i = 1; i <= RELIABLETRANSPORT_MAX_PEERS; i++)
+    {
+        InjectData(i, TYPE_DATA_SYN, 10);
+        InjectData(i, TYPE_DATA, 12);
+    }
+    ok = ok && (deliveredCount == RELIABLETRANSPORT_MAX_PEERS);
+
+    /* a new peer after the idle timeout is dropped, as all peers are still reassembling */
+    nowUs += (uint64_t)(RELIABLETRANSPORT_PEER_IDLE_TIMEOUT + 1) * 1000;
+    InjectData(RELIABLETRANSPORT_MAX_PEERS + 1, TYPE_DATA_SYN, 0);
+    ok = ok && (deliveredCount == RELIABLETRANSPORT_MAX_PEERS) && (ReliableTransport_GetRTO(RELIABLETRANSPORT_MAX_PEERS + 1) == 0);
+
+    /* the missing packets arrive, the buffered ones are delivered in order */
+    for (i = 1; i <= RELIABLETRANSPORT_MAX_PEERS; i++)
+    {
+        uint32_t index = deliveredCount;
+        InjectData(i, TYPE_DATA, 11);
+        ok = ok && Delivered(index, i, 11) && Delivered(index + 1, i, 12);
+    }
+
+    /* once the peers are idle, the new peer can replace one of them */
+    nowUs += (uint64_t)(RELIABLETRANSPORT_PEER_IDLE_TIMEOUT + 1) * 1000;
+    InjectData(RELIABLETRANSPORT_MAX_PEERS + 1, TYPE_DATA_SYN, 0);
+    ok = ok && Delivered(deliveredCount - 1, RELIABLETRANSPORT_MAX_PEERS + 1, 0);
+
+    printf("peer replacement with %u peers: %s\n", RELIABLETRANSPORT_MAX_PEERS + 1, ok ? "ok" : "failed");
+    return ok;
+}
+
+int main(int argc, char* argv[])
+{
+    static const uint32_t losses[] = { 0, 10, 50, 100, 200 };
+    bool ok = true;
+    int i = 0;
+
+    if (argc > 1) uartBaudrate = strtoul(argv[1], NULL, 0);
+    if (argc > 2) latencyUs = strtoul(argv[2], NULL, 0);
+
+    printf("%u x %u byte packets, UART %u baud, one-way latency %u us, window %u\n",
+           PACKET_COUNT, PACKET_LENGTH, uartBaudrate, latencyUs, RELIABLETRANSPORT_WINDOW_SIZE);
+    printf("loss   goodput [kbit/s]   frames/packet   RTO [ms]   missing\n");
+
+    for (i = 0; i < (int)(sizeof(losses) / sizeof(losses[0])); i++)
+    {
+        lossPerMille = losses[i];
+        if (!RunStream())
+        {
+            printf("error: stream incomplete or out of order (%u wrong packets)\n", packetsWrong);
+            ok = false;
+        }
+    }
+
+    if (!RunPeerReplacement())
+    {
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+#
+# This file is part of WIRELESS CONNECTIVITY SDK for STM32.
+# COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+#
+"""Host side reader for the record stream produced by WCON_Drivers/SnifferCapture.
+
+Reads the stream from a file (or a serial port if pyserial is installed), checks
+the records, prints them and optionally converts them to a pcap file that can be
+opened with Wireshark (link type USER0, packet data = source address (4 bytes, LE),
+RSSI (1 byte) and payload).
+
+Examples:
+    sniffer_reader.py capture.bin
+    sniffer_reader.py capture.bin --pcap capture.pcap
+    sniffer_reader.py --serial /dev/ttyACM0 --baudrate 115200 --pcap live.pcap
+"""
+
+import argparse
+import struct
+import sys
+
+STREAM_MAGIC = b"WESC"
+STREAM_HEADER_LENGTH = 8
+RECORD_SYNC = b"\xA5\x5A"
+RECORD_HEADER_LENGTH = 14   # sync (2), length, rssi, dropped (2), timestamp (4), source address (4)
+SOURCES = {0: "unknown", 1: "Thyone-I", 2: "proprietary radio"}
+PCAP_LINKTYPE_USER0 = 147
+
+
+class Reader:
+    """Incremental decoder that resynchronizes on the record sync bytes."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.header = None
+        self.last_timestamp = None
+        self.timestamp_high = 0
+        self.checksum_errors = 0
+        self.dropped = 0
+
+    def feed(self, data):
+        self.buffer += data
+        records = []
+        while True:
+            if self.header is None and len(self.buffer) >= STREAM_HEADER_LENGTH and self.buffer.startswith(STREAM_MAGIC):
+                version, source = self.buffer[4], self.buffer[5]
+                self.header = (version, source)
+                del self.buffer[:STREAM_HEADER_LENGTH]
+                continue
+
+            start = self.buffer.find(RECORD_SYNC)
+            if start < 0:
+                # keep a possible partial sync byte
+                del self.buffer[:max(0, len(self.buffer) - 1)]
+                return records
+            del self.buffer[:start]
+            if len(self.buffer) < RECORD_HEADER_LENGTH:
+                return records
+
+            length, rssi, dropped, timestamp, address = struct.unpack_from("<BbHII", self.buffer, 2)
+            record_length = RECORD_HEADER_LENGTH + length + 1
+            if len(self.buffer) < record_length:
+                return records
+
+            checksum = 0
+            for byte in self.buffer[2:record_length - 1]:
+                checksum ^= byte
+            if checksum != self.buffer[record_length - 1]:
+                # no valid record here, continue searching after this sync
+                self.checksum_errors += 1
+                del self.buffer[:1]
+                continue
+
+            payload = bytes(self.buffer[RECORD_HEADER_LENGTH:record_length - 1])
+            del self.buffer[:record_length]
+
+            # unwrap the 32 bit microsecond timestamp (WE_GetTickMicroseconds() wraps after 2^32 us)
+            if self.last_timestamp is not None and timestamp < self.last_timestamp:
+                self.timestamp_high += 1 << 32
+            self.last_timestamp = timestamp
+            self.dropped += dropped
+            records.append((self.timestamp_high + timestamp, address, rssi, dropped, payload))
+
+
+def write_pcap_header(file):
+    file.write(struct.pack("<IHHiIII", 0xA1B2C3D4, 2, 4, 0, 0, 65535, PCAP_LINKTYPE_USER0))
+
+
+def write_pcap_record(file, timestamp_us, address, rssi, payload):
+    data = struct.pack("<Ib", address, rssi) + payload
+    file.write(struct.pack("<IIII", timestamp_us // 1000000, timestamp_us % 1000000, len(data), len(data)))
+    file.write(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", help="binary capture file")
+    parser.add_argument("--serial", help="read from this serial port instead of a file")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--pcap", help="write the records to this pcap file")
+    parser.add_argument("--quiet", action="store_true", help="do not print the records")
+    args = parser.parse_args()
+
+    if args.serial:
+        import serial
+        source = serial.Serial(args.serial, args.baudrate, timeout=0.1)
+    elif args.input:
+        source = open(args.input, "rb")
+    else:
+        parser.error("either an input file or --serial is required")
+
+    pcap = open(args.pcap, "wb") if args.pcap else None
+    if pcap:
+        write_pcap_header(pcap)
+
+    reader = Reader()
+    count = 0
+    try:
+        while True:
+            data = source.read(4096)
+            if not data:
+                if args.serial:
+                    continue
+                break
+            for timestamp, address, rssi, dropped, payload in reader.feed(data):
+                count += 1
+                if not args.quiet:
+                    if dropped:
+                        print("--- %d packet(s) dropped by the capture buffer" % dropped)
+                    print("%12.6f  src 0x%08x  %4d dBm  %3d bytes  %s" %
+                          (timestamp / 1e6, address, rssi, len(payload), payload.hex(" ")))
+                if pcap:
+                    write_pcap_record(pcap, timestamp, address, rssi, payload)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if pcap:
+            pcap.close()
+
+    if reader.header is not None:
+        print("stream version %d, source %s" % (reader.header[0], SOURCES.get(reader.header[1], reader.header[1])), file=sys.stderr)
+    print("%d record(s), %d dropped, %d checksum error(s)" % (count, reader.dropped, reader.checksum_errors), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
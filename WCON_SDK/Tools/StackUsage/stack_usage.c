@@ -0,0 +1,211 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Host side per-function stack usage report.
+ *
+ * Collects the stack usage files (*.su) written by GCC when compiling with -fstack-usage
+ * (enabled by default in the STM32CubeIDE projects, the files are placed next to the object
+ * files in the build directory, e.g. STM32L0xx/Debug) and prints the functions with the
+ * largest stack frames. Frames with dynamic size (variable length arrays, alloca()) are
+ * flagged, as their size depends on the data being processed - the tool's exit code is
+ * non-zero if unbounded dynamic frames are found.
+ *
+ * Together with the stack high-water mark reported on the target by WE_StackMonitor_GetReport()
+ * (see global/stack_monitor.h), this helps finding the call chains responsible for high stack usage.
+ *
+ * Build and run on the host:
+ *   gcc -O2 -o stack_usage stack_usage.c
+ *   ./stack_usage [-n <number of functions>] <build directory or .su files>...
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Max. number of functions collected.
+ */
+#define STACK_USAGE_MAX_ENTRIES 8192
+
+/**
+ * @brief Stack usage of a single function as reported by GCC.
+ */
+typedef struct StackUsage_Entry_t
+{
+    char function[512];                     /**< Source location and function name (file:line:column:name) */
+    unsigned long frameSize;                /**< Size of stack frame in bytes */
+    bool dynamic;                           /**< Frame size depends on run-time data */
+    bool bounded;                           /**< Dynamic frame size has a known upper bound (frameSize) */
+} StackUsage_Entry_t;
+
+static StackUsage_Entry_t entries[STACK_USAGE_MAX_ENTRIES];
+static size_t entryCount = 0;
+
+/**
+ * @brief Parses a single .su file (one line per function: "location<TAB>size<TAB>qualifiers").
+ */
+static void ParseFile(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return;
+    }
+
+    char line[512];
+    while (fgets(line, sizeof(line), f) != NULL && entryCount < STACK_USAGE_MAX_ENTRIES)
+    {
+        char *size = strchr(line, '\t');
+        if (size == NULL)
+        {
+            continue;
+        }
+        *size++ = '\0';
+
+        char *qualifiers = strchr(size, '\t');
+        if (qualifiers == NULL)
+        {
+            continue;
+        }
+        *qualifiers++ = '\0';
+
+        StackUsage_Entry_t *entry = &entries[entryCount++];
+        snprintf(entry->function, sizeof(entry->function), "%s", line);
+        entry->frameSize = strtoul(size, NULL, 10);
+        entry->dynamic = (strstr(qualifiers, "dynamic") != NULL);
+        entry->bounded = (strstr(qualifiers, "bounded") != NULL);
+    }
+
+    fclose(f);
+}
+
+/**
+ * @brief Parses the given .su file or all .su files in the given directory (recursively).
+ */
+static void ParsePath(const char *path)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+    {
+        fprintf(stderr, "Failed to access %s\n", path);
+        return;
+    }
+
+    if (!S_ISDIR(st.st_mode))
+    {
+        size_t length = strlen(path);
+        if (length > 3 && strcmp(path + length - 3, ".su") == 0)
+        {
+            ParseFile(path);
+        }
+        return;
+    }
+
+    DIR *dir = opendir(path);
+    if (dir == NULL)
+    {
+        return;
+    }
+
+    struct dirent *dirEntry;
+    while ((dirEntry = readdir(dir)) != NULL)
+    {
+        if (dirEntry->d_name[0] == '.')
+        {
+            continue;
+        }
+        char child[1024];
+        snprintf(child, sizeof(child), "%s/%s", path, dirEntry->d_name);
+        ParsePath(child);
+    }
+
+    closedir(dir);
+}
+
+static int CompareFrameSize(const void *a, const void *b)
+{
+    const StackUsage_Entry_t *entryA = a;
+    const StackUsage_Entry_t *entryB = b;
+    if (entryA->frameSize != entryB->frameSize)
+    {
+        return entryA->frameSize < entryB->frameSize ? 1 : -1;
+    }
+    return strcmp(entryA->function, entryB->function);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t maxPrinted = 30;
+
+    int i = 1;
+    if (i + 1 < argc && strcmp(argv[i], "-n") == 0)
+    {
+        maxPrinted = strtoul(argv[i + 1], NULL, 10);
+        i += 2;
+    }
+    if (i >= argc)
+    {
+        fprintf(stderr, "Usage: %s [-n <number of functions>] <build directory or .su files>...\n", argv[0]);
+        return 2;
+    }
+    for (; i < argc; i++)
+    {
+        ParsePath(argv[i]);
+    }
+
+    qsort(entries, entryCount, sizeof(entries[0]), CompareFrameSize);
+
+    unsigned long total = 0;
+    size_t dynamicCount = 0;
+    size_t unboundedCount = 0;
+    for (size_t j = 0; j < entryCount; j++)
+    {
+        total += entries[j].frameSize;
+        if (entries[j].dynamic)
+        {
+            dynamicCount++;
+            if (!entries[j].bounded)
+            {
+                unboundedCount++;
+            }
+        }
+    }
+
+    printf("%zu functions, sum of frames %lu bytes\n\n", entryCount, total);
+    printf("%8s  %-9s  %s\n", "frame", "type", "function");
+    for (size_t j = 0; j < entryCount && j < maxPrinted; j++)
+    {
+        const char *type = !entries[j].dynamic ? "static" : (entries[j].bounded ? "bounded" : "DYNAMIC");
+        printf("%8lu  %-9s  %s\n", entries[j].frameSize, type, entries[j].function);
+    }
+
+    if (dynamicCount > 0)
+    {
+        printf("\nFunctions with dynamic stack frames (%zu, %zu unbounded):\n", dynamicCount, unboundedCount);
+        for (size_t j = 0; j < entryCount; j++)
+        {
+            if (entries[j].dynamic)
+            {
+                printf("%8lu  %-9s  %s\n",
+                       entries[j].frameSize,
+                       entries[j].bounded ? "bounded" : "DYNAMIC",
+                       entries[j].function);
+            }
+        }
+    }
+
+    return unboundedCount > 0 ? 1 : 0;
+}
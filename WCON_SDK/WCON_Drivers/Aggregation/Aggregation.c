@@ -0,0 +1,252 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Aggregation of small records into one radio payload source file.
+ */
+
+#include "Aggregation.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../global/global.h"
+
+#if (AGGREGATION_BUFFER_SIZE < 3) || (AGGREGATION_BUFFER_SIZE > 0x7FFF)
+#error "AGGREGATION_BUFFER_SIZE must be in range 3..32767"
+#endif
+
+#define MARKER 0xA6
+#define MARKER_LENGTH 1
+#define LENGTH_LONG_FLAG 0x80
+
+/**************************************
+ *          Static variables          *
+ **************************************/
+
+static Aggregation_Transmit_t Transmit = NULL;
+static void(*RxCallback)(uint8_t*,uint16_t) = NULL;
+static uint16_t maxPayloadLength = 0;
+static uint32_t maxAge = 0;
+
+static uint8_t buffer[AGGREGATION_BUFFER_SIZE];
+static uint16_t bufferLength = 0;
+static uint32_t firstRecordTick = 0;
+
+/**************************************
+ *         Static functions           *
+ **************************************/
+
+/**
+ * @brief Number of bytes of the length field of a record
+ */
+static uint16_t LengthFieldSize(uint16_t length)
+{
+    return (length < LENGTH_LONG_FLAG) ? 1 : 2;
+}
+
+/**************************************
+ *         Global functions           *
+ **************************************/
+
+/**
+ * @brief Initialize the aggregation
+ *
+ * @param[in] transmit: transmit function of the module
+ * @param[in] max_payload_length: maximum payload length of the transmit function
+ * @param[in] max_age_ms: maximum time a record is held back, 0 to flush on size and explicitly only
+ * @param[in] RXcb: callback for each received record
+ *
+ * @return true if initialization succeeded,
+ *         false otherwise
+ */
+bool Aggregation_Init(Aggregation_Transmit_t transmit, uint16_t max_payload_length, uint32_t max_age_ms, void(*RXcb)(uint8_t*,uint16_t))
+{
+    if ((transmit == NULL) || (max_payload_length < 3) || (max_payload_length > AGGREGATION_BUFFER_SIZE))
+    {
+        return false;
+    }
+
+    Transmit = transmit;
+    RxCallback = RXcb;
+    maxPayloadLength = max_payload_length;
+    maxAge = max_age_ms;
+    bufferLength = 0;
+    return true;
+}
+
+/**
+ * @brief Add a record
+ *
+ * The pending records are transmitted first if the record does not fit into the payload.
+ *
+ * @param[in] record: pointer to the record
+ * @param[in] length: length of the record
+ *
+ * @return true if the record has been queued,
+ *         false otherwise
+ */
+bool Aggregation_Add(uint8_t* record, uint16_t length)
+{
+    if ((Transmit == NULL) || (length > Aggregation_GetMaxRecordLength()))
+    {
+        return false;
+    }
+
+    uint16_t recordSize = LengthFieldSize(length) + length;
+    if ((bufferLength > 0) && (bufferLength + recordSize > maxPayloadLength))
+    {
+        if (!Aggregation_Flush())
+        {
+            return false;
+        }
+    }
+
+    if (bufferLength == 0)
+    {
+        buffer[0] = MARKER;
+        bufferLength = MARKER_LENGTH;
+        firstRecordTick = WE_GetTick();
+    }
+
+    if (length < LENGTH_LONG_FLAG)
+    {
+        buffer[bufferLength++] = (uint8_t)length;
+    }
+    else
+    {
+        buffer[bufferLength++] = (uint8_t)(LENGTH_LONG_FLAG | (length >> 8));
+        buffer[bufferLength++] = (uint8_t)length;
+    }
+    memcpy(&buffer[bufferLength], record, length);
+    bufferLength += length;
+
+    /* transmit right away if not even an empty record fits anymore */
+    if (bufferLength + 1 > maxPayloadLength)
+    {
+        return Aggregation_Flush();
+    }
+    return true;
+}
+
+/**
+ * @brief Transmit the pending records
+ *
+ * @return true if the records have been transmitted or no records were pending,
+ *         false otherwise
+ */
+bool Aggregation_Flush(void)
+{
+    if (bufferLength <= MARKER_LENGTH)
+    {
+        bufferLength = 0;
+        return true;
+    }
+
+    bool ret = Transmit(buffer, bufferLength);
+    if (!ret)
+    {
+        fprintf(stdout, "Transmission of %u aggregated bytes failed\n", bufferLength);
+    }
+    /* the records are dropped on failure, the next records start a new payload */
+    bufferLength = 0;
+    return ret;
+}
+
+/**
+ * @brief Transmit the pending records once the oldest record reached the maximum age
+ *
+ * Call this function cyclically from the main loop.
+ */
+void Aggregation_Process(void)
+{
+    if ((bufferLength > 0) && (maxAge > 0) && (WE_GetTick() - firstRecordTick >= maxAge))
+    {
+        Aggregation_Flush();
+    }
+}
+
+/**
+ * @brief Split a received payload into its records, call from the RX callback of the driver
+ *
+ * @param[in] payload: pointer to the received payload
+ * @param[in] length: length of the received payload
+ *
+ * @return true if the payload has been aggregated,
+ *         false otherwise
+ */
+bool Aggregation_HandleRx(uint8_t* payload, uint16_t length)
+{
+    uint16_t pos = MARKER_LENGTH;
+
+    if ((length <= MARKER_LENGTH) || (payload[0] != MARKER))
+    {
+        return false;
+    }
+
+    while (pos < length)
+    {
+        uint16_t recordLength = payload[pos++];
+        if (recordLength & LENGTH_LONG_FLAG)
+        {
+            if (pos >= length)
+            {
+                break;
+            }
+            recordLength = ((recordLength & ~LENGTH_LONG_FLAG) << 8) | payload[pos++];
+        }
+        if (recordLength > length - pos)
+        {
+            /* truncated payload, drop the rest */
+            break;
+        }
+        if (RxCallback != NULL)
+        {
+            RxCallback(&payload[pos], recordLength);
+        }
+        pos += recordLength;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the maximum length of a single record
+ *
+ * @return maximum record length
+ */
+uint16_t Aggregation_GetMaxRecordLength(void)
+{
+    if (maxPayloadLength <= MARKER_LENGTH + 1)
+    {
+        return 0;
+    }
+    uint16_t length = maxPayloadLength - MARKER_LENGTH - 1;
+    if (length >= LENGTH_LONG_FLAG)
+    {
+        length--;
+    }
+    return length;
+}
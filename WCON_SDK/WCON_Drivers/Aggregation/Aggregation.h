@@ -0,0 +1,77 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Aggregation of small records into one radio payload header file.
+ *
+ * Each transmission costs one UART frame and one confirmation round trip, independent
+ * of the payload length. The aggregation packs several small records into one payload
+ * and transmits it when
+ * - the next record does not fit into the payload anymore,
+ * - the oldest record reached the maximum age or
+ * - Aggregation_Flush() is called.
+ *
+ * Usage:
+ * - Call Aggregation_Init() with a transmit function and the maximum payload length of the
+ *   module (e.g. ProteusE_Transmit and PROTEUSE_MAX_PAYLOAD_LENGTH). The Tarvos family
+ *   (uint8_t length) and Metis (length in the first byte) need a small wrapper function.
+ * - Call Aggregation_Add() for each record and Aggregation_Process() cyclically from the main loop.
+ * - On the receiving side call Aggregation_HandleRx() from the RX callback of the driver.
+ *   It returns false for payloads that have not been aggregated.
+ *
+ * Payload: marker (1 byte, 0xA6), records
+ * Record: length (1 byte for 0..127, 2 bytes with the MSB of the first byte set otherwise), data
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef AGGREGATION_H_INCLUDED
+#define AGGREGATION_H_INCLUDED
+
+/* size of the aggregation buffer, the maximum payload length passed to Aggregation_Init must not exceed it */
+#ifndef AGGREGATION_BUFFER_SIZE
+#define AGGREGATION_BUFFER_SIZE 255
+#endif
+
+typedef bool (*Aggregation_Transmit_t)(uint8_t* payload, uint16_t length);
+
+extern bool Aggregation_Init(Aggregation_Transmit_t transmit, uint16_t max_payload_length, uint32_t max_age_ms, void(*RXcb)(uint8_t*,uint16_t));
+extern bool Aggregation_Add(uint8_t* record, uint16_t length);
+extern bool Aggregation_Flush(void);
+extern void Aggregation_Process(void);
+extern bool Aggregation_HandleRx(uint8_t* payload, uint16_t length);
+extern uint16_t Aggregation_GetMaxRecordLength(void);
+
+#endif // AGGREGATION_H_INCLUDED
+
+#ifdef __cplusplus
+}
+#endif
@@ -30,4 +30,4 @@
 
 #include "ATCommands.h"
 
-char AT_commandBuffer[AT_MAX_COMMAND_BUFFER_SIZE];
+/* AT_commandBuffer is part of the driver's buffer arena (see Calypso.c) */
@@ -31,13 +31,18 @@
 #ifndef AT_COMMMANDS_H_INCLUDED
 #define AT_COMMMANDS_H_INCLUDED
 
+#include "../Calypso.h"
+
 /**
  * @brief Size of buffer used for commands sent to the wireless module and the responses
  * received from the module.
  *
+ * Defaults to the line size of the selected memory profile (see CALYPSO_MEMORY_PROFILE).
  * May be adopted to required file/data sizes.
  */
-#define AT_MAX_COMMAND_BUFFER_SIZE 2048
+#ifndef AT_MAX_COMMAND_BUFFER_SIZE
+#define AT_MAX_COMMAND_BUFFER_SIZE CALYPSO_PROFILE_LINE_MAX_SIZE
+#endif
 
 /**
  * @brief Max. length of host name strings (e.g. URLs or IP addresses).
@@ -55,9 +60,10 @@ extern "C" {
 
 /**
  * @brief Buffer used for commands sent to the wireless module and the responses
- * received from the module.
+ * received from the module (AT_MAX_COMMAND_BUFFER_SIZE bytes, part of the driver's
+ * buffer arena, see CALYPSO_MEMORY_PROFILE).
  */
-extern char AT_commandBuffer[AT_MAX_COMMAND_BUFFER_SIZE];
+extern char *const AT_commandBuffer;
 
 #ifdef __cplusplus
 }
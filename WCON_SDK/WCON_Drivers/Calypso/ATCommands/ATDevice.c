@@ -238,6 +238,7 @@ bool ATDevice_Reboot()
 {
     bool ret = false;
 
+    Calypso_ResetStartupEvent();
     if (!Calypso_SendRequest("AT+reboot\r\n"))
     {
         return false;
@@ -256,6 +257,7 @@ bool ATDevice_FactoryReset()
 {
     bool ret = false;
 
+    Calypso_ResetStartupEvent();
     if (!Calypso_SendRequest("AT+factoryreset\r\n"))
     {
         return false;
@@ -655,48 +657,38 @@ static bool ATDevice_ParseResponseATget(uint8_t id, uint8_t option, char *pAtCom
             {
                 ATDevice_Time_t *time = &pValue->general.time;
 
-                char tempString[6];
-
-                ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
-                ret = Calypso_StringToInt(&(time->hour), tempString, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                ret = Calypso_GetNextArgumentInt(&pAtCommand, &(time->hour), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM);
 
                 if (ret)
                 {
-                    ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
-                    ret = Calypso_StringToInt(&(time->minute), tempString, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                    ret = Calypso_GetNextArgumentInt(&pAtCommand, &(time->minute), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM);
                 }
 
                 if (ret)
                 {
-                    ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
-                    ret = Calypso_StringToInt(&(time->second), tempString, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                    ret = Calypso_GetNextArgumentInt(&pAtCommand, &(time->second), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM);
                 }
 
                 if (ret)
                 {
-                    ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
-                    ret = Calypso_StringToInt(&(time->day), tempString, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                    ret = Calypso_GetNextArgumentInt(&pAtCommand, &(time->day), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM);
                 }
 
                 if (ret)
                 {
-                    ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
-                    ret = Calypso_StringToInt(&(time->month), tempString, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                    ret = Calypso_GetNextArgumentInt(&pAtCommand, &(time->month), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM);
                 }
 
                 if (ret)
                 {
-                    ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_STRING_TERMINATE, sizeof(tempString));
-                    ret = Calypso_StringToInt(&(time->year), tempString, CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                    ret = Calypso_GetNextArgumentInt(&pAtCommand, &(time->year), CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_STRING_TERMINATE);
                 }
                 break;
             }
 
             case ATDevice_GetGeneral_Persistent:
             {
-                char tempString[6];
-                ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_STRING_TERMINATE, sizeof(tempString));
-                ret = Calypso_StringToInt(&pValue->general.persistent, tempString, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                ret = Calypso_GetNextArgumentInt(&pAtCommand, &pValue->general.persistent, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_STRING_TERMINATE);
                 ret = true;
                 break;
 
@@ -721,18 +713,14 @@ static bool ATDevice_ParseResponseATget(uint8_t id, uint8_t option, char *pAtCom
             {
             case ATDevice_GetUart_Baudrate:
             {
-                char tempString[12];
-                ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_STRING_TERMINATE, sizeof(tempString));
-                ret = Calypso_StringToInt(&pValue->uart.baudrate, tempString, CALYPSO_INTFLAGS_SIZE32 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                ret = Calypso_GetNextArgumentInt(&pAtCommand, &pValue->uart.baudrate, CALYPSO_INTFLAGS_SIZE32 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_STRING_TERMINATE);
                 break;
             }
 
             case ATDevice_GetUart_Parity:
             {
-                char tempString[6];
-                ret = Calypso_GetNextArgumentString(&pAtCommand, tempString, CALYPSO_STRING_TERMINATE, sizeof(tempString));
                 uint8_t parity;
-                ret = Calypso_StringToInt(&parity, tempString, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC);
+                ret = Calypso_GetNextArgumentInt(&pAtCommand, &parity, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_STRING_TERMINATE);
                 pValue->uart.parity = parity;
                 break;
             }
@@ -812,18 +800,17 @@ static bool ATDevice_ParseResponseATget(uint8_t id, uint8_t option, char *pAtCom
 
             case ATDevice_GetTransparentMode_SocketType:
             {
-                char tempString[32];
-                ret = Calypso_GetNextArgumentString(&pAtCommand,
-                                                    tempString,
-                                                    CALYPSO_STRING_TERMINATE,
-                                                    sizeof(tempString));
+                Calypso_StringView_t argument;
+                ret = Calypso_GetNextArgumentView(&pAtCommand,
+                                                  &argument,
+                                                  CALYPSO_STRING_TERMINATE);
                 if (ret)
                 {
-                    pValue->transparentMode.socketType = Calypso_FindString(ATDevice_ATGetTransparentModeSocketTypeStrings,
-                                                                            ATDevice_TransparentModeSocketType_NumberOfValues,
-                                                                            tempString,
-                                                                            ATDevice_TransparentModeSocketType_UDP,
-                                                                            &ret);
+                    pValue->transparentMode.socketType = Calypso_FindView(ATDevice_ATGetTransparentModeSocketTypeStrings,
+                                                                          ATDevice_TransparentModeSocketType_NumberOfValues,
+                                                                          argument,
+                                                                          ATDevice_TransparentModeSocketType_UDP,
+                                                                          &ret);
                 }
                 break;
             }
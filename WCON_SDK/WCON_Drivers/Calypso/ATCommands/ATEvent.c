@@ -32,6 +32,13 @@
 
 #include "../Calypso.h"
 
+static const char *ATEvent_MQTTQoSStrings[ATMQTT_QoS_NumberOfValues] =
+{
+    "QOS0",
+    "QOS1",
+    "QOS2"
+};
+
 static const char *ATEvent_Strings[ATEvent_NumberOfValues] =
 {
     "invalid",
@@ -81,9 +88,13 @@ static const char *ATEvent_Strings[ATEvent_NumberOfValues] =
     "cmd_timout"
 };
 
-static bool ATEvent_ParseEventSubType(const char *eventSubTypeString,
+static bool ATEvent_ParseEventSubType(Calypso_StringView_t eventSubTypeString,
                                       ATEvent_t eventMainType,
                                       ATEvent_t *pEventSubType);
+static bool ATEvent_ParseData(char **pEventArguments,
+                              uint16_t length,
+                              bool decodeBase64,
+                              Calypso_StringView_t *data);
 
 /**
  * @brief Parses the received AT command and returns the corresponding ATEvent_t.
@@ -96,90 +107,90 @@ static bool ATEvent_ParseEventSubType(const char *eventSubTypeString,
 bool ATEvent_ParseEventType(char **pAtCommand, ATEvent_t *pEvent)
 {
     bool ret = false;
-    char cmdName[32];
-    char option[64];
+    Calypso_StringView_t cmdName;
+    Calypso_StringView_t option;
 
     *pEvent = ATEvent_Invalid;
-    ret = Calypso_GetCmdName(pAtCommand, cmdName, CALYPSO_EVENT_DELIM, CALYPSO_STRING_TERMINATE);
+    ret = Calypso_GetCmdNameView(pAtCommand, &cmdName, CALYPSO_EVENT_DELIM, CALYPSO_STRING_TERMINATE);
     if (ret)
     {
-        if (0 == strcasecmp(cmdName, "+eventgeneral"))
+        if (Calypso_ViewEquals(cmdName, "+eventgeneral"))
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, option, CALYPSO_ARGUMENT_DELIM, sizeof(option));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &option, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
                 ATEvent_ParseEventSubType(option, ATEvent_General, pEvent);
             }
         }
-        else if (0 == strcasecmp(cmdName, "+eventwlan"))
+        else if (Calypso_ViewEquals(cmdName, "+eventwlan"))
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, option, CALYPSO_ARGUMENT_DELIM, sizeof(option));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &option, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
                 ATEvent_ParseEventSubType(option, ATEvent_Wlan, pEvent);
             }
         }
-        else if (0 == strcasecmp(cmdName, "+eventsocket"))
+        else if (Calypso_ViewEquals(cmdName, "+eventsocket"))
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, option, CALYPSO_ARGUMENT_DELIM, sizeof(option));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &option, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
                 ATEvent_ParseEventSubType(option, ATEvent_Socket, pEvent);
             }
         }
-        else if (0 == strcasecmp(cmdName, "+eventnetapp"))
+        else if (Calypso_ViewEquals(cmdName, "+eventnetapp"))
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, option, CALYPSO_ARGUMENT_DELIM, sizeof(option));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &option, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
                 ATEvent_ParseEventSubType(option, ATEvent_Netapp, pEvent);
             }
         }
-        else if (0 == strcasecmp(cmdName, "+eventmqtt"))
+        else if (Calypso_ViewEquals(cmdName, "+eventmqtt"))
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, option, CALYPSO_ARGUMENT_DELIM, sizeof(option));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &option, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
                 ATEvent_ParseEventSubType(option, ATEvent_MQTT, pEvent);
             }
         }
-        else if (0 == strcasecmp(cmdName, "+eventfatalerror"))
+        else if (Calypso_ViewEquals(cmdName, "+eventfatalerror"))
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, option, CALYPSO_ARGUMENT_DELIM, sizeof(option));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &option, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
                 ATEvent_ParseEventSubType(option, ATEvent_FatalError, pEvent);
             }
         }
-        else if (0 == strcasecmp(cmdName, "+eventstartup"))
+        else if (Calypso_ViewEquals(cmdName, "+eventstartup"))
         {
             *pEvent = ATEvent_Startup;
         }
-        else if (0 == strcasecmp(cmdName, "+eventwakeup"))
+        else if (Calypso_ViewEquals(cmdName, "+eventwakeup"))
         {
             *pEvent = ATEvent_WakeUp;
         }
-        else if (0 == strcasecmp(cmdName, "+recv"))
+        else if (Calypso_ViewEquals(cmdName, "+recv"))
         {
             *pEvent = ATEvent_SocketRcvd;
         }
-        else if (0 == strcasecmp(cmdName, "+recvfrom"))
+        else if (Calypso_ViewEquals(cmdName, "+recvfrom"))
         {
             *pEvent = ATEvent_SocketRcvdFrom;
         }
-        else if (0 == strcasecmp(cmdName, "+connect"))
+        else if (Calypso_ViewEquals(cmdName, "+connect"))
         {
             *pEvent = ATEvent_SocketTCPConnect;
         }
-        else if (0 == strcasecmp(cmdName, "+accept"))
+        else if (Calypso_ViewEquals(cmdName, "+accept"))
         {
             *pEvent = ATEvent_SocketTCPAccept;
         }
-        else if (0 == strcasecmp(cmdName, "+eventhttpget"))
+        else if (Calypso_ViewEquals(cmdName, "+eventhttpget"))
         {
             *pEvent = ATEvent_HTTPGet;
         }
-        else if (0 == strcasecmp(cmdName, "+eventcustom"))
+        else if (Calypso_ViewEquals(cmdName, "+eventcustom"))
         {
             uint8_t customEventId;
             ret = Calypso_GetNextArgumentInt(pAtCommand,
@@ -203,11 +214,11 @@ bool ATEvent_ParseEventType(char **pAtCommand, ATEvent_t *pEvent)
                 }
             }
         }
-        else if (0 == strcasecmp(cmdName, "+netappping"))
+        else if (Calypso_ViewEquals(cmdName, "+netappping"))
         {
             *pEvent = ATEvent_Ping;
         }
-        else if (0 == strcasecmp(cmdName, "+filegetfilelist"))
+        else if (Calypso_ViewEquals(cmdName, "+filegetfilelist"))
         {
             *pEvent = ATEvent_FileListEntry;
         }
@@ -237,44 +248,64 @@ bool ATEvent_GetEventName(ATEvent_t event, char* pEventName)
  * @brief Parses the values of the startup event arguments.
  *
  * @param[in,out] pEventArguments String containing arguments of the AT command
- * @param[out] Calypso_Examples_startupEvent The parsed startup event data
+ * @param[out] startupEvent The parsed startup event data (references pEventArguments)
  *
  * @return true if parsed successfully, false otherwise
  */
-bool ATEvent_ParseStartUpEvent(char **pEventArguments, ATEvent_Startup_t *Calypso_Examples_startupEvent)
+bool ATEvent_ParseStartUpEvent(char **pEventArguments, ATEvent_Startup_t *startupEvent)
 {
     bool ret = false;
 
-    ret = Calypso_GetNextArgumentString(pEventArguments, Calypso_Examples_startupEvent->articleNr, CALYPSO_ARGUMENT_DELIM, sizeof(Calypso_Examples_startupEvent->articleNr));
+    ret = Calypso_GetNextArgumentView(pEventArguments, &startupEvent->articleNr, CALYPSO_ARGUMENT_DELIM);
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentString(pEventArguments, Calypso_Examples_startupEvent->chipID, CALYPSO_ARGUMENT_DELIM, sizeof(Calypso_Examples_startupEvent->chipID));
+        ret = Calypso_GetNextArgumentView(pEventArguments, &startupEvent->chipID, CALYPSO_ARGUMENT_DELIM);
     }
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentString(pEventArguments, Calypso_Examples_startupEvent->MACAddress, CALYPSO_ARGUMENT_DELIM, sizeof(Calypso_Examples_startupEvent->MACAddress));
+        ret = Calypso_GetNextArgumentView(pEventArguments, &startupEvent->MACAddress, CALYPSO_ARGUMENT_DELIM);
     }
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentInt(pEventArguments, &(Calypso_Examples_startupEvent->firmwareVersion[0]), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, '.');
+        ret = Calypso_GetNextArgumentInt(pEventArguments, &(startupEvent->firmwareVersion[0]), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, '.');
     }
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentInt(pEventArguments, &(Calypso_Examples_startupEvent->firmwareVersion[1]), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED,'.');
+        ret = Calypso_GetNextArgumentInt(pEventArguments, &(startupEvent->firmwareVersion[1]), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED,'.');
     }
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentInt(pEventArguments, &(Calypso_Examples_startupEvent->firmwareVersion[2]), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_STRING_TERMINATE);
+        ret = Calypso_GetNextArgumentInt(pEventArguments, &(startupEvent->firmwareVersion[2]), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_STRING_TERMINATE);
     }
 
     return ret;
 }
 
+/**
+ * @brief Copies the parameters of a startup event.
+ *
+ * @param[in] startupEvent Startup event data as returned by ATEvent_ParseStartUpEvent()
+ * @param[out] copy Copy of the startup event data
+ *
+ * @return true if successful, false if a string doesn't fit into the copy
+ */
+bool ATEvent_CopyStartUpEvent(const ATEvent_Startup_t *startupEvent, ATEvent_StartupCopy_t *copy)
+{
+    if (!Calypso_ViewToString(copy->articleNr, startupEvent->articleNr, sizeof(copy->articleNr)) ||
+        !Calypso_ViewToString(copy->chipID, startupEvent->chipID, sizeof(copy->chipID)) ||
+        !Calypso_ViewToString(copy->MACAddress, startupEvent->MACAddress, sizeof(copy->MACAddress)))
+    {
+        return false;
+    }
+    memcpy(copy->firmwareVersion, startupEvent->firmwareVersion, sizeof(copy->firmwareVersion));
+    return true;
+}
+
 /**
  * @brief Parses the values of the ping event arguments.
  *
@@ -306,7 +337,7 @@ bool ATEvent_ParsePingEvent(char **pEventArguments, ATEvent_Ping_t *pingEvent)
  * @brief Parses the values of the TCP connect event arguments.
  *
  * @param[in,out] pEventArguments String containing arguments of the AT command
- * @param[out] connectEvent The parsed TCP connect event data
+ * @param[out] connectEvent The parsed TCP connect event data (references pEventArguments)
  *
  * @return true if parsed successfully, false otherwise
  */
@@ -315,31 +346,45 @@ bool ATEvent_ParseSocketTCPConnectEvent(char **pEventArguments, ATEvent_SocketTC
     bool ret = Calypso_GetNextArgumentInt(pEventArguments, &(connectEvent->serverPort), CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM);
     if (ret)
     {
-        ret = Calypso_GetNextArgumentString(pEventArguments, connectEvent->serverAddress, CALYPSO_STRING_TERMINATE, sizeof(connectEvent->serverAddress));
+        ret = Calypso_GetNextArgumentView(pEventArguments, &connectEvent->serverAddress, CALYPSO_STRING_TERMINATE);
     }
     return ret;
 }
 
+/**
+ * @brief Copies the parameters of a TCP connect event.
+ *
+ * @param[in] connectEvent TCP connect event data as returned by ATEvent_ParseSocketTCPConnectEvent()
+ * @param[out] copy Copy of the TCP connect event data
+ *
+ * @return true if successful, false if the address doesn't fit into the copy
+ */
+bool ATEvent_CopySocketTCPConnectEvent(const ATEvent_SocketTCPConnect_t *connectEvent, ATEvent_SocketTCPConnectCopy_t *copy)
+{
+    copy->serverPort = connectEvent->serverPort;
+    return Calypso_ViewToString(copy->serverAddress, connectEvent->serverAddress, sizeof(copy->serverAddress));
+}
+
 /**
  * @brief Parses the values of the TCP accept event arguments.
  *
  * @param[in,out] pEventArguments String containing arguments of the AT command
- * @param[out] acceptEvent The parsed TCP accept event data
+ * @param[out] acceptEvent The parsed TCP accept event data (references pEventArguments)
  *
  * @return true if parsed successfully, false otherwise
  */
 bool ATEvent_ParseSocketTCPAcceptEvent(char **pEventArguments, ATEvent_SocketTCPAccept_t* acceptEvent)
 {
-    char temp[12];
+    Calypso_StringView_t argument;
 
     bool ret = Calypso_GetNextArgumentInt(pEventArguments, &(acceptEvent->socketID), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM);
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentString(pEventArguments, temp, CALYPSO_ARGUMENT_DELIM, sizeof(temp));
+        ret = Calypso_GetNextArgumentView(pEventArguments, &argument, CALYPSO_ARGUMENT_DELIM);
         if (ret)
         {
-            ret = ATSocket_ParseSocketFamily(temp, &(acceptEvent->family));
+            ret = ATSocket_ParseSocketFamilyView(argument, &(acceptEvent->family));
         }
     }
 
@@ -350,18 +395,36 @@ bool ATEvent_ParseSocketTCPAcceptEvent(char **pEventArguments, ATEvent_SocketTCP
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentString(pEventArguments, acceptEvent->clientAddress, CALYPSO_STRING_TERMINATE, sizeof(acceptEvent->clientAddress));
+        ret = Calypso_GetNextArgumentView(pEventArguments, &acceptEvent->clientAddress, CALYPSO_STRING_TERMINATE);
     }
 
     return ret;
 }
 
+/**
+ * @brief Copies the parameters of a TCP accept event.
+ *
+ * @param[in] acceptEvent TCP accept event data as returned by ATEvent_ParseSocketTCPAcceptEvent()
+ * @param[out] copy Copy of the TCP accept event data
+ *
+ * @return true if successful, false if the address doesn't fit into the copy
+ */
+bool ATEvent_CopySocketTCPAcceptEvent(const ATEvent_SocketTCPAccept_t *acceptEvent, ATEvent_SocketTCPAcceptCopy_t *copy)
+{
+    copy->socketID = acceptEvent->socketID;
+    copy->family = acceptEvent->family;
+    copy->clientPort = acceptEvent->clientPort;
+    return Calypso_ViewToString(copy->clientAddress, acceptEvent->clientAddress, sizeof(copy->clientAddress));
+}
+
 /**
  * @brief Parses the values of the socket receive / receive from event arguments.
  *
+ * Base64 encoded data is decoded in place, i.e. the event text is modified.
+ *
  * @param[in,out] pEventArguments String containing arguments of the AT command
  * @param[in] decodeBase64 Enables decoding of received Base64 data
- * @param[out] rcvdEvent The parsed socket receive / receive from event data
+ * @param[out] rcvdEvent The parsed socket receive / receive from event data (references pEventArguments)
  *
  * @return true if parsed successfully, false otherwise
  */
@@ -369,6 +432,8 @@ bool ATEvent_ParseSocketRcvdEvent(char **pEventArguments,
                                   bool decodeBase64,
                                   ATEvent_SocketRcvd_t* rcvdEvent)
 {
+    uint16_t length;
+
     if (!Calypso_GetNextArgumentInt(pEventArguments, &(rcvdEvent->socketID), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM))
     {
         return false;
@@ -379,85 +444,135 @@ bool ATEvent_ParseSocketRcvdEvent(char **pEventArguments,
         return false;
     }
 
-    if (!Calypso_GetNextArgumentInt(pEventArguments, &(rcvdEvent->length), CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM))
+    if (!Calypso_GetNextArgumentInt(pEventArguments, &length, CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
 
-    if (decodeBase64)
+    return ATEvent_ParseData(pEventArguments, length, decodeBase64, &rcvdEvent->data);
+}
+
+/**
+ * @brief Parses the values of the MQTT message received event arguments.
+ *
+ * Expected format: <topic>,<QoS>,<retain>,<duplicate>,<format>,<length>,<data>
+ *
+ * Base64 encoded data is decoded in place, i.e. the event text is modified.
+ *
+ * @param[in,out] pEventArguments String containing arguments of the AT command
+ * @param[in] decodeBase64 Enables decoding of received data if it is Base64 encoded
+ * @param[out] rcvdEvent The parsed MQTT message received event data (references pEventArguments)
+ *
+ * @return true if parsed successfully, false otherwise
+ */
+bool ATEvent_ParseMQTTRcvdEvent(char **pEventArguments,
+                                bool decodeBase64,
+                                ATEvent_MQTTRcvd_t* rcvdEvent)
+{
+    uint8_t qos;
+    uint16_t length;
+
+    if (!Calypso_GetNextArgumentView(pEventArguments, &rcvdEvent->topic, CALYPSO_ARGUMENT_DELIM))
     {
-        uint32_t decodedSize = Calypso_GetBase64DecBufSize((uint8_t*) *pEventArguments, rcvdEvent->length);
-        if (decodedSize - 1 > sizeof(rcvdEvent->data))
-        {
-            return false;
-        }
+        return false;
+    }
 
-        if (!Calypso_DecodeBase64((uint8_t*) *pEventArguments, rcvdEvent->length, (uint8_t*) rcvdEvent->data, &decodedSize))
-        {
-            return false;
-        }
-        rcvdEvent->length = decodedSize - 1;
-        return true;
+    if (!Calypso_GetNextArgumentEnum(pEventArguments, &qos, ATEvent_MQTTQoSStrings, ATMQTT_QoS_NumberOfValues, 8, CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
     }
+    rcvdEvent->QoS = (ATMQTT_QoS_t) qos;
 
-    /* Received bytes count must not exceed buffer size */
-    if (rcvdEvent->length >= sizeof(rcvdEvent->data) - 1)
+    if (!Calypso_GetNextArgumentInt(pEventArguments, &(rcvdEvent->retain), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
-    return Calypso_GetNextArgumentString(pEventArguments, rcvdEvent->data, CALYPSO_STRING_TERMINATE, sizeof(rcvdEvent->data));
+
+    if (!Calypso_GetNextArgumentInt(pEventArguments, &(rcvdEvent->duplicate), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
+    }
+
+    if (!Calypso_GetNextArgumentInt(pEventArguments, &(rcvdEvent->format), CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
+    }
+
+    if (!Calypso_GetNextArgumentInt(pEventArguments, &length, CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
+    }
+
+    return ATEvent_ParseData(pEventArguments,
+                             length,
+                             decodeBase64 && Calypso_DataFormat_Base64 == rcvdEvent->format,
+                             &rcvdEvent->data);
 }
 
 /**
  * @brief Parses the values of the IPv4 acquired event arguments.
  *
  * @param[in,out] pEventArguments String containing arguments of the AT command
- * @param[out] ipv4Event The parsed IPv4 acquired event data
+ * @param[out] ipv4Event The parsed IPv4 acquired event data (references pEventArguments)
  *
  * @return true if parsed successfully, false otherwise
  */
 bool ATEvent_ParseNetappIP4AcquiredEvent(char **pEventArguments, ATEvent_NetappIP4Acquired_t* ipv4Event)
 {
-    bool ret = Calypso_GetNextArgumentString(pEventArguments, ipv4Event->address, CALYPSO_ARGUMENT_DELIM, sizeof(ipv4Event->address));
+    bool ret = Calypso_GetNextArgumentView(pEventArguments, &ipv4Event->address, CALYPSO_ARGUMENT_DELIM);
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentString(pEventArguments, ipv4Event->gateway, CALYPSO_ARGUMENT_DELIM, sizeof(ipv4Event->gateway));
+        ret = Calypso_GetNextArgumentView(pEventArguments, &ipv4Event->gateway, CALYPSO_ARGUMENT_DELIM);
     }
 
     if (ret)
     {
-        ret = Calypso_GetNextArgumentString(pEventArguments, ipv4Event->DNS, CALYPSO_STRING_TERMINATE, sizeof(ipv4Event->DNS));
+        ret = Calypso_GetNextArgumentView(pEventArguments, &ipv4Event->DNS, CALYPSO_STRING_TERMINATE);
     }
 
     return ret;
 }
 
+/**
+ * @brief Copies the parameters of an IPv4 acquired event.
+ *
+ * @param[in] ipv4Event IPv4 acquired event data as returned by ATEvent_ParseNetappIP4AcquiredEvent()
+ * @param[out] copy Copy of the IPv4 acquired event data
+ *
+ * @return true if successful, false if an address doesn't fit into the copy
+ */
+bool ATEvent_CopyNetappIP4AcquiredEvent(const ATEvent_NetappIP4Acquired_t *ipv4Event, ATEvent_NetappIP4AcquiredCopy_t *copy)
+{
+    return Calypso_ViewToString(copy->address, ipv4Event->address, sizeof(copy->address)) &&
+           Calypso_ViewToString(copy->gateway, ipv4Event->gateway, sizeof(copy->gateway)) &&
+           Calypso_ViewToString(copy->DNS, ipv4Event->DNS, sizeof(copy->DNS));
+}
+
 /**
  * @brief Retrieves the HTTP GET event ID argument.
  *
  * @param[in,out] pEventArguments String containing arguments of the AT command
- * @param[out] id The HTTP GET event ID
- * @param[in] maxIdLength Max. length of ID (including string termination character).
+ * @param[out] id The HTTP GET event ID (references pEventArguments)
  *
  * @return true if parsed successfully, false otherwise
  */
-bool ATEvent_ParseHttpGetEvent(char **pEventArguments, char *id, uint16_t maxIdLength)
+bool ATEvent_ParseHttpGetEvent(char **pEventArguments, Calypso_StringView_t *id)
 {
-    return Calypso_GetNextArgumentString(pEventArguments, id, CALYPSO_STRING_TERMINATE, maxIdLength);
+    return Calypso_GetNextArgumentView(pEventArguments, id, CALYPSO_STRING_TERMINATE);
 }
 
 /**
  * @brief Parses the values of the file list entry event arguments.
  *
  * @param[in,out] pEventArguments String containing arguments of the AT command
- * @param[out] fileListEntry The parsed file list entry data
+ * @param[out] fileListEntry The parsed file list entry data (references pEventArguments)
  *
  * @return true if parsed successfully, false otherwise
  */
-bool ATEvent_ParseFileListEntryEvent(char **pEventArguments, ATFile_FileListEntry_t* fileListEntry)
+bool ATEvent_ParseFileListEntryEvent(char **pEventArguments, ATFile_FileListEntryView_t* fileListEntry)
 {
-    return ATFile_ParseFileListEntry(pEventArguments, fileListEntry);
+    return ATFile_ParseFileListEntryView(pEventArguments, fileListEntry);
 }
 
 /**
@@ -480,37 +595,30 @@ bool ATEvent_ParseCustomGPIOEvent(char **pEventArguments, uint8_t *gpioId)
  * @brief Parses the values of the custom HTTP POST event arguments.
  *
  * @param[in,out] pEventArguments String containing arguments of the AT command
- * @param[out] id HTTP POST event id
- * @param[out] value HTTP POST event value
- * @param[in] maxIdLength Max. length of ID (including string termination character)
- * @param[in] maxValueLength Max. length of value (including string termination character)
+ * @param[out] postEvent HTTP POST event id and value (references pEventArguments)
  *
  * @return true if parsed successfully, false otherwise
  */
-bool ATEvent_ParseCustomHTTPPostEvent(char **pEventArguments,
-                                      char *id,
-                                      char *value,
-                                      uint16_t maxIdLength,
-                                      uint16_t maxValueLength)
+bool ATEvent_ParseCustomHTTPPostEvent(char **pEventArguments, ATEvent_CustomHTTPPost_t *postEvent)
 {
-    if (!Calypso_GetNextArgumentString(pEventArguments, id, CALYPSO_ARGUMENT_DELIM, maxIdLength))
+    if (!Calypso_GetNextArgumentView(pEventArguments, &postEvent->id, CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
-    return Calypso_GetNextArgumentString(pEventArguments, value, CALYPSO_STRING_TERMINATE, maxValueLength);
+    return Calypso_GetNextArgumentView(pEventArguments, &postEvent->value, CALYPSO_STRING_TERMINATE);
 }
 
 /**
  * @brief Parses an event sub type string (first argument of received event string) to ATEvent_t.
  *
- * @param[in] eventSubTypeString String containing the event's ID
+ * @param[in] eventSubTypeString View of string containing the event's ID
  * @param[in] eventMainType Main event type category (ATEvent_General, ATEvent_Wlan, ATEvent_Socket,
  *            ATEvent_Netapp, ATEvent_MQTT or ATEvent_FatalError)
  * @param[out] pEventSubType ATEvent_t representing the event
  *
  * @return true if parsed successfully, false otherwise
  */
-static bool ATEvent_ParseEventSubType(const char *eventSubTypeString,
+static bool ATEvent_ParseEventSubType(Calypso_StringView_t eventSubTypeString,
                                       ATEvent_t eventMainType,
                                       ATEvent_t *pEventSubType)
 {
@@ -548,15 +656,73 @@ static bool ATEvent_ParseEventSubType(const char *eventSubTypeString,
 
     *pEventSubType = ATEvent_Invalid;
 
-    for (int i = 0; i < typeCount; i++)
+    bool ok;
+    uint8_t index = Calypso_FindView(&ATEvent_Strings[eventMainType], typeCount, eventSubTypeString, 0, &ok);
+    if (ok)
+    {
+        *pEventSubType = eventMainType + (ATEvent_t) index;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Gets the (last) data argument of a receive event.
+ *
+ * Base64 encoded data is decoded in place, i.e. the decoded data replaces the encoded data
+ * in the event text (and is null terminated).
+ *
+ * @param[in,out] pEventArguments String containing the data argument
+ * @param[in] length Number of bytes in data argument (as reported by the event)
+ * @param[in] decodeBase64 Enables decoding of Base64 data
+ * @param[out] data View of the (decoded) data
+ *
+ * @return true if successful, false otherwise
+ */
+static bool ATEvent_ParseData(char **pEventArguments,
+                              uint16_t length,
+                              bool decodeBase64,
+                              Calypso_StringView_t *data)
+{
+    char *pArgument = *pEventArguments;
+    if (NULL == pArgument)
+    {
+        return false;
+    }
+
+    /* Received bytes count must not exceed the length of the event text. The length is
+     * known, so the data is checked for a terminator with memchr() instead of being
+     * scanned character by character. */
+    if (NULL != memchr(pArgument, '\0', length))
+    {
+        return false;
+    }
+
+    /* Move the cursor behind the data (the last argument of the event) */
+    size_t argumentLength = length + strlen(pArgument + length);
+    if (argumentLength > 0)
+    {
+        *pEventArguments = pArgument + argumentLength + 1;
+    }
+
+    data->data = pArgument;
+    data->length = length;
+
+    if (decodeBase64)
     {
-        ATEvent_t event = eventMainType + (ATEvent_t) i;
-        if (0 == strcasecmp(eventSubTypeString, ATEvent_Strings[event]))
+        uint8_t *pData = (uint8_t*) pArgument;
+        uint32_t decodedSize = Calypso_GetBase64DecBufSize(pData, length);
+        if (0 == decodedSize)
         {
-            *pEventSubType = event;
-            return true;
+            return false;
+        }
+
+        if (!Calypso_DecodeBase64(pData, length, pData, &decodedSize))
+        {
+            return false;
         }
+        data->length = decodedSize - 1;
     }
 
-    return false;
+    return true;
 }
@@ -34,6 +34,7 @@
 #include <stdint.h>
 
 #include "ATSocket.h"
+#include "ATMQTT.h"
 
 #define ATEvent_General_NumberOfValues      2
 #define ATEvent_WLAN_NumberOfValues         13
@@ -42,11 +43,6 @@
 #define ATEvent_MQTT_NumberOfValues         3
 #define ATEvent_FatalError_NumberOfValues   5
 
-/**
- * @brief Size of receive buffer in ATEvent_SocketRcvd_t struct.
- */
-#define ATEVENT_RCVDEVENTBUFFERSIZE         CALYPSO_RECEIVE_BUFFER_SIZE
-
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -135,14 +131,28 @@ typedef enum ATEvent_CustomEventID_t
 
 /**
  * @brief Parameters of startup event (ATEvent_Startup).
+ *
+ * The strings reference the event text, i.e. they are only valid inside the event callback.
+ * Use ATEvent_CopyStartUpEvent() to retain the data.
  */
 typedef struct ATEvent_Startup_t
+{
+    Calypso_StringView_t articleNr;
+    Calypso_StringView_t chipID;
+    Calypso_StringView_t MACAddress;
+    uint8_t firmwareVersion[3];
+} ATEvent_Startup_t;
+
+/**
+ * @brief Copy of the parameters of the startup event (see ATEvent_CopyStartUpEvent()).
+ */
+typedef struct ATEvent_StartupCopy_t
 {
     char articleNr[16];
     char chipID[12];
     char MACAddress[18];
     uint8_t firmwareVersion[3];
-} ATEvent_Startup_t;
+} ATEvent_StartupCopy_t;
 
 /**
  * @brief Parameters of ping event (ATEvent_Ping).
@@ -156,65 +166,138 @@ typedef struct ATEvent_Ping_t
 
 /**
  * @brief Parameters of TCP connect event (ATEvent_SocketTCPConnect).
+ *
+ * The server address references the event text, i.e. it is only valid inside the event callback.
+ * Use ATEvent_CopySocketTCPConnectEvent() to retain the data.
  */
 typedef struct ATEvent_SocketTCPConnect_t
 {
     uint16_t serverPort;
-    char serverAddress[AT_MAX_IP_ADDRESS_LENGTH];
+    Calypso_StringView_t serverAddress;
 } ATEvent_SocketTCPConnect_t;
 
+/**
+ * @brief Copy of the parameters of the TCP connect event (see ATEvent_CopySocketTCPConnectEvent()).
+ */
+typedef struct ATEvent_SocketTCPConnectCopy_t
+{
+    uint16_t serverPort;
+    char serverAddress[AT_MAX_IP_ADDRESS_LENGTH];
+} ATEvent_SocketTCPConnectCopy_t;
+
 /**
  * @brief Parameters of TCP accept event (ATEvent_SocketTCPAccept).
+ *
+ * The client address references the event text, i.e. it is only valid inside the event callback.
+ * Use ATEvent_CopySocketTCPAcceptEvent() to retain the data.
  */
 typedef struct ATEvent_SocketTCPAccept_t
 {
     uint8_t socketID;
     ATSocket_Family_t family;
     uint16_t clientPort;
-    char clientAddress[AT_MAX_IP_ADDRESS_LENGTH];
+    Calypso_StringView_t clientAddress;
 } ATEvent_SocketTCPAccept_t;
 
+/**
+ * @brief Copy of the parameters of the TCP accept event (see ATEvent_CopySocketTCPAcceptEvent()).
+ */
+typedef struct ATEvent_SocketTCPAcceptCopy_t
+{
+    uint8_t socketID;
+    ATSocket_Family_t family;
+    uint16_t clientPort;
+    char clientAddress[AT_MAX_IP_ADDRESS_LENGTH];
+} ATEvent_SocketTCPAcceptCopy_t;
+
 /**
  * @brief Parameters of TCP data received event (ATEvent_SocketRcvd).
+ *
+ * The data references the event text, i.e. it is only valid inside the event callback.
+ * Use Calypso_ViewToString() to copy the data to a buffer of sufficient size.
  */
 typedef struct ATEvent_SocketRcvd_t
 {
     uint8_t socketID;
     uint8_t format;
-    uint16_t length;
-    char data[ATEVENT_RCVDEVENTBUFFERSIZE];
+    Calypso_StringView_t data;                              /**< Received data (data.length is the number of received bytes) */
 } ATEvent_SocketRcvd_t;
 
+/**
+ * @brief Parameters of MQTT message received event (ATEvent_MQTTRecv).
+ *
+ * Topic and data reference the event text, i.e. they are only valid inside the event callback.
+ * Use Calypso_ViewToString() to copy topic or data to a buffer of sufficient size.
+ */
+typedef struct ATEvent_MQTTRcvd_t
+{
+    Calypso_StringView_t topic;
+    ATMQTT_QoS_t QoS;
+    uint8_t retain;
+    uint8_t duplicate;
+    uint8_t format;
+    Calypso_StringView_t data;                              /**< Received data (data.length is the number of received bytes) */
+} ATEvent_MQTTRcvd_t;
+
 /**
  * @brief Parameters of IPv4 acquired event (ATEvent_NetappIP4Acquired).
+ *
+ * The addresses reference the event text, i.e. they are only valid inside the event callback.
+ * Use ATEvent_CopyNetappIP4AcquiredEvent() to retain the data.
  */
 typedef struct ATEvent_NetappIP4Acquired_t
+{
+    Calypso_StringView_t address;
+    Calypso_StringView_t gateway;
+    Calypso_StringView_t DNS;
+} ATEvent_NetappIP4Acquired_t;
+
+/**
+ * @brief Copy of the parameters of the IPv4 acquired event (see ATEvent_CopyNetappIP4AcquiredEvent()).
+ */
+typedef struct ATEvent_NetappIP4AcquiredCopy_t
 {
     char address[16];
     char gateway[16];
     char DNS[16];
-} ATEvent_NetappIP4Acquired_t;
+} ATEvent_NetappIP4AcquiredCopy_t;
+
+/**
+ * @brief Parameters of custom HTTP POST event (ATEvent_CustomHTTPPost).
+ *
+ * ID and value reference the event text, i.e. they are only valid inside the event callback.
+ * Use Calypso_ViewToString() to retain them.
+ */
+typedef struct ATEvent_CustomHTTPPost_t
+{
+    Calypso_StringView_t id;
+    Calypso_StringView_t value;
+} ATEvent_CustomHTTPPost_t;
 
 extern bool ATEvent_ParseEventType(char **pAtCommand, ATEvent_t *pEvent);
 
 extern bool ATEvent_GetEventName(ATEvent_t event, char* pEventName);
 
-extern bool ATEvent_ParseStartUpEvent(char **pEventArguments, ATEvent_Startup_t *Calypso_Examples_startupEvent);
+extern bool ATEvent_ParseStartUpEvent(char **pEventArguments, ATEvent_Startup_t *startupEvent);
 extern bool ATEvent_ParsePingEvent(char **pEventArguments, ATEvent_Ping_t *pingEvent);
 extern bool ATEvent_ParseSocketTCPConnectEvent(char **pEventArguments, ATEvent_SocketTCPConnect_t* connectEvent);
 extern bool ATEvent_ParseSocketTCPAcceptEvent(char **pEventArguments, ATEvent_SocketTCPAccept_t* acceptEvent);
 extern bool ATEvent_ParseSocketRcvdEvent(char **pEventArguments,
                                          bool decodeBase64,
                                          ATEvent_SocketRcvd_t* rcvdEvent);
+extern bool ATEvent_ParseMQTTRcvdEvent(char **pEventArguments,
+                                       bool decodeBase64,
+                                       ATEvent_MQTTRcvd_t* rcvdEvent);
 extern bool ATEvent_ParseNetappIP4AcquiredEvent(char **pEventArguments, ATEvent_NetappIP4Acquired_t* ipv4Event);
-extern bool ATEvent_ParseHttpGetEvent(char **pEventArguments, char *id, uint16_t maxIdLength);
-extern bool ATEvent_ParseFileListEntryEvent(char **pEventArguments, ATFile_FileListEntry_t* fileListEntry);
+extern bool ATEvent_ParseHttpGetEvent(char **pEventArguments, Calypso_StringView_t *id);
+extern bool ATEvent_ParseFileListEntryEvent(char **pEventArguments, ATFile_FileListEntryView_t* fileListEntry);
 extern bool ATEvent_ParseCustomGPIOEvent(char **pEventArguments, uint8_t *gpioId);
-extern bool ATEvent_ParseCustomHTTPPostEvent(char **pEventArguments,
-                                             char *id,
-                                             char *value,
-                                             uint16_t maxIdLength,
-                                             uint16_t maxValueLength);
+extern bool ATEvent_ParseCustomHTTPPostEvent(char **pEventArguments, ATEvent_CustomHTTPPost_t *postEvent);
+
+extern bool ATEvent_CopyStartUpEvent(const ATEvent_Startup_t *startupEvent, ATEvent_StartupCopy_t *copy);
+extern bool ATEvent_CopySocketTCPConnectEvent(const ATEvent_SocketTCPConnect_t *connectEvent, ATEvent_SocketTCPConnectCopy_t *copy);
+extern bool ATEvent_CopySocketTCPAcceptEvent(const ATEvent_SocketTCPAccept_t *acceptEvent, ATEvent_SocketTCPAcceptCopy_t *copy);
+extern bool ATEvent_CopyNetappIP4AcquiredEvent(const ATEvent_NetappIP4Acquired_t *ipv4Event, ATEvent_NetappIP4AcquiredCopy_t *copy);
 
 #ifdef __cplusplus
 }
@@ -64,7 +64,7 @@ static const char *ATFile_FileProperties_Strings[ATFile_FileProperties_NumberOfV
     "public_read"
 };
 
-static bool ATFile_AddArgumentsFileOpen(char *pAtCommand, const char *fileName, uint32_t options, uint16_t fileSize);
+static bool ATFile_AddArgumentsFileOpen(char *pAtCommand, const char *fileName, uint32_t options, uint32_t fileSize);
 static bool ATFile_AddArgumentsFileClose(char *pAtCommand, uint32_t fileID, const char *certName, const char *signature);
 static bool ATFile_AddArgumentsFileDel(char *pAtCommand, const char *fileName, uint32_t secureToken);
 static bool ATFile_AddArgumentsFileRead(char *pAtCommand,
@@ -76,6 +76,7 @@ static bool ATFile_AddArgumentsFileWrite(char *pAtCommand,
                                          uint32_t fileID,
                                          uint16_t offset,
                                          Calypso_DataFormat_t format,
+                                         bool encodeAsBase64,
                                          uint16_t bytesToWrite,
                                          const char *data);
 
@@ -87,6 +88,77 @@ static bool ATFile_ParseResponseFileRead(char **pAtCommand,
                                          char *data);
 static bool ATFile_ParseResponseFileWrite(char **pAtCommand, uint16_t *bytesWritten);
 
+#if ATFILE_CACHE_SIZE > 0
+
+#define ATFILE_CACHE_BLOCK_COUNT (ATFILE_CACHE_SIZE / ATFILE_CACHE_BLOCK_SIZE)
+
+#if ATFILE_CACHE_BLOCK_COUNT == 0
+#error "ATFILE_CACHE_SIZE must be at least ATFILE_CACHE_BLOCK_SIZE"
+#endif
+
+/**
+ * @brief Max. number of files opened for writing whose IDs are tracked for invalidating the cache.
+ */
+#define ATFILE_CACHE_MAX_WRITE_FILES 4
+
+/**
+ * @brief File with cached blocks.
+ */
+typedef struct ATFile_CacheFile_t
+{
+    char name[ATFILE_CACHE_MAX_FILENAME_LENGTH];    /**< File name (empty if unused) */
+    uint32_t size;                                  /**< File size as returned by ATFile_GetInfo() */
+    uint32_t lastUsed;                              /**< Value of ATFile_cacheUseCounter on last access */
+} ATFile_CacheFile_t;
+
+/**
+ * @brief Cached block of a file.
+ */
+typedef struct ATFile_CacheBlock_t
+{
+    bool valid;                                     /**< Block contains data */
+    uint8_t file;                                   /**< Index in ATFile_cacheFiles */
+    uint16_t index;                                 /**< Block index (file offset / ATFILE_CACHE_BLOCK_SIZE) */
+    uint16_t length;                                /**< Number of valid bytes (less than block size for the last block) */
+    uint32_t lastUsed;                              /**< Value of ATFile_cacheUseCounter on last access */
+    char data[ATFILE_CACHE_BLOCK_SIZE + 1];         /**< Block data (ATFile_Read() appends '\0') */
+} ATFile_CacheBlock_t;
+
+/**
+ * @brief File opened for writing using ATFile_Open().
+ */
+typedef struct ATFile_CacheWriteFile_t
+{
+    bool used;                                      /**< Entry is in use */
+    uint32_t fileID;                                /**< ID returned by ATFile_Open() */
+    char name[ATFILE_CACHE_MAX_FILENAME_LENGTH];    /**< File name */
+} ATFile_CacheWriteFile_t;
+
+static ATFile_CacheFile_t ATFile_cacheFiles[ATFILE_CACHE_MAX_FILES];
+static ATFile_CacheBlock_t ATFile_cacheBlocks[ATFILE_CACHE_BLOCK_COUNT];
+static ATFile_CacheWriteFile_t ATFile_cacheWriteFiles[ATFILE_CACHE_MAX_WRITE_FILES];
+
+/**
+ * @brief Incremented on every cache access, used for least recently used eviction.
+ */
+static uint32_t ATFile_cacheUseCounter = 0;
+
+/**
+ * @brief Value of Calypso_GetStartupCount() when the cache was last validated.
+ */
+static uint32_t ATFile_cacheStartupCount = 0;
+
+static uint32_t ATFile_cacheHits = 0;
+static uint32_t ATFile_cacheMisses = 0;
+
+static int8_t ATFile_CacheGetFile(const char *fileName);
+static ATFile_CacheBlock_t *ATFile_CacheGetBlock(uint8_t file, uint16_t index, bool *hit);
+static void ATFile_CacheValidate(void);
+static void ATFile_CacheRegisterWrite(const char *fileName, uint32_t fileID);
+static void ATFile_CacheInvalidateFileID(uint32_t fileID, bool closing);
+
+#endif /* ATFILE_CACHE_SIZE > 0 */
+
 
 /**
  * @brief Opens a file (using the AT+FileOpen command).
@@ -99,7 +171,7 @@ static bool ATFile_ParseResponseFileWrite(char **pAtCommand, uint16_t *bytesWrit
  *
  * @return true if successful, false otherwise
  */
-bool ATFile_Open(const char *fileName, uint32_t options, uint16_t fileSize, uint32_t *fileID, uint32_t *secureToken)
+bool ATFile_Open(const char *fileName, uint32_t options, uint32_t fileSize, uint32_t *fileID, uint32_t *secureToken)
 {
     bool ret = false;
 
@@ -124,6 +196,17 @@ bool ATFile_Open(const char *fileName, uint32_t options, uint16_t fileSize, uint
         ret = ATFile_ParseResponseFileOpen(&pRespondCommand, fileID, secureToken);
     }
 
+#if ATFILE_CACHE_SIZE > 0
+    if (0 != (options & (ATFile_OpenFlags_Create | ATFile_OpenFlags_Write | ATFile_OpenFlags_Overwrite)))
+    {
+        ATFile_InvalidateCache(fileName);
+        if (ret)
+        {
+            ATFile_CacheRegisterWrite(fileName, *fileID);
+        }
+    }
+#endif
+
     return ret;
 }
 
@@ -144,6 +227,10 @@ bool ATFile_Close(uint32_t fileID, char *certFileName, char *signature)
 
     strcpy(pRequestCommand, "AT+fileClose=");
 
+#if ATFILE_CACHE_SIZE > 0
+    ATFile_CacheInvalidateFileID(fileID, true);
+#endif
+
     ret = ATFile_AddArgumentsFileClose(pRequestCommand, fileID, certFileName, signature);
 
     if (ret)
@@ -172,6 +259,10 @@ bool ATFile_Delete(const char *fileName, uint32_t secureToken)
 
     char *pRequestCommand = AT_commandBuffer;
 
+#if ATFILE_CACHE_SIZE > 0
+    ATFile_InvalidateCache(fileName);
+#endif
+
     strcpy(pRequestCommand, "AT+fileDel=");
 
     ret = ATFile_AddArgumentsFileDel(pRequestCommand, fileName, secureToken);
@@ -291,52 +382,21 @@ bool ATFile_Write(uint32_t fileID,
 {
     *bytesWritten = 0;
 
-    if (encodeAsBase64)
-    {
-        /* Base64 encoded data might exceed the max. chunk size. To limit the required buffer size,
-         * the data is encoded in chunks, if necessary. */
-
-        uint16_t maxChunkSize = (((ATFILE_FILE_MAX_CHUNK_SIZE - 1) * 3) / 4) - 2;
-        uint16_t chunkSize = 0;
-        for (uint16_t chunkOffset = 0; chunkOffset < bytesToWrite; chunkOffset += chunkSize)
-        {
-            chunkSize = bytesToWrite - chunkOffset;
-            if (chunkSize > maxChunkSize)
-            {
-                chunkSize = maxChunkSize;
-            }
-
-            /* Encode as Base64 */
-            uint32_t lengthEncoded = Calypso_GetBase64EncBufSize(chunkSize);
-            char base64Buffer[lengthEncoded];
-            Calypso_EncodeBase64((uint8_t *) data + chunkOffset, chunkSize, (uint8_t *) base64Buffer, &lengthEncoded);
-
-            /* Recursively call ATFile_Write() with the encoded binary data */
-            uint16_t chunkBytesWritten = 0;
-            bool ok = ATFile_Write(fileID,
-                                   offset + chunkOffset,
-                                   format,
-                                   false,
-                                   lengthEncoded - 1,
-                                   base64Buffer,
-                                   &chunkBytesWritten);
-            if (!ok)
-            {
-                return false;
-            }
-            *bytesWritten += chunkSize;
-        }
+#if ATFILE_CACHE_SIZE > 0
+    ATFile_CacheInvalidateFileID(fileID, false);
+#endif
 
-       return true;
-    }
+    /* Base64 encoded data is larger than the raw data, so the raw chunk size is reduced accordingly.
+     * The data is encoded directly into the command buffer. */
+    uint16_t maxChunkSize = encodeAsBase64 ? (((ATFILE_FILE_MAX_CHUNK_SIZE - 1) * 3) / 4) - 2 : ATFILE_FILE_MAX_CHUNK_SIZE;
 
     uint16_t chunkBytesWritten = 0;
     for (uint16_t chunkOffset = 0; chunkOffset < bytesToWrite; chunkOffset += chunkBytesWritten)
     {
         uint16_t chunkSize = bytesToWrite - chunkOffset;
-        if (chunkSize > ATFILE_FILE_MAX_CHUNK_SIZE)
+        if (chunkSize > maxChunkSize)
         {
-            chunkSize = ATFILE_FILE_MAX_CHUNK_SIZE;
+            chunkSize = maxChunkSize;
         }
 
         char *pRequestCommand = AT_commandBuffer;
@@ -348,6 +408,7 @@ bool ATFile_Write(uint32_t fileID,
                                           fileID,
                                           offset + chunkOffset,
                                           format,
+                                          encodeAsBase64,
                                           chunkSize,
                                           data + chunkOffset))
         {
@@ -367,6 +428,11 @@ bool ATFile_Write(uint32_t fileID,
         {
             return false;
         }
+        if (encodeAsBase64)
+        {
+            /* Count the raw bytes (the response refers to the encoded data) */
+            chunkBytesWritten = chunkSize;
+        }
 
         *bytesWritten += chunkBytesWritten;
 
@@ -489,10 +555,27 @@ bool ATFile_GetFileList()
  */
 bool ATFile_ParseFileListEntry(char **pInArguments, ATFile_FileListEntry_t* fileListEntry)
 {
-    if (!Calypso_GetNextArgumentString(pInArguments,
-                                       fileListEntry->fileName,
-                                       CALYPSO_ARGUMENT_DELIM,
-                                       sizeof(fileListEntry->fileName)))
+    ATFile_FileListEntryView_t fileListEntryView;
+    return ATFile_ParseFileListEntryView(pInArguments, &fileListEntryView) &&
+           ATFile_CopyFileListEntry(&fileListEntryView, fileListEntry);
+}
+
+/**
+ * @brief Parses the values of a file list entry string without copying the file name.
+ *
+ * The file name references the supplied string, i.e. it is only valid as long as the
+ * string isn't modified (use ATFile_CopyFileListEntry() to retain the data).
+ *
+ * @param[in,out] pInArguments String containing arguments of the AT command
+ * @param[out] fileListEntry The parsed file list entry data
+ *
+ * @return true if parsed successfully, false otherwise
+ */
+bool ATFile_ParseFileListEntryView(char **pInArguments, ATFile_FileListEntryView_t* fileListEntry)
+{
+    if (!Calypso_GetNextArgumentView(pInArguments,
+                                     &fileListEntry->fileName,
+                                     CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
@@ -518,6 +601,26 @@ bool ATFile_ParseFileListEntry(char **pInArguments, ATFile_FileListEntry_t* file
                                       CALYPSO_STRING_TERMINATE);
 }
 
+/**
+ * @brief Copies a file list entry view to a file list entry.
+ *
+ * @param[in] fileListEntry File list entry view
+ * @param[out] copy Copy of the file list entry
+ *
+ * @return true if successful, false if the file name is too long
+ */
+bool ATFile_CopyFileListEntry(const ATFile_FileListEntryView_t *fileListEntry, ATFile_FileListEntry_t *copy)
+{
+    if (!Calypso_ViewToString(copy->fileName, fileListEntry->fileName, sizeof(copy->fileName)))
+    {
+        return false;
+    }
+    copy->maxFileSize = fileListEntry->maxFileSize;
+    copy->properties = fileListEntry->properties;
+    copy->allocatedBlocks = fileListEntry->allocatedBlocks;
+    return true;
+}
+
 /**
  * @brief Prints file property flags to string.
  *
@@ -537,6 +640,342 @@ bool ATFile_PrintFileProperties(uint32_t properties, char *pOutStr, size_t maxLe
                                          maxLength);
 }
 
+/**
+ * @brief Reads a file's contents using the RAM block cache (see ATFILE_CACHE_SIZE).
+ *
+ * Blocks which are not cached are read from the module (the file is opened, read and closed
+ * by this function). If the cache is disabled (ATFILE_CACHE_SIZE is 0) or the file name is
+ * longer than ATFILE_CACHE_MAX_FILENAME_LENGTH, the data is always read from the module.
+ *
+ * Note that the data is null terminated, i.e. the data buffer must be able to hold bytesToRead + 1 bytes.
+ *
+ * @param[in] fileName Name of the file
+ * @param[in] offset Offset for the read operation
+ * @param[in] bytesToRead Number of bytes to read
+ * @param[out] data Data that has been read
+ * @param[out] bytesRead Number of bytes which have been read (less than bytesToRead if the end of the file has been reached)
+ *
+ * @return true if successful, false otherwise
+ */
+bool ATFile_ReadCached(const char *fileName,
+                       uint16_t offset,
+                       uint16_t bytesToRead,
+                       char *data,
+                       uint16_t *bytesRead)
+{
+    *bytesRead = 0;
+
+    uint32_t fileID = 0;
+    uint32_t secureToken = 0;
+
+#if ATFILE_CACHE_SIZE > 0
+    int8_t file = ATFile_CacheGetFile(fileName);
+    if (file >= 0)
+    {
+        bool opened = false;
+        bool ret = true;
+
+        if (UINT32_MAX == ATFile_cacheFiles[file].size)
+        {
+            /* Size is unknown - required for not reading beyond the end of the file */
+            ATFile_FileInfo_t fileInfo;
+            if (!ATFile_GetInfo(fileName, 0, &fileInfo))
+            {
+                ATFile_cacheFiles[file].name[0] = '\0';
+                return false;
+            }
+            ATFile_cacheFiles[file].size = fileInfo.size;
+        }
+
+        while (*bytesRead < bytesToRead)
+        {
+            uint32_t position = (uint32_t) offset + *bytesRead;
+            if (position >= ATFile_cacheFiles[file].size)
+            {
+                break;
+            }
+
+            bool hit = false;
+            ATFile_CacheBlock_t *block = ATFile_CacheGetBlock(file, position / ATFILE_CACHE_BLOCK_SIZE, &hit);
+            if (!hit)
+            {
+                if (!opened)
+                {
+                    if (!ATFile_Open(fileName, ATFile_OpenFlags_Read, ATFILE_FILE_MIN_SIZE, &fileID, &secureToken))
+                    {
+                        ret = false;
+                        break;
+                    }
+                    opened = true;
+                }
+
+                uint32_t blockStart = (uint32_t) block->index * ATFILE_CACHE_BLOCK_SIZE;
+                uint16_t blockLength = ATFILE_CACHE_BLOCK_SIZE;
+                if (ATFile_cacheFiles[file].size - blockStart < blockLength)
+                {
+                    blockLength = ATFile_cacheFiles[file].size - blockStart;
+                }
+
+                if (!ATFile_Read(fileID, blockStart, Calypso_DataFormat_Base64, true, blockLength, block->data, &block->length))
+                {
+                    ret = false;
+                    break;
+                }
+                block->valid = true;
+            }
+
+            uint16_t blockOffset = position % ATFILE_CACHE_BLOCK_SIZE;
+            if (blockOffset >= block->length)
+            {
+                break;
+            }
+
+            uint16_t length = block->length - blockOffset;
+            if (length > bytesToRead - *bytesRead)
+            {
+                length = bytesToRead - *bytesRead;
+            }
+            memcpy(data + *bytesRead, block->data + blockOffset, length);
+            *bytesRead += length;
+        }
+
+        data[*bytesRead] = '\0';
+
+        if (opened && !ATFile_Close(fileID, NULL, NULL))
+        {
+            ret = false;
+        }
+
+        return ret;
+    }
+#endif /* ATFILE_CACHE_SIZE > 0 */
+
+    if (!ATFile_Open(fileName, ATFile_OpenFlags_Read, ATFILE_FILE_MIN_SIZE, &fileID, &secureToken))
+    {
+        return false;
+    }
+
+    bool ret = ATFile_Read(fileID, offset, Calypso_DataFormat_Base64, true, bytesToRead, data, bytesRead);
+
+    if (!ATFile_Close(fileID, NULL, NULL))
+    {
+        ret = false;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Removes a file's blocks from the RAM block cache.
+ *
+ * @param[in] fileName Name of the file. If NULL, the whole cache is invalidated.
+ */
+void ATFile_InvalidateCache(const char *fileName)
+{
+#if ATFILE_CACHE_SIZE > 0
+    for (uint8_t file = 0; file < ATFILE_CACHE_MAX_FILES; file++)
+    {
+        if ('\0' == ATFile_cacheFiles[file].name[0] ||
+                (NULL != fileName && 0 != strcmp(ATFile_cacheFiles[file].name, fileName)))
+        {
+            continue;
+        }
+
+        ATFile_cacheFiles[file].name[0] = '\0';
+        for (uint16_t i = 0; i < ATFILE_CACHE_BLOCK_COUNT; i++)
+        {
+            if (ATFile_cacheBlocks[i].file == file)
+            {
+                ATFile_cacheBlocks[i].valid = false;
+            }
+        }
+    }
+#else
+    (void) fileName;
+#endif
+}
+
+/**
+ * @brief Returns the number of cache hits and misses (blocks) of ATFile_ReadCached().
+ *
+ * @param[out] hits Number of blocks read from the cache
+ * @param[out] misses Number of blocks read from the module
+ */
+void ATFile_GetCacheStatistics(uint32_t *hits, uint32_t *misses)
+{
+#if ATFILE_CACHE_SIZE > 0
+    *hits = ATFile_cacheHits;
+    *misses = ATFile_cacheMisses;
+#else
+    *hits = 0;
+    *misses = 0;
+#endif
+}
+
+#if ATFILE_CACHE_SIZE > 0
+
+/**
+ * @brief Invalidates the cache if the module has restarted since the last access.
+ */
+static void ATFile_CacheValidate(void)
+{
+    uint32_t startupCount = Calypso_GetStartupCount();
+    if (startupCount != ATFile_cacheStartupCount)
+    {
+        ATFile_cacheStartupCount = startupCount;
+        ATFile_InvalidateCache(NULL);
+        memset(ATFile_cacheWriteFiles, 0, sizeof(ATFile_cacheWriteFiles));
+    }
+}
+
+/**
+ * @brief Returns the cache file entry for the supplied file name (evicting the least recently used file if required).
+ *
+ * @param[in] fileName Name of the file
+ *
+ * @return Index of the file entry or -1 if the file can't be cached (file name too long)
+ */
+static int8_t ATFile_CacheGetFile(const char *fileName)
+{
+    ATFile_CacheValidate();
+
+    if (strlen(fileName) >= ATFILE_CACHE_MAX_FILENAME_LENGTH)
+    {
+        return -1;
+    }
+
+    uint8_t lruFile = 0;
+    for (uint8_t file = 0; file < ATFILE_CACHE_MAX_FILES; file++)
+    {
+        if (0 == strcmp(ATFile_cacheFiles[file].name, fileName))
+        {
+            ATFile_cacheFiles[file].lastUsed = ++ATFile_cacheUseCounter;
+            return file;
+        }
+
+        if ('\0' == ATFile_cacheFiles[lruFile].name[0])
+        {
+            continue;
+        }
+        if ('\0' == ATFile_cacheFiles[file].name[0] || ATFile_cacheFiles[file].lastUsed < ATFile_cacheFiles[lruFile].lastUsed)
+        {
+            lruFile = file;
+        }
+    }
+
+    if ('\0' != ATFile_cacheFiles[lruFile].name[0])
+    {
+        ATFile_InvalidateCache(ATFile_cacheFiles[lruFile].name);
+    }
+
+    strcpy(ATFile_cacheFiles[lruFile].name, fileName);
+    ATFile_cacheFiles[lruFile].size = UINT32_MAX;
+    ATFile_cacheFiles[lruFile].lastUsed = ++ATFile_cacheUseCounter;
+    return lruFile;
+}
+
+/**
+ * @brief Returns the cached block or allocates a new block (evicting the least recently used block).
+ *
+ * @param[in] file Index of the file entry
+ * @param[in] index Block index
+ * @param[out] hit Is set to true if the block contains the cached data, false if it has been allocated
+ *
+ * @return Cache block
+ */
+static ATFile_CacheBlock_t *ATFile_CacheGetBlock(uint8_t file, uint16_t index, bool *hit)
+{
+    ATFile_CacheBlock_t *lruBlock = &ATFile_cacheBlocks[0];
+
+    for (uint16_t i = 0; i < ATFILE_CACHE_BLOCK_COUNT; i++)
+    {
+        ATFile_CacheBlock_t *block = &ATFile_cacheBlocks[i];
+        if (block->valid && block->file == file && block->index == index)
+        {
+            ATFile_cacheHits++;
+            block->lastUsed = ++ATFile_cacheUseCounter;
+            *hit = true;
+            return block;
+        }
+
+        if (!lruBlock->valid)
+        {
+            continue;
+        }
+        if (!block->valid || block->lastUsed < lruBlock->lastUsed)
+        {
+            lruBlock = block;
+        }
+    }
+
+    ATFile_cacheMisses++;
+    lruBlock->valid = false;
+    lruBlock->file = file;
+    lruBlock->index = index;
+    lruBlock->length = 0;
+    lruBlock->lastUsed = ++ATFile_cacheUseCounter;
+    *hit = false;
+    return lruBlock;
+}
+
+/**
+ * @brief Remembers the name of a file opened for writing, so that the cache can be invalidated on write and close.
+ *
+ * @param[in] fileName Name of the file
+ * @param[in] fileID ID of the file as returned by ATFile_Open()
+ */
+static void ATFile_CacheRegisterWrite(const char *fileName, uint32_t fileID)
+{
+    if (strlen(fileName) >= ATFILE_CACHE_MAX_FILENAME_LENGTH)
+    {
+        /* Can't be cached */
+        return;
+    }
+
+    for (uint8_t i = 0; i < ATFILE_CACHE_MAX_WRITE_FILES; i++)
+    {
+        if (!ATFile_cacheWriteFiles[i].used)
+        {
+            ATFile_cacheWriteFiles[i].used = true;
+            ATFile_cacheWriteFiles[i].fileID = fileID;
+            strcpy(ATFile_cacheWriteFiles[i].name, fileName);
+            return;
+        }
+    }
+
+    /* Not tracked - writes to this file will invalidate the whole cache */
+}
+
+/**
+ * @brief Invalidates the cached blocks of a file opened for writing.
+ *
+ * @param[in] fileID ID of the file as returned by ATFile_Open()
+ * @param[in] closing File is being closed (stop tracking the file ID)
+ */
+static void ATFile_CacheInvalidateFileID(uint32_t fileID, bool closing)
+{
+    for (uint8_t i = 0; i < ATFILE_CACHE_MAX_WRITE_FILES; i++)
+    {
+        if (ATFile_cacheWriteFiles[i].used && ATFile_cacheWriteFiles[i].fileID == fileID)
+        {
+            ATFile_InvalidateCache(ATFile_cacheWriteFiles[i].name);
+            if (closing)
+            {
+                ATFile_cacheWriteFiles[i].used = false;
+            }
+            return;
+        }
+    }
+
+    if (!closing)
+    {
+        /* Unknown file (opened for reading or not tracked) - invalidate everything to be safe */
+        ATFile_InvalidateCache(NULL);
+    }
+}
+
+#endif /* ATFILE_CACHE_SIZE > 0 */
+
 /**
  * @brief Adds arguments to the AT+fileOpen command string.
  *
@@ -547,7 +986,7 @@ bool ATFile_PrintFileProperties(uint32_t properties, char *pOutStr, size_t maxLe
  *
  * @return true if successful, false otherwise
  */
-static bool ATFile_AddArgumentsFileOpen(char *pAtCommand, const char *fileName, uint32_t options, uint16_t fileSize)
+static bool ATFile_AddArgumentsFileOpen(char *pAtCommand, const char *fileName, uint32_t options, uint32_t fileSize)
 {
     bool ret = false;
 
@@ -713,6 +1152,7 @@ static bool ATFile_AddArgumentsFileRead(char *pAtCommand, uint32_t fileID, uint1
  * @param[in] fileID ID of file to write as returned by ATFile_Open()
  * @param[in] offset Offset for the write operation
  * @param[in] format Format of the data to be written.
+ * @param[in] encodeAsBase64 Encode the data in Base64 format (directly into the command string)
  * @param[in] bytestoWrite Number of bytes to write
  * @param[in] data Data to be written
  *
@@ -722,6 +1162,7 @@ static bool ATFile_AddArgumentsFileWrite(char *pAtCommand,
                                          uint32_t fileID,
                                          uint16_t offset,
                                          Calypso_DataFormat_t format,
+                                         bool encodeAsBase64,
                                          uint16_t bytesToWrite,
                                          const char *data)
 {
@@ -746,12 +1187,20 @@ static bool ATFile_AddArgumentsFileWrite(char *pAtCommand,
 
     if (ret)
     {
-        ret = Calypso_AppendArgumentInt(pAtCommand, bytesToWrite, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM);
+        uint16_t length = encodeAsBase64 ? Calypso_GetBase64EncBufSize(bytesToWrite) - 1 : bytesToWrite;
+        ret = Calypso_AppendArgumentInt(pAtCommand, length, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM);
     }
 
     if (ret)
     {
-        ret = Calypso_AppendArgumentBytes(pAtCommand, data, bytesToWrite, CALYPSO_STRING_TERMINATE);
+        if (encodeAsBase64)
+        {
+            ret = Calypso_AppendArgumentBase64(pAtCommand, data, bytesToWrite, CALYPSO_STRING_TERMINATE, AT_MAX_COMMAND_BUFFER_SIZE);
+        }
+        else
+        {
+            ret = Calypso_AppendArgumentBytes(pAtCommand, data, bytesToWrite, CALYPSO_STRING_TERMINATE);
+        }
     }
 
     if (ret)
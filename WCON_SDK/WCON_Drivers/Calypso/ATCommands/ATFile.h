@@ -44,6 +44,38 @@
                                                                          (using ATFile_Write() and ATFile_Read()). Is limited
                                                                          to 750 bytes because of issues when using Base64 encoding. */
 
+/**
+ * @brief Size of the RAM block cache used by ATFile_ReadCached() in bytes (0 disables the cache).
+ *
+ * Cached blocks are invalidated when the file is opened for writing, written, closed after writing
+ * or deleted using the ATFile functions and when the module restarts. Files modified by other means
+ * (e.g. by the module's HTTP server) have to be invalidated using ATFile_InvalidateCache().
+ */
+#ifndef ATFILE_CACHE_SIZE
+#define ATFILE_CACHE_SIZE 0
+#endif
+
+/**
+ * @brief Size of a cache block in bytes.
+ */
+#ifndef ATFILE_CACHE_BLOCK_SIZE
+#define ATFILE_CACHE_BLOCK_SIZE 256
+#endif
+
+/**
+ * @brief Max. number of files with cached blocks. The least recently used file is evicted if exceeded.
+ */
+#ifndef ATFILE_CACHE_MAX_FILES
+#define ATFILE_CACHE_MAX_FILES 4
+#endif
+
+/**
+ * @brief Max. length of names of cached files (files with longer names are read without caching).
+ */
+#ifndef ATFILE_CACHE_MAX_FILENAME_LENGTH
+#define ATFILE_CACHE_MAX_FILENAME_LENGTH 64
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -112,10 +144,21 @@ typedef struct ATFile_FileListEntry_t
     uint32_t allocatedBlocks;                           /**< Allocated blocks */
 } ATFile_FileListEntry_t;
 
+/**
+ * @brief File list entry referencing the response or event text (see ATFile_ParseFileListEntryView()).
+ */
+typedef struct ATFile_FileListEntryView_t
+{
+    Calypso_StringView_t fileName;                      /**< File name */
+    uint32_t maxFileSize;                               /**< Max. size of file */
+    uint32_t properties;                                /**< File properties (see ATFile_FileProperties_t)  */
+    uint32_t allocatedBlocks;                           /**< Allocated blocks */
+} ATFile_FileListEntryView_t;
+
 
 extern bool ATFile_Open(const char *fileName,
                         uint32_t options,
-                        uint16_t fileSize,
+                        uint32_t fileSize,
                         uint32_t *fileID,
                         uint32_t *secureToken);
 extern bool ATFile_Close(uint32_t fileID, char *certFileName, char *signature);
@@ -137,8 +180,17 @@ extern bool ATFile_Write(uint32_t fileID,
 extern bool ATFile_GetInfo(const char *fileName,
                            uint32_t secureToken,
                            ATFile_FileInfo_t* fileInfo);
+extern bool ATFile_ReadCached(const char *fileName,
+                              uint16_t offset,
+                              uint16_t bytesToRead,
+                              char *data,
+                              uint16_t *bytesRead);
+extern void ATFile_InvalidateCache(const char *fileName);
+extern void ATFile_GetCacheStatistics(uint32_t *hits, uint32_t *misses);
 extern bool ATFile_GetFileList();
 extern bool ATFile_ParseFileListEntry(char **pInArguments, ATFile_FileListEntry_t* fileListEntry);
+extern bool ATFile_ParseFileListEntryView(char **pInArguments, ATFile_FileListEntryView_t* fileListEntry);
+extern bool ATFile_CopyFileListEntry(const ATFile_FileListEntryView_t *fileListEntry, ATFile_FileListEntry_t *copy);
 extern bool ATFile_PrintFileProperties(uint32_t properties, char *pOutStr, size_t maxLength);
 
 
@@ -121,6 +121,8 @@ static const char *ATHTTP_HeaderPersistency_Strings[ATHTTP_HeaderPersistency_Num
     "persistent"
 };
 
+static bool ATHTTP_AppendData(char *pAtCommand, bool encodeAsBase64, uint16_t length, const char *data);
+
 /**
  * @brief Creates an HTTP client.
  *
@@ -360,28 +362,6 @@ bool ATHTTP_SendRequest(uint8_t clientHandle,
         flags |= ATHTTP_RequestFlags_DropBody;
     }
 
-    if (encodeAsBase64)
-    {
-        /* Encode as Base64 */
-        uint32_t lengthEncoded = Calypso_GetBase64EncBufSize(length);
-        char base64Buffer[lengthEncoded];
-        Calypso_EncodeBase64((uint8_t *) data,
-                             length,
-                             (uint8_t *) base64Buffer,
-                             &lengthEncoded);
-
-        /* Recursively call ATHTTP_SendRequest() with the encoded binary data (excluding '\0') */
-        return ATHTTP_SendRequest(clientHandle,
-                                  method,
-                                  uri,
-                                  flags,
-                                  format,
-                                  false,
-                                  lengthEncoded - 1,
-                                  base64Buffer,
-                                  status);
-    }
-
     char *pRequestCommand = AT_commandBuffer;
     char *pRespondCommand = AT_commandBuffer;
     strcpy(pRequestCommand, "AT+httpSendReq=");
@@ -417,11 +397,7 @@ bool ATHTTP_SendRequest(uint8_t clientHandle,
     {
         return false;
     }
-    if (!Calypso_AppendArgumentInt(pRequestCommand, length, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM))
-    {
-        return false;
-    }
-    if (!Calypso_AppendArgumentBytes(pRequestCommand, data, length, CALYPSO_STRING_TERMINATE))
+    if (!ATHTTP_AppendData(pRequestCommand, encodeAsBase64, length, data))
     {
         return false;
     }
@@ -620,26 +596,6 @@ bool ATHTTP_SetHeader(uint8_t clientHandle,
                       uint16_t length,
                       const char *data)
 {
-    if (encodeAsBase64)
-    {
-        /* Encode as Base64 */
-        uint32_t lengthEncoded = Calypso_GetBase64EncBufSize(length);
-        char base64Buffer[lengthEncoded];
-        Calypso_EncodeBase64((uint8_t *) data,
-                             length,
-                             (uint8_t *) base64Buffer,
-                             &lengthEncoded);
-
-        /* Recursively call ATHTTP_SendRequest() with the encoded binary data (excluding '\0') */
-        return ATHTTP_SetHeader(clientHandle,
-                                field,
-                                persistency,
-                                format,
-                                false,
-                                lengthEncoded - 1,
-                                base64Buffer);
-    }
-
     char *pRequestCommand = AT_commandBuffer;
     strcpy(pRequestCommand, "AT+httpSetHeader=");
     if (!Calypso_AppendArgumentInt(pRequestCommand,
@@ -665,11 +621,7 @@ bool ATHTTP_SetHeader(uint8_t clientHandle,
     {
         return false;
     }
-    if (!Calypso_AppendArgumentInt(pRequestCommand, length, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM))
-    {
-        return false;
-    }
-    if (!Calypso_AppendArgumentBytes(pRequestCommand, data, length, CALYPSO_STRING_TERMINATE))
+    if (!ATHTTP_AppendData(pRequestCommand, encodeAsBase64, length, data))
     {
         return false;
     }
@@ -693,7 +645,7 @@ bool ATHTTP_SetHeader(uint8_t clientHandle,
  *                   causes the Calypso module to encode the data as Base64 before sending it to this device via UART.
  * @param[in] decodeBase64 Enables decoding of received Base64 data
  * @param[in] length Number of bytes to fetch
- * @param[out] header The returned header data
+ * @param[out] header The returned header data (references the response buffer, valid until the next request)
  *
  * @return true if successful, false otherwise
  */
@@ -768,49 +720,42 @@ bool ATHTTP_GetHeader(uint8_t clientHandle,
     {
         return false;
     }
+    uint16_t headerLength;
     if (!Calypso_GetNextArgumentInt(&pRespondCommand,
-                                    &header->length,
+                                    &headerLength,
                                     CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC,
                                     CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
 
-    if (header->length > 0)
+    if (!Calypso_GetNextArgumentView(&pRespondCommand, &header->data, CALYPSO_STRING_TERMINATE))
     {
-        if (decodeBase64)
-        {
-            uint32_t decodedSize = Calypso_GetBase64DecBufSize((uint8_t*) pRespondCommand, header->length);
+        return false;
+    }
 
-            if (decodedSize - 1 > length)
-            {
-                return false;
-            }
+    if (headerLength > header->data.length)
+    {
+        return false;
+    }
+    header->data.length = headerLength;
 
-            uint32_t encodedSize = header->length;
-            header->length = decodedSize - 1;
+    if (headerLength > 0 && decodeBase64)
+    {
+        /* Decode in place (decoded data is shorter than encoded data) */
+        uint8_t *pData = (uint8_t*) header->data.data;
+        uint32_t decodedSize = Calypso_GetBase64DecBufSize(pData, headerLength);
 
-            return Calypso_DecodeBase64((uint8_t*) pRespondCommand,
-                                        encodedSize,
-                                        (uint8_t*) header->data,
-                                        &decodedSize);
-        }
-        else
+        if (decodedSize - 1 > length)
         {
-            if (header->length > length)
-            {
-                return false;
-            }
-
-            return Calypso_GetNextArgumentString(&pRespondCommand,
-                                                 header->data,
-                                                 CALYPSO_STRING_TERMINATE,
-                                                 sizeof(header->data));
+            return false;
         }
+
+        header->data.length = decodedSize - 1;
+        return Calypso_DecodeBase64(pData, headerLength, pData, &decodedSize);
     }
 
-    header->data[0] = '\0';
-    return true;
+    return header->data.length <= length;
 }
 
 /**
@@ -831,34 +776,13 @@ bool ATHTTP_SendCustomResponse(Calypso_DataFormat_t format,
                                uint16_t length,
                                const char *data)
 {
-    if (encodeAsBase64)
-    {
-        /* Encode as Base64 */
-        uint32_t lengthEncoded = Calypso_GetBase64EncBufSize(length);
-        char base64Buffer[lengthEncoded];
-        Calypso_EncodeBase64((uint8_t *) data,
-                             length,
-                             (uint8_t *) base64Buffer,
-                             &lengthEncoded);
-
-        /* Recursively call ATHTTP_SendCustomResponse() with the encoded binary data (excluding '\0') */
-        return ATHTTP_SendCustomResponse(format,
-                                         false,
-                                         lengthEncoded - 1,
-                                         base64Buffer);
-    }
-
     char *pRequestCommand = AT_commandBuffer;
     strcpy(pRequestCommand, "AT+httpCustomResponse=");
     if (!Calypso_AppendArgumentInt(pRequestCommand, format, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
-    if (!Calypso_AppendArgumentInt(pRequestCommand, length, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM))
-    {
-        return false;
-    }
-    if (!Calypso_AppendArgumentBytes(pRequestCommand, data, length, CALYPSO_STRING_TERMINATE))
+    if (!ATHTTP_AppendData(pRequestCommand, encodeAsBase64, length, data))
     {
         return false;
     }
@@ -872,3 +796,28 @@ bool ATHTTP_SendCustomResponse(Calypso_DataFormat_t format,
     }
     return Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_General), Calypso_CNFStatus_Success, NULL);
 }
+
+/**
+ * @brief Appends the length and data arguments to an AT command string.
+ *
+ * If encodeAsBase64 is true, the data is encoded directly into the command string and the
+ * length of the encoded data is used as length argument.
+ *
+ * @param[out] pAtCommand The AT command string to add the arguments to
+ * @param[in] encodeAsBase64 Encode the data in Base64 format
+ * @param[in] length Number of data bytes
+ * @param[in] data Data to be added
+ *
+ * @return true if successful, false otherwise
+ */
+static bool ATHTTP_AppendData(char *pAtCommand, bool encodeAsBase64, uint16_t length, const char *data)
+{
+    if (encodeAsBase64)
+    {
+        return Calypso_AppendArgumentInt(pAtCommand, Calypso_GetBase64EncBufSize(length) - 1, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) &&
+               Calypso_AppendArgumentBase64(pAtCommand, data, length, CALYPSO_STRING_TERMINATE, AT_MAX_COMMAND_BUFFER_SIZE);
+    }
+
+    return Calypso_AppendArgumentInt(pAtCommand, length, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) &&
+           Calypso_AppendArgumentBytes(pAtCommand, data, length, CALYPSO_STRING_TERMINATE);
+}
@@ -37,7 +37,6 @@
 #include "ATSocket.h"
 
 #define ATHTTP_RECEIVE_BUFFER_SIZE CALYPSO_RECEIVE_BUFFER_SIZE
-#define ATHTTP_RECEIVE_HEADER_SIZE CALYPSO_RECEIVE_BUFFER_SIZE
 
 #ifdef __cplusplus
 extern "C" {
@@ -195,6 +194,9 @@ typedef struct ATHTTP_ResponseBody_t
 /**
  * @brief Stores HTTP header data.
  *
+ * The header data references the response buffer, i.e. it is only valid until the next
+ * request is sent to the module. Use Calypso_ViewToString() to retain the data.
+ *
  * @see ATHTTP_GetHeader()
  */
 typedef struct ATHTTP_HeaderData_t
@@ -210,14 +212,9 @@ typedef struct ATHTTP_HeaderData_t
     Calypso_DataFormat_t format;
 
     /**
-     * @brief Number of bytes in header data buffer.
-     */
-    uint16_t length;
-
-    /**
-     * @brief Header data.
+     * @brief Header data (data.length is the number of bytes in the header data).
      */
-    char data[ATHTTP_RECEIVE_HEADER_SIZE];
+    Calypso_StringView_t data;
 } ATHTTP_HeaderData_t;
 
 extern bool ATHTTP_Create(uint8_t *clientHandle);
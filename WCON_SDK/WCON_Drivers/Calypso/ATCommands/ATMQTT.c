@@ -84,11 +84,10 @@ static bool ATMQTT_AddArgumentsCreate(char *pAtCommand,
                                       ATMQTT_ConnectionParams_t connectionParams);
 static bool ATMQTT_AddArgumentsPublish(char *pAtCommand,
                                        uint8_t index,
-                                       char *topic,
+                                       const char *topic,
                                        ATMQTT_QoS_t QoS,
                                        uint8_t retain,
-                                       uint16_t messageLength,
-                                       char *pMessage);
+                                       uint16_t messageLength);
 static bool ATMQTT_AddArgumentsSubscribe(char *pAtCommand,
                                          uint8_t index,
                                          uint8_t numOfTopics,
@@ -262,24 +261,41 @@ bool ATMQTT_Disconnect(uint8_t index)
  */
 bool ATMQTT_Publish(uint8_t index, char *topic, ATMQTT_QoS_t QoS, uint8_t retain, uint16_t messageLength, char *pMessage)
 {
-    bool ret = false;
+    if (!ATMQTT_SendPublish(index, topic, QoS, retain, messageLength, pMessage))
+    {
+        return false;
+    }
 
+    return Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_General), Calypso_CNFStatus_Success, NULL);
+}
+
+/**
+ * @brief Sends the AT+MQTTpublish command without waiting for the confirmation.
+ *
+ * The message is transmitted directly from the supplied buffer (i.e. it is not copied to the
+ * command buffer and may contain binary data). Use Calypso_WaitForConfirm() or Calypso_PollConfirm()
+ * to get the result before sending the next command.
+ *
+ * @param[in] index Index (handle) of the MQTT client to use.
+ * @param[in] topic Topic to be published
+ * @param[in] retain Retain the message (1) or do not retain the message (0)
+ * @param[in] messageLength Length of the message
+ * @param[in] pMessage Message to publish
+ *
+ * @return true if successful, false otherwise
+ */
+bool ATMQTT_SendPublish(uint8_t index, const char *topic, ATMQTT_QoS_t QoS, uint8_t retain, uint16_t messageLength, const char *pMessage)
+{
     char *pRequestCommand = AT_commandBuffer;
 
     strcpy(pRequestCommand, "AT+mqttPublish=");
 
-    ret = ATMQTT_AddArgumentsPublish(pRequestCommand, index, topic, QoS, retain, messageLength, pMessage);
-
-    if (ret)
+    if (!ATMQTT_AddArgumentsPublish(pRequestCommand, index, topic, QoS, retain, messageLength))
     {
-        if (!Calypso_SendRequest(pRequestCommand))
-        {
-            return false;
-        }
-        ret = Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_General), Calypso_CNFStatus_Success, NULL);
+        return false;
     }
 
-    return ret;
+    return Calypso_SendRequestWithData(pRequestCommand, (const uint8_t *) pMessage, messageLength);
 }
 
 /**
@@ -482,24 +498,26 @@ static bool ATMQTT_AddArgumentsCreate(char *pAtCommand,
 }
 
 /**
- * @brief Adds arguments to the AT+MQTTpublish command string.
+ * @brief Adds arguments to the AT+MQTTpublish command string (excluding the message).
+ *
+ * The command ends with the delimiter preceding the message. If messageLength is 0,
+ * the command is terminated with "\r\n".
  *
  * @param[in] pAtCommand The AT command string to add the arguments to
- * @param[in] index Index (handle) of MQTT client.
+ * @param[in] index Index (handle) of MQTT client to use.
  * @param[in] topic Topic to be published
+ * @param[in] QoS Quality of service
  * @param[in] retain Retain the message (1) or do not retain the message (0)
  * @param[in] messageLength Length of the message
- * @param[in] pMessage Message to publish
  *
  * @return true if successful, false otherwise
 */
 static bool ATMQTT_AddArgumentsPublish(char *pAtCommand,
                                        uint8_t index,
-                                       char *topic,
+                                       const char *topic,
                                        ATMQTT_QoS_t QoS,
                                        uint8_t retain,
-                                       uint16_t messageLength,
-                                       char *pMessage)
+                                       uint16_t messageLength)
 {
     bool ret = false;
 
@@ -525,12 +543,7 @@ static bool ATMQTT_AddArgumentsPublish(char *pAtCommand,
         ret = Calypso_AppendArgumentInt(pAtCommand, messageLength, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM);
     }
 
-    if (ret)
-    {
-        ret = Calypso_AppendArgumentBytes(pAtCommand, pMessage, messageLength, CALYPSO_STRING_TERMINATE);
-    }
-
-    if (ret)
+    if (ret && 0 == messageLength)
     {
         ret = Calypso_AppendArgumentString(pAtCommand, CALYPSO_CRLF, CALYPSO_STRING_TERMINATE);
     }
@@ -187,6 +187,12 @@ extern bool ATMQTT_Publish(uint8_t index,
                            uint8_t retain,
                            uint16_t messageLength,
                            char *pMessage);
+extern bool ATMQTT_SendPublish(uint8_t index,
+                               const char *topic,
+                               ATMQTT_QoS_t QoS,
+                               uint8_t retain,
+                               uint16_t messageLength,
+                               const char *pMessage);
 extern bool ATMQTT_Subscribe(uint8_t index,
                              uint8_t numOfTopics,
                              ATMQTT_SubscribeTopic_t *pTopics);
@@ -93,10 +93,10 @@ typedef enum ATNetCfg_IPv6Method_t
 typedef struct ATNetCfg_IPv4Config_t
 {
     ATNetCfg_IPv4Method_t method;
-    char ipAddress[15];
-    char subnetMask[15];
-    char gatewayAddress[15];
-    char dnsAddress[15];
+    char ipAddress[16];
+    char subnetMask[16];
+    char gatewayAddress[16];
+    char dnsAddress[16];
 } ATNetCfg_IPv4Config_t;
 
 /**
@@ -132,6 +132,7 @@ static bool ATSocket_AddArgumentsSendTo(char *pAtCommand,
                                         uint8_t socketID,
                                         ATSocket_Descriptor_t *remoteSocket,
                                         Calypso_DataFormat_t format,
+                                        bool encodeAsBase64,
                                         uint16_t length,
                                         char *data);
 static bool ATSocket_AddArgumentsSetSockOpt(char *pAtCommand,
@@ -495,58 +496,19 @@ bool ATSocket_SendTo(uint8_t socketID,
 {
     *bytesSent = 0;
 
-    if (encodeAsBase64)
-    {
-        /* Base64 encoded data might exceed the max. chunk size. To limit the required buffer size,
-         * the data is encoded in chunks, if necessary. */
-
-        uint16_t maxChunkSize = (((CALYPSO_MAX_PAYLOAD_SIZE - 1) * 3) / 4) - 2;
-        uint16_t chunkSize = 0;
-        for (uint16_t chunkOffset = 0; chunkOffset < length; chunkOffset += chunkSize)
-        {
-            chunkSize = length - chunkOffset;
-            if (chunkSize > maxChunkSize)
-            {
-                chunkSize = maxChunkSize;
-            }
-
-            /* Encode as Base64 */
-            uint32_t lengthEncoded = Calypso_GetBase64EncBufSize(chunkSize);
-            char base64Buffer[lengthEncoded];
-            Calypso_EncodeBase64((uint8_t *) data + chunkOffset,
-                                 chunkSize,
-                                 (uint8_t *) base64Buffer,
-                                 &lengthEncoded);
-
-            /* Recursively call ATSocket_Send() with the encoded binary data (excluding '\0') */
-            uint16_t chunkBytesWritten = 0;
-            bool ok = ATSocket_SendTo(socketID,
-                                      remoteSocket,
-                                      format,
-                                      false,
-                                      lengthEncoded - 1,
-                                      base64Buffer,
-                                      &chunkBytesWritten);
-            if (!ok)
-            {
-                return false;
-            }
-
-            *bytesSent += chunkSize;
-        }
-
-       return true;
-    }
-
     /* Send data using either AT+send or AT+sendTo, splitting the payload into
-     * chunks of max. CALYPSO_MAX_PAYLOAD_SIZE, if necessary. */
+     * chunks of max. CALYPSO_MAX_PAYLOAD_SIZE, if necessary. Base64 encoded data is
+     * larger than the raw data, so the raw chunk size is reduced accordingly (the data
+     * is encoded directly into the command buffer). */
+    uint16_t maxChunkSize = encodeAsBase64 ? (((CALYPSO_MAX_PAYLOAD_SIZE - 1) * 3) / 4) - 2 : CALYPSO_MAX_PAYLOAD_SIZE;
+
     uint16_t chunkBytesSent = 0;
     for (uint16_t chunkOffset = 0; chunkOffset < length; chunkOffset += chunkBytesSent)
     {
         uint16_t chunkSize = length - chunkOffset;
-        if (chunkSize > CALYPSO_MAX_PAYLOAD_SIZE)
+        if (chunkSize > maxChunkSize)
         {
-            chunkSize = CALYPSO_MAX_PAYLOAD_SIZE;
+            chunkSize = maxChunkSize;
         }
 
         char *pRequestCommand = AT_commandBuffer;
@@ -566,6 +528,7 @@ bool ATSocket_SendTo(uint8_t socketID,
                                          socketID,
                                          remoteSocket,
                                          format,
+                                         encodeAsBase64,
                                          chunkSize,
                                          data + chunkOffset))
         {
@@ -894,6 +857,7 @@ static bool ATSocket_AddArgumentsRecvFrom(char *pAtCommand,
  * @param[in] socketID ID of the local socket via which the data should be sent
  * @param[in] remoteSocket Remote socket to which the data should be sent. Optional (to be used with AT+sendTo).
  * @param[in] format Format in which the data is provided
+ * @param[in] encodeAsBase64 Encode the data in Base64 format (directly into the command string)
  * @param[in] length Number of bytes to be sent
  * @param[in] data Data to be sent
  *
@@ -903,6 +867,7 @@ static bool ATSocket_AddArgumentsSendTo(char *pAtCommand,
                                         uint8_t socketID,
                                         ATSocket_Descriptor_t *remoteSocket,
                                         Calypso_DataFormat_t format,
+                                        bool encodeAsBase64,
                                         uint16_t length,
                                         char *data)
 {
@@ -929,14 +894,21 @@ static bool ATSocket_AddArgumentsSendTo(char *pAtCommand,
         return false;
     }
 
-    if (!Calypso_AppendArgumentInt(pAtCommand, length, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM))
+    if (encodeAsBase64)
     {
-        return false;
+        if (!Calypso_AppendArgumentInt(pAtCommand, Calypso_GetBase64EncBufSize(length) - 1, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+            !Calypso_AppendArgumentBase64(pAtCommand, data, length, CALYPSO_STRING_TERMINATE, AT_MAX_COMMAND_BUFFER_SIZE))
+        {
+            return false;
+        }
     }
-
-    if (!Calypso_AppendArgumentBytes(pAtCommand, data, length, CALYPSO_STRING_TERMINATE))
+    else
     {
-        return false;
+        if (!Calypso_AppendArgumentInt(pAtCommand, length, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+            !Calypso_AppendArgumentBytes(pAtCommand, data, length, CALYPSO_STRING_TERMINATE))
+        {
+            return false;
+        }
     }
 
     return Calypso_AppendArgumentString(pAtCommand, CALYPSO_CRLF, CALYPSO_STRING_TERMINATE);
@@ -1116,7 +1088,7 @@ bool ATSocket_ParseResponseGetOptions(ATSocket_SockOptLevel_t level,
     const char *expectedCmd = "+getsockopt:";
     const size_t cmdLength = strlen(expectedCmd);
 
-    char tempString[50];
+    Calypso_StringView_t argument;
 
     /* Check if response is for getSockOpt */
     if (0 != strncmp(*pAtCommand, expectedCmd, cmdLength))
@@ -1161,10 +1133,10 @@ bool ATSocket_ParseResponseGetOptions(ATSocket_SockOptLevel_t level,
             break;
 
         case ATSocket_SockOptSocket_SecMethod:
-            ret = Calypso_GetNextArgumentString(pAtCommand, tempString, CALYPSO_STRING_TERMINATE, sizeof(tempString));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_STRING_TERMINATE);
             if (ret)
             {
-                pValues->secMethod = Calypso_FindString(AtSocketSockOptSecMethod, ATSocket_SockOptSecMethod_NumberOfValues, tempString, ATSocket_SockOptSecMethod_SSLv3, &ret);
+                pValues->secMethod = Calypso_FindView(AtSocketSockOptSecMethod, ATSocket_SockOptSecMethod_NumberOfValues, argument, ATSocket_SockOptSecMethod_SSLv3, &ret);
             }
             break;
 
@@ -1246,6 +1218,21 @@ bool ATSocket_ParseSocketFamily(const char *familyString, ATSocket_Family_t *pOu
     return ok;
 }
 
+/**
+ * @brief Parses a string view to ATSocket_Family_t.
+ *
+ * @param[in] familyString View of string representing the socket family
+ * @param[out] pOutFamily The parsed socket family
+ *
+ * @return true if successful, false otherwise
+ */
+bool ATSocket_ParseSocketFamilyView(Calypso_StringView_t familyString, ATSocket_Family_t *pOutFamily)
+{
+    bool ok;
+    *pOutFamily = Calypso_FindView(ATSocketFamilyString, ATSocket_Family_NumberOfValues, familyString, ATSocket_Family_INET, &ok);
+    return ok;
+}
+
 /**
  * @brief Returns the string representation of the supplied socket family.
  *
@@ -261,6 +261,8 @@ extern bool ATSocket_SendTo(uint8_t socketID,
 
 extern bool ATSocket_ParseSocketFamily(const char *familyString,
                                        ATSocket_Family_t *pOutFamily);
+extern bool ATSocket_ParseSocketFamilyView(Calypso_StringView_t familyString,
+                                           ATSocket_Family_t *pOutFamily);
 extern bool ATSocket_GetSocketFamilyString(ATSocket_Family_t family, char *pOutFamilyStr);
 
 extern bool ATSocket_AppendSocketDescriptor(char *pAtCommand, ATSocket_Descriptor_t socket, char lastDelim);
@@ -213,6 +213,29 @@ static bool ATWLAN_ParseResponseWlanGet(ATWLAN_SetID_t id, uint8_t option, char
 
 static bool ATWLAN_SendPolicyGet(ATWLAN_PolicyID_t id, char **pRespondCommand);
 
+static void ATWLAN_ScanResponseLineCallback(char *line, uint16_t length, void *context);
+static void ATWLAN_ScanStoreEntry(const ATWLAN_ScanEntry_t *scanEntry, void *context);
+
+/**
+ * @brief Scan state used for parsing AT+wlanScan response lines as they are received.
+ */
+typedef struct ATWLAN_ScanState_t
+{
+    ATWLAN_ScanEntryCallback_t callback;    /**< Function to be called for each received scan entry */
+    void *context;                          /**< Context pointer passed to callback */
+    volatile uint8_t numEntries;            /**< Number of entries received */
+} ATWLAN_ScanState_t;
+
+/**
+ * @brief Output array used by ATWLAN_Scan().
+ */
+typedef struct ATWLAN_ScanOutput_t
+{
+    ATWLAN_ScanEntry_t *pValues;            /**< Array receiving the scan entries */
+    uint8_t maxEntries;                     /**< Size of array */
+    uint8_t numEntries;                     /**< Number of entries stored */
+} ATWLAN_ScanOutput_t;
+
 
 /**
  * @brief Sets the wireless LAN mode (using the AT+wlanSetMode command).
@@ -271,7 +294,6 @@ bool ATWLAN_Scan(uint8_t index, uint8_t deviceCount, ATWLAN_ScanEntry_t *pOutVal
     if ((index < 30) && (deviceCount < 30))
     {
         char *pRequestCommand = AT_commandBuffer;
-        char *pRespondCommand = AT_commandBuffer;
 
         strcpy(pRequestCommand, "AT+wlanScan=");
 
@@ -289,30 +311,96 @@ bool ATWLAN_Scan(uint8_t index, uint8_t deviceCount, ATWLAN_ScanEntry_t *pOutVal
 
         if (ret)
         {
+            /* Entries are parsed into pOutValues as they are received */
+            ATWLAN_ScanOutput_t output = {pOutValues, deviceCount, 0};
+            ATWLAN_ScanState_t state = {ATWLAN_ScanStoreEntry, &output, 0};
+            Calypso_SetResponseLineCallback(ATWLAN_ScanResponseLineCallback, &state);
             if (!Calypso_SendRequest(pRequestCommand))
             {
+                Calypso_SetResponseLineCallback(NULL, NULL);
                 return false;
             }
-            ret = Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_WlanScan), Calypso_CNFStatus_Success, pRespondCommand);
-        }
-
-        if (ret)
-        {
-            uint8_t numEntries = 0;
-            for (int i = 0; i < deviceCount; i++)
+            ret = Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_WlanScan), Calypso_CNFStatus_Success, NULL);
+            if (ret)
             {
-                if (ATWLAN_ParseResponseWlanScanEntry(&pRespondCommand, &pOutValues[numEntries]))
-                {
-                    numEntries++;
-                }
+                *pOutNumEntries = output.numEntries;
             }
-            *pOutNumEntries = numEntries;
         }
     }
 
     return ret;
 }
 
+/**
+ * @brief Initiates a WLAN scan (using the AT+wlanScan command), passing each scan entry to
+ * the supplied callback as soon as it has been received.
+ *
+ * In contrast to ATWLAN_Scan(), no array of entries needs to be provided by the caller.
+ *
+ * Note that when calling this function for the first time, an error is returned, as the module responds
+ * with SL_ERROR_WLAN_GET_NETWORK_LIST_EAGAIN (-2073).
+ *
+ * @param[in] index Starting index (0 to ATWLAN_SCAN_MAX_ENTRIES - 1)
+ * @param[in] deviceCount Max. number of entries to get (max. ATWLAN_SCAN_MAX_ENTRIES)
+ * @param[in] callback Function to be called for each received scan entry (from interrupt context)
+ * @param[in] context Context pointer passed to the callback
+ * @param[out] pOutNumEntries Number of entries the module has returned (optional, may be NULL)
+ *
+ * @return true if successful, false otherwise
+ */
+bool ATWLAN_ScanStreamed(uint8_t index,
+                         uint8_t deviceCount,
+                         ATWLAN_ScanEntryCallback_t callback,
+                         void *context,
+                         uint8_t *pOutNumEntries)
+{
+    if ((index >= ATWLAN_SCAN_MAX_ENTRIES) || (deviceCount > ATWLAN_SCAN_MAX_ENTRIES) || (NULL == callback))
+    {
+        return false;
+    }
+
+    char *pRequestCommand = AT_commandBuffer;
+
+    strcpy(pRequestCommand, "AT+wlanScan=");
+
+    bool ret = Calypso_AppendArgumentInt(pRequestCommand, index, (CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC), CALYPSO_ARGUMENT_DELIM);
+
+    if (ret)
+    {
+        ret = Calypso_AppendArgumentInt(pRequestCommand, deviceCount, (CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC), CALYPSO_STRING_TERMINATE);
+    }
+
+    if (ret)
+    {
+        ret = Calypso_AppendArgumentString(pRequestCommand, CALYPSO_CRLF, CALYPSO_STRING_TERMINATE);
+    }
+
+    if (!ret)
+    {
+        return false;
+    }
+
+    ATWLAN_ScanState_t state = {callback, context, 0};
+    Calypso_SetResponseLineCallback(ATWLAN_ScanResponseLineCallback, &state);
+
+    ret = Calypso_SendRequest(pRequestCommand);
+    if (ret)
+    {
+        ret = Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_WlanScan), Calypso_CNFStatus_Success, NULL);
+    }
+    else
+    {
+        Calypso_SetResponseLineCallback(NULL, NULL);
+    }
+
+    if (NULL != pOutNumEntries)
+    {
+        *pOutNumEntries = state.numEntries;
+    }
+
+    return ret;
+}
+
 /**
  * @brief Connects to a wireless network (using the AT+wlanConnect command).
  *
@@ -705,14 +793,14 @@ bool ATWLAN_GetScanPolicy(ATWLAN_PolicyScan_t *policy, uint32_t *scanIntervalSec
         return false;
     }
 
-    char temp[15];
-    if (!Calypso_GetNextArgumentString(&pRespondCommand, temp, CALYPSO_ARGUMENT_DELIM, sizeof(temp)))
+    Calypso_StringView_t argument;
+    if (!Calypso_GetNextArgumentView(&pRespondCommand, &argument, CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
 
     bool ok;
-    *policy = Calypso_FindString(ATWLAN_PolicyScanStrings, ATWLAN_PolicyScan_NumberOfValues, temp, ATWLAN_PolicyScan_DisableScan, &ok);
+    *policy = Calypso_FindView(ATWLAN_PolicyScanStrings, ATWLAN_PolicyScan_NumberOfValues, argument, ATWLAN_PolicyScan_DisableScan, &ok);
     if (!ok)
     {
         return false;
@@ -778,14 +866,14 @@ bool ATWLAN_GetPMPolicy(ATWLAN_PolicyPM_t *policy, uint32_t *maxSleepTimeMs)
         return false;
     }
 
-    char temp[15];
-    if (!Calypso_GetNextArgumentString(&pRespondCommand, temp, CALYPSO_ARGUMENT_DELIM, sizeof(temp)))
+    Calypso_StringView_t argument;
+    if (!Calypso_GetNextArgumentView(&pRespondCommand, &argument, CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
 
     bool ok;
-    *policy = Calypso_FindString(ATWLAN_PolicyPMStrings, ATWLAN_PolicyPM_NumberOfValues, temp, ATWLAN_PolicyPM_Normal, &ok);
+    *policy = Calypso_FindView(ATWLAN_PolicyPMStrings, ATWLAN_PolicyPM_NumberOfValues, argument, ATWLAN_PolicyPM_Normal, &ok);
     if (!ok)
     {
         return false;
@@ -851,25 +939,25 @@ bool ATWLAN_GetP2PPolicy(ATWLAN_PolicyP2P_t *policy, ATWLAN_PolicyP2PValue_t *va
         return false;
     }
 
-    char temp[15];
-    if (!Calypso_GetNextArgumentString(&pRespondCommand, temp, CALYPSO_ARGUMENT_DELIM, sizeof(temp)))
+    Calypso_StringView_t argument;
+    if (!Calypso_GetNextArgumentView(&pRespondCommand, &argument, CALYPSO_ARGUMENT_DELIM))
     {
         return false;
     }
 
     bool ok;
-    *policy = Calypso_FindString(ATWLAN_PolicyP2PStrings, ATWLAN_PolicyP2P_NumberOfValues, temp, ATWLAN_PolicyP2P_Negotiate, &ok);
+    *policy = Calypso_FindView(ATWLAN_PolicyP2PStrings, ATWLAN_PolicyP2P_NumberOfValues, argument, ATWLAN_PolicyP2P_Negotiate, &ok);
     if (!ok)
     {
         return false;
     }
 
-    if (!Calypso_GetNextArgumentString(&pRespondCommand, temp, CALYPSO_STRING_TERMINATE, sizeof(temp)))
+    if (!Calypso_GetNextArgumentView(&pRespondCommand, &argument, CALYPSO_STRING_TERMINATE))
     {
         return false;
     }
 
-    *value = Calypso_FindString(ATWLAN_PolicyP2PValue_Strings, ATWLAN_PolicyP2PValue_NumberOfValues, temp, ATWLAN_PolicyP2PValue_Active, &ok);
+    *value = Calypso_FindView(ATWLAN_PolicyP2PValue_Strings, ATWLAN_PolicyP2PValue_NumberOfValues, argument, ATWLAN_PolicyP2PValue_Active, &ok);
     return ok;
 }
 
@@ -1281,7 +1369,7 @@ static bool ATWLAN_ParseResponseWlanScanEntry(char **pAtCommand, ATWLAN_ScanEntr
 
     const char *expectedCmd = "+wlanscan:";
     const size_t cmdLength = strlen(expectedCmd);
-    char tempString[32];
+    Calypso_StringView_t argument;
 
     /* Check if response is for wlanscan */
     ret = (0 == strncmp(*pAtCommand, expectedCmd, cmdLength));
@@ -1307,14 +1395,14 @@ static bool ATWLAN_ParseResponseWlanScanEntry(char **pAtCommand, ATWLAN_ScanEntr
 
         if (ret)
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
-                pOutScanEntry->securityType = Calypso_FindString(ATWLAN_ScanSecurityTypeStrings,
-                                                                 ATWLAN_ScanSecurityType_NumberOfValues,
-                                                                 tempString,
-                                                                 ATWLAN_ScanSecurityType_Open,
-                                                                 &ret);
+                pOutScanEntry->securityType = Calypso_FindView(ATWLAN_ScanSecurityTypeStrings,
+                                                               ATWLAN_ScanSecurityType_NumberOfValues,
+                                                               argument,
+                                                               ATWLAN_ScanSecurityType_Open,
+                                                               &ret);
             }
         }
 
@@ -1325,27 +1413,27 @@ static bool ATWLAN_ParseResponseWlanScanEntry(char **pAtCommand, ATWLAN_ScanEntr
 
         if (ret)
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
-                pOutScanEntry->cipher = Calypso_FindString(ATWLAN_ScanCipherStrings,
-                                                           ATWLAN_ScanCipherType_NumberOfValues,
-                                                           tempString,
-                                                           ATWLAN_ScanCipherType_None,
-                                                           &ret);
+                pOutScanEntry->cipher = Calypso_FindView(ATWLAN_ScanCipherStrings,
+                                                         ATWLAN_ScanCipherType_NumberOfValues,
+                                                         argument,
+                                                         ATWLAN_ScanCipherType_None,
+                                                         &ret);
             }
         }
 
         if (ret)
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, tempString, CALYPSO_STRING_TERMINATE, sizeof(tempString));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_STRING_TERMINATE);
             if (ret)
             {
-                pOutScanEntry->keyManagementMethod = Calypso_FindString(ATWLAN_ScanKeyMgmntStrings,
-                                                                        ATWLAN_ScanKeyManagementType_NumberOfValues,
-                                                                        tempString,
-                                                                        ATWLAN_ScanKeyManagementType_None,
-                                                                        &ret);
+                pOutScanEntry->keyManagementMethod = Calypso_FindView(ATWLAN_ScanKeyMgmntStrings,
+                                                                      ATWLAN_ScanKeyManagementType_NumberOfValues,
+                                                                      argument,
+                                                                      ATWLAN_ScanKeyManagementType_None,
+                                                                      &ret);
             }
         }
     }
@@ -1353,6 +1441,46 @@ static bool ATWLAN_ParseResponseWlanScanEntry(char **pAtCommand, ATWLAN_ScanEntr
     return ret;
 }
 
+/**
+ * @brief Response line callback used by ATWLAN_Scan() and ATWLAN_ScanStreamed().
+ *
+ * Parses a "+wlanscan:" line and passes the entry to the scan entry callback.
+ *
+ * @param[in] line Received line
+ * @param[in] length Length of received line
+ * @param[in] context Scan state (ATWLAN_ScanState_t)
+ */
+static void ATWLAN_ScanResponseLineCallback(char *line, uint16_t length, void *context)
+{
+    ATWLAN_ScanState_t *state = (ATWLAN_ScanState_t *) context;
+    ATWLAN_ScanEntry_t scanEntry;
+    char *pLine = line;
+
+    (void) length;
+
+    if (ATWLAN_ParseResponseWlanScanEntry(&pLine, &scanEntry))
+    {
+        state->numEntries++;
+        state->callback(&scanEntry, state->context);
+    }
+}
+
+/**
+ * @brief Scan entry callback used by ATWLAN_Scan() - stores the entry in the output array.
+ *
+ * @param[in] scanEntry Received scan entry
+ * @param[in] context Output array (ATWLAN_ScanOutput_t)
+ */
+static void ATWLAN_ScanStoreEntry(const ATWLAN_ScanEntry_t *scanEntry, void *context)
+{
+    ATWLAN_ScanOutput_t *output = (ATWLAN_ScanOutput_t *) context;
+    if (output->numEntries < output->maxEntries)
+    {
+        memcpy(&output->pValues[output->numEntries], scanEntry, sizeof(ATWLAN_ScanEntry_t));
+        output->numEntries++;
+    }
+}
+
 
 /**
  * @brief Parses the response of a AT+wlanProfileAdd command.
@@ -1394,7 +1522,7 @@ static bool ATWLAN_ParseResponseWlanGetProfile(char **pAtCommand, ATWLAN_Profile
     const char *expectedCmd = "+wlanprofileget:";
     const size_t cmdLength = strlen(expectedCmd);
 
-    char tempString[32];
+    Calypso_StringView_t argument;
 
     /* Check if response is for get profile */
     ret = (0 == strncmp(*pAtCommand, expectedCmd, cmdLength));
@@ -1410,20 +1538,20 @@ static bool ATWLAN_ParseResponseWlanGetProfile(char **pAtCommand, ATWLAN_Profile
 
         if (ret)
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
-                if (tempString[0] == '\0')
+                if (argument.length == 0)
                 {
                     pOutProfile->connection.securityParams.securityType = ATWLAN_SecurityType_Open;
                 }
                 else
                 {
-                    pOutProfile->connection.securityParams.securityType = Calypso_FindString(ATWLAN_SecurityTypeStrings,
-                                                                                             ATWLAN_SecurityType_NumberOfValues,
-                                                                                             tempString,
-                                                                                             ATWLAN_SecurityType_Open,
-                                                                                             &ret);
+                    pOutProfile->connection.securityParams.securityType = Calypso_FindView(ATWLAN_SecurityTypeStrings,
+                                                                                           ATWLAN_SecurityType_NumberOfValues,
+                                                                                           argument,
+                                                                                           ATWLAN_SecurityType_Open,
+                                                                                           &ret);
                 }
             }
         }
@@ -1445,20 +1573,20 @@ static bool ATWLAN_ParseResponseWlanGetProfile(char **pAtCommand, ATWLAN_Profile
 
         if (ret)
         {
-            ret = Calypso_GetNextArgumentString(pAtCommand, tempString, CALYPSO_ARGUMENT_DELIM, sizeof(tempString));
+            ret = Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_ARGUMENT_DELIM);
             if (ret)
             {
-                if (tempString[0] == '\0')
+                if (argument.length == 0)
                 {
                     pOutProfile->connection.securityExtParams.eapMethod = ATWLAN_SecurityEAP_None;
                 }
                 else
                 {
-                    pOutProfile->connection.securityExtParams.eapMethod = Calypso_FindString(ATWLAN_SecurityEAPStrings,
-                                                                                             ATWLAN_SecurityEAP_NumberOfValues,
-                                                                                             tempString,
-                                                                                             ATWLAN_SecurityEAP_None,
-                                                                                             &ret);
+                    pOutProfile->connection.securityExtParams.eapMethod = Calypso_FindView(ATWLAN_SecurityEAPStrings,
+                                                                                           ATWLAN_SecurityEAP_NumberOfValues,
+                                                                                           argument,
+                                                                                           ATWLAN_SecurityEAP_None,
+                                                                                           &ret);
                 }
             }
         }
@@ -1492,7 +1620,7 @@ static bool ATWLAN_ParseResponseWlanGet(ATWLAN_SetID_t id,
     const char *expectedCmd = "+wlanget:";
     const size_t cmdLength = strlen(expectedCmd);
 
-    char tempString[32];
+    Calypso_StringView_t argument;
 
     /* Check if response is for wlanget */
     ret = (0 == strncmp(*pAtCommand, expectedCmd, cmdLength));
@@ -1571,44 +1699,43 @@ static bool ATWLAN_ParseResponseWlanGet(ATWLAN_SetID_t id,
 
         case ATWLAN_SetID_Connection:
         {
-            char temp[32];
-            if (!Calypso_GetNextArgumentString(pAtCommand, temp, CALYPSO_ARGUMENT_DELIM, sizeof(temp)))
+            if (!Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_ARGUMENT_DELIM))
             {
                 return false;
             }
-            pValues->connection.role = Calypso_FindString(ATWLAN_SetModeStrings,
-                                                          ATWLAN_SetMode_NumberOfValues,
-                                                          temp,
-                                                          ATWLAN_SetMode_Station,
-                                                          &ret);
+            pValues->connection.role = Calypso_FindView(ATWLAN_SetModeStrings,
+                                                        ATWLAN_SetMode_NumberOfValues,
+                                                        argument,
+                                                        ATWLAN_SetMode_Station,
+                                                        &ret);
             if (!ret)
             {
                 return false;
             }
 
-            if (!Calypso_GetNextArgumentString(pAtCommand, temp, CALYPSO_ARGUMENT_DELIM, sizeof(temp)))
+            if (!Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_ARGUMENT_DELIM))
             {
                 return false;
             }
-            pValues->connection.status = Calypso_FindString(ATWLAN_StatusStrings,
-                                                            ATWLAN_Status_NumberOfValues,
-                                                            temp,
-                                                            ATWLAN_Status_Disconnected,
-                                                            &ret);
+            pValues->connection.status = Calypso_FindView(ATWLAN_StatusStrings,
+                                                          ATWLAN_Status_NumberOfValues,
+                                                          argument,
+                                                          ATWLAN_Status_Disconnected,
+                                                          &ret);
             if (!ret)
             {
                 return false;
             }
 
-            if (!Calypso_GetNextArgumentString(pAtCommand, temp, CALYPSO_ARGUMENT_DELIM, sizeof(temp)))
+            if (!Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_ARGUMENT_DELIM))
             {
                 return false;
             }
-            pValues->connection.security = Calypso_FindString(ATWLAN_SecurityStatusStrings,
-                                                              ATWLAN_SecurityStatus_NumberOfValues,
-                                                              temp,
-                                                              ATWLAN_SecurityStatus_OPEN,
-                                                              &ret);
+            pValues->connection.security = Calypso_FindView(ATWLAN_SecurityStatusStrings,
+                                                            ATWLAN_SecurityStatus_NumberOfValues,
+                                                            argument,
+                                                            ATWLAN_SecurityStatus_OPEN,
+                                                            &ret);
             if (!ret)
             {
                 return false;
@@ -1648,14 +1775,14 @@ static bool ATWLAN_ParseResponseWlanGet(ATWLAN_SetID_t id,
 
             case ATWLAN_SetAP_Security:
             {
-                ret = Calypso_GetNextArgumentString(pAtCommand, tempString, CALYPSO_STRING_TERMINATE, sizeof(tempString));
+                ret = Calypso_GetNextArgumentView(pAtCommand, &argument, CALYPSO_STRING_TERMINATE);
                 if (ret)
                 {
-                    pValues->ap.security = Calypso_FindString(ATWLAN_APSecurityTypeStrings,
-                                                              ATWLAN_APSecurityType_NumberOfValues,
-                                                              tempString,
-                                                              ATWLAN_APSecurityType_Open,
-                                                              &ret);
+                    pValues->ap.security = Calypso_FindView(ATWLAN_APSecurityTypeStrings,
+                                                            ATWLAN_APSecurityType_NumberOfValues,
+                                                            argument,
+                                                            ATWLAN_APSecurityType_Open,
+                                                            &ret);
                 }
 
                 break;
@@ -40,6 +40,7 @@
 #define ATWLAN_SSID_MAX_LENGTH                  32      /**< Max. SSID length (Wireless LAN identifier) */
 #define ATWLAN_SECURITYKEY_LENGTH               64      /**< Max. security key length */
 #define ATWLAN_AP_SECURITYKEY_LENGTH            64
+#define ATWLAN_SCAN_MAX_ENTRIES                 30      /**< Max. number of entries in the module's scan result list */
 
 #ifdef __cplusplus
 extern "C" {
@@ -431,12 +432,27 @@ typedef union ATWLAN_Settings_t
     ATWLAN_SettingsAP_t ap;                     /**< AP settings, used with ATWLAN_SetID_AccessPoint */
 } ATWLAN_Settings_t;
 
+/**
+ * @brief Callback for scan entries returned by ATWLAN_ScanStreamed().
+ *
+ * Is called from within the UART receive handler (interrupt context) - code in this
+ * function should thus be kept simple.
+ *
+ * Arguments: Scan entry, context pointer passed to ATWLAN_ScanStreamed()
+ */
+typedef void (*ATWLAN_ScanEntryCallback_t)(const ATWLAN_ScanEntry_t *, void *);
+
 
 extern bool ATWLAN_SetMode(ATWLAN_SetMode_t mode);
 extern bool ATWLAN_Scan(uint8_t index,
                         uint8_t deviceCount,
                         ATWLAN_ScanEntry_t *pValues,
                         uint8_t *pNumEntries);
+extern bool ATWLAN_ScanStreamed(uint8_t index,
+                                uint8_t deviceCount,
+                                ATWLAN_ScanEntryCallback_t callback,
+                                void *context,
+                                uint8_t *pNumEntries);
 extern bool ATWLAN_Connect(ATWLAN_ConnectionArguments_t connectionArgs);
 extern bool ATWLAN_Disconnect();
 extern bool ATWLAN_AddProfile(ATWLAN_Profile_t profile,
@@ -33,16 +33,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "ATCommands/ATCommands.h"
 #include "ATCommands/ATDevice.h"
 #include "ATCommands/ATEvent.h"
 
 static void Calypso_HandleRxByte(uint8_t receivedByte);
 static void Calypso_HandleRxLine(char *rxPacket, uint16_t rxLength);
+static void Calypso_CopyResponse(char *pOutResponse);
 
 /**
  * @brief Base64 encoding table
  */
-static uint8_t Calypso_base64EncTable[64] =  {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
+static const uint8_t Calypso_base64EncTable[64] =  {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
                                               'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
                                               'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
                                               'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
@@ -55,7 +57,7 @@ static uint8_t Calypso_base64EncTable[64] =  {'A', 'B', 'C', 'D', 'E', 'F', 'G',
 /**
  * @brief Base64 decoding table
  */
-static uint8_t Calypso_base64DecTable[123] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,62,0,0,0,63,
+static const uint8_t Calypso_base64DecTable[123] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,62,0,0,0,63,
                                               52,53,54,55,56,57,58,59,60,61, /* 0-9 */
                                               0,0,0,0,0,0,0,
                                               0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25, /* A-Z */
@@ -70,6 +72,62 @@ static const char *Calypso_BooleanValueStrings[Calypso_BooleanValue_NumberOfValu
     "true"
 };
 
+/**
+ * @brief Size of the driver's buffer arena (RX line buffer followed by command / response buffer).
+ */
+#define CALYPSO_ARENA_SIZE (CALYPSO_LINE_MAX_SIZE + AT_MAX_COMMAND_BUFFER_SIZE)
+
+/**
+ * @brief Buffer arena containing all large buffers of the driver (see CALYPSO_MEMORY_PROFILE).
+ *
+ * Layout:
+ * - RX line buffer (CALYPSO_LINE_MAX_SIZE bytes): Used in interrupt context to assemble lines
+ *   received from Calypso. Must not be shared, as events may arrive at any time.
+ * - Command / response buffer (AT_MAX_COMMAND_BUFFER_SIZE bytes, AT_commandBuffer): Used to
+ *   build a request (TX phase). As soon as the request has been sent, the buffer is lent
+ *   to the response (RX phase), i.e. the response lines overwrite the request text (unless
+ *   a different response buffer or a response line callback has been set). Data sent using
+ *   the encodeAsBase64 option of the AT command functions is encoded directly into the request
+ *   (see Calypso_AppendArgumentBase64()), so no separate encoding buffer is required.
+ */
+static char Calypso_arena[CALYPSO_ARENA_SIZE];
+
+/**
+ * @brief RX line buffer (part of Calypso_arena).
+ */
+#define Calypso_rxBuffer (&Calypso_arena[0])
+
+/**
+ * @brief Command / response buffer (part of Calypso_arena).
+ */
+#define CALYPSO_ARENA_COMMAND_BUFFER (&Calypso_arena[CALYPSO_LINE_MAX_SIZE])
+
+char *const AT_commandBuffer = CALYPSO_ARENA_COMMAND_BUFFER;
+
+/**
+ * @brief Max. length of lines received so far (including termination character).
+ * @see Calypso_GetMemoryReport()
+ */
+static uint16_t Calypso_maxLineLength = 0;
+
+/**
+ * @brief Max. length of response text received so far.
+ * @see Calypso_GetMemoryReport()
+ */
+static size_t Calypso_maxResponseLength = 0;
+
+/**
+ * @brief Number of received lines that have been discarded because they didn't fit into the RX line buffer.
+ * @see Calypso_GetMemoryReport()
+ */
+static uint32_t Calypso_lineOverflowCount = 0;
+
+/**
+ * @brief Number of responses that have been truncated because they didn't fit into the response buffer.
+ * @see Calypso_GetMemoryReport()
+ */
+static uint32_t Calypso_responseOverflowCount = 0;
+
 /**
  * @brief Timeouts for responses to AT commands (milliseconds).
  * Initialization is done in Calypso_Init().
@@ -92,15 +150,51 @@ static char Calypso_pendingCommandName[64] = {0};
 static size_t Calypso_pendingCommandNameLength = 0;
 
 /**
- * @brief Buffer used for current response text.
+ * @brief Buffer receiving the response text of the pending request (if no response line callback is set).
+ * @see Calypso_SetResponseBuffer()
+ */
+static char *Calypso_responseBuffer = CALYPSO_ARENA_COMMAND_BUFFER;
+
+/**
+ * @brief Size of Calypso_responseBuffer.
+ */
+static size_t Calypso_responseBufferSize = AT_MAX_COMMAND_BUFFER_SIZE;
+
+/**
+ * @brief Length of text in Calypso_responseBuffer.
+ */
+static size_t Calypso_responseLength = 0;
+
+/**
+ * @brief Callback receiving the response lines of the pending request (NULL if the response is written to Calypso_responseBuffer).
+ * @see Calypso_SetResponseLineCallback()
+ */
+static Calypso_ResponseLineCallback_t Calypso_responseLineCallback = NULL;
+
+/**
+ * @brief Context pointer passed to Calypso_responseLineCallback.
  */
-static char Calypso_currentResponseText[CALYPSO_MAX_RESPONSE_TEXT_LENGTH];
+static void *Calypso_responseLineContext = NULL;
 
 /**
- * @brief Length of text in current response text buffer.
- * @see Calypso_currentResponseText
+ * @brief Response buffer to be used for the next request.
  */
-static size_t Calypso_currentResponseLength = 0;
+static char *Calypso_nextResponseBuffer = CALYPSO_ARENA_COMMAND_BUFFER;
+
+/**
+ * @brief Size of Calypso_nextResponseBuffer.
+ */
+static size_t Calypso_nextResponseBufferSize = AT_MAX_COMMAND_BUFFER_SIZE;
+
+/**
+ * @brief Response line callback to be used for the next request.
+ */
+static Calypso_ResponseLineCallback_t Calypso_nextResponseLineCallback = NULL;
+
+/**
+ * @brief Context pointer passed to Calypso_nextResponseLineCallback.
+ */
+static void *Calypso_nextResponseLineContext = NULL;
 
 /**
  * @brief Last error text (if any).
@@ -113,14 +207,22 @@ static char Calypso_lastErrorText[32] = {0};
 static int32_t Calypso_lastErrorCode = 0;
 
 /**
- * @brief Confirmation status of the current (last issued) command.
+ * @brief Is set to true when the startup event has been received, i.e. when the module
+ * is ready for operation after (re)start.
+ * @see Calypso_WaitForStartup(), Calypso_ResetStartupEvent()
  */
-static Calypso_CNFStatus_t Calypso_cmdConfirmStatus;
+static bool Calypso_startupEventReceived = false;
 
 /**
- * @brief Data buffer for received data.
+ * @brief Number of startup events received so far.
+ * @see Calypso_GetStartupCount()
  */
-static char Calypso_rxBuffer[CALYPSO_LINE_MAX_SIZE];
+static uint32_t Calypso_startupCount = 0;
+
+/**
+ * @brief Confirmation status of the current (last issued) command.
+ */
+static Calypso_CNFStatus_t Calypso_cmdConfirmStatus;
 
 /**
  * @brief Number of bytes in receive buffer.
@@ -232,6 +334,34 @@ Calypso_EventCallback_t Calypso_eventCallback;
  */
 static bool Calypso_executingEventCallback = false;
 
+#if CALYPSO_EVENT_QUEUE_SIZE > 0
+/**
+ * @brief Queue of received events waiting to be passed to the event callback by WE_Poll().
+ * @see CALYPSO_EVENT_QUEUE_SIZE
+ */
+static WE_EventQueue_t Calypso_eventQueue;
+
+/**
+ * @brief Buffer holding the records of Calypso_eventQueue.
+ */
+static uint32_t Calypso_eventQueueBuffer[CALYPSO_EVENT_QUEUE_SIZE / 4];
+
+/**
+ * @brief Passes a queued event to the event callback (is called by WE_Poll() in main loop context).
+ *
+ * @param[in] data Event text (including string termination character)
+ * @param[in] length Event text length
+ */
+static void Calypso_DispatchEvent(uint8_t *data, uint16_t length)
+{
+    (void) length;
+    if (NULL != Calypso_eventCallback)
+    {
+        Calypso_eventCallback((char *) data);
+    }
+}
+#endif /* CALYPSO_EVENT_QUEUE_SIZE > 0 */
+
 /**
  * @brief Callback function which is executed if a single byte has been received from Calypso.
  * The default callback is Calypso_HandleRxByte().
@@ -271,6 +401,16 @@ bool Calypso_Init(uint32_t baudrate,
     Calypso_lineRxCallback = NULL;
     Calypso_eventCallback = eventCallback;
 
+#if CALYPSO_EVENT_QUEUE_SIZE > 0
+    if (!WE_EventQueue_Init(&Calypso_eventQueue,
+                            (uint8_t *) Calypso_eventQueueBuffer,
+                            sizeof(Calypso_eventQueueBuffer),
+                            Calypso_DispatchEvent))
+    {
+        return false;
+    }
+#endif
+
     /* Initialize the pins */
     if (NULL == pins)
     {
@@ -329,10 +469,16 @@ bool Calypso_Deinit(void)
     Calypso_rxByteCounter = 0;
     Calypso_eolChar1Found = 0;
     Calypso_requestPending = false;
-    Calypso_currentResponseLength = 0;
+    Calypso_responseLength = 0;
+    Calypso_responseLineCallback = NULL;
 
     WE_UART_DeInit();
 
+#if CALYPSO_EVENT_QUEUE_SIZE > 0
+    /* Discard events that have not been dispatched yet */
+    WE_EventQueue_Clear(&Calypso_eventQueue);
+#endif
+
     return true;
 }
 
@@ -359,6 +505,7 @@ bool Calypso_SetApplicationModePins(Calypso_ApplicationMode_t appMode)
  */
 bool Calypso_PinReset(void)
 {
+    Calypso_ResetStartupEvent();
     if (!WE_SetPin(Calypso_pins[Calypso_Pin_Reset], WE_Pin_Level_Low))
     {
         return false;
@@ -367,6 +514,46 @@ bool Calypso_PinReset(void)
     return WE_SetPin(Calypso_pins[Calypso_Pin_Reset], WE_Pin_Level_High);
 }
 
+/**
+ * @brief Waits for the startup event, i.e. until the module is ready for operation after (re)start.
+ *
+ * The startup event flag is cleared by Calypso_PinReset() and Calypso_ResetStartupEvent(),
+ * so calling this function returns immediately if the module has already become ready
+ * since the last restart.
+ *
+ * @param[in] timeoutMs Maximum wait time in milliseconds
+ *
+ * @return true if the startup event has been received, false otherwise
+ */
+bool Calypso_WaitForStartup(uint32_t timeoutMs)
+{
+    uint32_t t0 = WE_GetTick();
+    while (!Calypso_startupEventReceived)
+    {
+        if (WE_GetTick() - t0 > timeoutMs)
+        {
+            return false;
+        }
+        if (Calypso_waitTimeStepUsec > 0)
+        {
+            WE_DelayMicroseconds(Calypso_waitTimeStepUsec);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Clears the startup event flag.
+ *
+ * Must be called before restarting the module by other means than Calypso_PinReset()
+ * (e.g. using ATDevice_Reboot()), so that Calypso_WaitForStartup() waits for the next
+ * startup event.
+ */
+void Calypso_ResetStartupEvent(void)
+{
+    Calypso_startupEventReceived = false;
+}
+
 /**
  * @brief Wakes the module up from power save mode using the wake up pin.
  *
@@ -415,6 +602,18 @@ WE_Pin_Level_t Calypso_GetPinLevel(Calypso_Pin_t pin)
     return WE_GetPinLevel(Calypso_pins[pin]);
 }
 
+/**
+ * @brief Returns the number of startup events received so far.
+ *
+ * Can be used to detect restarts of the module (e.g. to invalidate cached module state).
+ *
+ * @return Number of startup events
+ */
+uint32_t Calypso_GetStartupCount(void)
+{
+    return Calypso_startupCount;
+}
+
 /**
  * @brief Sends the supplied AT command to the module
  *
@@ -423,6 +622,24 @@ WE_Pin_Level_t Calypso_GetPinLevel(Calypso_Pin_t pin)
  * @return true if successful, false otherwise
  */
 bool Calypso_SendRequest(char *data)
+{
+    return Calypso_SendRequestWithData(data, NULL, 0);
+}
+
+/**
+ * @brief Sends the supplied AT command followed by a binary data argument to the module
+ *
+ * The command (including the delimiter preceding the data, e.g. "AT+fileWrite=<id>,<offset>,<format>,<length>,")
+ * is sent first, followed by the data and "\r\n". The data is transmitted directly from the supplied
+ * buffer, i.e. it is not copied to the command buffer and may contain any byte values.
+ *
+ * @param[in] command AT command to send. If dataLength is 0, the command has to end with "\r\n\0".
+ * @param[in] data Data to be sent after the command (optional). Can be NULL if dataLength is 0.
+ * @param[in] dataLength Number of data bytes
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_SendRequestWithData(char *command, const uint8_t *data, uint16_t dataLength)
 {
     if (Calypso_executingEventCallback)
     {
@@ -431,8 +648,19 @@ bool Calypso_SendRequest(char *data)
         return false;
     }
 
+    /* Response buffer and response line callback apply to this request only */
+    Calypso_responseBuffer = Calypso_nextResponseBuffer;
+    Calypso_responseBufferSize = Calypso_nextResponseBufferSize;
+    Calypso_responseLength = 0;
+    Calypso_responseLineCallback = Calypso_nextResponseLineCallback;
+    Calypso_responseLineContext = Calypso_nextResponseLineContext;
+    Calypso_nextResponseBuffer = AT_commandBuffer;
+    Calypso_nextResponseBufferSize = AT_MAX_COMMAND_BUFFER_SIZE;
+    Calypso_nextResponseLineCallback = NULL;
+    Calypso_nextResponseLineContext = NULL;
+
     Calypso_requestPending = true;
-    Calypso_currentResponseLength = 0;
+    Calypso_cmdConfirmStatus = Calypso_CNFStatus_Invalid;
     *Calypso_lastErrorText = '\0';
     Calypso_lastErrorCode = 0;
 
@@ -444,17 +672,17 @@ bool Calypso_SendRequest(char *data)
         WE_DelayMicroseconds(Calypso_minCommandIntervalUsec - t);
     }
 
-    size_t dataLength = strlen(data);
+    size_t commandLength = strlen(command);
 
     /* Get command name from request string (remove prefix "AT+" and parameters) */
     Calypso_pendingCommandName[0] = '\0';
     Calypso_pendingCommandNameLength = 0;
-    if (dataLength > 3 &&
-            (data[0] == 'a' || data[0] == 'A') &&
-            (data[1] == 't' || data[1] == 'T') &&
-            data[2] == '+')
+    if (commandLength > 3 &&
+            (command[0] == 'a' || command[0] == 'A') &&
+            (command[1] == 't' || command[1] == 'T') &&
+            command[2] == '+')
     {
-        char *pData = data + 3;
+        char *pData = command + 3;
         if (Calypso_GetCmdName(&pData, Calypso_pendingCommandName, CALYPSO_COMMAND_DELIM, '\r'))
         {
             Calypso_pendingCommandNameLength = strlen(Calypso_pendingCommandName);
@@ -462,10 +690,23 @@ bool Calypso_SendRequest(char *data)
     }
 
 #ifdef WE_DEBUG
-    fprintf(stdout, "> %s", data);
+    if (dataLength > 0)
+    {
+        fprintf(stdout, "> %s<%u bytes>\r\n", command, dataLength);
+    }
+    else
+    {
+        fprintf(stdout, "> %s", command);
+    }
 #endif
 
-    Calypso_Transmit(data, dataLength);
+    Calypso_Transmit(command, commandLength);
+
+    if (dataLength > 0)
+    {
+        WE_UART_Transmit((uint8_t *) data, dataLength);
+        Calypso_Transmit(CALYPSO_CRLF, 2);
+    }
 
     return true;
 }
@@ -487,9 +728,15 @@ void Calypso_Transmit(const char *data, uint16_t dataLength)
 /**
  * @brief Waits for the response from the module after a request.
  *
+ * The confirmation status is reset when the request is sent, so other (non AT command) work may be
+ * done between Calypso_SendRequest() and Calypso_WaitForConfirm() without missing the confirmation.
+ *
  * @param[in] maxTimeMs Maximum wait time in milliseconds
  * @param[in] expectedStatus Status to wait for
- * @param[out] pOutResponse Received response text (if any) will be written to this buffer (optional)
+ * @param[out] pOutResponse Received response text (if any) will be written to this buffer (optional).
+ *                          The response is received directly into the response buffer of the request
+ *                          (AT_commandBuffer by default, see Calypso_SetResponseBuffer()) - if
+ *                          pOutResponse points to that buffer, the response is not copied.
  *
  * @return true if successful, false otherwise
  */
@@ -497,8 +744,6 @@ bool Calypso_WaitForConfirm(uint32_t maxTimeMs,
                             Calypso_CNFStatus_t expectedStatus,
                             char *pOutResponse)
 {
-    Calypso_cmdConfirmStatus = Calypso_CNFStatus_Invalid;
-
     uint32_t t0 = WE_GetTick();
 
     while (1)
@@ -509,14 +754,11 @@ bool Calypso_WaitForConfirm(uint32_t maxTimeMs,
             Calypso_lastConfirmTimeUsec = WE_GetTickMicroseconds();
 
             Calypso_requestPending = false;
+            Calypso_responseLineCallback = NULL;
 
             if (Calypso_cmdConfirmStatus == expectedStatus)
             {
-                if (NULL != pOutResponse)
-                {
-                    /* Copy response for further processing */
-                    memcpy(pOutResponse, Calypso_currentResponseText, Calypso_currentResponseLength);
-                }
+                Calypso_CopyResponse(pOutResponse);
                 return true;
             }
             else
@@ -539,9 +781,139 @@ bool Calypso_WaitForConfirm(uint32_t maxTimeMs,
     }
 
     Calypso_requestPending = false;
+    Calypso_responseLineCallback = NULL;
     return false;
 }
 
+/**
+ * @brief Checks if the response to the last request has been received (without blocking).
+ *
+ * Can be used instead of Calypso_WaitForConfirm() to continue with other work while the module
+ * is processing a request. No other AT command may be sent until the confirmation has been received.
+ *
+ * @param[out] status Confirmation status (Calypso_CNFStatus_Invalid if no confirmation has been received yet)
+ * @param[out] pOutResponse Received response text (if any) will be written to this buffer if status is
+ *                          Calypso_CNFStatus_Success (optional)
+ *
+ * @return true if the confirmation has been received, false otherwise
+ */
+bool Calypso_PollConfirm(Calypso_CNFStatus_t *status, char *pOutResponse)
+{
+    *status = Calypso_cmdConfirmStatus;
+
+    if (Calypso_CNFStatus_Invalid == *status)
+    {
+        return false;
+    }
+
+    if (Calypso_requestPending)
+    {
+        /* Store current time to enable check for min. time between received confirm and next command. */
+        Calypso_lastConfirmTimeUsec = WE_GetTickMicroseconds();
+
+        Calypso_requestPending = false;
+        Calypso_responseLineCallback = NULL;
+    }
+
+    if (Calypso_CNFStatus_Success == *status)
+    {
+        Calypso_CopyResponse(pOutResponse);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sets the buffer receiving the response text of the next request.
+ *
+ * Applies to the next request sent using Calypso_SendRequest() or Calypso_SendRequestWithData() only.
+ * Subsequent requests use the default response buffer (AT_commandBuffer). All response lines
+ * are stored consecutively (each terminated by '\0'). Lines exceeding the buffer size are truncated.
+ *
+ * @param[in] buffer Response buffer (NULL to discard the response text)
+ * @param[in] size Size of response buffer
+ */
+void Calypso_SetResponseBuffer(char *buffer, size_t size)
+{
+    Calypso_nextResponseBuffer = buffer;
+    Calypso_nextResponseBufferSize = (NULL == buffer) ? 0 : size;
+}
+
+/**
+ * @brief Sets a callback receiving the response lines of the next request.
+ *
+ * Applies to the next request sent using Calypso_SendRequest() or Calypso_SendRequestWithData() only.
+ * Each response line is passed to the callback as soon as it has been received, i.e. multi-line
+ * responses can be parsed line by line without being stored in a response buffer. Response
+ * text is not written to the response buffer if a callback is set.
+ *
+ * Note that the callback is executed from interrupt context and must not send AT commands.
+ *
+ * @param[in] callback Response line callback (NULL to use the response buffer)
+ * @param[in] context Context pointer passed to the callback
+ */
+void Calypso_SetResponseLineCallback(Calypso_ResponseLineCallback_t callback, void *context)
+{
+    Calypso_nextResponseLineCallback = callback;
+    Calypso_nextResponseLineContext = context;
+}
+
+/**
+ * @brief Returns the static RAM usage of the driver and the high-water marks of its buffers.
+ *
+ * Can be used to check whether a smaller memory profile (see CALYPSO_MEMORY_PROFILE) is
+ * sufficient for the application: The max. line and response lengths must stay below the
+ * line and command buffer sizes of the profile and no overflows must occur.
+ *
+ * @param[out] report Memory report
+ */
+void Calypso_GetMemoryReport(Calypso_MemoryReport_t *report)
+{
+    report->profile = CALYPSO_MEMORY_PROFILE;
+    report->arenaSize = sizeof(Calypso_arena);
+    report->lineBufferSize = CALYPSO_LINE_MAX_SIZE;
+    report->commandBufferSize = AT_MAX_COMMAND_BUFFER_SIZE;
+    report->eventQueueSize = CALYPSO_EVENT_QUEUE_SIZE;
+    report->stateSize = sizeof(Calypso_pendingCommandName) +
+                        sizeof(Calypso_lastErrorText) +
+                        sizeof(Calypso_timeouts) +
+                        sizeof(Calypso_pins);
+    report->totalSize = report->arenaSize + report->eventQueueSize + report->stateSize;
+    report->maxLineLength = Calypso_maxLineLength;
+    report->maxResponseLength = Calypso_maxResponseLength;
+    report->lineOverflowCount = Calypso_lineOverflowCount;
+    report->responseOverflowCount = Calypso_responseOverflowCount;
+}
+
+#if CALYPSO_EVENT_QUEUE_SIZE > 0
+/**
+ * @brief Returns the statistics of the event queue (queue depth, dropped events, dispatch latency).
+ *
+ * @param[out] stats Event queue statistics
+ */
+void Calypso_GetEventQueueStats(WE_EventQueue_Stats_t *stats)
+{
+    WE_EventQueue_GetStats(&Calypso_eventQueue, stats);
+}
+#endif /* CALYPSO_EVENT_QUEUE_SIZE > 0 */
+
+/**
+ * @brief Copies the response text of the last request to the supplied buffer (if it has not
+ * been received directly into that buffer).
+ *
+ * @param[out] pOutResponse Destination buffer (optional)
+ */
+static void Calypso_CopyResponse(char *pOutResponse)
+{
+    if ((NULL == pOutResponse) || (NULL == Calypso_responseBuffer) || (pOutResponse == Calypso_responseBuffer))
+    {
+        return;
+    }
+
+    /* Buffers may overlap if pOutResponse points into the response buffer */
+    memmove(pOutResponse, Calypso_responseBuffer, Calypso_responseLength);
+}
+
 /**
  * @brief Returns the code of the last error (if any).
  *
@@ -609,52 +981,138 @@ bool Calypso_IntToString(char *outString, uint32_t number, uint16_t intFlags)
  */
 bool Calypso_StringToInt(void *number, const char *inString, uint16_t intFlags)
 {
-    if ((NULL == inString) || (NULL == number))
+    if (NULL == inString)
     {
         return false;
     }
 
-    bool hex = (0 == strncmp(inString, "0x", 2)) || ((intFlags & CALYPSO_INTFLAGS_NOTATION_HEX) != 0);
-    bool signedDataType = (intFlags & CALYPSO_INTFLAGS_SIGNED) != 0;
+    Calypso_StringView_t view;
+    view.data = inString;
+    view.length = strlen(inString);
+    return Calypso_ViewToInt(number, view, intFlags);
+}
 
-    if (signedDataType)
+/**
+ * @brief Parses a string view to integer (in place, without copying the string).
+ *
+ * Leading blanks and a sign are accepted. Hexadecimal notation is used if requested by
+ * intFlags or if the number starts with "0x". Parsing stops at the first invalid character.
+ *
+ * @param[out] number Parsed integer value
+ * @param[in] view String view to be parsed
+ * @param[in] intFlags Flags to determine how to parse
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_ViewToInt(void *number, Calypso_StringView_t view, uint16_t intFlags)
+{
+    if ((NULL == number) || ((NULL == view.data) && (view.length > 0)))
     {
-        long longNr = strtol(inString, NULL, (hex == true) ? 16 : 10);
+        return false;
+    }
 
-        if ((intFlags & CALYPSO_INTFLAGS_SIZE8) != 0)
-        {
-            *((int8_t*) number) = longNr;
-        }
-        else if ((intFlags & CALYPSO_INTFLAGS_SIZE16) != 0)
-        {
-            *((int16_t*) number) = longNr;
-        }
-        else if ((intFlags & CALYPSO_INTFLAGS_SIZE32) != 0)
-        {
-            *((int32_t*) number) = longNr;
-        }
+    const char *pData = view.data;
+    const char *pEnd = view.data + view.length;
+
+    while ((pData < pEnd) && ((' ' == *pData) || ('\t' == *pData)))
+    {
+        pData++;
     }
-    else
+
+    bool negative = false;
+    if ((pData < pEnd) && (('-' == *pData) || ('+' == *pData)))
+    {
+        negative = ('-' == *pData);
+        pData++;
+    }
+
+    bool hex = ((intFlags & CALYPSO_INTFLAGS_NOTATION_HEX) != 0);
+    if ((pEnd - pData >= 2) && ('0' == pData[0]) && (('x' == pData[1]) || ('X' == pData[1])))
     {
-        unsigned long longNr = strtoul(inString, NULL, (hex == true) ? 16 : 10);
+        hex = true;
+        pData += 2;
+    }
 
-        if ((intFlags & CALYPSO_INTFLAGS_SIZE8) != 0)
+    uint32_t value = 0;
+    for (; pData < pEnd; pData++)
+    {
+        char c = *pData;
+        uint8_t digit;
+        if ((c >= '0') && (c <= '9'))
         {
-            *((uint8_t*) number) = longNr;
+            digit = c - '0';
         }
-        else if ((intFlags & CALYPSO_INTFLAGS_SIZE16) != 0)
+        else if (hex && (c >= 'a') && (c <= 'f'))
         {
-            *((uint16_t*) number) = longNr;
+            digit = c - 'a' + 10;
         }
-        else if ((intFlags & CALYPSO_INTFLAGS_SIZE32) != 0)
+        else if (hex && (c >= 'A') && (c <= 'F'))
         {
-            *((uint32_t*) number) = longNr;
+            digit = c - 'A' + 10;
         }
+        else
+        {
+            break;
+        }
+        value = hex ? ((value << 4) | digit) : (value * 10 + digit);
+    }
+
+    if (negative)
+    {
+        value = 0 - value;
+    }
+
+    /* Signed and unsigned values share the same two's complement representation */
+    if ((intFlags & CALYPSO_INTFLAGS_SIZE8) != 0)
+    {
+        *((uint8_t*) number) = (uint8_t) value;
+    }
+    else if ((intFlags & CALYPSO_INTFLAGS_SIZE16) != 0)
+    {
+        *((uint16_t*) number) = (uint16_t) value;
+    }
+    else if ((intFlags & CALYPSO_INTFLAGS_SIZE32) != 0)
+    {
+        *((uint32_t*) number) = value;
     }
 
     return true;
 }
 
+/**
+ * @brief Copies the contents of a string view to a (null terminated) string.
+ *
+ * @param[out] pOutString Output string
+ * @param[in] view String view to be copied
+ * @param[in] maxLength Max. length of output string (including termination character)
+ *
+ * @return true if successful, false if the string doesn't fit into the output buffer
+ */
+bool Calypso_ViewToString(char *pOutString, Calypso_StringView_t view, uint16_t maxLength)
+{
+    if ((NULL == pOutString) || (view.length >= maxLength))
+    {
+        return false;
+    }
+
+    memcpy(pOutString, view.data, view.length);
+    pOutString[view.length] = '\0';
+    return true;
+}
+
+/**
+ * @brief Checks if a string view equals the supplied string (case insensitive).
+ *
+ * @param[in] view String view
+ * @param[in] str String to compare with
+ *
+ * @return true if equal, false otherwise
+ */
+bool Calypso_ViewEquals(Calypso_StringView_t view, const char *str)
+{
+    return (0 == strncasecmp(str, view.data, view.length)) && ('\0' == str[view.length]);
+}
+
 /**
  * @brief Appends a byte array argument to the end of an AT command.
  *
@@ -687,6 +1145,44 @@ bool Calypso_AppendArgumentBytes(char *pOutString,
     return true;
 }
 
+/**
+ * @brief Appends a byte array argument to the end of an AT command, encoding it in Base64 format.
+ *
+ * The data is encoded directly into the AT command (no intermediate buffer is used). The
+ * length of the encoded data is Calypso_GetBase64EncBufSize(numBytes) - 1.
+ *
+ * @param[out] pOutString  AT command after appending argument
+ * @param[in] pInArgument Pointer to byte array to be encoded and added
+ * @param[in] numBytes    Number of bytes to encode
+ * @param[in] delimiter   Delimiter to append after argument
+ * @param[in] maxStringLength Size of the AT command buffer (room for a terminating CRLF is reserved)
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_AppendArgumentBase64(char *pOutString,
+                                  const char *pInArgument,
+                                  uint16_t numBytes,
+                                  char delimiter,
+                                  uint16_t maxStringLength)
+{
+    if (NULL == pOutString || NULL == pInArgument)
+    {
+        return false;
+    }
+
+    size_t strLength = strlen(pOutString);
+    uint32_t lengthEncoded = Calypso_GetBase64EncBufSize(numBytes);
+    if (strLength + lengthEncoded + 2 > maxStringLength)
+    {
+        return false;
+    }
+
+    Calypso_EncodeBase64((uint8_t *) pInArgument, numBytes, (uint8_t *) &pOutString[strLength], &lengthEncoded);
+    pOutString[strLength + lengthEncoded - 1] = delimiter;
+
+    return true;
+}
+
 /**
  * @brief Appends a string argument to the end of an AT command.
  *
@@ -805,6 +1301,51 @@ bool Calypso_AppendArgumentBoolean(char *pOutString, bool inBool, char delimiter
     return Calypso_AppendArgumentString(pOutString, Calypso_BooleanValueStrings[(inBool == true) ? 1 : 0], delimiter);
 }
 
+/**
+ * @brief Gets the next argument from the supplied AT command as a view (without copying).
+ *
+ * This is the tokenizer used by all Calypso_GetNextArgument*() functions. The argument is located
+ * in a single pass. The cursor is moved behind the delimiter - if the delimiter is the terminating
+ * '\0' of a non-empty argument, the cursor is moved to the next (consecutively stored) response line.
+ *
+ * @param[in,out] pInArguments AT command to get argument from (cursor)
+ * @param[out] pOutView View of the argument (references the AT command)
+ * @param[in] delimiter Delimiter which occurs after argument to get
+ *
+ * @return true if successful, false if the delimiter was not found
+ */
+bool Calypso_GetNextArgumentView(char **pInArguments,
+                                 Calypso_StringView_t *pOutView,
+                                 char delimiter)
+{
+    if ((NULL == pInArguments) || (NULL == *pInArguments) || (NULL == pOutView))
+    {
+        return false;
+    }
+
+    char *pStart = *pInArguments;
+    char *pData = pStart;
+
+    while (*pData != delimiter)
+    {
+        if ('\0' == *pData)
+        {
+            return false;
+        }
+        pData++;
+    }
+
+    pOutView->data = pStart;
+    pOutView->length = (uint16_t) (pData - pStart);
+
+    if ((pData != pStart) || ('\0' != *pStart))
+    {
+        *pInArguments = pData + 1;
+    }
+
+    return true;
+}
+
 /**
  * @brief Gets the next string argument from the supplied AT command.
  *
@@ -825,40 +1366,25 @@ bool Calypso_GetNextArgumentString(char **pInArguments,
         return false;
     }
 
-    size_t argumentLength = 0;
-    size_t inputStringLength = strlen(*pInArguments);
+    char *pArguments = *pInArguments;
+    Calypso_StringView_t view;
 
-    while (true)
+    if (!Calypso_GetNextArgumentView(&pArguments, &view, delimiter) ||
+            !Calypso_ViewToString(pOutArgument, view, maxLength))
     {
-        if (argumentLength > maxLength - 1)
-        {
-            return false;
-        }
-        else if (((*pInArguments)[argumentLength] == delimiter))
-        {
-            /* If argument list is not empty, copy string to output arguments */
-            memcpy(pOutArgument, *pInArguments, argumentLength);
-
-            pOutArgument[argumentLength] = '\0';
-
-            if (argumentLength > 0 || **pInArguments != '\0')
-            {
-                *pInArguments = &((*pInArguments)[argumentLength+1]);
-            }
-
-            return true;
-        }
-        else if (argumentLength > inputStringLength)
-        {
-            return false;
-        }
-        argumentLength++;
+        return false;
     }
+
+    *pInArguments = pArguments;
+    return true;
 }
 
 /**
  * @brief Gets the next integer argument from the supplied AT command.
  *
+ * The argument is parsed in place. If the delimiter is not found, the remainder of the
+ * AT command is parsed and the cursor is not moved.
+ *
  * @param[in,out] pInArguments AT command to get argument from
  * @param[out] pOutArgument Argument parsed as integer
  * @param[in] intFlags Flags to determine how to parse
@@ -871,15 +1397,20 @@ bool Calypso_GetNextArgumentInt(char **pInArguments,
                                 uint16_t intFlags,
                                 char delimiter)
 {
-    if ((NULL == pInArguments) || (NULL == pOutArgument))
+    if ((NULL == pInArguments) || (NULL == *pInArguments) || (NULL == pOutArgument))
     {
         return false;
     }
 
-    char tempString[12];
+    Calypso_StringView_t view;
+
+    if (!Calypso_GetNextArgumentView(pInArguments, &view, delimiter))
+    {
+        view.data = *pInArguments;
+        view.length = strlen(*pInArguments);
+    }
 
-    Calypso_GetNextArgumentString(pInArguments, tempString, delimiter, sizeof(tempString));
-    return Calypso_StringToInt(pOutArgument, tempString, intFlags);
+    return Calypso_ViewToInt(pOutArgument, view, intFlags);
 }
 
 /**
@@ -901,22 +1432,27 @@ bool Calypso_GetNextArgumentEnum(char **pInArguments,
                                  uint16_t maxStringLength,
                                  char delimiter)
 {
-    char tempString[maxStringLength];
+    if ((NULL == pInArguments) || (NULL == pOutArgument))
+    {
+        return false;
+    }
+
+    char *pArguments = *pInArguments;
+    Calypso_StringView_t view;
 
-    if (!Calypso_GetNextArgumentString(pInArguments,
-                                       tempString,
-                                       delimiter,
-                                       sizeof(tempString)))
+    if (!Calypso_GetNextArgumentView(&pArguments, &view, delimiter) || (view.length >= maxStringLength))
     {
         return false;
     }
 
+    *pInArguments = pArguments;
+
     bool ok;
-    *pOutArgument = Calypso_FindString(stringList,
-                                       numStrings,
-                                       tempString,
-                                       0,
-                                       &ok);
+    *pOutArgument = Calypso_FindView(stringList,
+                                     numStrings,
+                                     view,
+                                     0,
+                                     &ok);
     return ok;
 }
 
@@ -926,7 +1462,7 @@ bool Calypso_GetNextArgumentEnum(char **pInArguments,
  * @param[in,out] pInArguments AT command to get argument from
  * @param[in] stringList List of strings containing the string representations of the bits in the output bitmask
  * @param[in] numStrings Number of elements in stringList (max. number of bits in output bitmask)
- * @param[in] maxStringLength Max. length of individual bitmask strings
+ * @param[in] maxStringLength Max. length of individual bitmask strings (limited to CALYPSO_MAX_BITMASK_STRING_LENGTH)
  * @param[out] bitmask Output bitmask
  * @param[in] delimiter Delimiter which occurs after argument to get
  *
@@ -941,13 +1477,18 @@ bool Calypso_GetNextArgumentBitmask(char **pInArguments,
 {
 
     bool ret = false;
-    char tempString[maxStringLength];
+    char tempString[CALYPSO_MAX_BITMASK_STRING_LENGTH];
+
+    if (maxStringLength > sizeof(tempString))
+    {
+        maxStringLength = sizeof(tempString);
+    }
 
     *bitmask = 0;
 
     while (**pInArguments != '\0' &&
-            ((ret = Calypso_GetNextArgumentString(pInArguments, tempString, CALYPSO_BITMASK_DELIM, sizeof(tempString))) ||
-             (ret = Calypso_GetNextArgumentString(pInArguments, tempString, delimiter, sizeof(tempString)))))
+            ((ret = Calypso_GetNextArgumentString(pInArguments, tempString, CALYPSO_BITMASK_DELIM, maxStringLength)) ||
+             (ret = Calypso_GetNextArgumentString(pInArguments, tempString, delimiter, maxStringLength))))
     {
         bool ok;
         uint8_t flag = Calypso_FindString(stringList, numStrings, tempString, 0, &ok);
@@ -999,33 +1540,57 @@ bool Calypso_GetCmdName(char **pInAtCmd,
                         char delimiter,
                         char alternativeDelimiter)
 {
-    if ((NULL == pInAtCmd) || (NULL == pCmdName))
+    if (NULL == pCmdName)
+    {
+        return false;
+    }
+
+    Calypso_StringView_t view;
+    if (!Calypso_GetCmdNameView(pInAtCmd, &view, delimiter, alternativeDelimiter))
     {
         return false;
     }
 
-    size_t argumentLength = 0;
+    memcpy(pCmdName, view.data, view.length);
+    pCmdName[view.length] = '\0';
+    return true;
+}
 
-    while (true)
+/**
+ * @param Gets the command name from an AT command as a view (without copying).
+ *
+ * @param[in,out] pInAtCmd AT command to get command name from
+ * @param[out] pOutView View of the command name (references the AT command)
+ * @param[in] delimiter Delimiter which occurs after command name
+ * @param[in] delimiter Alternative delimiter which may occur after command name
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_GetCmdNameView(char **pInAtCmd,
+                            Calypso_StringView_t *pOutView,
+                            char delimiter,
+                            char alternativeDelimiter)
+{
+    if ((NULL == pInAtCmd) || (NULL == *pInAtCmd) || (NULL == pOutView))
     {
-        if ((*pInAtCmd)[argumentLength] == delimiter ||
-                (*pInAtCmd)[argumentLength] == alternativeDelimiter)
-        {
-            /* if argument list not empty*/
-            /* copy string to output arguments */
-            memcpy(pCmdName, *pInAtCmd, argumentLength);
+        return false;
+    }
 
-            pCmdName[argumentLength] = '\0';
+    char *pData = *pInAtCmd;
 
-            *pInAtCmd = &((*pInAtCmd)[argumentLength+1]);
-            return true;
-        }
-        if ((*pInAtCmd)[argumentLength] == '\0')
+    while ((*pData != delimiter) && (*pData != alternativeDelimiter))
+    {
+        if ('\0' == *pData)
         {
             return false;
         }
-        argumentLength++;
+        pData++;
     }
+
+    pOutView->data = *pInAtCmd;
+    pOutView->length = (uint16_t) (pData - *pInAtCmd);
+    *pInAtCmd = pData + 1;
+    return true;
 }
 
 /**
@@ -1065,6 +1630,43 @@ uint8_t Calypso_FindString(const char *stringList[],
     return defaultValue;
 }
 
+/**
+ * @brief Looks up a string view in a list of strings (case insensitive) and returns the
+ * index of the string or the supplied default value, if the string is not found.
+ *
+ * @param[in] stringList List of strings to search in
+ * @param[in] numStrings Number of strings in stringList
+ * @param[in] view String view to look for
+ * @param[in] defaultValue Value to return if the string is not found
+ * @param[out] ok Is set to true if the string is found. Optional.
+ *
+ * @return Index of the first occurrence of the string in stringList or defaultValue, if string is not found
+ */
+uint8_t Calypso_FindView(const char *stringList[],
+                         uint8_t numStrings,
+                         Calypso_StringView_t view,
+                         uint8_t defaultValue,
+                         bool *ok)
+{
+    for (uint8_t i = 0; i < numStrings; i++)
+    {
+        if ((view.length == strnlen(stringList[i], view.length + 1)) && (0 == strncasecmp(stringList[i], view.data, view.length)))
+        {
+            if (ok)
+            {
+                *ok = true;
+            }
+            return i;
+        }
+    }
+
+    if (ok)
+    {
+        *ok = false;
+    }
+    return defaultValue;
+}
+
 /**
  * @brief Set timing parameters used by the Calypso driver.
  *
@@ -1349,6 +1951,7 @@ static void Calypso_HandleRxByte(uint8_t receivedByte)
     {
         if (Calypso_rxByteCounter >= CALYPSO_LINE_MAX_SIZE)
         {
+            Calypso_lineOverflowCount++;
             Calypso_rxByteCounter = 0;
             Calypso_eolChar1Found = false;
             return;
@@ -1399,6 +2002,11 @@ static void Calypso_HandleRxLine(char *rxPacket, uint16_t rxLength)
     fprintf(stdout, "< %s\r\n", rxPacket);
 #endif
 
+    if (rxLength > Calypso_maxLineLength)
+    {
+        Calypso_maxLineLength = rxLength;
+    }
+
     /* Check if a custom line rx callback is specified and call it if so */
     if (NULL != Calypso_lineRxCallback)
     {
@@ -1454,34 +2062,68 @@ static void Calypso_HandleRxLine(char *rxPacket, uint16_t rxLength)
         }
         else
         {
-            /* Doesn't start with o or e - copy to response text buffer, if the start
-             * of the response matches the pending command name preceded by '+' */
+            /* Doesn't start with o or e - pass to the response line callback or copy to the
+             * response buffer, if the start of the response matches the pending command name
+             * preceded by '+' */
             if (rxLength < CALYPSO_LINE_MAX_SIZE &&
                     rxLength > 1 &&
                     Calypso_rxBuffer[0] == '+' &&
                     Calypso_pendingCommandName[0] != '\0' &&
                     0 == strncasecmp(Calypso_pendingCommandName, Calypso_rxBuffer + 1, Calypso_pendingCommandNameLength))
             {
-                /* Copy to response text buffer, taking care not to exceed buffer size */
-                uint16_t chunkLength = rxLength;
-                if (Calypso_currentResponseLength + chunkLength >= CALYPSO_MAX_RESPONSE_TEXT_LENGTH)
+                if (NULL != Calypso_responseLineCallback)
+                {
+                    Calypso_responseLineCallback(Calypso_rxBuffer, rxLength, Calypso_responseLineContext);
+                }
+                else if (NULL != Calypso_responseBuffer)
                 {
-                    chunkLength = CALYPSO_MAX_RESPONSE_TEXT_LENGTH - Calypso_currentResponseLength;
+                    /* Copy to response buffer (including the '\0' terminator), taking care not to
+                     * exceed buffer size. A truncated line is terminated in the last byte. */
+                    if (Calypso_responseLength < Calypso_responseBufferSize)
+                    {
+                        uint16_t chunkLength = rxLength;
+                        if (Calypso_responseLength + chunkLength > Calypso_responseBufferSize)
+                        {
+                            chunkLength = Calypso_responseBufferSize - Calypso_responseLength;
+                            Calypso_responseOverflowCount++;
+                        }
+                        memcpy(&Calypso_responseBuffer[Calypso_responseLength], Calypso_rxBuffer, chunkLength);
+                        Calypso_responseLength += chunkLength;
+                        Calypso_responseBuffer[Calypso_responseLength - 1] = '\0';
+                        if (Calypso_responseLength > Calypso_maxResponseLength)
+                        {
+                            Calypso_maxResponseLength = Calypso_responseLength;
+                        }
+                    }
+                    else
+                    {
+                        Calypso_responseOverflowCount++;
+                    }
                 }
-                memcpy(&Calypso_currentResponseText[Calypso_currentResponseLength], Calypso_rxBuffer, chunkLength);
-                Calypso_currentResponseLength += chunkLength;
             }
         }
     }
 
     if ('+' == rxPacket[0])
     {
+        if (0 == strncasecmp(rxPacket, CALYPSO_EVENT_STARTUP, strlen(CALYPSO_EVENT_STARTUP)))
+        {
+            /* Module is ready for operation */
+            Calypso_startupEventReceived = true;
+            Calypso_startupCount++;
+        }
+
         /* An event occurred. Execute callback (if specified). */
         if (NULL != Calypso_eventCallback)
         {
+#if CALYPSO_EVENT_QUEUE_SIZE > 0
+            /* Defer callback to main loop (see WE_Poll()) */
+            WE_EventQueue_Push(&Calypso_eventQueue, (uint8_t *) rxPacket, rxLength);
+#else
             Calypso_executingEventCallback = true;
             Calypso_eventCallback(Calypso_rxBuffer);
             Calypso_executingEventCallback = false;
+#endif
         }
     }
 }
@@ -1512,6 +2154,18 @@ void Calypso_SetLineRxCallback(Calypso_LineRxCallback_t callback)
     Calypso_lineRxCallback = callback;
 }
 
+/**
+ * @brief Returns the currently set line received callback function (NULL if none).
+ *
+ * Can be used to restore or chain to a previously set callback.
+ *
+ * @return Pointer to line received callback function
+ */
+Calypso_LineRxCallback_t Calypso_GetLineRxCallback(void)
+{
+    return Calypso_lineRxCallback;
+}
+
 /**
  * @brief Sets EOL character(s) used for interpreting responses from Calypso.
  *
@@ -38,26 +38,78 @@
 
 #include <global/global.h>
 
+#define CALYPSO_MEMORY_PROFILE_DEFAULT  0               /**< 2 KB lines and commands, 1460 byte socket payloads (4 KB arena) */
+#define CALYPSO_MEMORY_PROFILE_SMALL    1               /**< 1.5 KB lines and commands, 1024 byte socket payloads (3 KB arena) */
+#define CALYPSO_MEMORY_PROFILE_TINY     2               /**< 1088 byte lines and commands, 768 byte socket payloads (2.1 KB arena) */
+
+/**
+ * @brief Memory profile determining the size of the driver's buffer arena (see Calypso_GetMemoryReport()).
+ *
+ * The RX line buffer and the command / response buffer are carved from a single arena of
+ * CALYPSO_ARENA_SIZE bytes. The sizes of the buffers and the max. socket payload size are
+ * selected by the profile. Individual sizes can still be overridden by defining
+ * CALYPSO_LINE_MAX_SIZE, AT_MAX_COMMAND_BUFFER_SIZE or CALYPSO_MAX_PAYLOAD_SIZE.
+ */
+#ifndef CALYPSO_MEMORY_PROFILE
+#define CALYPSO_MEMORY_PROFILE CALYPSO_MEMORY_PROFILE_DEFAULT
+#endif
+
+#if CALYPSO_MEMORY_PROFILE == CALYPSO_MEMORY_PROFILE_TINY
+#define CALYPSO_PROFILE_LINE_MAX_SIZE 1088
+#define CALYPSO_PROFILE_MAX_PAYLOAD_SIZE 768
+#elif CALYPSO_MEMORY_PROFILE == CALYPSO_MEMORY_PROFILE_SMALL
+#define CALYPSO_PROFILE_LINE_MAX_SIZE 1536
+#define CALYPSO_PROFILE_MAX_PAYLOAD_SIZE 1024
+#elif CALYPSO_MEMORY_PROFILE == CALYPSO_MEMORY_PROFILE_DEFAULT
+#define CALYPSO_PROFILE_LINE_MAX_SIZE 2048
+#define CALYPSO_PROFILE_MAX_PAYLOAD_SIZE 1460
+#else
+#error "Unknown CALYPSO_MEMORY_PROFILE"
+#endif
+
 /**
  * @brief Max recommended payload size is 1460 bytes.
  */
-#define CALYPSO_MAX_PAYLOAD_SIZE 1460
+#ifndef CALYPSO_MAX_PAYLOAD_SIZE
+#define CALYPSO_MAX_PAYLOAD_SIZE CALYPSO_PROFILE_MAX_PAYLOAD_SIZE
+#endif
 
 /**
  * @brief Default receive buffer size (used when receiving data e.g. via sockets or HTTP requests).
  */
-#define CALYPSO_RECEIVE_BUFFER_SIZE 2048
+#define CALYPSO_RECEIVE_BUFFER_SIZE CALYPSO_LINE_MAX_SIZE
 
 /**
- * @brief Max. length of sent commands and responses from Calypso.
+ * @brief Max. length of responses and events received from Calypso (size of RX line buffer).
  */
-#define CALYPSO_LINE_MAX_SIZE 2048
+#ifndef CALYPSO_LINE_MAX_SIZE
+#define CALYPSO_LINE_MAX_SIZE CALYPSO_PROFILE_LINE_MAX_SIZE
+#endif
+
+/* Socket receive events contain the (possibly Base64 encoded) payload plus a short prefix */
+#if CALYPSO_LINE_MAX_SIZE < (((CALYPSO_MAX_PAYLOAD_SIZE + 2) / 3) * 4 + 32)
+#error "CALYPSO_LINE_MAX_SIZE is too small for CALYPSO_MAX_PAYLOAD_SIZE"
+#endif
 
 /**
- * @brief Max. length of response text (size of buffer storing responses received from Calypso).
- * @see Calypso_currentResponseText
+ * @brief Size of the queue used to defer the event callback to the main loop (bytes, multiple of 4).
+ *
+ * If 0 (default), the event callback is executed in interrupt context as soon as an event has
+ * been received. Otherwise, received events are added to a queue of this size and the event
+ * callback is executed by WE_Poll(), which must then be called from the application's main loop.
+ * In this case, the event callback may send AT commands. Any loop waiting for a flag set by the
+ * event callback must call WE_Poll() as well, otherwise it waits until its timeout expires
+ * (driver functions waiting for events, e.g. Calypso_WLANReconnect_Connect(), do so). Each event occupies
+ * WE_EVENT_QUEUE_RECORD_SIZE(event length + 1) bytes, events which don't fit are dropped
+ * (see Calypso_GetEventQueueStats()).
  */
-#define CALYPSO_MAX_RESPONSE_TEXT_LENGTH CALYPSO_LINE_MAX_SIZE
+#ifndef CALYPSO_EVENT_QUEUE_SIZE
+#define CALYPSO_EVENT_QUEUE_SIZE 0
+#endif
+
+#if (CALYPSO_EVENT_QUEUE_SIZE % 4) != 0
+#error "CALYPSO_EVENT_QUEUE_SIZE must be a multiple of 4"
+#endif
 
 #define CALYPSO_COMMAND_PREFIX  "AT+"                       /**< Prefix for AT commands */
 #define CALYPSO_COMMAND_DELIM   (char)'='                   /**< Character delimiting AT command and parameters */
@@ -67,10 +119,12 @@
 #define CALYPSO_EVENT_DELIM     (char)':'                   /**< Character delimiting event name and parameters in received notifications */
 #define CALYPSO_ARGUMENT_DELIM  (char)','                   /**< Character delimiting parameters in AT commands */
 #define CALYPSO_BITMASK_DELIM   (char)'|'                   /**< Character delimiting elements in bitmask parameters */
+#define CALYPSO_MAX_BITMASK_STRING_LENGTH 64               /**< Max. length of an element of a bitmask parameter (including termination character) */
 #define CALYPSO_CRLF            "\r\n"                      /**< Newline string indicating end of command (carriage return and line feed) */
 
 #define CALYPSO_RESPONSE_OK     "OK"                        /**< String sent by module if AT command was successful */
 #define CALYPSO_RESPONSE_ERROR  "error"                     /**< String sent by module if AT command failed */
+#define CALYPSO_EVENT_STARTUP   "+eventstartup"             /**< Event sent by module when it is ready for operation after (re)start */
 
 #define CALYPSO_STRING_TERMINATE '\0'                       /**< End of string character */
 #define CALYPSO_STRING_EMPTY     ""                         /**< Empty string */
@@ -168,9 +222,25 @@ typedef enum Calypso_Pin_t
     Calypso_Pin_Count
 } Calypso_Pin_t;
 
+/**
+ * @brief Zero-copy view of a string (e.g. an argument of a received response or event).
+ *
+ * The referenced text is not terminated and is only valid as long as the buffer containing
+ * it (usually the receive line buffer or the response buffer) is not modified.
+ *
+ * @see Calypso_GetNextArgumentView()
+ */
+typedef struct Calypso_StringView_t
+{
+    const char *data;                       /**< Start of string */
+    uint16_t length;                        /**< Length of string (number of characters) */
+} Calypso_StringView_t;
+
 /**
  * @brief Calypso event callback.
  * Arguments: Event text
+ *
+ * Is executed in interrupt context, unless the event queue is enabled (see CALYPSO_EVENT_QUEUE_SIZE).
  */
 typedef void (*Calypso_EventCallback_t)(char *);
 
@@ -198,6 +268,38 @@ typedef void (*Calypso_ByteRxCallback_t)(uint8_t);
  */
 typedef bool (*Calypso_LineRxCallback_t)(char *, uint16_t);
 
+/**
+ * @brief Calypso response line callback.
+ *
+ * Receives the response lines of a single request (lines starting with '+' followed by
+ * the name of the pending command).
+ *
+ * Arguments: Line text, length of text (including terminating '\0'), context pointer
+ *
+ * @see Calypso_SetResponseLineCallback()
+ */
+typedef void (*Calypso_ResponseLineCallback_t)(char *, uint16_t, void *);
+
+/**
+ * @brief Static RAM usage and buffer high-water marks of the driver.
+ *
+ * @see Calypso_GetMemoryReport(), CALYPSO_MEMORY_PROFILE
+ */
+typedef struct Calypso_MemoryReport_t
+{
+    uint8_t profile;                        /**< Memory profile (CALYPSO_MEMORY_PROFILE) */
+    size_t arenaSize;                       /**< Size of buffer arena (line buffer and command / response buffer) */
+    size_t lineBufferSize;                  /**< Size of RX line buffer (CALYPSO_LINE_MAX_SIZE) */
+    size_t commandBufferSize;               /**< Size of command / response buffer (AT_MAX_COMMAND_BUFFER_SIZE) */
+    size_t eventQueueSize;                  /**< Size of event queue (CALYPSO_EVENT_QUEUE_SIZE) */
+    size_t stateSize;                       /**< Size of the driver's other static buffers (command name, error text, timeouts, pins) */
+    size_t totalSize;                       /**< Arena, event queue and other static buffers */
+    uint16_t maxLineLength;                 /**< Longest line received so far (including termination character) */
+    size_t maxResponseLength;               /**< Longest response text received so far */
+    uint32_t lineOverflowCount;             /**< Number of received lines discarded because they exceeded the line buffer */
+    uint32_t responseOverflowCount;         /**< Number of responses truncated because they exceeded the response buffer */
+} Calypso_MemoryReport_t;
+
 extern uint8_t Calypso_firmwareVersionMajor;
 extern uint8_t Calypso_firmwareVersionMinor;
 extern uint8_t Calypso_firmwareVersionPatch;
@@ -216,10 +318,22 @@ extern bool Calypso_PinWakeUp(void);
 extern bool Calypso_SetPin(Calypso_Pin_t pin, WE_Pin_Level_t level);
 extern WE_Pin_Level_t Calypso_GetPinLevel(Calypso_Pin_t pin);
 
+extern bool Calypso_WaitForStartup(uint32_t timeoutMs);
+extern void Calypso_ResetStartupEvent(void);
+extern uint32_t Calypso_GetStartupCount(void);
+
 extern bool Calypso_SendRequest(char *data);
+extern bool Calypso_SendRequestWithData(char *command, const uint8_t *data, uint16_t dataLength);
 extern bool Calypso_WaitForConfirm(uint32_t maxTimeMs,
                                    Calypso_CNFStatus_t expectedStatus,
                                    char *pOutResponse);
+extern bool Calypso_PollConfirm(Calypso_CNFStatus_t *status, char *pOutResponse);
+extern void Calypso_SetResponseBuffer(char *buffer, size_t size);
+extern void Calypso_SetResponseLineCallback(Calypso_ResponseLineCallback_t callback, void *context);
+extern void Calypso_GetMemoryReport(Calypso_MemoryReport_t *report);
+#if CALYPSO_EVENT_QUEUE_SIZE > 0
+extern void Calypso_GetEventQueueStats(WE_EventQueue_Stats_t *stats);
+#endif
 
 extern int32_t Calypso_GetLastError(char *lastErrorText);
 
@@ -237,11 +351,19 @@ extern bool Calypso_EncodeBase64(uint8_t *inputData,
 
 extern bool Calypso_IntToString(char *outString, uint32_t number, uint16_t intFlags);
 extern bool Calypso_StringToInt(void *pOutInt, const char *pInString, uint16_t intFlags);
+extern bool Calypso_ViewToInt(void *pOutInt, Calypso_StringView_t view, uint16_t intFlags);
+extern bool Calypso_ViewToString(char *pOutString, Calypso_StringView_t view, uint16_t maxLength);
+extern bool Calypso_ViewEquals(Calypso_StringView_t view, const char *str);
 
 extern bool Calypso_AppendArgumentBytes(char *pOutString,
                                         const char *pInArgument,
                                         uint16_t numBytes,
                                         char delimiter);
+extern bool Calypso_AppendArgumentBase64(char *pOutString,
+                                         const char *pInArgument,
+                                         uint16_t numBytes,
+                                         char delimiter,
+                                         uint16_t maxStringLength);
 extern bool Calypso_AppendArgumentString(char *pOutString,
                                          const char *pInArgument,
                                          char delimiter);
@@ -258,6 +380,9 @@ extern bool Calypso_AppendArgumentBitmask(char *pOutString,
 extern bool Calypso_AppendArgumentBoolean(char *pOutString,
                                           bool inBool,
                                           char delimiter);
+extern bool Calypso_GetNextArgumentView(char **pInArguments,
+                                        Calypso_StringView_t *pOutView,
+                                        char delimiter);
 extern bool Calypso_GetNextArgumentString(char **pInArguments,
                                           char *pOutArgument,
                                           char delimiter,
@@ -287,11 +412,21 @@ extern bool Calypso_GetCmdName(char **pInAtCmd,
                                char delimiter,
                                char alternativeDelimiter);
 
+extern bool Calypso_GetCmdNameView(char **pInAtCmd,
+                                   Calypso_StringView_t *pOutView,
+                                   char delimiter,
+                                   char alternativeDelimiter);
+
 extern uint8_t Calypso_FindString(const char *stringList[],
                                   uint8_t numStrings,
                                   const char *str,
                                   uint8_t defaultValue,
                                   bool *ok);
+extern uint8_t Calypso_FindView(const char *stringList[],
+                                uint8_t numStrings,
+                                Calypso_StringView_t view,
+                                uint8_t defaultValue,
+                                bool *ok);
 
 extern bool Calypso_SetTimingParameters(uint32_t waitTimeStepMicroseconds, uint32_t minCommandIntervalMicroseconds);
 extern void Calypso_SetTimeout(Calypso_Timeout_t type, uint32_t timeout);
@@ -301,6 +436,7 @@ extern void Calypso_GetDefaultPinConfig(WE_Pin_t *pins);
 extern void Calypso_Transmit(const char *data, uint16_t dataLength);
 extern void Calypso_SetByteRxCallback(Calypso_ByteRxCallback_t callback);
 extern void Calypso_SetLineRxCallback(Calypso_LineRxCallback_t callback);
+extern Calypso_LineRxCallback_t Calypso_GetLineRxCallback(void);
 extern void Calypso_SetEolCharacters(uint8_t eol1, uint8_t eol2, bool twoEolCharacters);
 
 #ifdef __cplusplus
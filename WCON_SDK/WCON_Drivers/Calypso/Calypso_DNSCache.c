@@ -0,0 +1,327 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso DNS result cache source file.
+ */
+
+#include "Calypso_DNSCache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Calypso.h"
+
+/**
+ * @brief State of a cache entry.
+ */
+typedef enum Calypso_DNSCache_State_t
+{
+    Calypso_DNSCache_State_Free,            /**< Entry is unused */
+    Calypso_DNSCache_State_Resolved,        /**< Lookup was successful */
+    Calypso_DNSCache_State_Failed           /**< Lookup was rejected by the module */
+} Calypso_DNSCache_State_t;
+
+/**
+ * @brief Cache entry.
+ */
+typedef struct Calypso_DNSCache_Entry_t
+{
+    uint8_t state;                                          /**< Entry state (see Calypso_DNSCache_State_t) */
+    ATSocket_Family_t family;                               /**< Protocol family */
+    uint32_t timestamp;                                     /**< Time of lookup (ms) */
+    uint32_t ttlMs;                                         /**< Time to live (ms) */
+    uint32_t lastUsed;                                      /**< Time of last use (ms), used for replacement */
+    char hostName[CALYPSO_DNSCACHE_MAX_HOST_NAME_LENGTH];   /**< Host name */
+    char hostAddress[AT_MAX_IP_ADDRESS_LENGTH];             /**< IP address (resolved entries only) */
+} Calypso_DNSCache_Entry_t;
+
+static Calypso_DNSCache_Entry_t *Calypso_DNSCache_Find(const char *hostName, ATSocket_Family_t family);
+static Calypso_DNSCache_Entry_t *Calypso_DNSCache_Allocate(void);
+static bool Calypso_DNSCache_IsExpired(Calypso_DNSCache_Entry_t *entry, uint32_t now);
+
+/**
+ * @brief Cache entries.
+ */
+static Calypso_DNSCache_Entry_t Calypso_DNSCache_entries[CALYPSO_DNSCACHE_SIZE];
+
+/**
+ * @brief Time to live of successful lookups (ms).
+ */
+static uint32_t Calypso_DNSCache_ttlMs = CALYPSO_DNSCACHE_DEFAULT_TTL_MS;
+
+/**
+ * @brief Time to live of failed lookups (ms).
+ */
+static uint32_t Calypso_DNSCache_negativeTtlMs = CALYPSO_DNSCACHE_DEFAULT_NEGATIVE_TTL_MS;
+
+/**
+ * @brief Cache statistics.
+ */
+static Calypso_DNSCache_Statistics_t Calypso_DNSCache_statistics;
+
+/**
+ * @brief Initializes (clears) the cache.
+ */
+void Calypso_DNSCache_Init(void)
+{
+    memset(Calypso_DNSCache_entries, 0, sizeof(Calypso_DNSCache_entries));
+    memset(&Calypso_DNSCache_statistics, 0, sizeof(Calypso_DNSCache_statistics));
+}
+
+/**
+ * @brief Sets the time to live of new cache entries.
+ *
+ * @param[in] ttlMs Time to live of successful lookups in milliseconds
+ * @param[in] negativeTtlMs Time to live of failed lookups in milliseconds (0 to disable negative caching)
+ */
+void Calypso_DNSCache_SetTTL(uint32_t ttlMs, uint32_t negativeTtlMs)
+{
+    Calypso_DNSCache_ttlMs = ttlMs;
+    Calypso_DNSCache_negativeTtlMs = negativeTtlMs;
+}
+
+/**
+ * @brief Looks up the IP address for the supplied host name.
+ *
+ * Replacement for ATNetApp_GetHostByName() which returns cached results if available.
+ *
+ * @param[in] hostName Name of host
+ * @param[in] family Network protocol family
+ * @param[out] lookupResult The lookup result containing the IP address for the supplied host
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_DNSCache_GetHostByName(const char *hostName,
+                                    ATSocket_Family_t family,
+                                    ATNetApp_GetHostByNameResult_t *lookupResult)
+{
+    if (NULL == hostName || '\0' == hostName[0] || strlen(hostName) >= CALYPSO_DNSCACHE_MAX_HOST_NAME_LENGTH)
+    {
+        return ATNetApp_GetHostByName(hostName, family, lookupResult);
+    }
+
+    Calypso_DNSCache_Entry_t *entry = Calypso_DNSCache_Find(hostName, family);
+    uint32_t now = WE_GetTick();
+
+    if (NULL != entry && !Calypso_DNSCache_IsExpired(entry, now))
+    {
+        entry->lastUsed = now;
+        if (Calypso_DNSCache_State_Failed == entry->state)
+        {
+            Calypso_DNSCache_statistics.negativeHits++;
+            return false;
+        }
+
+        strcpy(lookupResult->hostName, entry->hostName);
+        strcpy(lookupResult->hostAddress, entry->hostAddress);
+        Calypso_DNSCache_statistics.hits++;
+        return true;
+    }
+
+    Calypso_DNSCache_statistics.misses++;
+
+    bool ret = ATNetApp_GetHostByName(hostName, family, lookupResult);
+
+    Calypso_DNSCache_State_t state = Calypso_DNSCache_State_Free;
+    if (ret && strlen(lookupResult->hostAddress) < AT_MAX_IP_ADDRESS_LENGTH)
+    {
+        state = Calypso_DNSCache_State_Resolved;
+    }
+    else if (!ret && 0 != Calypso_GetLastError(NULL) && 0 != Calypso_DNSCache_negativeTtlMs)
+    {
+        /* The module has rejected the lookup (as opposed to a timeout) */
+        state = Calypso_DNSCache_State_Failed;
+    }
+
+    if (!ret)
+    {
+        Calypso_DNSCache_statistics.failures++;
+    }
+
+    if (Calypso_DNSCache_State_Free == state)
+    {
+        /* Result is not cached - drop the expired entry (if any) */
+        if (NULL != entry)
+        {
+            entry->state = Calypso_DNSCache_State_Free;
+        }
+        return ret;
+    }
+
+    /* The entry is filled after the lookup has completed, so that the event callback (which may
+     * use the cache while the lookup is in progress) never sees an incomplete entry. */
+    if (NULL == entry)
+    {
+        entry = Calypso_DNSCache_Allocate();
+    }
+    entry->state = Calypso_DNSCache_State_Free;
+    entry->family = family;
+    strcpy(entry->hostName, hostName);
+    if (Calypso_DNSCache_State_Resolved == state)
+    {
+        strcpy(entry->hostAddress, lookupResult->hostAddress);
+        entry->ttlMs = Calypso_DNSCache_ttlMs;
+    }
+    else
+    {
+        entry->hostAddress[0] = '\0';
+        entry->ttlMs = Calypso_DNSCache_negativeTtlMs;
+    }
+    entry->timestamp = WE_GetTick();
+    entry->lastUsed = entry->timestamp;
+    entry->state = state;
+
+    return ret;
+}
+
+/**
+ * @brief Resolves the supplied host names, so that subsequent lookups are answered from the cache.
+ *
+ * Host names that are already cached (and not expired) are not looked up again.
+ *
+ * @param[in] hostNames Host names to be resolved
+ * @param[in] numHostNames Number of host names
+ * @param[in] family Network protocol family
+ *
+ * @return Number of successfully resolved host names
+ */
+uint8_t Calypso_DNSCache_Warm(const char *hostNames[],
+                              uint8_t numHostNames,
+                              ATSocket_Family_t family)
+{
+    ATNetApp_GetHostByNameResult_t lookupResult;
+    uint8_t resolved = 0;
+
+    for (uint8_t i = 0; i < numHostNames; i++)
+    {
+        if (Calypso_DNSCache_GetHostByName(hostNames[i], family, &lookupResult))
+        {
+            resolved++;
+        }
+    }
+
+    return resolved;
+}
+
+/**
+ * @brief Removes entries from the cache.
+ *
+ * @param[in] hostName Host name to be removed (all families) or NULL to remove all entries
+ */
+void Calypso_DNSCache_Flush(const char *hostName)
+{
+    for (uint8_t i = 0; i < CALYPSO_DNSCACHE_SIZE; i++)
+    {
+        Calypso_DNSCache_Entry_t *entry = &Calypso_DNSCache_entries[i];
+        if (NULL == hostName || 0 == strcmp(entry->hostName, hostName))
+        {
+            entry->state = Calypso_DNSCache_State_Free;
+        }
+    }
+}
+
+/**
+ * @brief Returns cache statistics.
+ *
+ * @param[out] statistics Cache statistics
+ */
+void Calypso_DNSCache_GetStatistics(Calypso_DNSCache_Statistics_t *statistics)
+{
+    *statistics = Calypso_DNSCache_statistics;
+}
+
+/**
+ * @brief Returns the cache entry for the supplied host name and family.
+ *
+ * @param[in] hostName Host name
+ * @param[in] family Network protocol family
+ *
+ * @return Cache entry or NULL if not found
+ */
+static Calypso_DNSCache_Entry_t *Calypso_DNSCache_Find(const char *hostName, ATSocket_Family_t family)
+{
+    for (uint8_t i = 0; i < CALYPSO_DNSCACHE_SIZE; i++)
+    {
+        Calypso_DNSCache_Entry_t *entry = &Calypso_DNSCache_entries[i];
+        if (Calypso_DNSCache_State_Free != entry->state &&
+            entry->family == family &&
+            0 == strcmp(entry->hostName, hostName))
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns an entry for a new lookup.
+ *
+ * Free entries are used first, followed by expired entries and finally by the least recently used entry.
+ *
+ * @return Cache entry
+ */
+static Calypso_DNSCache_Entry_t *Calypso_DNSCache_Allocate(void)
+{
+    uint32_t now = WE_GetTick();
+    Calypso_DNSCache_Entry_t *leastRecentlyUsed = NULL;
+
+    for (uint8_t i = 0; i < CALYPSO_DNSCACHE_SIZE; i++)
+    {
+        Calypso_DNSCache_Entry_t *entry = &Calypso_DNSCache_entries[i];
+        if (Calypso_DNSCache_State_Free == entry->state)
+        {
+            return entry;
+        }
+    }
+
+    for (uint8_t i = 0; i < CALYPSO_DNSCACHE_SIZE; i++)
+    {
+        Calypso_DNSCache_Entry_t *entry = &Calypso_DNSCache_entries[i];
+        if (Calypso_DNSCache_IsExpired(entry, now))
+        {
+            return entry;
+        }
+        if (NULL == leastRecentlyUsed || now - entry->lastUsed > now - leastRecentlyUsed->lastUsed)
+        {
+            leastRecentlyUsed = entry;
+        }
+    }
+
+    return leastRecentlyUsed;
+}
+
+/**
+ * @brief Checks if a (resolved or failed) cache entry has expired.
+ *
+ * @param[in] entry Cache entry
+ * @param[in] now Current time (ms)
+ *
+ * @return true if the entry has expired, false otherwise
+ */
+static bool Calypso_DNSCache_IsExpired(Calypso_DNSCache_Entry_t *entry, uint32_t now)
+{
+    return (now - entry->timestamp >= entry->ttlMs);
+}
@@ -0,0 +1,110 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso DNS result cache header file.
+ *
+ * Caches the results of ATNetApp_GetHostByName() on the host side, so that repeated lookups of
+ * the same host names (e.g. when reconnecting after a WLAN disconnect) are answered without
+ * sending a request to the module.
+ *
+ * - Entries are stored per host name and protocol family (IPv4 / IPv6).
+ * - Each entry expires after its time to live. As the module doesn't report the DNS record's TTL,
+ *   the TTL is configurable (see Calypso_DNSCache_SetTTL()).
+ * - Lookups rejected by the module (e.g. unknown host) are cached as well (negative caching)
+ *   using a separate, shorter TTL. Timeouts are not cached.
+ * - Cache hits don't communicate with the module and may thus also be used from within the
+ *   Calypso event callback.
+ *
+ * Host names longer than CALYPSO_DNSCACHE_MAX_HOST_NAME_LENGTH - 1 are not cached.
+ */
+
+#ifndef CALYPSO_DNSCACHE_H_INCLUDED
+#define CALYPSO_DNSCACHE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ATCommands/ATNetApp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Max. number of cached host names.
+ */
+#ifndef CALYPSO_DNSCACHE_SIZE
+#define CALYPSO_DNSCACHE_SIZE 8
+#endif
+
+/**
+ * @brief Max. length of cached host names (including terminating '\0').
+ */
+#ifndef CALYPSO_DNSCACHE_MAX_HOST_NAME_LENGTH
+#define CALYPSO_DNSCACHE_MAX_HOST_NAME_LENGTH 64
+#endif
+
+/**
+ * @brief Default time to live of successful lookups in milliseconds.
+ */
+#ifndef CALYPSO_DNSCACHE_DEFAULT_TTL_MS
+#define CALYPSO_DNSCACHE_DEFAULT_TTL_MS 300000
+#endif
+
+/**
+ * @brief Default time to live of failed lookups in milliseconds.
+ */
+#ifndef CALYPSO_DNSCACHE_DEFAULT_NEGATIVE_TTL_MS
+#define CALYPSO_DNSCACHE_DEFAULT_NEGATIVE_TTL_MS 10000
+#endif
+
+/**
+ * @brief Cache statistics as returned by Calypso_DNSCache_GetStatistics().
+ */
+typedef struct Calypso_DNSCache_Statistics_t
+{
+    uint32_t hits;              /**< Lookups answered from the cache (successful lookups) */
+    uint32_t negativeHits;      /**< Lookups answered from the cache (failed lookups) */
+    uint32_t misses;            /**< Lookups sent to the module */
+    uint32_t failures;          /**< Lookups sent to the module that failed */
+} Calypso_DNSCache_Statistics_t;
+
+extern void Calypso_DNSCache_Init(void);
+extern void Calypso_DNSCache_SetTTL(uint32_t ttlMs, uint32_t negativeTtlMs);
+extern bool Calypso_DNSCache_GetHostByName(const char *hostName,
+                                           ATSocket_Family_t family,
+                                           ATNetApp_GetHostByNameResult_t *lookupResult);
+extern uint8_t Calypso_DNSCache_Warm(const char *hostNames[],
+                                     uint8_t numHostNames,
+                                     ATSocket_Family_t family);
+extern void Calypso_DNSCache_Flush(const char *hostName);
+extern void Calypso_DNSCache_GetStatistics(Calypso_DNSCache_Statistics_t *statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_DNSCACHE_H_INCLUDED
@@ -0,0 +1,741 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Calypso file streaming source file.
+ */
+
+#include "Calypso_FileStream.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Calypso.h"
+#include "ATCommands/ATFile.h"
+
+#if (CALYPSO_FILESTREAM_MIN_CHUNK_SIZE % 3) != 0 || (CALYPSO_FILESTREAM_MAX_CHUNK_SIZE % 3) != 0
+#error "CALYPSO_FILESTREAM_MIN_CHUNK_SIZE and CALYPSO_FILESTREAM_MAX_CHUNK_SIZE must be multiples of 3"
+#endif
+
+#if CALYPSO_FILESTREAM_MIN_CHUNK_SIZE > CALYPSO_FILESTREAM_MAX_CHUNK_SIZE
+#error "CALYPSO_FILESTREAM_MIN_CHUNK_SIZE must not exceed CALYPSO_FILESTREAM_MAX_CHUNK_SIZE"
+#endif
+
+/**
+ * @brief Size of the receive buffer (response prefix "+fileread:<format>,<length>," and Base64 encoded chunk).
+ */
+#define CALYPSO_FILESTREAM_BUFFER_SIZE (32 + ((CALYPSO_FILESTREAM_MAX_CHUNK_SIZE / 3) * 4) + 1)
+
+#if CALYPSO_FILESTREAM_BUFFER_SIZE > CALYPSO_LINE_MAX_SIZE
+#error "CALYPSO_FILESTREAM_MAX_CHUNK_SIZE is too large for CALYPSO_LINE_MAX_SIZE"
+#endif
+
+/**
+ * @brief Max. length of AT+fileRead commands and AT+fileWrite command prefixes.
+ */
+#define CALYPSO_FILESTREAM_COMMAND_MAX_LENGTH 64
+
+static bool Calypso_FileStream_SendReadRequest(void);
+static bool Calypso_FileStream_NextChunk(void);
+static bool Calypso_FileStream_ReceiveReadResponse(void);
+static bool Calypso_FileStream_WaitForPendingRequest(void);
+static void Calypso_FileStream_UpdateCycleTime(uint16_t chunkBytes);
+static void Calypso_FileStream_UpdateChunkSize(uint32_t roundTripUsec, uint16_t uartBytes);
+
+/**
+ * @brief Is set to true while a stream is open.
+ */
+static bool Calypso_FileStream_open = false;
+
+/**
+ * @brief Is set to true if the stream has been opened for writing.
+ */
+static bool Calypso_FileStream_writing = false;
+
+/**
+ * @brief Is set to true if a request has been sent whose confirmation has not been received yet.
+ */
+static bool Calypso_FileStream_requestPending = false;
+
+/**
+ * @brief Is set to true if a write request failed (reported by Calypso_FileStream_Write() or Calypso_FileStream_Close()).
+ */
+static bool Calypso_FileStream_failed = false;
+
+/**
+ * @brief ID of the open file.
+ */
+static uint32_t Calypso_FileStream_fileID = 0;
+
+/**
+ * @brief File size (reading) or max. file size (writing).
+ */
+static uint32_t Calypso_FileStream_fileSize = 0;
+
+/**
+ * @brief File offset of the next read or write request.
+ */
+static uint32_t Calypso_FileStream_offset = 0;
+
+/**
+ * @brief Number of bytes transferred on the UART by the pending request (used for adapting the chunk size).
+ */
+static uint16_t Calypso_FileStream_pendingUartBytes = 0;
+
+/**
+ * @brief Time at which the pending request has been sent (microseconds).
+ */
+static uint32_t Calypso_FileStream_requestTimeUsec = 0;
+
+/**
+ * @brief Receive buffer. Holds the response to the pending AT+fileRead or AT+fileWrite request.
+ */
+static char Calypso_FileStream_buffer[CALYPSO_FILESTREAM_BUFFER_SIZE];
+
+/**
+ * @brief Decoded data of the last received chunk. Separate from Calypso_FileStream_buffer, as the
+ * response to the read-ahead request is written to that buffer while the application consumes the chunk.
+ */
+static uint8_t Calypso_FileStream_chunkBuffer[CALYPSO_FILESTREAM_MAX_CHUNK_SIZE + 1];
+
+/**
+ * @brief Decoded data of the current chunk which has not been consumed yet.
+ */
+static const uint8_t *Calypso_FileStream_chunkData = NULL;
+static uint16_t Calypso_FileStream_chunkRemaining = 0;
+
+/**
+ * @brief Time at which the current chunk has been made available to the application (microseconds).
+ */
+static uint32_t Calypso_FileStream_chunkReadyUsec = 0;
+
+/**
+ * @brief Is set to true if the request for the chunk following the current one has been sent
+ * as soon as the current chunk had been received (read-ahead).
+ */
+static bool Calypso_FileStream_readAhead = false;
+
+/**
+ * @brief Smoothed time per byte from one chunk to the next in 1/16 microseconds, without
+ * (index 0) and with (index 1) read-ahead (0 if unknown).
+ */
+static uint32_t Calypso_FileStream_cycleUsecPerByte16[2] = {0, 0};
+
+/**
+ * @brief Number of chunks since the mode that is currently slower has last been tried.
+ */
+static uint8_t Calypso_FileStream_probeCounter = 0;
+
+/**
+ * @brief Current chunk size.
+ */
+static uint16_t Calypso_FileStream_chunkSize = CALYPSO_FILESTREAM_MAX_CHUNK_SIZE;
+
+/**
+ * @brief Round trip time of a command without payload (microseconds), measured when opening the file.
+ */
+static uint32_t Calypso_FileStream_overheadUsec = 0;
+
+/**
+ * @brief Smoothed UART transfer time per byte in 1/16 microseconds (0 if unknown).
+ */
+static uint32_t Calypso_FileStream_usecPerByte16 = 0;
+
+/**
+ * @brief Transfer statistics.
+ */
+static uint32_t Calypso_FileStream_bytesTransferred = 0;
+static uint32_t Calypso_FileStream_chunks = 0;
+static uint32_t Calypso_FileStream_startTick = 0;
+
+/**
+ * @brief Opens a file for reading and requests the first chunk.
+ *
+ * @param[in] fileName Name of the file
+ * @param[out] fileSize Size of the file (optional). Can be NULL if not used.
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_FileStream_OpenRead(const char *fileName, uint32_t *fileSize)
+{
+    if (Calypso_FileStream_open || NULL == fileName)
+    {
+        return false;
+    }
+
+    Calypso_FileStream_startTick = WE_GetTick();
+
+    ATFile_FileInfo_t fileInfo;
+    if (!ATFile_GetInfo(fileName, 0, &fileInfo))
+    {
+        return false;
+    }
+
+    uint32_t t0 = WE_GetTickMicroseconds();
+    uint32_t secureToken = 0;
+    if (!ATFile_Open(fileName, ATFile_OpenFlags_Read, ATFILE_FILE_MIN_SIZE, &Calypso_FileStream_fileID, &secureToken))
+    {
+        return false;
+    }
+    Calypso_FileStream_overheadUsec = WE_GetTickMicroseconds() - t0;
+
+    Calypso_FileStream_open = true;
+    Calypso_FileStream_writing = false;
+    Calypso_FileStream_requestPending = false;
+    Calypso_FileStream_failed = false;
+    Calypso_FileStream_fileSize = fileInfo.size;
+    Calypso_FileStream_offset = 0;
+    Calypso_FileStream_chunkData = NULL;
+    Calypso_FileStream_chunkRemaining = 0;
+    Calypso_FileStream_chunkSize = CALYPSO_FILESTREAM_MAX_CHUNK_SIZE;
+    Calypso_FileStream_usecPerByte16 = 0;
+    Calypso_FileStream_readAhead = true;
+    Calypso_FileStream_cycleUsecPerByte16[0] = 0;
+    Calypso_FileStream_cycleUsecPerByte16[1] = 0;
+    Calypso_FileStream_probeCounter = 0;
+    Calypso_FileStream_bytesTransferred = 0;
+    Calypso_FileStream_chunks = 0;
+
+    if (NULL != fileSize)
+    {
+        *fileSize = fileInfo.size;
+    }
+
+    if (!Calypso_FileStream_SendReadRequest())
+    {
+        Calypso_FileStream_Close();
+        return false;
+    }
+    Calypso_FileStream_chunkReadyUsec = WE_GetTickMicroseconds();
+
+    return true;
+}
+
+/**
+ * @brief Creates (or overwrites) a file and opens it for writing.
+ *
+ * @param[in] fileName Name of the file
+ * @param[in] maxFileSize Maximum size of the file (allocated on creation)
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_FileStream_OpenWrite(const char *fileName, uint32_t maxFileSize)
+{
+    if (Calypso_FileStream_open || NULL == fileName)
+    {
+        return false;
+    }
+
+    Calypso_FileStream_startTick = WE_GetTick();
+
+    uint32_t t0 = WE_GetTickMicroseconds();
+    uint32_t secureToken = 0;
+    if (!ATFile_Open(fileName,
+                     (ATFile_OpenFlags_Create | ATFile_OpenFlags_Overwrite),
+                     maxFileSize,
+                     &Calypso_FileStream_fileID,
+                     &secureToken))
+    {
+        return false;
+    }
+    Calypso_FileStream_overheadUsec = WE_GetTickMicroseconds() - t0;
+
+    Calypso_FileStream_open = true;
+    Calypso_FileStream_writing = true;
+    Calypso_FileStream_requestPending = false;
+    Calypso_FileStream_failed = false;
+    Calypso_FileStream_fileSize = maxFileSize;
+    Calypso_FileStream_offset = 0;
+    Calypso_FileStream_chunkData = NULL;
+    Calypso_FileStream_chunkRemaining = 0;
+    Calypso_FileStream_chunkSize = CALYPSO_FILESTREAM_MAX_CHUNK_SIZE;
+    Calypso_FileStream_usecPerByte16 = 0;
+    Calypso_FileStream_bytesTransferred = 0;
+    Calypso_FileStream_chunks = 0;
+
+    return true;
+}
+
+/**
+ * @brief Returns the next chunk of data without copying it.
+ *
+ * The returned data is valid until the next call of a Calypso_FileStream function.
+ * While the application processes the data, the module is already reading the next chunk.
+ *
+ * @param[out] data Pointer to the data
+ * @param[out] length Number of bytes (0 if the end of the file has been reached)
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_FileStream_ReadChunk(const uint8_t **data, uint16_t *length)
+{
+    *data = NULL;
+    *length = 0;
+
+    if (!Calypso_FileStream_open || Calypso_FileStream_writing)
+    {
+        return false;
+    }
+
+    if (0 == Calypso_FileStream_chunkRemaining)
+    {
+        if (!Calypso_FileStream_NextChunk())
+        {
+            return false;
+        }
+    }
+
+    *data = Calypso_FileStream_chunkData;
+    *length = Calypso_FileStream_chunkRemaining;
+    Calypso_FileStream_chunkData += Calypso_FileStream_chunkRemaining;
+    Calypso_FileStream_chunkRemaining = 0;
+
+    return true;
+}
+
+/**
+ * @brief Reads data from the file.
+ *
+ * @param[out] buffer Buffer the data is copied to
+ * @param[in] maxLength Size of the buffer
+ * @param[out] bytesRead Number of bytes read (less than maxLength only if the end of the file has been reached)
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_FileStream_Read(uint8_t *buffer, uint16_t maxLength, uint16_t *bytesRead)
+{
+    *bytesRead = 0;
+
+    if (!Calypso_FileStream_open || Calypso_FileStream_writing)
+    {
+        return false;
+    }
+
+    while (*bytesRead < maxLength)
+    {
+        if (0 == Calypso_FileStream_chunkRemaining)
+        {
+            if (!Calypso_FileStream_NextChunk())
+            {
+                return false;
+            }
+            if (0 == Calypso_FileStream_chunkRemaining)
+            {
+                /* End of file */
+                break;
+            }
+        }
+
+        uint16_t length = maxLength - *bytesRead;
+        if (length > Calypso_FileStream_chunkRemaining)
+        {
+            length = Calypso_FileStream_chunkRemaining;
+        }
+
+        memcpy(buffer + *bytesRead, Calypso_FileStream_chunkData, length);
+        Calypso_FileStream_chunkData += length;
+        Calypso_FileStream_chunkRemaining -= length;
+        *bytesRead += length;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes data to the file.
+ *
+ * The data is sent in binary format directly from the supplied buffer. Returns as soon as the
+ * last chunk has been transmitted, i.e. the buffer may be reused when the function returns.
+ * The confirmation of the last chunk is checked by the next call to Calypso_FileStream_Write()
+ * or Calypso_FileStream_Close().
+ *
+ * @param[in] data Data to be written
+ * @param[in] length Number of bytes
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_FileStream_Write(const uint8_t *data, uint16_t length)
+{
+    if (!Calypso_FileStream_open || !Calypso_FileStream_writing || Calypso_FileStream_failed)
+    {
+        return false;
+    }
+
+    if (Calypso_FileStream_offset + length > Calypso_FileStream_fileSize)
+    {
+        fprintf(stdout, "File stream exceeds max. file size (%lu bytes)\n", Calypso_FileStream_fileSize);
+        return false;
+    }
+
+    uint16_t chunkOffset = 0;
+    while (chunkOffset < length)
+    {
+        if (!Calypso_FileStream_WaitForPendingRequest())
+        {
+            return false;
+        }
+
+        uint16_t chunkSize = length - chunkOffset;
+        if (chunkSize > Calypso_FileStream_chunkSize)
+        {
+            chunkSize = Calypso_FileStream_chunkSize;
+        }
+
+        char command[CALYPSO_FILESTREAM_COMMAND_MAX_LENGTH];
+        strcpy(command, "AT+fileWrite=");
+        if (!Calypso_AppendArgumentInt(command, Calypso_FileStream_fileID, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+            !Calypso_AppendArgumentInt(command, Calypso_FileStream_offset, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+            !Calypso_AppendArgumentInt(command, Calypso_DataFormat_Binary, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+            !Calypso_AppendArgumentInt(command, chunkSize, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM))
+        {
+            return false;
+        }
+
+        /* Receive the response directly into the stream buffer */
+        Calypso_SetResponseBuffer(Calypso_FileStream_buffer, sizeof(Calypso_FileStream_buffer));
+        Calypso_FileStream_requestTimeUsec = WE_GetTickMicroseconds();
+        if (!Calypso_SendRequestWithData(command, data + chunkOffset, chunkSize))
+        {
+            return false;
+        }
+        Calypso_FileStream_requestPending = true;
+        Calypso_FileStream_pendingUartBytes = chunkSize;
+
+        Calypso_FileStream_offset += chunkSize;
+        Calypso_FileStream_bytesTransferred += chunkSize;
+        Calypso_FileStream_chunks++;
+        chunkOffset += chunkSize;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Waits for pending requests and closes the file.
+ *
+ * @return true if successful (i.e. all data has been written), false otherwise
+ */
+bool Calypso_FileStream_Close(void)
+{
+    if (!Calypso_FileStream_open)
+    {
+        return false;
+    }
+
+    bool ok = Calypso_FileStream_WaitForPendingRequest();
+
+    Calypso_FileStream_open = false;
+    Calypso_FileStream_chunkRemaining = 0;
+
+    if (!ATFile_Close(Calypso_FileStream_fileID, NULL, NULL))
+    {
+        ok = false;
+    }
+
+    return ok && !Calypso_FileStream_failed;
+}
+
+/**
+ * @brief Returns the transfer statistics of the current (or last) stream.
+ *
+ * @param[out] statistics Transfer statistics
+ */
+void Calypso_FileStream_GetStatistics(Calypso_FileStream_Statistics_t *statistics)
+{
+    statistics->bytesTransferred = Calypso_FileStream_bytesTransferred;
+    statistics->chunks = Calypso_FileStream_chunks;
+    statistics->chunkSize = Calypso_FileStream_chunkSize;
+    statistics->elapsedMs = WE_GetTick() - Calypso_FileStream_startTick;
+}
+
+/**
+ * @brief Sends the AT+fileRead request for the next chunk (if the end of the file has not been reached).
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_FileStream_SendReadRequest(void)
+{
+    if (Calypso_FileStream_offset >= Calypso_FileStream_fileSize)
+    {
+        return true;
+    }
+
+    uint16_t chunkSize = Calypso_FileStream_chunkSize;
+    if (Calypso_FileStream_fileSize - Calypso_FileStream_offset < chunkSize)
+    {
+        chunkSize = Calypso_FileStream_fileSize - Calypso_FileStream_offset;
+    }
+
+    char command[CALYPSO_FILESTREAM_COMMAND_MAX_LENGTH];
+    strcpy(command, "AT+fileRead=");
+    if (!Calypso_AppendArgumentInt(command, Calypso_FileStream_fileID, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_AppendArgumentInt(command, Calypso_FileStream_offset, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_AppendArgumentInt(command, Calypso_DataFormat_Base64, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_AppendArgumentInt(command, chunkSize, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_STRING_TERMINATE) ||
+        !Calypso_AppendArgumentString(command, CALYPSO_CRLF, CALYPSO_STRING_TERMINATE))
+    {
+        return false;
+    }
+
+    /* Receive the response directly into the stream buffer */
+    Calypso_SetResponseBuffer(Calypso_FileStream_buffer, sizeof(Calypso_FileStream_buffer));
+    Calypso_FileStream_requestTimeUsec = WE_GetTickMicroseconds();
+    if (!Calypso_SendRequest(command))
+    {
+        return false;
+    }
+    Calypso_FileStream_requestPending = true;
+    Calypso_FileStream_pendingUartBytes = Calypso_GetBase64EncBufSize(chunkSize) - 1;
+
+    return true;
+}
+
+/**
+ * @brief Makes the next chunk available, sending its request first if it hasn't been read ahead.
+ *
+ * @return true if successful (Calypso_FileStream_chunkRemaining is 0 at the end of the file), false otherwise
+ */
+static bool Calypso_FileStream_NextChunk(void)
+{
+    if (!Calypso_FileStream_requestPending)
+    {
+        if (!Calypso_FileStream_SendReadRequest())
+        {
+            return false;
+        }
+        if (!Calypso_FileStream_requestPending)
+        {
+            /* End of file */
+            return true;
+        }
+    }
+
+    return Calypso_FileStream_ReceiveReadResponse();
+}
+
+/**
+ * @brief Waits for the response to the pending AT+fileRead request, decodes the chunk
+ * and sends the request for the next chunk (read-ahead).
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_FileStream_ReceiveReadResponse(void)
+{
+    uint32_t waitStartUsec = WE_GetTickMicroseconds();
+
+    Calypso_FileStream_requestPending = false;
+    if (!Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_FileIO), Calypso_CNFStatus_Success, Calypso_FileStream_buffer))
+    {
+        return false;
+    }
+
+    uint32_t now = WE_GetTickMicroseconds();
+    if (now - waitStartUsec >= 1000)
+    {
+        /* Only use the round trip time if the confirmation hasn't been waiting for the application */
+        Calypso_FileStream_UpdateChunkSize(now - Calypso_FileStream_requestTimeUsec, Calypso_FileStream_pendingUartBytes);
+    }
+
+    char *pRespondCommand = Calypso_FileStream_buffer;
+    const char *cmd = "+fileread:";
+    const size_t cmdLength = strlen(cmd);
+
+    if (0 != strncmp(pRespondCommand, cmd, cmdLength))
+    {
+        return false;
+    }
+    pRespondCommand += cmdLength;
+
+    uint8_t format = 0;
+    uint16_t length = 0;
+    if (!Calypso_GetNextArgumentInt(&pRespondCommand, &format, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_GetNextArgumentInt(&pRespondCommand, &length, CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED, CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
+    }
+
+    if (Calypso_DataFormat_Base64 != format ||
+            0 == length ||
+            length > (CALYPSO_FILESTREAM_MAX_CHUNK_SIZE / 3) * 4 ||
+            (size_t) (pRespondCommand - Calypso_FileStream_buffer) + length > sizeof(Calypso_FileStream_buffer))
+    {
+        return false;
+    }
+
+    /* Decode to the chunk buffer, so that the receive buffer is free for the read-ahead request */
+    uint32_t decodedSize = 0;
+    if (!Calypso_DecodeBase64((uint8_t*) pRespondCommand, length, Calypso_FileStream_chunkBuffer, &decodedSize))
+    {
+        return false;
+    }
+
+    Calypso_FileStream_chunkData = Calypso_FileStream_chunkBuffer;
+    Calypso_FileStream_chunkRemaining = decodedSize - 1;
+    Calypso_FileStream_offset += Calypso_FileStream_chunkRemaining;
+    Calypso_FileStream_bytesTransferred += Calypso_FileStream_chunkRemaining;
+    Calypso_FileStream_chunks++;
+
+    /* Read ahead while the application consumes this chunk. A request sent right after a
+     * confirmation has to wait for the driver's minimum command interval and its confirmation
+     * is only polled once the application asks for the next chunk, so the read-ahead slows
+     * down applications that consume the data quickly. The time per chunk is therefore measured
+     * with and without read-ahead and the faster mode is used. The slower mode is tried again
+     * every CALYPSO_FILESTREAM_PROBE_INTERVAL chunks, in case the application's speed changes. */
+    Calypso_FileStream_UpdateCycleTime(Calypso_FileStream_chunkRemaining);
+    Calypso_FileStream_chunkReadyUsec = WE_GetTickMicroseconds();
+
+    if (Calypso_FileStream_readAhead)
+    {
+        return Calypso_FileStream_SendReadRequest();
+    }
+    return true;
+}
+
+/**
+ * @brief Adds the time since the previous chunk to the cycle time of the mode used for this
+ * chunk and selects the mode (read-ahead or not) for the next chunk.
+ *
+ * @param[in] chunkBytes Number of bytes in the chunk that has just been received
+ */
+static void Calypso_FileStream_UpdateCycleTime(uint16_t chunkBytes)
+{
+    uint32_t *cycle = &Calypso_FileStream_cycleUsecPerByte16[Calypso_FileStream_readAhead ? 1 : 0];
+    uint32_t sample = ((WE_GetTickMicroseconds() - Calypso_FileStream_chunkReadyUsec) * 16) / chunkBytes;
+    *cycle = (0 == *cycle) ? sample : ((3 * *cycle) + sample) / 4;
+
+    if (0 == Calypso_FileStream_cycleUsecPerByte16[0])
+    {
+        /* Started with read-ahead, try without */
+        Calypso_FileStream_readAhead = false;
+        return;
+    }
+
+    bool faster = Calypso_FileStream_cycleUsecPerByte16[1] <= Calypso_FileStream_cycleUsecPerByte16[0];
+    if (++Calypso_FileStream_probeCounter >= CALYPSO_FILESTREAM_PROBE_INTERVAL)
+    {
+        Calypso_FileStream_probeCounter = 0;
+        Calypso_FileStream_readAhead = !faster;
+    }
+    else
+    {
+        Calypso_FileStream_readAhead = faster;
+    }
+}
+
+/**
+ * @brief Waits for the confirmation of the pending request (if any).
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_FileStream_WaitForPendingRequest(void)
+{
+    if (!Calypso_FileStream_requestPending)
+    {
+        return true;
+    }
+
+    if (!Calypso_FileStream_writing)
+    {
+        /* Discard read-ahead data */
+        Calypso_FileStream_requestPending = false;
+        return Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_FileIO), Calypso_CNFStatus_Success, Calypso_FileStream_buffer);
+    }
+
+    uint32_t waitStartUsec = WE_GetTickMicroseconds();
+
+    Calypso_FileStream_requestPending = false;
+    if (!Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_FileIO), Calypso_CNFStatus_Success, Calypso_FileStream_buffer))
+    {
+        Calypso_FileStream_failed = true;
+        return false;
+    }
+
+    uint32_t now = WE_GetTickMicroseconds();
+    if (now - waitStartUsec >= 1000)
+    {
+        Calypso_FileStream_UpdateChunkSize(now - Calypso_FileStream_requestTimeUsec, Calypso_FileStream_pendingUartBytes);
+    }
+
+    const char *cmd = "+filewrite:";
+    if (0 != strncmp(Calypso_FileStream_buffer, cmd, strlen(cmd)))
+    {
+        Calypso_FileStream_failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Adapts the chunk size to the measured UART transfer time.
+ *
+ * The transfer time per byte is estimated from the round trip time of a chunk minus the
+ * round trip time of a command without payload. The chunk size is then chosen such that a
+ * round trip takes about CALYPSO_FILESTREAM_TARGET_CHUNK_TIME_MS.
+ *
+ * @param[in] roundTripUsec Round trip time of the last chunk
+ * @param[in] uartBytes Number of payload bytes transferred on the UART (Base64 encoded when reading)
+ */
+static void Calypso_FileStream_UpdateChunkSize(uint32_t roundTripUsec, uint16_t uartBytes)
+{
+    if (roundTripUsec > Calypso_FileStream_overheadUsec && uartBytes > 0)
+    {
+        uint32_t sample = ((roundTripUsec - Calypso_FileStream_overheadUsec) * 16) / uartBytes;
+        if (0 == Calypso_FileStream_usecPerByte16)
+        {
+            Calypso_FileStream_usecPerByte16 = sample;
+        }
+        else
+        {
+            Calypso_FileStream_usecPerByte16 = (3 * Calypso_FileStream_usecPerByte16 + sample) / 4;
+        }
+    }
+
+    if (0 == Calypso_FileStream_usecPerByte16)
+    {
+        return;
+    }
+
+    uint32_t targetUsec = CALYPSO_FILESTREAM_TARGET_CHUNK_TIME_MS * 1000;
+    uint32_t budgetUsec = (targetUsec > Calypso_FileStream_overheadUsec) ? (targetUsec - Calypso_FileStream_overheadUsec) : 0;
+    uint32_t chunkSize = (budgetUsec * 16) / Calypso_FileStream_usecPerByte16;
+    if (!Calypso_FileStream_writing)
+    {
+        /* Base64 encoded data is 4/3 the size of the decoded data */
+        chunkSize = (chunkSize * 3) / 4;
+    }
+
+    if (chunkSize < CALYPSO_FILESTREAM_MIN_CHUNK_SIZE)
+    {
+        chunkSize = CALYPSO_FILESTREAM_MIN_CHUNK_SIZE;
+    }
+    else if (chunkSize > CALYPSO_FILESTREAM_MAX_CHUNK_SIZE)
+    {
+        chunkSize = CALYPSO_FILESTREAM_MAX_CHUNK_SIZE;
+    }
+
+    Calypso_FileStream_chunkSize = chunkSize - (chunkSize % 3);
+}
@@ -0,0 +1,110 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Calypso file streaming header file.
+ *
+ * Reads and writes large files on the module's file system in chunks, keeping the module busy
+ * while the application processes data:
+ * - Reading: As soon as a chunk has been received, the request for the next chunk is sent
+ *   (read-ahead). The module processes this request while the application consumes the current
+ *   chunk. For applications that consume the data faster than the read-ahead saves, the request
+ *   is sent when the next chunk is needed instead (the faster mode is selected by measuring the
+ *   time per chunk). Chunks are transferred in Base64 format (binary data can't be received
+ *   reliably, as responses are line based).
+ * - Writing: Data is sent in binary format directly from the caller's buffer. The function
+ *   returns as soon as the data has been transmitted; the confirmation is collected by the
+ *   next call (write-behind).
+ *
+ * The chunk size is adapted to the measured UART transfer time, so that a chunk round trip
+ * doesn't take longer than CALYPSO_FILESTREAM_TARGET_CHUNK_TIME_MS.
+ *
+ * Only one stream can be open at a time. While a stream is open, no other AT commands may be
+ * sent, as the module may still be processing a read-ahead or write request.
+ */
+
+#ifndef CALYPSO_FILESTREAM_H_INCLUDED
+#define CALYPSO_FILESTREAM_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Min. number of bytes transferred per chunk (must be a multiple of 3).
+ */
+#ifndef CALYPSO_FILESTREAM_MIN_CHUNK_SIZE
+#define CALYPSO_FILESTREAM_MIN_CHUNK_SIZE 96
+#endif
+
+/**
+ * @brief Max. number of bytes transferred per chunk (must be a multiple of 3).
+ */
+#ifndef CALYPSO_FILESTREAM_MAX_CHUNK_SIZE
+#define CALYPSO_FILESTREAM_MAX_CHUNK_SIZE 750
+#endif
+
+/**
+ * @brief Target duration of a chunk round trip (request, UART transfer and confirmation).
+ */
+#ifndef CALYPSO_FILESTREAM_TARGET_CHUNK_TIME_MS
+#define CALYPSO_FILESTREAM_TARGET_CHUNK_TIME_MS 250
+#endif
+
+/**
+ * @brief Number of chunks after which reading with and without read-ahead is compared again.
+ */
+#ifndef CALYPSO_FILESTREAM_PROBE_INTERVAL
+#define CALYPSO_FILESTREAM_PROBE_INTERVAL 16
+#endif
+
+/**
+ * @brief Transfer statistics as returned by Calypso_FileStream_GetStatistics().
+ */
+typedef struct Calypso_FileStream_Statistics_t
+{
+    uint32_t bytesTransferred;      /**< Number of bytes read or written */
+    uint32_t chunks;                /**< Number of AT+fileRead or AT+fileWrite commands */
+    uint16_t chunkSize;             /**< Current chunk size */
+    uint32_t elapsedMs;             /**< Time since opening the stream */
+} Calypso_FileStream_Statistics_t;
+
+extern bool Calypso_FileStream_OpenRead(const char *fileName, uint32_t *fileSize);
+extern bool Calypso_FileStream_OpenWrite(const char *fileName, uint32_t maxFileSize);
+extern bool Calypso_FileStream_ReadChunk(const uint8_t **data, uint16_t *length);
+extern bool Calypso_FileStream_Read(uint8_t *buffer, uint16_t maxLength, uint16_t *bytesRead);
+extern bool Calypso_FileStream_Write(const uint8_t *data, uint16_t length);
+extern bool Calypso_FileStream_Close(void);
+extern void Calypso_FileStream_GetStatistics(Calypso_FileStream_Statistics_t *statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_FILESTREAM_H_INCLUDED
@@ -0,0 +1,376 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Calypso HTTP download source file.
+ */
+
+#include "Calypso_HTTPDownload.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Calypso.h"
+#include "ATCommands/ATCommands.h"
+#include "ATCommands/ATFile.h"
+
+#if (CALYPSO_HTTPDOWNLOAD_CHUNK_SIZE % 3) != 0
+#error "CALYPSO_HTTPDOWNLOAD_CHUNK_SIZE must be a multiple of 3"
+#endif
+
+/**
+ * @brief Offset in AT_commandBuffer at which the AT+httpReadResBody response is stored.
+ *
+ * Together with the response prefix "+httpreadresbody:<handle>,<more>,<format>,<length>,", this
+ * leaves enough room to write the AT+fileWrite command prefix directly in front of the received data.
+ */
+#define CALYPSO_HTTPDOWNLOAD_HEADROOM 32
+
+/**
+ * @brief Max. length of the AT+fileWrite command prefix "AT+fileWrite=<id>,<offset>,<format>,<length>,".
+ */
+#define CALYPSO_HTTPDOWNLOAD_WRITE_PREFIX_MAX_LENGTH 48
+
+/**
+ * @brief Number of Base64 characters decoded at once when updating the CRC.
+ */
+#define CALYPSO_HTTPDOWNLOAD_CRC_BLOCK_SIZE 64
+
+/**
+ * @brief Size of the buffer receiving the AT+fileWrite response "+filewrite:<length>".
+ */
+#define CALYPSO_HTTPDOWNLOAD_WRITE_RESPONSE_SIZE 32
+
+static bool Calypso_HTTPDownload_ReadChunk(uint8_t clientHandle, bool *hasMoreData, char **data, uint16_t *length);
+static bool Calypso_HTTPDownload_WriteChunk(uint32_t fileID, uint32_t offset, char *data, uint16_t length, uint32_t *crc);
+static uint32_t Calypso_HTTPDownload_Crc32Base64(uint32_t crc, const char *data, uint16_t length);
+
+/**
+ * @brief Receives the AT+fileWrite response.
+ *
+ * The Base64 data of the chunk in AT_commandBuffer is still needed for the CRC after the
+ * AT+fileWrite command has been sent, so the response must not be written to AT_commandBuffer.
+ */
+static char Calypso_HTTPDownload_writeResponse[CALYPSO_HTTPDOWNLOAD_WRITE_RESPONSE_SIZE];
+
+/**
+ * @brief CRC-32 (reflected polynomial 0xEDB88320) lookup table for 4 bit nibbles.
+ */
+static const uint32_t Calypso_HTTPDownload_crcTable[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/**
+ * @brief Downloads the body of an HTTP response to a file on the module.
+ *
+ * The HTTP request must have been sent using ATHTTP_SendRequest() before calling this function.
+ * The file is created (or overwritten, if it exists) and the response body is written to the file
+ * chunk by chunk. If the transfer fails or the CRC doesn't match the expected value, the file is deleted.
+ *
+ * @param[in] clientHandle Handle of the HTTP client used to send the request
+ * @param[in] fileName Name of the file to be written
+ * @param[in] maxFileSize Maximum size of the file (allocated on creation)
+ * @param[in] expectedCrc32 Expected CRC-32 of the content (optional). Can be NULL if not used.
+ * @param[out] result Number of bytes written, CRC-32 of the content and download statistics
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_HTTPDownload_ToFile(uint8_t clientHandle,
+                                 const char *fileName,
+                                 uint32_t maxFileSize,
+                                 const uint32_t *expectedCrc32,
+                                 Calypso_HTTPDownload_Result_t *result)
+{
+    if (NULL == fileName || NULL == result)
+    {
+        return false;
+    }
+
+    memset(result, 0, sizeof(*result));
+
+    uint32_t startTick = WE_GetTick();
+
+    uint32_t fileID = 0;
+    uint32_t secureToken = 0;
+    if (!ATFile_Open(fileName,
+                     (ATFile_OpenFlags_Create | ATFile_OpenFlags_Overwrite),
+                     maxFileSize,
+                     &fileID,
+                     &secureToken))
+    {
+        return false;
+    }
+
+    uint32_t crc = 0xFFFFFFFF;
+    bool hasMoreData = true;
+    bool ok = true;
+
+    while (ok && hasMoreData)
+    {
+        char *data = NULL;
+        uint16_t length = 0;
+
+        ok = Calypso_HTTPDownload_ReadChunk(clientHandle, &hasMoreData, &data, &length);
+        if (!ok || 0 == length)
+        {
+            break;
+        }
+
+        result->chunks++;
+
+        uint16_t decodedLength = Calypso_GetBase64DecBufSize((uint8_t*) data, length) - 1;
+        if (result->bytesWritten + decodedLength > maxFileSize)
+        {
+            fprintf(stdout, "HTTP download exceeds max. file size (%lu bytes)\n", maxFileSize);
+            ok = false;
+            break;
+        }
+
+        ok = Calypso_HTTPDownload_WriteChunk(fileID, result->bytesWritten, data, length, &crc);
+        if (ok)
+        {
+            result->bytesWritten += decodedLength;
+        }
+    }
+
+    result->crc32 = ~crc;
+    result->elapsedMs = WE_GetTick() - startTick;
+
+    if (!ATFile_Close(fileID, NULL, NULL))
+    {
+        ok = false;
+    }
+
+    if (ok && NULL != expectedCrc32 && *expectedCrc32 != result->crc32)
+    {
+        fprintf(stdout, "HTTP download CRC mismatch (expected 0x%08lx, got 0x%08lx)\n", *expectedCrc32, result->crc32);
+        ok = false;
+    }
+
+    if (!ok)
+    {
+        /* Don't leave an incomplete or corrupted file behind */
+        ATFile_Delete(fileName, secureToken);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Updates a CRC-32 (IEEE 802.3) with the supplied data.
+ *
+ * Start with crc = 0xFFFFFFFF and invert the result after the last update.
+ *
+ * @param[in] crc Current CRC value
+ * @param[in] data Data to be added
+ * @param[in] length Number of bytes
+ *
+ * @return Updated CRC value
+ */
+uint32_t Calypso_HTTPDownload_Crc32(uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ Calypso_HTTPDownload_crcTable[crc & 0x0F];
+        crc = (crc >> 4) ^ Calypso_HTTPDownload_crcTable[crc & 0x0F];
+    }
+    return crc;
+}
+
+/**
+ * @brief Reads the next response body chunk (in Base64 format) using the AT+httpReadResBody command.
+ *
+ * The response is stored at offset CALYPSO_HTTPDOWNLOAD_HEADROOM in AT_commandBuffer and left there
+ * for Calypso_HTTPDownload_WriteChunk().
+ *
+ * @param[in] clientHandle Handle of the HTTP client
+ * @param[out] hasMoreData Is set to true if more body data is available
+ * @param[out] data Pointer to the Base64 encoded body data in AT_commandBuffer
+ * @param[out] length Number of Base64 characters
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_HTTPDownload_ReadChunk(uint8_t clientHandle, bool *hasMoreData, char **data, uint16_t *length)
+{
+    char *pRequestCommand = AT_commandBuffer;
+    char *pRespondCommand = AT_commandBuffer + CALYPSO_HTTPDOWNLOAD_HEADROOM;
+
+    strcpy(pRequestCommand, "AT+httpReadResBody=");
+    if (!Calypso_AppendArgumentInt(pRequestCommand,
+                                   clientHandle,
+                                   CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC,
+                                   CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
+    }
+    if (!Calypso_AppendArgumentInt(pRequestCommand, Calypso_DataFormat_Base64, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
+    }
+    if (!Calypso_AppendArgumentInt(pRequestCommand, CALYPSO_HTTPDOWNLOAD_CHUNK_SIZE, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_STRING_TERMINATE))
+    {
+        return false;
+    }
+    if (!Calypso_AppendArgumentString(pRequestCommand, CALYPSO_CRLF, CALYPSO_STRING_TERMINATE))
+    {
+        return false;
+    }
+    if (!Calypso_SendRequest(pRequestCommand))
+    {
+        return false;
+    }
+    if (!Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_HttpRequest), Calypso_CNFStatus_Success, pRespondCommand))
+    {
+        return false;
+    }
+
+    const char *cmd = "+httpreadresbody:";
+    const size_t cmdLength = strlen(cmd);
+
+    if (0 != strncmp(pRespondCommand, cmd, cmdLength))
+    {
+        return false;
+    }
+    pRespondCommand += cmdLength;
+
+    uint8_t handle = 0;
+    uint8_t moreData = 0;
+    uint8_t format = 0;
+    if (!Calypso_GetNextArgumentInt(&pRespondCommand, &handle, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_GetNextArgumentInt(&pRespondCommand, &moreData, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_GetNextArgumentInt(&pRespondCommand, &format, CALYPSO_INTFLAGS_SIZE8 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_GetNextArgumentInt(&pRespondCommand, length, CALYPSO_INTFLAGS_SIZE16 | CALYPSO_INTFLAGS_UNSIGNED | CALYPSO_INTFLAGS_NOTATION_DEC, CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
+    }
+
+    if (handle != clientHandle || Calypso_DataFormat_Base64 != format || 0 != (*length % 4))
+    {
+        return false;
+    }
+
+    /* Data must leave room for the AT+fileWrite prefix in front and the CRLF and terminating '\0' at the end */
+    if ((size_t) (pRespondCommand - AT_commandBuffer) < CALYPSO_HTTPDOWNLOAD_WRITE_PREFIX_MAX_LENGTH ||
+            (size_t) (pRespondCommand - AT_commandBuffer) + *length + 3 > AT_MAX_COMMAND_BUFFER_SIZE)
+    {
+        return false;
+    }
+
+    *hasMoreData = (0 != moreData);
+    *data = pRespondCommand;
+    return true;
+}
+
+/**
+ * @brief Writes a Base64 encoded chunk to a file using the AT+fileWrite command.
+ *
+ * The command is assembled in place around the data (which must have been received
+ * using Calypso_HTTPDownload_ReadChunk()). The CRC is updated while the module is writing,
+ * the response is received into Calypso_HTTPDownload_writeResponse so that the data isn't
+ * overwritten in the meantime.
+ *
+ * @param[in] fileID ID of the file
+ * @param[in] offset Offset of the (decoded) data in the file
+ * @param[in] data Base64 encoded data
+ * @param[in] length Number of Base64 characters
+ * @param[in,out] crc Running CRC-32 of the decoded content
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_HTTPDownload_WriteChunk(uint32_t fileID, uint32_t offset, char *data, uint16_t length, uint32_t *crc)
+{
+    char prefix[CALYPSO_HTTPDOWNLOAD_WRITE_PREFIX_MAX_LENGTH];
+
+    strcpy(prefix, "AT+fileWrite=");
+    if (!Calypso_AppendArgumentInt(prefix, fileID, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_AppendArgumentInt(prefix, offset, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_AppendArgumentInt(prefix, Calypso_DataFormat_Base64, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM) ||
+        !Calypso_AppendArgumentInt(prefix, length, (CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED), CALYPSO_ARGUMENT_DELIM))
+    {
+        return false;
+    }
+
+    /* Place the command prefix directly in front of the data and terminate the command */
+    size_t prefixLength = strlen(prefix);
+    char *pRequestCommand = data - prefixLength;
+    memcpy(pRequestCommand, prefix, prefixLength);
+    memcpy(data + length, CALYPSO_CRLF, 2);
+    data[length + 2] = '\0';
+
+    Calypso_SetResponseBuffer(Calypso_HTTPDownload_writeResponse, sizeof(Calypso_HTTPDownload_writeResponse));
+    if (!Calypso_SendRequest(pRequestCommand))
+    {
+        return false;
+    }
+
+    /* The request has been transmitted - update the CRC while the module is writing to flash */
+    *crc = Calypso_HTTPDownload_Crc32Base64(*crc, data, length);
+
+    char *pRespondCommand = Calypso_HTTPDownload_writeResponse;
+    if (!Calypso_WaitForConfirm(Calypso_GetTimeout(Calypso_Timeout_FileIO), Calypso_CNFStatus_Success, pRespondCommand))
+    {
+        return false;
+    }
+
+    const char *cmd = "+filewrite:";
+    const size_t cmdLength = strlen(cmd);
+
+    return (0 == strncmp(pRespondCommand, cmd, cmdLength));
+}
+
+/**
+ * @brief Updates a CRC-32 with the decoded content of Base64 encoded data.
+ *
+ * @param[in] crc Current CRC value
+ * @param[in] data Base64 encoded data
+ * @param[in] length Number of Base64 characters (multiple of 4)
+ *
+ * @return Updated CRC value
+ */
+static uint32_t Calypso_HTTPDownload_Crc32Base64(uint32_t crc, const char *data, uint16_t length)
+{
+    uint8_t decoded[(CALYPSO_HTTPDOWNLOAD_CRC_BLOCK_SIZE / 4) * 3 + 1];
+
+    for (uint16_t i = 0; i < length; i += CALYPSO_HTTPDOWNLOAD_CRC_BLOCK_SIZE)
+    {
+        uint16_t blockLength = length - i;
+        if (blockLength > CALYPSO_HTTPDOWNLOAD_CRC_BLOCK_SIZE)
+        {
+            blockLength = CALYPSO_HTTPDOWNLOAD_CRC_BLOCK_SIZE;
+        }
+
+        uint32_t decodedLength = 0;
+        if (Calypso_DecodeBase64((uint8_t*) data + i, blockLength, decoded, &decodedLength))
+        {
+            crc = Calypso_HTTPDownload_Crc32(crc, decoded, decodedLength - 1);
+        }
+    }
+
+    return crc;
+}
@@ -0,0 +1,88 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Calypso HTTP download header file.
+ *
+ * Streams the body of an HTTP response into a file on the module's file system.
+ *
+ * Each body chunk is read in Base64 format and the received Base64 text is forwarded
+ * unchanged as the data argument of the AT+fileWrite command, which is assembled in
+ * place around the received text (no intermediate decoding or copying). The running CRC-32
+ * of the decoded content is calculated while the module is busy writing the chunk to flash.
+ *
+ * Usage:
+ * - Create and connect an HTTP client (ATHTTP_Create(), ATHTTP_Connect()).
+ * - Send the request using ATHTTP_SendRequest() and check the returned status code.
+ * - Call Calypso_HTTPDownload_ToFile() to transfer the response body.
+ *
+ * If the download fails, the HTTP client should be disconnected, as the remaining
+ * response body has not been read.
+ */
+
+#ifndef CALYPSO_HTTPDOWNLOAD_H_INCLUDED
+#define CALYPSO_HTTPDOWNLOAD_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of (decoded) bytes requested per AT+httpReadResBody command.
+ *
+ * Must be a multiple of 3, so that every chunk is a complete Base64 block. The default
+ * value results in AT+fileWrite data arguments just below ATFILE_FILE_MAX_CHUNK_SIZE.
+ */
+#ifndef CALYPSO_HTTPDOWNLOAD_CHUNK_SIZE
+#define CALYPSO_HTTPDOWNLOAD_CHUNK_SIZE 558
+#endif
+
+/**
+ * @brief Download statistics and checksum as returned by Calypso_HTTPDownload_ToFile().
+ */
+typedef struct Calypso_HTTPDownload_Result_t
+{
+    uint32_t bytesWritten;      /**< Number of (decoded) bytes written to the file */
+    uint32_t crc32;             /**< CRC-32 (IEEE 802.3) of the written content */
+    uint16_t chunks;            /**< Number of body chunks read from the module */
+    uint32_t elapsedMs;         /**< Duration of the download */
+} Calypso_HTTPDownload_Result_t;
+
+extern bool Calypso_HTTPDownload_ToFile(uint8_t clientHandle,
+                                        const char *fileName,
+                                        uint32_t maxFileSize,
+                                        const uint32_t *expectedCrc32,
+                                        Calypso_HTTPDownload_Result_t *result);
+extern uint32_t Calypso_HTTPDownload_Crc32(uint32_t crc, const uint8_t *data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_HTTPDOWNLOAD_H_INCLUDED
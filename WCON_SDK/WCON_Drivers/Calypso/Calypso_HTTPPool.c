@@ -0,0 +1,454 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso HTTP client connection pool source file.
+ */
+
+#include "Calypso_HTTPPool.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Calypso.h"
+
+/**
+ * @brief Pooled HTTP client.
+ */
+typedef struct Calypso_HTTPPool_Entry_t
+{
+    bool used;                                      /**< Entry contains a connected client */
+    bool acquired;                                  /**< Client is currently in use */
+    bool secure;                                    /**< Connected using HTTPS */
+    uint8_t clientHandle;                           /**< HTTP client handle */
+    uint16_t port;                                  /**< Port */
+    uint32_t lastUsed;                              /**< Time at which the client has been released (ms) */
+    char host[CALYPSO_HTTPPOOL_MAX_HOST_LENGTH];    /**< Host name */
+} Calypso_HTTPPool_Entry_t;
+
+static void Calypso_HTTPPool_CheckStartup(void);
+static bool Calypso_HTTPPool_Matches(Calypso_HTTPPool_Entry_t *entry, const Calypso_HTTPPool_Server_t *server);
+static bool Calypso_HTTPPool_Connect(uint8_t clientHandle, const Calypso_HTTPPool_Server_t *server);
+static void Calypso_HTTPPool_Close(Calypso_HTTPPool_Entry_t *entry);
+static Calypso_HTTPPool_Entry_t *Calypso_HTTPPool_GetEntry(uint8_t clientHandle);
+static bool Calypso_HTTPPool_AcquireEntry(const Calypso_HTTPPool_Server_t *server, Calypso_HTTPPool_Entry_t **pEntry, bool *pReused);
+
+/**
+ * @brief Pooled HTTP clients.
+ */
+static Calypso_HTTPPool_Entry_t Calypso_HTTPPool_entries[CALYPSO_HTTPPOOL_SIZE];
+
+/**
+ * @brief Value of Calypso_GetStartupCount() when the pooled clients have been created.
+ */
+static uint32_t Calypso_HTTPPool_startupCount = 0;
+
+/**
+ * @brief Pool statistics.
+ */
+static Calypso_HTTPPool_Statistics_t Calypso_HTTPPool_statistics;
+
+/**
+ * @brief Initializes the pool.
+ *
+ * Note that this function doesn't close pooled connections - use Calypso_HTTPPool_Flush() for that purpose.
+ */
+void Calypso_HTTPPool_Init(void)
+{
+    memset(Calypso_HTTPPool_entries, 0, sizeof(Calypso_HTTPPool_entries));
+    memset(&Calypso_HTTPPool_statistics, 0, sizeof(Calypso_HTTPPool_statistics));
+    Calypso_HTTPPool_startupCount = Calypso_GetStartupCount();
+}
+
+/**
+ * @brief Returns a client connected to the supplied server.
+ *
+ * Reuses an idle pooled client if available, otherwise a new client is created and connected.
+ * The client must be returned to the pool using Calypso_HTTPPool_Release().
+ *
+ * @param[in] server Server to connect to
+ * @param[out] clientHandle Handle of the connected HTTP client
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_HTTPPool_Acquire(const Calypso_HTTPPool_Server_t *server, uint8_t *clientHandle)
+{
+    Calypso_HTTPPool_Entry_t *entry;
+    bool reused;
+
+    if (!Calypso_HTTPPool_AcquireEntry(server, &entry, &reused))
+    {
+        return false;
+    }
+
+    *clientHandle = entry->clientHandle;
+    return true;
+}
+
+/**
+ * @brief Sends an HTTP request using a pooled client.
+ *
+ * If the request fails on a reused connection (e.g. because the server has closed the connection),
+ * the client is reconnected and idempotent requests are sent again.
+ *
+ * On success, the response body can be read using ATHTTP_ReadResponseBody() with the returned client
+ * handle. The client must then be returned to the pool using Calypso_HTTPPool_Release().
+ * On failure, the client has already been released.
+ *
+ * @param[in] server Server to send the request to
+ * @param[in] method HTTP method to be used
+ * @param[in] uri HTTP server address or URL
+ * @param[in] flags HTTP Request flags (see ATHTTP_RequestFlags_t)
+ * @param[in] format Format in which the request's data is provided (see ATHTTP_SendRequest())
+ * @param[in] encodeAsBase64 Encode the data in Base64 format before sending it to the Calypso module
+ * @param[in] length Number of bytes to send as payload of the request (see argument data)
+ * @param[in] data Payload of the request
+ * @param[out] status HTTP status code (usually 200 in case of success, else failure)
+ * @param[out] clientHandle Handle of the HTTP client used for the request
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_HTTPPool_SendRequest(const Calypso_HTTPPool_Server_t *server,
+                                  ATHTTP_Method_t method,
+                                  const char *uri,
+                                  uint8_t flags,
+                                  Calypso_DataFormat_t format,
+                                  bool encodeAsBase64,
+                                  uint16_t length,
+                                  const char *data,
+                                  uint32_t *status,
+                                  uint8_t *clientHandle)
+{
+    Calypso_HTTPPool_Entry_t *entry;
+    bool reused;
+
+    if (!Calypso_HTTPPool_AcquireEntry(server, &entry, &reused))
+    {
+        return false;
+    }
+
+    bool ret = ATHTTP_SendRequest(entry->clientHandle, method, uri, flags, format, encodeAsBase64, length, data, status);
+
+    if (!ret && reused)
+    {
+        /* Connection has probably been closed by the server - reconnect */
+        Calypso_HTTPPool_statistics.reconnects++;
+        ATHTTP_Disconnect(entry->clientHandle);
+        if (Calypso_HTTPPool_Connect(entry->clientHandle, server))
+        {
+            if (ATHTTP_Method_Post != method && ATHTTP_Method_Connect != method)
+            {
+                ret = ATHTTP_SendRequest(entry->clientHandle, method, uri, flags, format, encodeAsBase64, length, data, status);
+            }
+        }
+        else
+        {
+            Calypso_HTTPPool_statistics.connectFailures++;
+        }
+    }
+
+    if (!ret)
+    {
+        Calypso_HTTPPool_Release(entry->clientHandle, false);
+        return false;
+    }
+
+    *clientHandle = entry->clientHandle;
+    return true;
+}
+
+/**
+ * @brief Returns a client to the pool.
+ *
+ * @param[in] clientHandle Handle of the HTTP client as returned by Calypso_HTTPPool_Acquire()
+ *            or Calypso_HTTPPool_SendRequest()
+ * @param[in] keepAlive If true, the connection is kept open for subsequent requests. Set to false
+ *            if the connection is known to be unusable (e.g. on errors or if the server has sent
+ *            "Connection: close").
+ */
+void Calypso_HTTPPool_Release(uint8_t clientHandle, bool keepAlive)
+{
+    Calypso_HTTPPool_Entry_t *entry = Calypso_HTTPPool_GetEntry(clientHandle);
+    if (NULL == entry)
+    {
+        return;
+    }
+
+    if (keepAlive)
+    {
+        entry->acquired = false;
+        entry->lastUsed = WE_GetTick();
+    }
+    else
+    {
+        Calypso_HTTPPool_Close(entry);
+    }
+}
+
+/**
+ * @brief Closes connections that have been idle for longer than CALYPSO_HTTPPOOL_IDLE_TIMEOUT_MS.
+ *
+ * Is intended to be called cyclically from the main loop. Calling this function is optional, as
+ * expired connections are not reused anyway.
+ */
+void Calypso_HTTPPool_Process(void)
+{
+    Calypso_HTTPPool_CheckStartup();
+
+    uint32_t now = WE_GetTick();
+    for (uint8_t i = 0; i < CALYPSO_HTTPPOOL_SIZE; i++)
+    {
+        Calypso_HTTPPool_Entry_t *entry = &Calypso_HTTPPool_entries[i];
+        if (entry->used && !entry->acquired && now - entry->lastUsed >= CALYPSO_HTTPPOOL_IDLE_TIMEOUT_MS)
+        {
+            Calypso_HTTPPool_statistics.evictions++;
+            Calypso_HTTPPool_Close(entry);
+        }
+    }
+}
+
+/**
+ * @brief Closes all idle connections.
+ */
+void Calypso_HTTPPool_Flush(void)
+{
+    Calypso_HTTPPool_CheckStartup();
+
+    for (uint8_t i = 0; i < CALYPSO_HTTPPOOL_SIZE; i++)
+    {
+        Calypso_HTTPPool_Entry_t *entry = &Calypso_HTTPPool_entries[i];
+        if (entry->used && !entry->acquired)
+        {
+            Calypso_HTTPPool_Close(entry);
+        }
+    }
+}
+
+/**
+ * @brief Returns pool statistics.
+ *
+ * @param[out] statistics Pool statistics
+ */
+void Calypso_HTTPPool_GetStatistics(Calypso_HTTPPool_Statistics_t *statistics)
+{
+    *statistics = Calypso_HTTPPool_statistics;
+}
+
+/**
+ * @brief Drops all pooled clients if the module has been restarted (client handles are no longer valid).
+ */
+static void Calypso_HTTPPool_CheckStartup(void)
+{
+    uint32_t startupCount = Calypso_GetStartupCount();
+    if (startupCount != Calypso_HTTPPool_startupCount)
+    {
+        memset(Calypso_HTTPPool_entries, 0, sizeof(Calypso_HTTPPool_entries));
+        Calypso_HTTPPool_startupCount = startupCount;
+    }
+}
+
+/**
+ * @brief Checks if a pooled client is connected to the supplied server.
+ *
+ * @param[in] entry Pooled client
+ * @param[in] server Server
+ *
+ * @return true if the client is connected to the server, false otherwise
+ */
+static bool Calypso_HTTPPool_Matches(Calypso_HTTPPool_Entry_t *entry, const Calypso_HTTPPool_Server_t *server)
+{
+    return (entry->port == server->port &&
+            entry->secure == server->secure &&
+            0 == strcmp(entry->host, server->host));
+}
+
+/**
+ * @brief Connects an HTTP client to the supplied server.
+ *
+ * @param[in] clientHandle Handle of the HTTP client
+ * @param[in] server Server to connect to
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_HTTPPool_Connect(uint8_t clientHandle, const Calypso_HTTPPool_Server_t *server)
+{
+    char url[CALYPSO_HTTPPOOL_MAX_HOST_LENGTH + 16];
+
+    strcpy(url, server->secure ? "https://" : "http://");
+    strcat(url, server->host);
+    if (0 != server->port)
+    {
+        char port[8] = ":";
+        Calypso_IntToString(&port[1], server->port, CALYPSO_INTFLAGS_NOTATION_DEC | CALYPSO_INTFLAGS_UNSIGNED);
+        strcat(url, port);
+    }
+
+    return ATHTTP_Connect(clientHandle,
+                          url,
+                          server->connectFlags,
+                          server->privateKey,
+                          server->certificate,
+                          server->rootCaCertificate);
+}
+
+/**
+ * @brief Disconnects and destroys a pooled client.
+ *
+ * @param[in] entry Pooled client
+ */
+static void Calypso_HTTPPool_Close(Calypso_HTTPPool_Entry_t *entry)
+{
+    ATHTTP_Disconnect(entry->clientHandle);
+    ATHTTP_Destroy(entry->clientHandle);
+    entry->used = false;
+    entry->acquired = false;
+}
+
+/**
+ * @brief Returns the pooled client with the supplied handle.
+ *
+ * @param[in] clientHandle HTTP client handle
+ *
+ * @return Pooled client or NULL if not found
+ */
+static Calypso_HTTPPool_Entry_t *Calypso_HTTPPool_GetEntry(uint8_t clientHandle)
+{
+    for (uint8_t i = 0; i < CALYPSO_HTTPPOOL_SIZE; i++)
+    {
+        Calypso_HTTPPool_Entry_t *entry = &Calypso_HTTPPool_entries[i];
+        if (entry->used && entry->clientHandle == clientHandle)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns a pooled client connected to the supplied server (see Calypso_HTTPPool_Acquire()).
+ *
+ * @param[in] server Server to connect to
+ * @param[out] pEntry Pooled client
+ * @param[out] pReused Is set to true if an already connected client is returned
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_HTTPPool_AcquireEntry(const Calypso_HTTPPool_Server_t *server, Calypso_HTTPPool_Entry_t **pEntry, bool *pReused)
+{
+    *pReused = false;
+
+    if (NULL == server || NULL == server->host || strlen(server->host) >= CALYPSO_HTTPPOOL_MAX_HOST_LENGTH)
+    {
+        return false;
+    }
+
+    Calypso_HTTPPool_CheckStartup();
+
+    uint32_t now = WE_GetTick();
+    Calypso_HTTPPool_Entry_t *entry = NULL;
+    Calypso_HTTPPool_Entry_t *leastRecentlyUsed = NULL;
+
+    for (uint8_t i = 0; i < CALYPSO_HTTPPOOL_SIZE; i++)
+    {
+        Calypso_HTTPPool_Entry_t *candidate = &Calypso_HTTPPool_entries[i];
+        if (!candidate->used)
+        {
+            if (NULL == entry)
+            {
+                entry = candidate;
+            }
+            continue;
+        }
+        if (candidate->acquired)
+        {
+            continue;
+        }
+
+        if (Calypso_HTTPPool_Matches(candidate, server))
+        {
+            if (now - candidate->lastUsed < CALYPSO_HTTPPOOL_IDLE_TIMEOUT_MS)
+            {
+                candidate->acquired = true;
+                Calypso_HTTPPool_statistics.hits++;
+                *pEntry = candidate;
+                *pReused = true;
+                return true;
+            }
+
+            /* Idle for too long - the server has probably closed the connection */
+            Calypso_HTTPPool_statistics.evictions++;
+            Calypso_HTTPPool_Close(candidate);
+            if (NULL == entry)
+            {
+                entry = candidate;
+            }
+            continue;
+        }
+
+        if (NULL == leastRecentlyUsed || now - candidate->lastUsed > now - leastRecentlyUsed->lastUsed)
+        {
+            leastRecentlyUsed = candidate;
+        }
+    }
+
+    Calypso_HTTPPool_statistics.misses++;
+
+    if (NULL == entry)
+    {
+        if (NULL == leastRecentlyUsed)
+        {
+            fprintf(stdout, "HTTP pool: All clients in use\n");
+            return false;
+        }
+
+        /* Close least recently used idle connection to make room */
+        Calypso_HTTPPool_statistics.evictions++;
+        Calypso_HTTPPool_Close(leastRecentlyUsed);
+        entry = leastRecentlyUsed;
+    }
+
+    if (!ATHTTP_Create(&entry->clientHandle))
+    {
+        Calypso_HTTPPool_statistics.connectFailures++;
+        return false;
+    }
+
+    if (!Calypso_HTTPPool_Connect(entry->clientHandle, server))
+    {
+        Calypso_HTTPPool_statistics.connectFailures++;
+        ATHTTP_Destroy(entry->clientHandle);
+        return false;
+    }
+
+    entry->used = true;
+    entry->acquired = true;
+    entry->secure = server->secure;
+    entry->port = server->port;
+    entry->lastUsed = now;
+    strcpy(entry->host, server->host);
+
+    *pEntry = entry;
+    return true;
+}
@@ -0,0 +1,128 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso HTTP client connection pool header file.
+ *
+ * Keeps connected HTTP client handles per server (host, port, TLS) and reuses them for
+ * subsequent requests, so that a request to a server that has recently been used only costs
+ * the request itself instead of creating, connecting (TLS handshake), disconnecting and
+ * destroying an HTTP client.
+ *
+ * Usage:
+ * - Call Calypso_HTTPPool_SendRequest() (or Calypso_HTTPPool_Acquire() followed by
+ *   ATHTTP_SendRequest()) to send a request using a pooled client.
+ * - Read the response body using ATHTTP_ReadResponseBody() with the returned client handle.
+ * - Return the client to the pool using Calypso_HTTPPool_Release().
+ * - Optionally call Calypso_HTTPPool_Process() cyclically to close idle connections.
+ *
+ * Connections closed by the server are detected when sending a request fails on a reused
+ * connection. In this case, the client is reconnected and idempotent requests (all methods
+ * except POST and CONNECT) are sent again. Connections that have been idle for longer than
+ * CALYPSO_HTTPPOOL_IDLE_TIMEOUT_MS are not reused, as most servers close idle connections
+ * after some time. All pooled clients are dropped if the module has been restarted.
+ */
+
+#ifndef CALYPSO_HTTPPOOL_H_INCLUDED
+#define CALYPSO_HTTPPOOL_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ATCommands/ATHTTP.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Max. number of pooled HTTP clients.
+ */
+#ifndef CALYPSO_HTTPPOOL_SIZE
+#define CALYPSO_HTTPPOOL_SIZE 2
+#endif
+
+/**
+ * @brief Max. length of host names (including terminating '\0').
+ */
+#ifndef CALYPSO_HTTPPOOL_MAX_HOST_LENGTH
+#define CALYPSO_HTTPPOOL_MAX_HOST_LENGTH 64
+#endif
+
+/**
+ * @brief Time after which idle connections are closed (ms).
+ */
+#ifndef CALYPSO_HTTPPOOL_IDLE_TIMEOUT_MS
+#define CALYPSO_HTTPPOOL_IDLE_TIMEOUT_MS 30000
+#endif
+
+/**
+ * @brief HTTP server used as key for pooled clients.
+ */
+typedef struct Calypso_HTTPPool_Server_t
+{
+    const char *host;                   /**< Host name or IP address (without scheme and port) */
+    uint16_t port;                      /**< Port (0 to use the default port) */
+    bool secure;                        /**< Use HTTPS */
+    uint8_t connectFlags;               /**< Connection flags (see ATHTTP_ConnectFlags_t) */
+    const char *privateKey;             /**< Private key file name (optional, NULL if not used) */
+    const char *certificate;            /**< Client certificate file name (optional, NULL if not used) */
+    const char *rootCaCertificate;      /**< Root CA certificate file name (optional, NULL if not used) */
+} Calypso_HTTPPool_Server_t;
+
+/**
+ * @brief Pool statistics as returned by Calypso_HTTPPool_GetStatistics().
+ */
+typedef struct Calypso_HTTPPool_Statistics_t
+{
+    uint32_t hits;                      /**< Requests using an already connected client */
+    uint32_t misses;                    /**< Requests requiring a new connection */
+    uint32_t reconnects;                /**< Connections found closed by the server when reused */
+    uint32_t evictions;                 /**< Idle connections closed (idle timeout or to make room) */
+    uint32_t connectFailures;           /**< Failed connection attempts */
+} Calypso_HTTPPool_Statistics_t;
+
+extern void Calypso_HTTPPool_Init(void);
+extern bool Calypso_HTTPPool_Acquire(const Calypso_HTTPPool_Server_t *server, uint8_t *clientHandle);
+extern bool Calypso_HTTPPool_SendRequest(const Calypso_HTTPPool_Server_t *server,
+                                         ATHTTP_Method_t method,
+                                         const char *uri,
+                                         uint8_t flags,
+                                         Calypso_DataFormat_t format,
+                                         bool encodeAsBase64,
+                                         uint16_t length,
+                                         const char *data,
+                                         uint32_t *status,
+                                         uint8_t *clientHandle);
+extern void Calypso_HTTPPool_Release(uint8_t clientHandle, bool keepAlive);
+extern void Calypso_HTTPPool_Process(void);
+extern void Calypso_HTTPPool_Flush(void);
+extern void Calypso_HTTPPool_GetStatistics(Calypso_HTTPPool_Statistics_t *statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_HTTPPOOL_H_INCLUDED
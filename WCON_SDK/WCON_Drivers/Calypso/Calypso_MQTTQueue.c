@@ -0,0 +1,430 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Calypso MQTT publish queue source file.
+ */
+
+#include "Calypso_MQTTQueue.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Calypso.h"
+
+/**
+ * @brief Queued message.
+ */
+typedef struct Calypso_MQTTQueue_Entry_t
+{
+    bool used;                                                  /**< Entry contains a message */
+    uint8_t index;                                              /**< Index (handle) of the MQTT client */
+    uint8_t QoS;                                                /**< Quality of service (see ATMQTT_QoS_t) */
+    uint8_t retain;                                             /**< Retain flag */
+    uint8_t messageClass;                                       /**< Message class (see Calypso_MQTTQueue_Class_t) */
+    uint8_t retries;                                            /**< Number of rejected transmissions */
+    uint16_t messageLength;                                     /**< Message length */
+    uint32_t sequence;                                          /**< Order in which the messages have been queued */
+    char topic[CALYPSO_MQTTQUEUE_MAX_TOPIC_LENGTH];             /**< Topic */
+    char message[CALYPSO_MQTTQUEUE_MAX_MESSAGE_LENGTH];         /**< Message */
+} Calypso_MQTTQueue_Entry_t;
+
+static void Calypso_MQTTQueue_HandleConfirm(void);
+static int16_t Calypso_MQTTQueue_GetNextEntry(void);
+static void Calypso_MQTTQueue_FreeEntry(int16_t entry);
+
+/**
+ * @brief Queued messages.
+ */
+static Calypso_MQTTQueue_Entry_t Calypso_MQTTQueue_entries[CALYPSO_MQTTQUEUE_SIZE];
+
+/**
+ * @brief Sequence number of the last queued message.
+ */
+static uint32_t Calypso_MQTTQueue_sequence = 0;
+
+/**
+ * @brief Is set to true while the confirmation of a publish request is pending.
+ */
+static bool Calypso_MQTTQueue_requestPending = false;
+
+/**
+ * @brief Entry whose transmission is waiting for the confirmation (QoS1 and QoS2 only, -1 if none).
+ */
+static int16_t Calypso_MQTTQueue_pendingEntry = -1;
+
+/**
+ * @brief Time at which the pending request has been sent.
+ */
+static uint32_t Calypso_MQTTQueue_requestTick = 0;
+
+/**
+ * @brief Queue statistics.
+ */
+static Calypso_MQTTQueue_Statistics_t Calypso_MQTTQueue_statistics;
+
+/**
+ * @brief Initializes (clears) the queue.
+ */
+void Calypso_MQTTQueue_Init(void)
+{
+    memset(Calypso_MQTTQueue_entries, 0, sizeof(Calypso_MQTTQueue_entries));
+    memset(&Calypso_MQTTQueue_statistics, 0, sizeof(Calypso_MQTTQueue_statistics));
+    Calypso_MQTTQueue_sequence = 0;
+    Calypso_MQTTQueue_requestPending = false;
+    Calypso_MQTTQueue_pendingEntry = -1;
+}
+
+/**
+ * @brief Adds a message to the publish queue.
+ *
+ * @param[in] index Index (handle) of the MQTT client to use
+ * @param[in] topic Topic to be published
+ * @param[in] QoS Quality of service
+ * @param[in] retain Retain the message (1) or do not retain the message (0)
+ * @param[in] messageClass Message class (see Calypso_MQTTQueue_Class_t)
+ * @param[in] pMessage Message to publish (is copied to the queue)
+ * @param[in] messageLength Length of the message
+ *
+ * @return true if the message has been queued, false otherwise (invalid parameters or queue full)
+ */
+bool Calypso_MQTTQueue_Publish(uint8_t index,
+                               const char *topic,
+                               ATMQTT_QoS_t QoS,
+                               uint8_t retain,
+                               Calypso_MQTTQueue_Class_t messageClass,
+                               const char *pMessage,
+                               uint16_t messageLength)
+{
+    if (NULL == topic ||
+            strlen(topic) >= CALYPSO_MQTTQUEUE_MAX_TOPIC_LENGTH ||
+            messageLength > CALYPSO_MQTTQUEUE_MAX_MESSAGE_LENGTH ||
+            QoS >= ATMQTT_QoS_NumberOfValues ||
+            messageClass >= Calypso_MQTTQueue_Class_NumberOfValues)
+    {
+        return false;
+    }
+
+    int16_t freeEntry = -1;
+    int16_t oldestEntry = -1;
+
+    for (int16_t i = 0; i < CALYPSO_MQTTQUEUE_SIZE; i++)
+    {
+        Calypso_MQTTQueue_Entry_t *entry = &Calypso_MQTTQueue_entries[i];
+
+        if (!entry->used)
+        {
+            if (freeEntry < 0)
+            {
+                freeEntry = i;
+            }
+            continue;
+        }
+
+        if (i == Calypso_MQTTQueue_pendingEntry)
+        {
+            /* Already transmitted - must not be modified */
+            continue;
+        }
+
+        if (Calypso_MQTTQueue_Class_State == messageClass &&
+                Calypso_MQTTQueue_Class_State == entry->messageClass &&
+                entry->index == index &&
+                0 == strcmp(entry->topic, topic))
+        {
+            /* Replace the queued value, keeping the message's position in the queue */
+            entry->QoS = QoS;
+            entry->retain = retain;
+            entry->retries = 0;
+            entry->messageLength = messageLength;
+            memcpy(entry->message, pMessage, messageLength);
+            Calypso_MQTTQueue_statistics.coalesced++;
+            return true;
+        }
+
+        if (Calypso_MQTTQueue_Class_Alarm != entry->messageClass &&
+                (oldestEntry < 0 || entry->sequence < Calypso_MQTTQueue_entries[oldestEntry].sequence))
+        {
+            oldestEntry = i;
+        }
+    }
+
+    if (freeEntry < 0)
+    {
+        if (Calypso_MQTTQueue_Class_Alarm != messageClass || oldestEntry < 0)
+        {
+            Calypso_MQTTQueue_statistics.dropped++;
+            return false;
+        }
+
+        /* Make room for the alarm */
+        Calypso_MQTTQueue_FreeEntry(oldestEntry);
+        Calypso_MQTTQueue_statistics.evicted++;
+        freeEntry = oldestEntry;
+    }
+
+    Calypso_MQTTQueue_Entry_t *entry = &Calypso_MQTTQueue_entries[freeEntry];
+    entry->used = true;
+    entry->index = index;
+    entry->QoS = QoS;
+    entry->retain = retain;
+    entry->messageClass = messageClass;
+    entry->retries = 0;
+    entry->messageLength = messageLength;
+    entry->sequence = ++Calypso_MQTTQueue_sequence;
+    strcpy(entry->topic, topic);
+    memcpy(entry->message, pMessage, messageLength);
+
+    Calypso_MQTTQueue_statistics.queued++;
+    Calypso_MQTTQueue_statistics.depth++;
+    if (Calypso_MQTTQueue_statistics.depth > Calypso_MQTTQueue_statistics.maxDepth)
+    {
+        Calypso_MQTTQueue_statistics.maxDepth = Calypso_MQTTQueue_statistics.depth;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Dispatches queued messages. Must be called cyclically from the main loop.
+ *
+ * Checks the confirmation of the last publish request (without blocking) and sends the
+ * next message as soon as the module has confirmed the previous one.
+ */
+void Calypso_MQTTQueue_Process(void)
+{
+    if (Calypso_MQTTQueue_requestPending)
+    {
+        Calypso_MQTTQueue_HandleConfirm();
+        if (Calypso_MQTTQueue_requestPending)
+        {
+            return;
+        }
+    }
+
+    int16_t next = Calypso_MQTTQueue_GetNextEntry();
+    if (next < 0)
+    {
+        return;
+    }
+
+    Calypso_MQTTQueue_Entry_t *entry = &Calypso_MQTTQueue_entries[next];
+    if (!ATMQTT_SendPublish(entry->index,
+                            entry->topic,
+                            (ATMQTT_QoS_t) entry->QoS,
+                            entry->retain,
+                            entry->messageLength,
+                            entry->message))
+    {
+        /* Retry on next call */
+        return;
+    }
+
+    Calypso_MQTTQueue_requestPending = true;
+    Calypso_MQTTQueue_requestTick = WE_GetTick();
+    Calypso_MQTTQueue_statistics.sent++;
+
+    if (ATMQTT_QoS_QoS0 == entry->QoS)
+    {
+        /* Fire-and-forget: the message has been transmitted, the entry can be reused */
+        Calypso_MQTTQueue_FreeEntry(next);
+        Calypso_MQTTQueue_pendingEntry = -1;
+    }
+    else
+    {
+        Calypso_MQTTQueue_pendingEntry = next;
+    }
+}
+
+/**
+ * @brief Waits until the confirmation of the last publish request has been received.
+ *
+ * Must be called before sending other AT commands.
+ *
+ * @param[in] timeoutMs Max. time to wait
+ *
+ * @return true if no request is pending, false otherwise
+ */
+bool Calypso_MQTTQueue_WaitIdle(uint32_t timeoutMs)
+{
+    uint32_t t0 = WE_GetTick();
+
+    while (Calypso_MQTTQueue_requestPending)
+    {
+        Calypso_MQTTQueue_HandleConfirm();
+
+        if (Calypso_MQTTQueue_requestPending)
+        {
+            if (WE_GetTick() - t0 > timeoutMs)
+            {
+                return false;
+            }
+            WE_Delay(1);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sends all queued messages.
+ *
+ * @param[in] timeoutMs Max. time to wait
+ *
+ * @return true if the queue is empty and no request is pending, false otherwise
+ */
+bool Calypso_MQTTQueue_Flush(uint32_t timeoutMs)
+{
+    uint32_t t0 = WE_GetTick();
+
+    while (1)
+    {
+        Calypso_MQTTQueue_Process();
+
+        if (0 == Calypso_MQTTQueue_statistics.depth && !Calypso_MQTTQueue_requestPending)
+        {
+            return true;
+        }
+
+        if (WE_GetTick() - t0 > timeoutMs)
+        {
+            return false;
+        }
+        WE_Delay(1);
+    }
+}
+
+/**
+ * @brief Returns the queue statistics.
+ *
+ * @param[out] statistics Queue statistics
+ */
+void Calypso_MQTTQueue_GetStatistics(Calypso_MQTTQueue_Statistics_t *statistics)
+{
+    *statistics = Calypso_MQTTQueue_statistics;
+}
+
+/**
+ * @brief Resets the queue statistics (except for the current queue depth).
+ */
+void Calypso_MQTTQueue_ResetStatistics(void)
+{
+    uint16_t depth = Calypso_MQTTQueue_statistics.depth;
+    memset(&Calypso_MQTTQueue_statistics, 0, sizeof(Calypso_MQTTQueue_statistics));
+    Calypso_MQTTQueue_statistics.depth = depth;
+    Calypso_MQTTQueue_statistics.maxDepth = depth;
+}
+
+/**
+ * @brief Checks the confirmation of the pending publish request and updates the queue accordingly.
+ */
+static void Calypso_MQTTQueue_HandleConfirm(void)
+{
+    Calypso_CNFStatus_t status;
+    if (!Calypso_PollConfirm(&status, NULL))
+    {
+        if (WE_GetTick() - Calypso_MQTTQueue_requestTick <= Calypso_GetTimeout(Calypso_Timeout_General))
+        {
+            return;
+        }
+        /* Timeout - handle like a rejected request */
+        status = Calypso_CNFStatus_Failed;
+    }
+
+    Calypso_MQTTQueue_requestPending = false;
+
+    if (Calypso_CNFStatus_Success == status)
+    {
+        if (Calypso_MQTTQueue_pendingEntry >= 0)
+        {
+            Calypso_MQTTQueue_FreeEntry(Calypso_MQTTQueue_pendingEntry);
+        }
+    }
+    else if (Calypso_MQTTQueue_pendingEntry < 0)
+    {
+        /* QoS0 message rejected */
+        Calypso_MQTTQueue_statistics.failed++;
+    }
+    else
+    {
+        Calypso_MQTTQueue_Entry_t *entry = &Calypso_MQTTQueue_entries[Calypso_MQTTQueue_pendingEntry];
+        entry->retries++;
+        if (entry->retries > CALYPSO_MQTTQUEUE_MAX_RETRIES)
+        {
+            fprintf(stdout, "MQTT publish of topic %s failed\n", entry->topic);
+            Calypso_MQTTQueue_FreeEntry(Calypso_MQTTQueue_pendingEntry);
+            Calypso_MQTTQueue_statistics.failed++;
+        }
+    }
+
+    Calypso_MQTTQueue_pendingEntry = -1;
+}
+
+/**
+ * @brief Returns the next message to be sent (oldest alarm or, if there is none, oldest message).
+ *
+ * @return Index of the entry or -1 if the queue is empty
+ */
+static int16_t Calypso_MQTTQueue_GetNextEntry(void)
+{
+    int16_t next = -1;
+
+    for (int16_t i = 0; i < CALYPSO_MQTTQUEUE_SIZE; i++)
+    {
+        Calypso_MQTTQueue_Entry_t *entry = &Calypso_MQTTQueue_entries[i];
+        if (!entry->used)
+        {
+            continue;
+        }
+
+        if (next < 0)
+        {
+            next = i;
+            continue;
+        }
+
+        bool isAlarm = (Calypso_MQTTQueue_Class_Alarm == entry->messageClass);
+        bool nextIsAlarm = (Calypso_MQTTQueue_Class_Alarm == Calypso_MQTTQueue_entries[next].messageClass);
+        if ((isAlarm && !nextIsAlarm) ||
+                (isAlarm == nextIsAlarm && entry->sequence < Calypso_MQTTQueue_entries[next].sequence))
+        {
+            next = i;
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @brief Removes a message from the queue.
+ *
+ * @param[in] entry Index of the entry
+ */
+static void Calypso_MQTTQueue_FreeEntry(int16_t entry)
+{
+    Calypso_MQTTQueue_entries[entry].used = false;
+    Calypso_MQTTQueue_statistics.depth--;
+}
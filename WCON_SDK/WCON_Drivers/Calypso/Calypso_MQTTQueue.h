@@ -0,0 +1,134 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Calypso MQTT publish queue header file.
+ *
+ * Outbound MQTT messages are queued by Calypso_MQTTQueue_Publish() and sent to the module
+ * by Calypso_MQTTQueue_Process(), which has to be called cyclically from the main loop.
+ * The dispatcher sends the next message as soon as the module has confirmed the previous
+ * one, without blocking while the module processes the request.
+ *
+ * Message classes:
+ * - Normal: Messages are sent in order. If the queue is full, new messages are dropped.
+ * - State: Only the latest value per topic is kept, i.e. a queued message with the same
+ *   topic (and client) is replaced.
+ * - Alarm: Messages are sent before all other messages. If the queue is full, the oldest
+ *   normal or state message is dropped to make room.
+ *
+ * QoS0 messages are removed from the queue as soon as they have been transmitted
+ * (fire-and-forget). QoS1 and QoS2 messages are removed when the module has accepted
+ * them and are retried up to CALYPSO_MQTTQUEUE_MAX_RETRIES times otherwise.
+ *
+ * Call Calypso_MQTTQueue_WaitIdle() before sending other AT commands, as the module might
+ * still be processing a publish request.
+ */
+
+#ifndef CALYPSO_MQTTQUEUE_H_INCLUDED
+#define CALYPSO_MQTTQUEUE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ATCommands/ATMQTT.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Max. number of queued messages.
+ */
+#ifndef CALYPSO_MQTTQUEUE_SIZE
+#define CALYPSO_MQTTQUEUE_SIZE 16
+#endif
+
+/**
+ * @brief Max. topic length (including terminating '\0').
+ */
+#ifndef CALYPSO_MQTTQUEUE_MAX_TOPIC_LENGTH
+#define CALYPSO_MQTTQUEUE_MAX_TOPIC_LENGTH 64
+#endif
+
+/**
+ * @brief Max. message length.
+ */
+#ifndef CALYPSO_MQTTQUEUE_MAX_MESSAGE_LENGTH
+#define CALYPSO_MQTTQUEUE_MAX_MESSAGE_LENGTH 64
+#endif
+
+/**
+ * @brief Max. number of retries of QoS1 and QoS2 messages not accepted by the module.
+ */
+#ifndef CALYPSO_MQTTQUEUE_MAX_RETRIES
+#define CALYPSO_MQTTQUEUE_MAX_RETRIES 3
+#endif
+
+/**
+ * @brief Message classes (see Calypso_MQTTQueue.h).
+ */
+typedef enum Calypso_MQTTQueue_Class_t
+{
+    Calypso_MQTTQueue_Class_Normal,
+    Calypso_MQTTQueue_Class_State,
+    Calypso_MQTTQueue_Class_Alarm,
+    Calypso_MQTTQueue_Class_NumberOfValues
+} Calypso_MQTTQueue_Class_t;
+
+/**
+ * @brief Queue statistics as returned by Calypso_MQTTQueue_GetStatistics().
+ */
+typedef struct Calypso_MQTTQueue_Statistics_t
+{
+    uint16_t depth;             /**< Number of currently queued messages */
+    uint16_t maxDepth;          /**< Max. number of queued messages */
+    uint32_t queued;            /**< Messages added to the queue */
+    uint32_t coalesced;         /**< State messages replaced by a newer value */
+    uint32_t dropped;           /**< Messages dropped because the queue was full */
+    uint32_t evicted;           /**< Messages dropped to make room for alarms */
+    uint32_t sent;              /**< Messages transmitted to the module (including retries) */
+    uint32_t failed;            /**< Messages rejected by the module (QoS1 and QoS2: after all retries) */
+} Calypso_MQTTQueue_Statistics_t;
+
+extern void Calypso_MQTTQueue_Init(void);
+extern bool Calypso_MQTTQueue_Publish(uint8_t index,
+                                      const char *topic,
+                                      ATMQTT_QoS_t QoS,
+                                      uint8_t retain,
+                                      Calypso_MQTTQueue_Class_t messageClass,
+                                      const char *pMessage,
+                                      uint16_t messageLength);
+extern void Calypso_MQTTQueue_Process(void);
+extern bool Calypso_MQTTQueue_WaitIdle(uint32_t timeoutMs);
+extern bool Calypso_MQTTQueue_Flush(uint32_t timeoutMs);
+extern void Calypso_MQTTQueue_GetStatistics(Calypso_MQTTQueue_Statistics_t *statistics);
+extern void Calypso_MQTTQueue_ResetStatistics(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_MQTTQUEUE_H_INCLUDED
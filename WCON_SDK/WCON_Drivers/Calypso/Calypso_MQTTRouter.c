@@ -0,0 +1,820 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso MQTT subscription dispatcher source file.
+ */
+
+#include "Calypso_MQTTRouter.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Calypso.h"
+
+/**
+ * @brief Marks an unused node, handler or hash table entry.
+ */
+#define CALYPSO_MQTTROUTER_NONE ((uint16_t) 0xFFFF)
+
+/**
+ * @brief Index of the trie's root node.
+ */
+#define CALYPSO_MQTTROUTER_ROOT ((uint16_t) 0)
+
+/**
+ * @brief Topic level separator.
+ */
+#define CALYPSO_MQTTROUTER_LEVEL_SEPARATOR '/'
+
+#if (CALYPSO_MQTTROUTER_HASH_SIZE & (CALYPSO_MQTTROUTER_HASH_SIZE - 1)) != 0
+#error "CALYPSO_MQTTROUTER_HASH_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief Trie node (one topic level of a topic filter).
+ *
+ * Child nodes matching a specific level string are stored in the hash table, while the
+ * wildcard children are referenced directly by their parent.
+ */
+typedef struct Calypso_MQTTRouter_Node_t
+{
+    uint16_t parent;                    /**< Parent node */
+    uint16_t levelOffset;               /**< Offset of level string in level string buffer */
+    uint8_t levelLength;                /**< Length of level string */
+    uint16_t plusChild;                 /**< Single level wildcard ('+') child node */
+    uint16_t hashChild;                 /**< Multi level wildcard ('#') child node */
+    uint16_t firstHandler;              /**< First handler registered for this node */
+    uint16_t childCount;                /**< Number of child nodes (including wildcard children) */
+} Calypso_MQTTRouter_Node_t;
+
+/**
+ * @brief Registered handler.
+ */
+typedef struct Calypso_MQTTRouter_HandlerEntry_t
+{
+    Calypso_MQTTRouter_Handler_t handler;       /**< Handler function (NULL if entry is unused) */
+    void *context;                              /**< Context passed to handler function */
+    uint16_t next;                              /**< Next handler registered for the same node */
+} Calypso_MQTTRouter_HandlerEntry_t;
+
+static uint16_t Calypso_MQTTRouter_Hash(uint16_t parent, const char *level, uint8_t levelLength);
+static uint16_t Calypso_MQTTRouter_FindChild(uint16_t parent, const char *level, uint8_t levelLength, uint16_t *pSlot);
+static uint16_t Calypso_MQTTRouter_AddNode(uint16_t parent);
+static void Calypso_MQTTRouter_ReleaseNodes(uint16_t node);
+static void Calypso_MQTTRouter_RemoveFromHashTable(uint16_t slot);
+static void Calypso_MQTTRouter_ReleaseLevel(uint16_t levelOffset, uint8_t levelLength);
+static uint16_t Calypso_MQTTRouter_GetNode(const char *topicFilter, bool create);
+static bool Calypso_MQTTRouter_AddHandler(const char *topicFilter, Calypso_MQTTRouter_Handler_t handler, void *context, bool *pAdded);
+static uint16_t Calypso_MQTTRouter_CallHandlers(uint16_t node, const ATEvent_MQTTRcvd_t *message);
+static uint16_t Calypso_MQTTRouter_Match(uint16_t node, const char *level, const char *topicEnd, const ATEvent_MQTTRcvd_t *message);
+
+/**
+ * @brief Trie nodes (node 0 is the root node).
+ */
+static Calypso_MQTTRouter_Node_t Calypso_MQTTRouter_nodes[CALYPSO_MQTTROUTER_MAX_NODES];
+
+/**
+ * @brief Number of used trie nodes.
+ */
+static uint16_t Calypso_MQTTRouter_nodeCount = 0;
+
+/**
+ * @brief Number of entries of Calypso_MQTTRouter_nodes that have been used so far (used or released).
+ */
+static uint16_t Calypso_MQTTRouter_nodesAllocated = 0;
+
+/**
+ * @brief First released trie node (released nodes are linked using their parent field).
+ */
+static uint16_t Calypso_MQTTRouter_freeNodes = CALYPSO_MQTTROUTER_NONE;
+
+/**
+ * @brief Hash table containing the indices of all non-wildcard nodes (open addressing, linear probing).
+ */
+static uint16_t Calypso_MQTTRouter_hashTable[CALYPSO_MQTTROUTER_HASH_SIZE];
+
+/**
+ * @brief Registered handlers.
+ */
+static Calypso_MQTTRouter_HandlerEntry_t Calypso_MQTTRouter_handlers[CALYPSO_MQTTROUTER_MAX_HANDLERS];
+
+/**
+ * @brief Number of registered handlers.
+ */
+static uint16_t Calypso_MQTTRouter_handlerCount = 0;
+
+/**
+ * @brief Buffer containing the level strings of all trie nodes (not null terminated).
+ */
+static char Calypso_MQTTRouter_levelPool[CALYPSO_MQTTROUTER_LEVEL_POOL_SIZE];
+
+/**
+ * @brief Number of used bytes in Calypso_MQTTRouter_levelPool.
+ */
+static uint16_t Calypso_MQTTRouter_levelPoolUsed = 0;
+
+/**
+ * @brief Dispatcher statistics.
+ */
+static Calypso_MQTTRouter_Statistics_t Calypso_MQTTRouter_statistics;
+
+/**
+ * @brief Initializes the dispatcher (removes all handlers and trie nodes).
+ */
+void Calypso_MQTTRouter_Init(void)
+{
+    memset(&Calypso_MQTTRouter_statistics, 0, sizeof(Calypso_MQTTRouter_statistics));
+    memset(Calypso_MQTTRouter_hashTable, 0xFF, sizeof(Calypso_MQTTRouter_hashTable));
+    memset(Calypso_MQTTRouter_handlers, 0, sizeof(Calypso_MQTTRouter_handlers));
+    Calypso_MQTTRouter_handlerCount = 0;
+    Calypso_MQTTRouter_levelPoolUsed = 0;
+    Calypso_MQTTRouter_nodeCount = 0;
+    Calypso_MQTTRouter_nodesAllocated = 0;
+    Calypso_MQTTRouter_freeNodes = CALYPSO_MQTTROUTER_NONE;
+    Calypso_MQTTRouter_AddNode(CALYPSO_MQTTROUTER_NONE);
+}
+
+/**
+ * @brief Registers a handler for a topic filter.
+ *
+ * Registering the same handler with the same context for the same topic filter more than once has no effect.
+ *
+ * @param[in] topicFilter Topic filter (may contain '+' and '#' wildcards)
+ * @param[in] handler Handler to be called for messages with topics matching the topic filter
+ * @param[in] context Context pointer passed to the handler
+ *
+ * @return true if successful, false otherwise (invalid topic filter or out of resources)
+ */
+bool Calypso_MQTTRouter_Register(const char *topicFilter,
+                                 Calypso_MQTTRouter_Handler_t handler,
+                                 void *context)
+{
+    bool added;
+    return Calypso_MQTTRouter_AddHandler(topicFilter, handler, context, &added);
+}
+
+/**
+ * @brief Unregisters a handler for a topic filter.
+ *
+ * Trie nodes and topic level strings that are no longer needed by any other topic filter are released.
+ *
+ * @param[in] topicFilter Topic filter used when registering the handler
+ * @param[in] handler Handler to be removed (NULL to remove all handlers of the topic filter)
+ *
+ * @return true if at least one handler has been removed, false otherwise
+ */
+bool Calypso_MQTTRouter_Unregister(const char *topicFilter,
+                                   Calypso_MQTTRouter_Handler_t handler)
+{
+    uint16_t node = Calypso_MQTTRouter_GetNode(topicFilter, false);
+    if (CALYPSO_MQTTROUTER_NONE == node)
+    {
+        return false;
+    }
+
+    bool removed = false;
+    uint16_t *pLink = &Calypso_MQTTRouter_nodes[node].firstHandler;
+    while (CALYPSO_MQTTROUTER_NONE != *pLink)
+    {
+        Calypso_MQTTRouter_HandlerEntry_t *entry = &Calypso_MQTTRouter_handlers[*pLink];
+        if (NULL == handler || entry->handler == handler)
+        {
+            *pLink = entry->next;
+            entry->handler = NULL;
+            entry->context = NULL;
+            Calypso_MQTTRouter_handlerCount--;
+            removed = true;
+        }
+        else
+        {
+            pLink = &entry->next;
+        }
+    }
+
+    Calypso_MQTTRouter_ReleaseNodes(node);
+
+    return removed;
+}
+
+/**
+ * @brief Registers a handler for one or more topic filters and subscribes to them (using ATMQTT_Subscribe()).
+ *
+ * The handler is registered before sending the subscribe request, so that no messages are missed.
+ * If the subscription fails, the handlers added by this function are removed again.
+ *
+ * @param[in] index Index (handle) of MQTT client to use
+ * @param[in] numOfTopics Number of topics to subscribe to (max. MQTT_MAX_NUM_TOPICS_TO_SUBSCRIBE)
+ * @param[in] pTopics Topics to subscribe to. See ATMQTT_SubscribeTopic_t
+ * @param[in] handler Handler to be called for messages with topics matching one of the topic filters
+ * @param[in] context Context pointer passed to the handler
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_MQTTRouter_Subscribe(uint8_t index,
+                                  uint8_t numOfTopics,
+                                  ATMQTT_SubscribeTopic_t *pTopics,
+                                  Calypso_MQTTRouter_Handler_t handler,
+                                  void *context)
+{
+    bool added[MQTT_MAX_NUM_TOPICS_TO_SUBSCRIBE] = {false};
+    bool ret = (numOfTopics > 0 && numOfTopics <= MQTT_MAX_NUM_TOPICS_TO_SUBSCRIBE && NULL != handler);
+
+    for (uint8_t i = 0; ret && i < numOfTopics; i++)
+    {
+        ret = Calypso_MQTTRouter_AddHandler(pTopics[i].topic, handler, context, &added[i]);
+    }
+
+    if (ret)
+    {
+        ret = ATMQTT_Subscribe(index, numOfTopics, pTopics);
+    }
+
+    if (!ret)
+    {
+        for (uint8_t i = 0; i < numOfTopics && i < MQTT_MAX_NUM_TOPICS_TO_SUBSCRIBE; i++)
+        {
+            if (added[i])
+            {
+                Calypso_MQTTRouter_Unregister(pTopics[i].topic, handler);
+            }
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Unsubscribes from a topic (using ATMQTT_Unsubscribe()) and unregisters the corresponding handler.
+ *
+ * @param[in] index Index (handle) of MQTT client to use
+ * @param[in] topicFilter Topic filter to unsubscribe from
+ * @param[in] handler Handler to be removed (NULL to remove all handlers of the topic filter)
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_MQTTRouter_Unsubscribe(uint8_t index,
+                                    char *topicFilter,
+                                    Calypso_MQTTRouter_Handler_t handler)
+{
+    if (!ATMQTT_Unsubscribe(index, topicFilter, NULL, NULL, NULL))
+    {
+        return false;
+    }
+
+    Calypso_MQTTRouter_Unregister(topicFilter, handler);
+    return true;
+}
+
+/**
+ * @brief Parses MQTT receive events and dispatches the received messages to the registered handlers.
+ *
+ * Is intended to be called from the Calypso event callback for every event (after ATEvent_ParseEventType()).
+ *
+ * @param[in] event Event type as returned by ATEvent_ParseEventType()
+ * @param[in,out] pEventArguments Event arguments as returned by ATEvent_ParseEventType()
+ *
+ * @return true if the event was an MQTT receive event, false otherwise
+ */
+bool Calypso_MQTTRouter_HandleEvent(ATEvent_t event, char **pEventArguments)
+{
+    if (ATEvent_MQTTRecv != event)
+    {
+        return false;
+    }
+
+    ATEvent_MQTTRcvd_t message;
+    if (!ATEvent_ParseMQTTRcvdEvent(pEventArguments, true, &message))
+    {
+        Calypso_MQTTRouter_statistics.invalid++;
+        return true;
+    }
+
+    Calypso_MQTTRouter_Dispatch(&message);
+    return true;
+}
+
+/**
+ * @brief Calls all handlers whose topic filters match the topic of the supplied message.
+ *
+ * @param[in] message Received message
+ *
+ * @return Number of called handlers
+ */
+uint16_t Calypso_MQTTRouter_Dispatch(const ATEvent_MQTTRcvd_t *message)
+{
+    if (0 == Calypso_MQTTRouter_nodeCount)
+    {
+        return 0;
+    }
+
+    uint16_t count = Calypso_MQTTRouter_Match(CALYPSO_MQTTROUTER_ROOT,
+                                              message->topic.data,
+                                              message->topic.data + message->topic.length,
+                                              message);
+
+    Calypso_MQTTRouter_statistics.received++;
+    if (0 == count)
+    {
+        Calypso_MQTTRouter_statistics.unmatched++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns dispatcher statistics.
+ *
+ * @param[out] statistics Dispatcher statistics
+ */
+void Calypso_MQTTRouter_GetStatistics(Calypso_MQTTRouter_Statistics_t *statistics)
+{
+    *statistics = Calypso_MQTTRouter_statistics;
+    statistics->nodes = Calypso_MQTTRouter_nodeCount;
+    statistics->handlers = Calypso_MQTTRouter_handlerCount;
+    statistics->levelPoolUsed = Calypso_MQTTRouter_levelPoolUsed;
+}
+
+/**
+ * @brief Computes the hash table index of a child node (FNV-1a of parent index and level string).
+ *
+ * @param[in] parent Parent node
+ * @param[in] level Level string (not null terminated)
+ * @param[in] levelLength Length of level string
+ *
+ * @return Hash table index
+ */
+static uint16_t Calypso_MQTTRouter_Hash(uint16_t parent, const char *level, uint8_t levelLength)
+{
+    uint32_t hash = 2166136261UL;
+
+    hash = (hash ^ (parent & 0xFF)) * 16777619UL;
+    hash = (hash ^ (parent >> 8)) * 16777619UL;
+    for (uint8_t i = 0; i < levelLength; i++)
+    {
+        hash = (hash ^ (uint8_t) level[i]) * 16777619UL;
+    }
+
+    return (uint16_t) (hash & (CALYPSO_MQTTROUTER_HASH_SIZE - 1));
+}
+
+/**
+ * @brief Looks up the (non-wildcard) child node with the supplied level string.
+ *
+ * @param[in] parent Parent node
+ * @param[in] level Level string (not null terminated)
+ * @param[in] levelLength Length of level string
+ * @param[out] pSlot Hash table slot of the child node or first free slot if the child
+ *             node doesn't exist (CALYPSO_MQTTROUTER_NONE if the table is full). May be NULL.
+ *
+ * @return Index of child node or CALYPSO_MQTTROUTER_NONE if not found
+ */
+static uint16_t Calypso_MQTTRouter_FindChild(uint16_t parent, const char *level, uint8_t levelLength, uint16_t *pSlot)
+{
+    uint16_t slot = Calypso_MQTTRouter_Hash(parent, level, levelLength);
+
+    for (uint16_t probe = 0; probe < CALYPSO_MQTTROUTER_HASH_SIZE; probe++)
+    {
+        uint16_t node = Calypso_MQTTRouter_hashTable[slot];
+        if (CALYPSO_MQTTROUTER_NONE == node)
+        {
+            break;
+        }
+
+        Calypso_MQTTRouter_Node_t *pNode = &Calypso_MQTTRouter_nodes[node];
+        if (pNode->parent == parent &&
+            pNode->levelLength == levelLength &&
+            0 == memcmp(&Calypso_MQTTRouter_levelPool[pNode->levelOffset], level, levelLength))
+        {
+            if (NULL != pSlot)
+            {
+                *pSlot = slot;
+            }
+            return node;
+        }
+
+        slot = (slot + 1) & (CALYPSO_MQTTROUTER_HASH_SIZE - 1);
+    }
+
+    if (NULL != pSlot)
+    {
+        *pSlot = (CALYPSO_MQTTROUTER_NONE == Calypso_MQTTRouter_hashTable[slot]) ? slot : CALYPSO_MQTTROUTER_NONE;
+    }
+    return CALYPSO_MQTTROUTER_NONE;
+}
+
+/**
+ * @brief Allocates a new trie node.
+ *
+ * @param[in] parent Parent node
+ *
+ * @return Index of new node or CALYPSO_MQTTROUTER_NONE if out of nodes
+ */
+static uint16_t Calypso_MQTTRouter_AddNode(uint16_t parent)
+{
+    uint16_t node;
+    if (CALYPSO_MQTTROUTER_NONE != Calypso_MQTTRouter_freeNodes)
+    {
+        node = Calypso_MQTTRouter_freeNodes;
+        Calypso_MQTTRouter_freeNodes = Calypso_MQTTRouter_nodes[node].parent;
+    }
+    else if (Calypso_MQTTRouter_nodesAllocated < CALYPSO_MQTTROUTER_MAX_NODES)
+    {
+        node = Calypso_MQTTRouter_nodesAllocated++;
+    }
+    else
+    {
+        fprintf(stdout, "MQTT router: Out of trie nodes\n");
+        return CALYPSO_MQTTROUTER_NONE;
+    }
+
+    Calypso_MQTTRouter_nodeCount++;
+    Calypso_MQTTRouter_Node_t *pNode = &Calypso_MQTTRouter_nodes[node];
+    pNode->parent = parent;
+    pNode->levelOffset = 0;
+    pNode->levelLength = 0;
+    pNode->plusChild = CALYPSO_MQTTROUTER_NONE;
+    pNode->hashChild = CALYPSO_MQTTROUTER_NONE;
+    pNode->firstHandler = CALYPSO_MQTTROUTER_NONE;
+    pNode->childCount = 0;
+    if (CALYPSO_MQTTROUTER_NONE != parent)
+    {
+        Calypso_MQTTRouter_nodes[parent].childCount++;
+    }
+    return node;
+}
+
+/**
+ * @brief Releases a trie node without handlers and children, and then its parents if they become unused.
+ *
+ * @param[in] node Trie node (nothing is released if the node still has handlers or children)
+ */
+static void Calypso_MQTTRouter_ReleaseNodes(uint16_t node)
+{
+    while (CALYPSO_MQTTROUTER_ROOT != node)
+    {
+        Calypso_MQTTRouter_Node_t *pNode = &Calypso_MQTTRouter_nodes[node];
+        if (CALYPSO_MQTTROUTER_NONE != pNode->firstHandler || 0 != pNode->childCount)
+        {
+            return;
+        }
+
+        uint16_t parent = pNode->parent;
+        Calypso_MQTTRouter_Node_t *pParent = &Calypso_MQTTRouter_nodes[parent];
+        if (pParent->plusChild == node)
+        {
+            pParent->plusChild = CALYPSO_MQTTROUTER_NONE;
+        }
+        else if (pParent->hashChild == node)
+        {
+            pParent->hashChild = CALYPSO_MQTTROUTER_NONE;
+        }
+        else
+        {
+            uint16_t slot;
+            if (node == Calypso_MQTTRouter_FindChild(parent,
+                                                     &Calypso_MQTTRouter_levelPool[pNode->levelOffset],
+                                                     pNode->levelLength,
+                                                     &slot))
+            {
+                Calypso_MQTTRouter_RemoveFromHashTable(slot);
+            }
+            Calypso_MQTTRouter_ReleaseLevel(pNode->levelOffset, pNode->levelLength);
+        }
+        pParent->childCount--;
+
+        pNode->parent = Calypso_MQTTRouter_freeNodes;
+        Calypso_MQTTRouter_freeNodes = node;
+        Calypso_MQTTRouter_nodeCount--;
+
+        node = parent;
+    }
+}
+
+/**
+ * @brief Removes an entry from the hash table.
+ *
+ * The following entries of the probe sequence are moved back to fill the gap, so that
+ * lookups don't stop early at the freed slot.
+ *
+ * @param[in] slot Hash table slot to be freed
+ */
+static void Calypso_MQTTRouter_RemoveFromHashTable(uint16_t slot)
+{
+    const uint16_t mask = CALYPSO_MQTTROUTER_HASH_SIZE - 1;
+
+    for (uint16_t next = (slot + 1) & mask; next != slot; next = (next + 1) & mask)
+    {
+        uint16_t node = Calypso_MQTTRouter_hashTable[next];
+        if (CALYPSO_MQTTROUTER_NONE == node)
+        {
+            break;
+        }
+
+        /* Move the entry to the free slot, if its home slot isn't located between the free slot and the entry */
+        Calypso_MQTTRouter_Node_t *pNode = &Calypso_MQTTRouter_nodes[node];
+        uint16_t home = Calypso_MQTTRouter_Hash(pNode->parent, &Calypso_MQTTRouter_levelPool[pNode->levelOffset], pNode->levelLength);
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            Calypso_MQTTRouter_hashTable[slot] = node;
+            slot = next;
+        }
+    }
+
+    Calypso_MQTTRouter_hashTable[slot] = CALYPSO_MQTTROUTER_NONE;
+}
+
+/**
+ * @brief Removes a level string from the level string buffer (the following strings are moved down).
+ *
+ * @param[in] levelOffset Offset of level string in level string buffer
+ * @param[in] levelLength Length of level string
+ */
+static void Calypso_MQTTRouter_ReleaseLevel(uint16_t levelOffset, uint8_t levelLength)
+{
+    if (0 == levelLength)
+    {
+        return;
+    }
+
+    memmove(&Calypso_MQTTRouter_levelPool[levelOffset],
+            &Calypso_MQTTRouter_levelPool[levelOffset + levelLength],
+            Calypso_MQTTRouter_levelPoolUsed - levelOffset - levelLength);
+    Calypso_MQTTRouter_levelPoolUsed -= levelLength;
+
+    for (uint16_t i = 0; i < Calypso_MQTTRouter_nodesAllocated; i++)
+    {
+        if (Calypso_MQTTRouter_nodes[i].levelOffset > levelOffset)
+        {
+            Calypso_MQTTRouter_nodes[i].levelOffset -= levelLength;
+        }
+    }
+}
+
+/**
+ * @brief Returns the trie node of a topic filter.
+ *
+ * @param[in] topicFilter Topic filter
+ * @param[in] create If true, missing nodes are added to the trie
+ *
+ * @return Index of node or CALYPSO_MQTTROUTER_NONE if the topic filter is invalid,
+ *         not found (create == false) or if out of resources (create == true)
+ */
+static uint16_t Calypso_MQTTRouter_GetNode(const char *topicFilter, bool create)
+{
+    if (NULL == topicFilter || '\0' == topicFilter[0] || 0 == Calypso_MQTTRouter_nodeCount)
+    {
+        return CALYPSO_MQTTROUTER_NONE;
+    }
+
+    uint16_t node = CALYPSO_MQTTROUTER_ROOT;
+    const char *level = topicFilter;
+
+    while (NULL != level)
+    {
+        const char *separator = strchr(level, CALYPSO_MQTTROUTER_LEVEL_SEPARATOR);
+        size_t levelLength = (NULL != separator) ? (size_t) (separator - level) : strlen(level);
+        const char *nextLevel = (NULL != separator) ? separator + 1 : NULL;
+
+        if (levelLength > UINT8_MAX)
+        {
+            break;
+        }
+
+        uint16_t *pWildcardChild = NULL;
+        if (1 == levelLength && '+' == level[0])
+        {
+            pWildcardChild = &Calypso_MQTTRouter_nodes[node].plusChild;
+        }
+        else if (1 == levelLength && '#' == level[0])
+        {
+            if (NULL != nextLevel)
+            {
+                /* '#' must be the last level */
+                break;
+            }
+            pWildcardChild = &Calypso_MQTTRouter_nodes[node].hashChild;
+        }
+        else if (NULL != memchr(level, '+', levelLength) || NULL != memchr(level, '#', levelLength))
+        {
+            /* Wildcards must occupy an entire level */
+            break;
+        }
+
+        uint16_t child;
+        if (NULL != pWildcardChild)
+        {
+            child = *pWildcardChild;
+            if (CALYPSO_MQTTROUTER_NONE == child && create)
+            {
+                child = Calypso_MQTTRouter_AddNode(node);
+                if (CALYPSO_MQTTROUTER_NONE != child)
+                {
+                    *pWildcardChild = child;
+                }
+            }
+        }
+        else
+        {
+            uint16_t slot;
+            child = Calypso_MQTTRouter_FindChild(node, level, (uint8_t) levelLength, &slot);
+            if (CALYPSO_MQTTROUTER_NONE == child && create)
+            {
+                if (CALYPSO_MQTTROUTER_NONE == slot ||
+                    Calypso_MQTTRouter_levelPoolUsed + levelLength > CALYPSO_MQTTROUTER_LEVEL_POOL_SIZE)
+                {
+                    fprintf(stdout, "MQTT router: Out of memory\n");
+                    break;
+                }
+
+                child = Calypso_MQTTRouter_AddNode(node);
+                if (CALYPSO_MQTTROUTER_NONE != child)
+                {
+                    Calypso_MQTTRouter_Node_t *pChild = &Calypso_MQTTRouter_nodes[child];
+                    pChild->levelOffset = Calypso_MQTTRouter_levelPoolUsed;
+                    pChild->levelLength = (uint8_t) levelLength;
+                    memcpy(&Calypso_MQTTRouter_levelPool[Calypso_MQTTRouter_levelPoolUsed], level, levelLength);
+                    Calypso_MQTTRouter_levelPoolUsed += levelLength;
+                    Calypso_MQTTRouter_hashTable[slot] = child;
+                }
+            }
+        }
+
+        if (CALYPSO_MQTTROUTER_NONE == child)
+        {
+            break;
+        }
+
+        node = child;
+        level = nextLevel;
+    }
+
+    if (NULL != level)
+    {
+        /* Invalid topic filter or out of resources - release the nodes that have been added */
+        Calypso_MQTTRouter_ReleaseNodes(node);
+        return CALYPSO_MQTTROUTER_NONE;
+    }
+
+    return node;
+}
+
+/**
+ * @brief Registers a handler for a topic filter.
+ *
+ * @param[in] topicFilter Topic filter
+ * @param[in] handler Handler function
+ * @param[in] context Context pointer passed to the handler
+ * @param[out] pAdded Is set to true if the handler has been added, false if it was already registered
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_MQTTRouter_AddHandler(const char *topicFilter, Calypso_MQTTRouter_Handler_t handler, void *context, bool *pAdded)
+{
+    *pAdded = false;
+
+    if (NULL == handler)
+    {
+        return false;
+    }
+
+    uint16_t node = Calypso_MQTTRouter_GetNode(topicFilter, true);
+    if (CALYPSO_MQTTROUTER_NONE == node)
+    {
+        return false;
+    }
+
+    uint16_t *pLink = &Calypso_MQTTRouter_nodes[node].firstHandler;
+    while (CALYPSO_MQTTROUTER_NONE != *pLink)
+    {
+        Calypso_MQTTRouter_HandlerEntry_t *entry = &Calypso_MQTTRouter_handlers[*pLink];
+        if (entry->handler == handler && entry->context == context)
+        {
+            return true;
+        }
+        pLink = &entry->next;
+    }
+
+    for (uint16_t i = 0; i < CALYPSO_MQTTROUTER_MAX_HANDLERS; i++)
+    {
+        if (NULL == Calypso_MQTTRouter_handlers[i].handler)
+        {
+            Calypso_MQTTRouter_handlers[i].context = context;
+            Calypso_MQTTRouter_handlers[i].next = CALYPSO_MQTTROUTER_NONE;
+            Calypso_MQTTRouter_handlers[i].handler = handler;
+
+            /* Append to the node's list as last step, so that the dispatcher never sees an incomplete entry */
+            *pLink = i;
+            Calypso_MQTTRouter_handlerCount++;
+            *pAdded = true;
+            return true;
+        }
+    }
+
+    fprintf(stdout, "MQTT router: Out of handlers\n");
+    Calypso_MQTTRouter_ReleaseNodes(node);
+    return false;
+}
+
+/**
+ * @brief Calls all handlers registered for a node.
+ *
+ * @param[in] node Trie node
+ * @param[in] message Received message
+ *
+ * @return Number of called handlers
+ */
+static uint16_t Calypso_MQTTRouter_CallHandlers(uint16_t node, const ATEvent_MQTTRcvd_t *message)
+{
+    uint16_t count = 0;
+
+    for (uint16_t i = Calypso_MQTTRouter_nodes[node].firstHandler; CALYPSO_MQTTROUTER_NONE != i; i = Calypso_MQTTRouter_handlers[i].next)
+    {
+        Calypso_MQTTRouter_handlers[i].handler(message, Calypso_MQTTRouter_handlers[i].context);
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Calls the handlers of all nodes below the supplied node that match the remaining topic levels.
+ *
+ * Per level, the exact match is looked up in the hash table and the wildcard children are
+ * checked, i.e. the cost depends on the number of topic levels and not on the number of
+ * registered topic filters.
+ *
+ * @param[in] node Trie node matching the topic levels before level
+ * @param[in] level Remaining topic levels (NULL if all levels have been matched)
+ * @param[in] topicEnd End of the topic (topic is not null terminated)
+ * @param[in] message Received message
+ *
+ * @return Number of called handlers
+ */
+static uint16_t Calypso_MQTTRouter_Match(uint16_t node, const char *level, const char *topicEnd, const ATEvent_MQTTRcvd_t *message)
+{
+    const Calypso_MQTTRouter_Node_t *pNode = &Calypso_MQTTRouter_nodes[node];
+    uint16_t count = 0;
+
+    if (NULL == level)
+    {
+        count += Calypso_MQTTRouter_CallHandlers(node, message);
+
+        /* "a/#" also matches "a" */
+        if (CALYPSO_MQTTROUTER_NONE != pNode->hashChild)
+        {
+            count += Calypso_MQTTRouter_CallHandlers(pNode->hashChild, message);
+        }
+        return count;
+    }
+
+    /* Topics starting with '$' are not matched by wildcards on the first level */
+    bool wildcardsAllowed = (CALYPSO_MQTTROUTER_ROOT != node || level == topicEnd || '$' != level[0]);
+
+    if (wildcardsAllowed && CALYPSO_MQTTROUTER_NONE != pNode->hashChild)
+    {
+        count += Calypso_MQTTRouter_CallHandlers(pNode->hashChild, message);
+    }
+
+    const char *separator = memchr(level, CALYPSO_MQTTROUTER_LEVEL_SEPARATOR, topicEnd - level);
+    size_t levelLength = (NULL != separator) ? (size_t) (separator - level) : (size_t) (topicEnd - level);
+    const char *nextLevel = (NULL != separator) ? separator + 1 : NULL;
+
+    if (levelLength <= UINT8_MAX)
+    {
+        uint16_t child = Calypso_MQTTRouter_FindChild(node, level, (uint8_t) levelLength, NULL);
+        if (CALYPSO_MQTTROUTER_NONE != child)
+        {
+            count += Calypso_MQTTRouter_Match(child, nextLevel, topicEnd, message);
+        }
+    }
+
+    if (wildcardsAllowed && CALYPSO_MQTTROUTER_NONE != pNode->plusChild)
+    {
+        count += Calypso_MQTTRouter_Match(pNode->plusChild, nextLevel, topicEnd, message);
+    }
+
+    return count;
+}
@@ -0,0 +1,138 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso MQTT subscription dispatcher header file.
+ *
+ * Routes received MQTT messages (ATEvent_MQTTRecv) to handlers registered per topic filter.
+ * The topic filters are stored in a topic trie (one node per topic level) with support for
+ * the single level ('+') and multi level ('#') wildcards. Child nodes are looked up using a
+ * hash table, so the cost of dispatching a message depends on the number of levels of the
+ * topic rather than on the number of subscriptions.
+ *
+ * Usage:
+ * - Call Calypso_MQTTRouter_Init() once.
+ * - Subscribe to topics using Calypso_MQTTRouter_Subscribe() (registers the handler and
+ *   subscribes to the topics using ATMQTT_Subscribe()) or register handlers for topics that
+ *   have already been subscribed to using Calypso_MQTTRouter_Register().
+ * - Pass all events to Calypso_MQTTRouter_HandleEvent() from within the Calypso event callback.
+ *
+ * Note that the handlers are called from within the Calypso event callback, i.e. the
+ * restrictions of the event callback apply (code should be kept simple, no AT commands).
+ *
+ * Trie nodes and topic level strings are released when the last handler using them is
+ * unregistered, so that subscribing and unsubscribing repeatedly doesn't use up the static pools.
+ * Handlers must not be registered or unregistered from within a handler.
+ */
+
+#ifndef CALYPSO_MQTTROUTER_H_INCLUDED
+#define CALYPSO_MQTTROUTER_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ATCommands/ATEvent.h"
+#include "ATCommands/ATMQTT.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Max. number of trie nodes (one per distinct topic level of all registered topic filters).
+ */
+#ifndef CALYPSO_MQTTROUTER_MAX_NODES
+#define CALYPSO_MQTTROUTER_MAX_NODES 160
+#endif
+
+/**
+ * @brief Max. number of registered handlers.
+ */
+#ifndef CALYPSO_MQTTROUTER_MAX_HANDLERS
+#define CALYPSO_MQTTROUTER_MAX_HANDLERS 96
+#endif
+
+/**
+ * @brief Size of hash table used to look up child nodes (must be a power of two and should be
+ * larger than CALYPSO_MQTTROUTER_MAX_NODES).
+ */
+#ifndef CALYPSO_MQTTROUTER_HASH_SIZE
+#define CALYPSO_MQTTROUTER_HASH_SIZE 256
+#endif
+
+/**
+ * @brief Size of buffer used to store the topic level strings of all trie nodes.
+ */
+#ifndef CALYPSO_MQTTROUTER_LEVEL_POOL_SIZE
+#define CALYPSO_MQTTROUTER_LEVEL_POOL_SIZE 1536
+#endif
+
+/**
+ * @brief Handler for received MQTT messages.
+ *
+ * Topic and data of the message reference the event text, i.e. they are only valid until the
+ * handler returns.
+ *
+ * @param[in] message Received message
+ * @param[in] context Context pointer passed when registering the handler
+ */
+typedef void (*Calypso_MQTTRouter_Handler_t)(const ATEvent_MQTTRcvd_t *message, void *context);
+
+/**
+ * @brief Dispatcher statistics as returned by Calypso_MQTTRouter_GetStatistics().
+ */
+typedef struct Calypso_MQTTRouter_Statistics_t
+{
+    uint16_t nodes;             /**< Number of used trie nodes */
+    uint16_t handlers;          /**< Number of registered handlers */
+    uint16_t levelPoolUsed;     /**< Number of used bytes in level string buffer */
+    uint32_t received;          /**< Number of received messages */
+    uint32_t unmatched;         /**< Number of received messages without matching handler */
+    uint32_t invalid;           /**< Number of receive events that could not be parsed */
+} Calypso_MQTTRouter_Statistics_t;
+
+extern void Calypso_MQTTRouter_Init(void);
+extern bool Calypso_MQTTRouter_Register(const char *topicFilter,
+                                        Calypso_MQTTRouter_Handler_t handler,
+                                        void *context);
+extern bool Calypso_MQTTRouter_Unregister(const char *topicFilter,
+                                          Calypso_MQTTRouter_Handler_t handler);
+extern bool Calypso_MQTTRouter_Subscribe(uint8_t index,
+                                         uint8_t numOfTopics,
+                                         ATMQTT_SubscribeTopic_t *pTopics,
+                                         Calypso_MQTTRouter_Handler_t handler,
+                                         void *context);
+extern bool Calypso_MQTTRouter_Unsubscribe(uint8_t index,
+                                           char *topicFilter,
+                                           Calypso_MQTTRouter_Handler_t handler);
+extern bool Calypso_MQTTRouter_HandleEvent(ATEvent_t event, char **pEventArguments);
+extern uint16_t Calypso_MQTTRouter_Dispatch(const ATEvent_MQTTRcvd_t *message);
+extern void Calypso_MQTTRouter_GetStatistics(Calypso_MQTTRouter_Statistics_t *statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_MQTTROUTER_H_INCLUDED
@@ -0,0 +1,491 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Calypso transparent mode data pump source file.
+ */
+
+#include "Calypso_TransparentMode.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Calypso.h"
+#include "ATCommands/ATDevice.h"
+
+#if (CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE & (CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE - 1)) != 0 || CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE > 32768
+#error "CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE must be a power of two (max. 32768)"
+#endif
+
+#if (CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE & (CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE - 1)) != 0 || CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE > 32768
+#error "CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE must be a power of two (max. 32768)"
+#endif
+
+#define RX_MASK (CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE - 1)
+#define TX_MASK (CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE - 1)
+
+static void Calypso_TransparentMode_HandleRxBlock(uint8_t *data, size_t size);
+static void Calypso_TransparentMode_HandleRxByte(uint8_t receivedByte);
+static void Calypso_TransparentMode_HandleTxComplete(void);
+static void Calypso_TransparentMode_StartTx(void);
+
+/**
+ * @brief Settings passed to Calypso_TransparentMode_Start().
+ */
+static Calypso_TransparentMode_Settings_t Calypso_TransparentMode_settings;
+
+/**
+ * @brief Is set to true while transparent mode is active.
+ */
+static bool Calypso_TransparentMode_active = false;
+
+/**
+ * @brief Receive ring buffer. Written in interrupt context, read by Calypso_TransparentMode_Read().
+ */
+static uint8_t Calypso_TransparentMode_rxBuffer[CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE];
+static volatile uint16_t Calypso_TransparentMode_rxHead = 0;   /**< Written in interrupt context only */
+static volatile uint16_t Calypso_TransparentMode_rxTail = 0;   /**< Written by Calypso_TransparentMode_Read() only */
+
+/**
+ * @brief Transmit ring buffer. Written by Calypso_TransparentMode_Write(), read by DMA.
+ */
+static uint8_t Calypso_TransparentMode_txBuffer[CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE];
+static volatile uint16_t Calypso_TransparentMode_txHead = 0;   /**< Written by Calypso_TransparentMode_Write() only */
+static volatile uint16_t Calypso_TransparentMode_txTail = 0;   /**< Written in interrupt context only (after start of transmission) */
+
+/**
+ * @brief Number of bytes of the currently running DMA transmission (0 if idle).
+ */
+static volatile uint16_t Calypso_TransparentMode_txInFlight = 0;
+
+/**
+ * @brief Time (tick) when the last transmission was started (used for wake up in power save mode).
+ */
+static uint32_t Calypso_TransparentMode_lastTxTick = 0;
+
+/**
+ * @brief Throughput counters.
+ */
+static volatile uint32_t Calypso_TransparentMode_bytesSent = 0;
+static volatile uint32_t Calypso_TransparentMode_bytesReceived = 0;
+static volatile uint32_t Calypso_TransparentMode_bytesDropped = 0;
+static uint32_t Calypso_TransparentMode_packetsSent = 0;
+static uint32_t Calypso_TransparentMode_statisticsStartTick = 0;
+
+/**
+ * @brief Switches the module to transparent mode and starts the data pump.
+ *
+ * Sets the application mode pins to transparent mode and resets the module. If applySettings is true,
+ * the UART trigger settings are written to the module first (module must be in AT command mode).
+ * Use Calypso_TransparentMode_WaitForConnection() to wait until WLAN and socket are connected.
+ *
+ * @param[in] settings Transparent mode UART settings
+ * @param[in] applySettings Write the UART trigger settings to the module before switching
+ * @param[in] startupTimeMs Time to wait for the module to start up after reset
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_TransparentMode_Start(const Calypso_TransparentMode_Settings_t *settings,
+                                   bool applySettings,
+                                   uint32_t startupTimeMs)
+{
+    if (NULL == settings)
+    {
+        return false;
+    }
+
+    if (applySettings)
+    {
+        ATDevice_Value_t deviceValue;
+
+        memset(&deviceValue, 0, sizeof(deviceValue));
+        deviceValue.uart.transparentTrigger = settings->trigger;
+        if (!ATDevice_Set(ATDevice_GetId_UART, ATDevice_GetUart_TransparentTrigger, &deviceValue))
+        {
+            return false;
+        }
+
+        memset(&deviceValue, 0, sizeof(deviceValue));
+        deviceValue.uart.transparentTimeoutMs = settings->timeoutMs;
+        if (!ATDevice_Set(ATDevice_GetId_UART, ATDevice_GetUart_TransparentTimeout, &deviceValue))
+        {
+            return false;
+        }
+
+        memset(&deviceValue, 0, sizeof(deviceValue));
+        deviceValue.uart.transparentETX[0] = settings->etx[0];
+        deviceValue.uart.transparentETX[1] = settings->etx[1];
+        if (!ATDevice_Set(ATDevice_GetId_UART, ATDevice_GetUart_TransparentETX, &deviceValue))
+        {
+            return false;
+        }
+    }
+
+    Calypso_TransparentMode_settings = *settings;
+    Calypso_TransparentMode_rxHead = 0;
+    Calypso_TransparentMode_rxTail = 0;
+    Calypso_TransparentMode_txHead = 0;
+    Calypso_TransparentMode_txTail = 0;
+    Calypso_TransparentMode_txInFlight = 0;
+    Calypso_TransparentMode_ResetStatistics();
+
+    if (!Calypso_SetApplicationModePins(Calypso_ApplicationMode_TransparentMode))
+    {
+        return false;
+    }
+
+    /* All data received from now on is payload, not AT responses */
+    WE_uartRxBlockCallback = Calypso_TransparentMode_HandleRxBlock;
+    WE_uartTransmitDmaCompleteCallback = Calypso_TransparentMode_HandleTxComplete;
+    Calypso_SetByteRxCallback(Calypso_TransparentMode_HandleRxByte);
+    Calypso_TransparentMode_active = true;
+
+    if (!Calypso_PinReset())
+    {
+        Calypso_TransparentMode_Stop(0);
+        return false;
+    }
+    WE_Delay(startupTimeMs);
+
+    /* Discard anything the module sent during startup */
+    Calypso_TransparentMode_rxTail = Calypso_TransparentMode_rxHead;
+    Calypso_TransparentMode_lastTxTick = WE_GetTick();
+    return true;
+}
+
+/**
+ * @brief Stops the data pump and switches the module back to AT command mode.
+ *
+ * @param[in] flushTimeoutMs Maximum time to wait for pending data to be transmitted
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_TransparentMode_Stop(uint32_t flushTimeoutMs)
+{
+    if (Calypso_TransparentMode_active)
+    {
+        Calypso_TransparentMode_Flush(flushTimeoutMs);
+    }
+
+    Calypso_TransparentMode_active = false;
+    WE_uartRxBlockCallback = NULL;
+    WE_uartTransmitDmaCompleteCallback = NULL;
+    Calypso_SetByteRxCallback(NULL);
+
+    if (!Calypso_SetApplicationModePins(Calypso_ApplicationMode_ATCommandMode))
+    {
+        return false;
+    }
+    return Calypso_PinReset();
+}
+
+/**
+ * @brief Checks if WLAN and socket are connected (using the status pins STATUS_IND_0 and STATUS_IND_1).
+ *
+ * @return true if connected, false otherwise
+ */
+bool Calypso_TransparentMode_IsConnected(void)
+{
+    return (WE_Pin_Level_High == Calypso_GetPinLevel(Calypso_Pin_StatusInd0)) &&
+           (WE_Pin_Level_High == Calypso_GetPinLevel(Calypso_Pin_StatusInd1));
+}
+
+/**
+ * @brief Waits until WLAN and socket are connected.
+ *
+ * @param[in] timeoutMs Maximum wait time in milliseconds
+ *
+ * @return true if connected, false otherwise
+ */
+bool Calypso_TransparentMode_WaitForConnection(uint32_t timeoutMs)
+{
+    uint32_t t0 = WE_GetTick();
+    while (!Calypso_TransparentMode_IsConnected())
+    {
+        if (WE_GetTick() - t0 > timeoutMs)
+        {
+            return false;
+        }
+        WE_Delay(1);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes data to the transmit buffer and starts the transmission.
+ *
+ * Copies as many bytes as fit into the transmit buffer and returns immediately.
+ * Note that the module triggers transmission of a packet according to the UART trigger settings,
+ * use Calypso_TransparentMode_WritePacket() for ETX terminated packets.
+ *
+ * @param[in] data Data to be sent
+ * @param[in] length Number of bytes to be sent
+ *
+ * @return Number of bytes written to the transmit buffer
+ */
+uint16_t Calypso_TransparentMode_Write(const uint8_t *data, uint16_t length)
+{
+    if (!Calypso_TransparentMode_active)
+    {
+        return 0;
+    }
+
+    uint16_t free = Calypso_TransparentMode_GetTxFree();
+    if (length > free)
+    {
+        length = free;
+    }
+    if (0 == length)
+    {
+        return 0;
+    }
+
+    /* Copy in up to two chunks (wrap around at end of ring buffer) */
+    uint16_t head = Calypso_TransparentMode_txHead;
+    uint16_t offset = head & TX_MASK;
+    uint16_t chunk = CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE - offset;
+    if (chunk > length)
+    {
+        chunk = length;
+    }
+    memcpy(&Calypso_TransparentMode_txBuffer[offset], data, chunk);
+    memcpy(&Calypso_TransparentMode_txBuffer[0], data + chunk, length - chunk);
+    Calypso_TransparentMode_txHead = head + length;
+
+    if (0 == Calypso_TransparentMode_txInFlight)
+    {
+        if (Calypso_TransparentMode_settings.powerSave &&
+                (WE_GetTick() - Calypso_TransparentMode_lastTxTick >= CALYPSO_TRANSPARENTMODE_WAKEUP_IDLE_TIME_MS))
+        {
+            /* Wake up signal (5ms) plus guard interval (5ms) */
+            Calypso_PinWakeUp();
+            WE_Delay(5);
+        }
+        Calypso_TransparentMode_StartTx();
+    }
+    return length;
+}
+
+/**
+ * @brief Writes a complete packet followed by the ETX character(s) (if an ETX trigger is enabled).
+ *
+ * The packet is only written if it fits into the transmit buffer as a whole.
+ *
+ * @param[in] data Data to be sent
+ * @param[in] length Number of bytes to be sent
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_TransparentMode_WritePacket(const uint8_t *data, uint16_t length)
+{
+    uint8_t etxLength = 0;
+    if (0 != (Calypso_TransparentMode_settings.trigger & ATDevice_TransparentModeUartTrigger_TwoETX))
+    {
+        etxLength = 2;
+    }
+    else if (0 != (Calypso_TransparentMode_settings.trigger & ATDevice_TransparentModeUartTrigger_OneETX))
+    {
+        etxLength = 1;
+    }
+
+    if (!Calypso_TransparentMode_active || (length + etxLength > Calypso_TransparentMode_GetTxFree()))
+    {
+        return false;
+    }
+
+    Calypso_TransparentMode_Write(data, length);
+    Calypso_TransparentMode_Write((const uint8_t *) Calypso_TransparentMode_settings.etx, etxLength);
+    Calypso_TransparentMode_packetsSent++;
+    return true;
+}
+
+/**
+ * @brief Waits until all data in the transmit buffer has been transmitted.
+ *
+ * @param[in] timeoutMs Maximum wait time in milliseconds
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_TransparentMode_Flush(uint32_t timeoutMs)
+{
+    uint32_t t0 = WE_GetTick();
+    while ((Calypso_TransparentMode_txTail != Calypso_TransparentMode_txHead) || WE_UART_IsTransmitDmaBusy())
+    {
+        if (WE_GetTick() - t0 > timeoutMs)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reads received data from the receive buffer.
+ *
+ * @param[out] buffer Buffer for received data
+ * @param[in] maxLength Size of buffer
+ *
+ * @return Number of bytes read
+ */
+uint16_t Calypso_TransparentMode_Read(uint8_t *buffer, uint16_t maxLength)
+{
+    uint16_t tail = Calypso_TransparentMode_rxTail;
+    uint16_t length = (uint16_t) (Calypso_TransparentMode_rxHead - tail);
+    if (length > maxLength)
+    {
+        length = maxLength;
+    }
+
+    /* Copy in up to two chunks (wrap around at end of ring buffer) */
+    uint16_t offset = tail & RX_MASK;
+    uint16_t chunk = CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE - offset;
+    if (chunk > length)
+    {
+        chunk = length;
+    }
+    memcpy(buffer, &Calypso_TransparentMode_rxBuffer[offset], chunk);
+    memcpy(buffer + chunk, &Calypso_TransparentMode_rxBuffer[0], length - chunk);
+    Calypso_TransparentMode_rxTail = tail + length;
+    return length;
+}
+
+/**
+ * @brief Returns the number of received bytes which can be read using Calypso_TransparentMode_Read().
+ */
+uint16_t Calypso_TransparentMode_GetRxAvailable(void)
+{
+    return (uint16_t) (Calypso_TransparentMode_rxHead - Calypso_TransparentMode_rxTail);
+}
+
+/**
+ * @brief Returns the number of bytes which can be written using Calypso_TransparentMode_Write().
+ */
+uint16_t Calypso_TransparentMode_GetTxFree(void)
+{
+    return CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE - (uint16_t) (Calypso_TransparentMode_txHead - Calypso_TransparentMode_txTail);
+}
+
+/**
+ * @brief Returns the throughput counters.
+ *
+ * @param[out] statistics Counters since start or last call of Calypso_TransparentMode_ResetStatistics()
+ */
+void Calypso_TransparentMode_GetStatistics(Calypso_TransparentMode_Statistics_t *statistics)
+{
+    statistics->bytesSent = Calypso_TransparentMode_bytesSent;
+    statistics->bytesReceived = Calypso_TransparentMode_bytesReceived;
+    statistics->packetsSent = Calypso_TransparentMode_packetsSent;
+    statistics->bytesDropped = Calypso_TransparentMode_bytesDropped;
+    statistics->elapsedMs = WE_GetTick() - Calypso_TransparentMode_statisticsStartTick;
+}
+
+/**
+ * @brief Resets the throughput counters.
+ */
+void Calypso_TransparentMode_ResetStatistics(void)
+{
+    Calypso_TransparentMode_bytesSent = 0;
+    Calypso_TransparentMode_bytesReceived = 0;
+    Calypso_TransparentMode_bytesDropped = 0;
+    Calypso_TransparentMode_packetsSent = 0;
+    Calypso_TransparentMode_statisticsStartTick = WE_GetTick();
+}
+
+/**
+ * @brief Starts a DMA transmission of the next contiguous chunk of the transmit buffer (if any).
+ *
+ * Is called by Calypso_TransparentMode_Write() if no transmission is running and
+ * in interrupt context when a transmission is complete.
+ */
+static void Calypso_TransparentMode_StartTx(void)
+{
+    uint16_t tail = Calypso_TransparentMode_txTail;
+    uint16_t length = (uint16_t) (Calypso_TransparentMode_txHead - tail);
+    if (0 == length)
+    {
+        return;
+    }
+
+    uint16_t offset = tail & TX_MASK;
+    if (length > CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE - offset)
+    {
+        length = CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE - offset;
+    }
+
+    Calypso_TransparentMode_txInFlight = length;
+    Calypso_TransparentMode_lastTxTick = WE_GetTick();
+    if (!WE_UART_TransmitDma(&Calypso_TransparentMode_txBuffer[offset], length))
+    {
+        Calypso_TransparentMode_txInFlight = 0;
+    }
+}
+
+/**
+ * @brief Is called (in interrupt context) when a DMA transmission is complete.
+ */
+static void Calypso_TransparentMode_HandleTxComplete(void)
+{
+    uint16_t length = Calypso_TransparentMode_txInFlight;
+    Calypso_TransparentMode_txTail += length;
+    Calypso_TransparentMode_bytesSent += length;
+    Calypso_TransparentMode_txInFlight = 0;
+
+    /* Continue with the data written in the meantime */
+    Calypso_TransparentMode_StartTx();
+}
+
+/**
+ * @brief Is called (in interrupt context) for blocks of bytes received via DMA.
+ */
+static void Calypso_TransparentMode_HandleRxBlock(uint8_t *data, size_t size)
+{
+    uint16_t head = Calypso_TransparentMode_rxHead;
+    uint16_t free = CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE - (uint16_t) (head - Calypso_TransparentMode_rxTail);
+    if (size > free)
+    {
+        Calypso_TransparentMode_bytesDropped += size - free;
+        size = free;
+    }
+
+    uint16_t offset = head & RX_MASK;
+    uint16_t chunk = CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE - offset;
+    if (chunk > size)
+    {
+        chunk = size;
+    }
+    memcpy(&Calypso_TransparentMode_rxBuffer[offset], data, chunk);
+    memcpy(&Calypso_TransparentMode_rxBuffer[0], data + chunk, size - chunk);
+    Calypso_TransparentMode_rxHead = head + size;
+    Calypso_TransparentMode_bytesReceived += size;
+}
+
+/**
+ * @brief Is called (in interrupt context) for each byte received if DMA is disabled.
+ */
+static void Calypso_TransparentMode_HandleRxByte(uint8_t receivedByte)
+{
+    Calypso_TransparentMode_HandleRxBlock(&receivedByte, 1);
+}
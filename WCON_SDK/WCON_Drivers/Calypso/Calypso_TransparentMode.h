@@ -0,0 +1,120 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Calypso transparent mode data pump header file.
+ *
+ * In transparent mode, all data written to the UART is forwarded to the configured socket and
+ * all data received from the socket is written to the UART. This module switches the module to
+ * transparent mode using the application mode pins and moves data in both directions via
+ * ring buffers: received data is copied from the DMA receive buffer, data to be sent is
+ * transmitted by DMA directly from the transmit ring buffer.
+ *
+ * Usage:
+ * - Configure the transparent mode socket parameters (ATDevice_GetId_TransparentMode) in AT command mode.
+ * - Call Calypso_TransparentMode_Start() (optionally writes the UART trigger settings first).
+ * - Use Calypso_TransparentMode_Write()/Calypso_TransparentMode_WritePacket() and
+ *   Calypso_TransparentMode_Read().
+ * - Call Calypso_TransparentMode_Stop() to return to AT command mode.
+ *
+ * Note that Calypso_Init() should be called with DMA enabled for full UART speed, otherwise
+ * received data is handled byte by byte in the UART interrupt.
+ */
+
+#ifndef CALYPSO_TRANSPARENTMODE_H_INCLUDED
+#define CALYPSO_TRANSPARENTMODE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size of the receive ring buffer (must be a power of two).
+ */
+#ifndef CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE
+#define CALYPSO_TRANSPARENTMODE_RX_BUFFER_SIZE 4096
+#endif
+
+/**
+ * @brief Size of the transmit ring buffer (must be a power of two).
+ */
+#ifndef CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE
+#define CALYPSO_TRANSPARENTMODE_TX_BUFFER_SIZE 4096
+#endif
+
+/**
+ * @brief Idle time (milliseconds) after which the module is woken up before transmitting (power save only).
+ */
+#define CALYPSO_TRANSPARENTMODE_WAKEUP_IDLE_TIME_MS 10
+
+/**
+ * @brief Transparent mode UART settings.
+ */
+typedef struct Calypso_TransparentMode_Settings_t
+{
+    uint8_t trigger;        /**< Bitmask defining UART trigger (see ATDevice_TransparentModeUartTrigger_t) */
+    uint16_t timeoutMs;     /**< Timeout used for triggering transmission (see ATDevice_TransparentModeUartTrigger_Timer) */
+    char etx[2];            /**< ETX character(s) (see ATDevice_TransparentModeUartTrigger_OneETX and ATDevice_TransparentModeUartTrigger_TwoETX) */
+    bool powerSave;         /**< Module uses power save mode, i.e. has to be woken up before sending data */
+} Calypso_TransparentMode_Settings_t;
+
+/**
+ * @brief Throughput counters.
+ */
+typedef struct Calypso_TransparentMode_Statistics_t
+{
+    uint32_t bytesSent;             /**< Bytes transmitted to the module */
+    uint32_t bytesReceived;         /**< Bytes received from the module */
+    uint32_t packetsSent;           /**< Packets written using Calypso_TransparentMode_WritePacket() */
+    uint32_t bytesDropped;          /**< Received bytes dropped because the receive buffer was full */
+    uint32_t elapsedMs;             /**< Time since start or last reset of the counters */
+} Calypso_TransparentMode_Statistics_t;
+
+extern bool Calypso_TransparentMode_Start(const Calypso_TransparentMode_Settings_t *settings,
+                                          bool applySettings,
+                                          uint32_t startupTimeMs);
+extern bool Calypso_TransparentMode_Stop(uint32_t flushTimeoutMs);
+extern bool Calypso_TransparentMode_IsConnected(void);
+extern bool Calypso_TransparentMode_WaitForConnection(uint32_t timeoutMs);
+
+extern uint16_t Calypso_TransparentMode_Write(const uint8_t *data, uint16_t length);
+extern bool Calypso_TransparentMode_WritePacket(const uint8_t *data, uint16_t length);
+extern bool Calypso_TransparentMode_Flush(uint32_t timeoutMs);
+extern uint16_t Calypso_TransparentMode_Read(uint8_t *buffer, uint16_t maxLength);
+extern uint16_t Calypso_TransparentMode_GetRxAvailable(void);
+extern uint16_t Calypso_TransparentMode_GetTxFree(void);
+
+extern void Calypso_TransparentMode_GetStatistics(Calypso_TransparentMode_Statistics_t *statistics);
+extern void Calypso_TransparentMode_ResetStatistics(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_TRANSPARENTMODE_H_INCLUDED
@@ -0,0 +1,398 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso WLAN fast reconnect source file.
+ */
+
+#include "Calypso_WLANReconnect.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Calypso.h"
+#include "ATCommands/ATDevice.h"
+#include "ATCommands/ATNetCfg.h"
+
+static bool Calypso_WLANReconnect_ConnectAndWait(bool useBSSID, uint32_t timeoutMs);
+static bool Calypso_WLANReconnect_SetIPv4Method(ATNetCfg_IPv4Method_t method);
+static void Calypso_WLANReconnect_UpdateStatistics(Calypso_WLANReconnect_Path_t path, bool success, uint32_t startTick);
+
+/**
+ * @brief Parameters of the last successful connection.
+ */
+static Calypso_WLANReconnect_Cache_t Calypso_WLANReconnect_cache;
+
+/**
+ * @brief Is set to true when the station has joined an access point (set by event handler).
+ */
+static volatile bool Calypso_WLANReconnect_connected = false;
+
+/**
+ * @brief Is set to true when an IPv4 address has been acquired (set by event handler).
+ */
+static volatile bool Calypso_WLANReconnect_ipAcquired = false;
+
+/**
+ * @brief Time at which the last IPv4 address has been acquired (set by event handler).
+ */
+static volatile uint32_t Calypso_WLANReconnect_ipAcquiredTick = 0;
+
+/**
+ * @brief Is set to true while the module is configured to use the recorded lease as static address.
+ */
+static bool Calypso_WLANReconnect_staticIPActive = false;
+
+/**
+ * @brief Connection statistics.
+ */
+static Calypso_WLANReconnect_Statistics_t Calypso_WLANReconnect_statistics;
+
+/**
+ * @brief Initializes the fast reconnect manager (clears recorded parameters and statistics).
+ */
+void Calypso_WLANReconnect_Init(void)
+{
+    memset(&Calypso_WLANReconnect_cache, 0, sizeof(Calypso_WLANReconnect_cache));
+    memset(&Calypso_WLANReconnect_statistics, 0, sizeof(Calypso_WLANReconnect_statistics));
+    Calypso_WLANReconnect_connected = false;
+    Calypso_WLANReconnect_ipAcquired = false;
+    Calypso_WLANReconnect_staticIPActive = false;
+}
+
+/**
+ * @brief Connects to a wireless network, using the fastest available path (see Calypso_WLANReconnect.h).
+ *
+ * Dispatches queued events (WE_Poll()) while waiting, must thus not be called from within the event callback.
+ *
+ * @param[in] connectArgs Connection arguments (NULL to use the recorded arguments). The BSSID is ignored.
+ *            If the SSID differs from the recorded SSID, the recorded parameters are discarded.
+ * @param[in] timeoutMs Max. time to wait for an IPv4 address (ms)
+ * @param[out] pPath Path that has resulted in the connection (optional, may be NULL)
+ *
+ * @return true if an IPv4 address has been acquired, false otherwise
+ */
+bool Calypso_WLANReconnect_Connect(const ATWLAN_ConnectionArguments_t *connectArgs,
+                                   uint32_t timeoutMs,
+                                   Calypso_WLANReconnect_Path_t *pPath)
+{
+    uint32_t startTick = WE_GetTick();
+
+    if (NULL != connectArgs)
+    {
+        if (0 != strcmp(connectArgs->SSID, Calypso_WLANReconnect_cache.connection.SSID))
+        {
+            memset(&Calypso_WLANReconnect_cache, 0, sizeof(Calypso_WLANReconnect_cache));
+        }
+        char BSSID[ATWLAN_BSSID_LENGTH];
+        strcpy(BSSID, Calypso_WLANReconnect_cache.connection.BSSID);
+        Calypso_WLANReconnect_cache.connection = *connectArgs;
+        strcpy(Calypso_WLANReconnect_cache.connection.BSSID, BSSID);
+    }
+
+    if ('\0' == Calypso_WLANReconnect_cache.connection.SSID[0])
+    {
+        return false;
+    }
+
+    if (Calypso_WLANReconnect_staticIPActive)
+    {
+        /* Static address has been used for the last connection - switch back to DHCP */
+        Calypso_WLANReconnect_SetIPv4Method(ATNetCfg_IPv4Method_Dhcp);
+    }
+
+    if ('\0' != Calypso_WLANReconnect_cache.connection.BSSID[0])
+    {
+        uint32_t dhcpTimeoutMs = (timeoutMs < CALYPSO_WLANRECONNECT_DHCP_TIMEOUT_MS) ? timeoutMs : CALYPSO_WLANRECONNECT_DHCP_TIMEOUT_MS;
+        bool ret = Calypso_WLANReconnect_ConnectAndWait(true, dhcpTimeoutMs);
+        Calypso_WLANReconnect_UpdateStatistics(Calypso_WLANReconnect_Path_BSSID, ret, startTick);
+        if (ret)
+        {
+            if (NULL != pPath)
+            {
+                *pPath = Calypso_WLANReconnect_Path_BSSID;
+            }
+            return true;
+        }
+
+        bool joined = Calypso_WLANReconnect_connected;
+        ATWLAN_Disconnect();
+
+        if (!joined)
+        {
+            /* Access point not available (anymore) */
+            Calypso_WLANReconnect_cache.connection.BSSID[0] = '\0';
+        }
+        else if (Calypso_WLANReconnect_cache.leaseValid &&
+                 WE_GetTick() - Calypso_WLANReconnect_cache.leaseTick < CALYPSO_WLANRECONNECT_LEASE_MAX_AGE_MS &&
+                 WE_GetTick() - startTick < timeoutMs)
+        {
+            /* Access point is available, but DHCP is slow - use last lease as static address */
+            ret = Calypso_WLANReconnect_SetIPv4Method(ATNetCfg_IPv4Method_Static);
+            if (ret)
+            {
+                uint32_t elapsedMs = WE_GetTick() - startTick;
+                ret = (elapsedMs < timeoutMs) && Calypso_WLANReconnect_ConnectAndWait(true, timeoutMs - elapsedMs);
+            }
+            Calypso_WLANReconnect_UpdateStatistics(Calypso_WLANReconnect_Path_StaticIP, ret, startTick);
+            if (ret)
+            {
+                if (NULL != pPath)
+                {
+                    *pPath = Calypso_WLANReconnect_Path_StaticIP;
+                }
+                return true;
+            }
+
+            ATWLAN_Disconnect();
+            Calypso_WLANReconnect_SetIPv4Method(ATNetCfg_IPv4Method_Dhcp);
+        }
+    }
+
+    uint32_t elapsedMs = WE_GetTick() - startTick;
+    if (elapsedMs >= timeoutMs)
+    {
+        return false;
+    }
+
+    bool ret = Calypso_WLANReconnect_ConnectAndWait(false, timeoutMs - elapsedMs);
+    Calypso_WLANReconnect_UpdateStatistics(Calypso_WLANReconnect_Path_Scan, ret, startTick);
+    if (ret && NULL != pPath)
+    {
+        *pPath = Calypso_WLANReconnect_Path_Scan;
+    }
+    return ret;
+}
+
+/**
+ * @brief Records connection parameters from WLAN and NetApp events.
+ *
+ * Must be called from within the Calypso event callback for every event (after ATEvent_ParseEventType()).
+ *
+ * @param[in] event Event type as returned by ATEvent_ParseEventType()
+ * @param[in,out] pEventArguments Event arguments as returned by ATEvent_ParseEventType()
+ */
+void Calypso_WLANReconnect_HandleEvent(ATEvent_t event, char **pEventArguments)
+{
+    switch (event)
+    {
+    case ATEvent_WlanConnect:
+    {
+        /* Arguments: <SSID>,<BSSID> */
+        char SSID[ATWLAN_SSID_MAX_LENGTH];
+        char BSSID[ATWLAN_BSSID_LENGTH];
+        if (Calypso_GetNextArgumentString(pEventArguments, SSID, CALYPSO_ARGUMENT_DELIM, sizeof(SSID)) &&
+            Calypso_GetNextArgumentString(pEventArguments, BSSID, CALYPSO_STRING_TERMINATE, sizeof(BSSID)) &&
+            0 == strcmp(SSID, Calypso_WLANReconnect_cache.connection.SSID))
+        {
+            strcpy(Calypso_WLANReconnect_cache.connection.BSSID, BSSID);
+        }
+        Calypso_WLANReconnect_connected = true;
+        break;
+    }
+
+    case ATEvent_WlanDisconnect:
+        Calypso_WLANReconnect_connected = false;
+        Calypso_WLANReconnect_ipAcquired = false;
+        break;
+
+    case ATEvent_NetappIP4Acquired:
+    {
+        ATEvent_NetappIP4Acquired_t ipv4Event;
+        Calypso_WLANReconnect_ipAcquiredTick = WE_GetTick();
+        if (ATEvent_ParseNetappIP4AcquiredEvent(pEventArguments, &ipv4Event) && !Calypso_WLANReconnect_staticIPActive)
+        {
+            if (!Calypso_ViewEquals(ipv4Event.address, Calypso_WLANReconnect_cache.ipAddress))
+            {
+                /* Subnet mask is not part of the event - is queried by Calypso_WLANReconnect_Connect() */
+                Calypso_WLANReconnect_cache.subnetMask[0] = '\0';
+            }
+            Calypso_ViewToString(Calypso_WLANReconnect_cache.ipAddress, ipv4Event.address, sizeof(Calypso_WLANReconnect_cache.ipAddress));
+            Calypso_ViewToString(Calypso_WLANReconnect_cache.gatewayAddress, ipv4Event.gateway, sizeof(Calypso_WLANReconnect_cache.gatewayAddress));
+            Calypso_ViewToString(Calypso_WLANReconnect_cache.dnsAddress, ipv4Event.DNS, sizeof(Calypso_WLANReconnect_cache.dnsAddress));
+            Calypso_WLANReconnect_cache.leaseTick = Calypso_WLANReconnect_ipAcquiredTick;
+            Calypso_WLANReconnect_cache.leaseValid = ('\0' != Calypso_WLANReconnect_cache.subnetMask[0]);
+        }
+        Calypso_WLANReconnect_ipAcquired = true;
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Checks if an IPv4 address has been acquired (and the connection is still active).
+ *
+ * @return true if an IPv4 address has been acquired, false otherwise
+ */
+bool Calypso_WLANReconnect_IsIPAcquired(void)
+{
+    return Calypso_WLANReconnect_ipAcquired;
+}
+
+/**
+ * @brief Returns the recorded connection parameters (e.g. to store them in retained memory).
+ *
+ * @param[out] cache Recorded connection parameters
+ */
+void Calypso_WLANReconnect_GetCache(Calypso_WLANReconnect_Cache_t *cache)
+{
+    *cache = Calypso_WLANReconnect_cache;
+}
+
+/**
+ * @brief Restores recorded connection parameters (e.g. after waking up from a low power mode).
+ *
+ * @param[in] cache Connection parameters as returned by Calypso_WLANReconnect_GetCache()
+ */
+void Calypso_WLANReconnect_SetCache(const Calypso_WLANReconnect_Cache_t *cache)
+{
+    Calypso_WLANReconnect_cache = *cache;
+}
+
+/**
+ * @brief Returns connection statistics.
+ *
+ * @param[out] statistics Connection statistics
+ */
+void Calypso_WLANReconnect_GetStatistics(Calypso_WLANReconnect_Statistics_t *statistics)
+{
+    *statistics = Calypso_WLANReconnect_statistics;
+}
+
+/**
+ * @brief Connects to the recorded network and waits for the IPv4 address.
+ *
+ * On success, the subnet mask of a new lease is queried and the lease is marked as valid.
+ *
+ * @param[in] useBSSID Connect to the recorded access point (BSSID) instead of scanning for the SSID
+ * @param[in] timeoutMs Max. time to wait for the IPv4 address (ms)
+ *
+ * @return true if an IPv4 address has been acquired, false otherwise
+ */
+static bool Calypso_WLANReconnect_ConnectAndWait(bool useBSSID, uint32_t timeoutMs)
+{
+    ATWLAN_ConnectionArguments_t connectArgs = Calypso_WLANReconnect_cache.connection;
+    if (!useBSSID)
+    {
+        connectArgs.BSSID[0] = '\0';
+    }
+
+    Calypso_WLANReconnect_connected = false;
+    Calypso_WLANReconnect_ipAcquired = false;
+
+    uint32_t t0 = WE_GetTick();
+    if (!ATWLAN_Connect(connectArgs))
+    {
+        return false;
+    }
+
+    while (!Calypso_WLANReconnect_ipAcquired)
+    {
+        if (WE_GetTick() - t0 > timeoutMs)
+        {
+            return false;
+        }
+
+        /* The flags are set by Calypso_WLANReconnect_HandleEvent(), which is called from the event
+         * callback - if events are queued (CALYPSO_EVENT_QUEUE_SIZE > 0), they are dispatched by WE_Poll() */
+        WE_Poll();
+        WE_Delay(1);
+    }
+
+    if (!Calypso_WLANReconnect_staticIPActive && '\0' == Calypso_WLANReconnect_cache.subnetMask[0])
+    {
+        ATNetCfg_IPv4Config_t ipConfig;
+        if (ATNetCfg_GetIPv4AddressStation(&ipConfig))
+        {
+            strcpy(Calypso_WLANReconnect_cache.subnetMask, ipConfig.subnetMask);
+        }
+    }
+    Calypso_WLANReconnect_cache.leaseValid = ('\0' != Calypso_WLANReconnect_cache.subnetMask[0]);
+
+    return true;
+}
+
+/**
+ * @brief Configures the station's IPv4 address method (DHCP or static using the recorded lease).
+ *
+ * The new method only takes effect after restarting the network processor, which is done
+ * by this function (followed by a delay of CALYPSO_WLANRECONNECT_RESTART_DELAY_MS).
+ *
+ * @param[in] method ATNetCfg_IPv4Method_Dhcp or ATNetCfg_IPv4Method_Static
+ *
+ * @return true if successful, false otherwise
+ */
+static bool Calypso_WLANReconnect_SetIPv4Method(ATNetCfg_IPv4Method_t method)
+{
+    ATNetCfg_IPv4Config_t ipConfig;
+    memset(&ipConfig, 0, sizeof(ipConfig));
+    ipConfig.method = method;
+
+    if (ATNetCfg_IPv4Method_Static == method)
+    {
+        strcpy(ipConfig.ipAddress, Calypso_WLANReconnect_cache.ipAddress);
+        strcpy(ipConfig.subnetMask, Calypso_WLANReconnect_cache.subnetMask);
+        strcpy(ipConfig.gatewayAddress, Calypso_WLANReconnect_cache.gatewayAddress);
+        strcpy(ipConfig.dnsAddress, Calypso_WLANReconnect_cache.dnsAddress);
+    }
+
+    if (!ATNetCfg_SetIPv4AddressStation(&ipConfig))
+    {
+        return false;
+    }
+    Calypso_WLANReconnect_staticIPActive = (ATNetCfg_IPv4Method_Static == method);
+
+    if (!ATDevice_Restart(0))
+    {
+        return false;
+    }
+    WE_Delay(CALYPSO_WLANRECONNECT_RESTART_DELAY_MS);
+
+    return true;
+}
+
+/**
+ * @brief Updates the statistics of a connection path.
+ *
+ * @param[in] path Connection path
+ * @param[in] success true if the path has resulted in an IPv4 address
+ * @param[in] startTick Time at which Calypso_WLANReconnect_Connect() has been called
+ */
+static void Calypso_WLANReconnect_UpdateStatistics(Calypso_WLANReconnect_Path_t path, bool success, uint32_t startTick)
+{
+    Calypso_WLANReconnect_PathStatistics_t *pathStatistics = &Calypso_WLANReconnect_statistics.paths[path];
+
+    pathStatistics->attempts++;
+    if (success)
+    {
+        uint32_t timeToIpMs = Calypso_WLANReconnect_ipAcquiredTick - startTick;
+        pathStatistics->successes++;
+        pathStatistics->lastTimeToIpMs = timeToIpMs;
+        pathStatistics->totalTimeToIpMs += timeToIpMs;
+    }
+}
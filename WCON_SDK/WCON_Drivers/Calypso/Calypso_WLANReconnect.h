@@ -0,0 +1,150 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso WLAN fast reconnect header file.
+ *
+ * Records the parameters of the last successful WLAN connection (SSID, BSSID, security
+ * parameters and IPv4 lease) and uses them to reconnect as fast as possible:
+ *
+ * 1. BSSID: Connect to the last used access point (SSID and BSSID), using DHCP. The module
+ *    requests the previously leased address (DHCP fast renew, see ATNetCfg_InterfaceMode_DisableFastRenew).
+ * 2. Static IP: If the access point has been joined but DHCP didn't complete within
+ *    CALYPSO_WLANRECONNECT_DHCP_TIMEOUT_MS, the last lease is configured as static IPv4
+ *    address (if it isn't older than CALYPSO_WLANRECONNECT_LEASE_MAX_AGE_MS), the network
+ *    processor is restarted (required for the new address method to take effect) and the
+ *    connection is established again. The next call of Calypso_WLANReconnect_Connect()
+ *    switches back to DHCP, which requires another restart.
+ * 3. Scan: Connect using the SSID only, i.e. the module scans for the network.
+ *
+ * The time from calling Calypso_WLANReconnect_Connect() to the reception of the IPv4 acquired
+ * event is measured per path (see Calypso_WLANReconnect_GetStatistics()), including the time
+ * spent on restarting the network processor.
+ *
+ * Calypso_WLANReconnect_HandleEvent() must be called from within the Calypso event callback.
+ * While waiting for the IPv4 address, Calypso_WLANReconnect_Connect() calls WE_Poll(), so that
+ * queued events are dispatched if CALYPSO_EVENT_QUEUE_SIZE > 0. In this case, it must be called
+ * from the main loop and not from within the event callback (i.e. not from within WE_Poll()).
+ * The recorded parameters can be stored (e.g. in retained RAM before entering a low power mode)
+ * and restored using Calypso_WLANReconnect_GetCache() and Calypso_WLANReconnect_SetCache().
+ *
+ * Note that the AT+wlanConnect command doesn't accept a channel, so the channel isn't used to
+ * speed up the connection.
+ */
+
+#ifndef CALYPSO_WLANRECONNECT_H_INCLUDED
+#define CALYPSO_WLANRECONNECT_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ATCommands/ATEvent.h"
+#include "ATCommands/ATWLAN.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Max. time to wait for the IPv4 address after connecting by BSSID before falling back
+ * to the static IP or scan path (ms).
+ */
+#ifndef CALYPSO_WLANRECONNECT_DHCP_TIMEOUT_MS
+#define CALYPSO_WLANRECONNECT_DHCP_TIMEOUT_MS 3000
+#endif
+
+/**
+ * @brief Max. age of a recorded IPv4 lease for it to be used as static address (ms).
+ */
+#ifndef CALYPSO_WLANRECONNECT_LEASE_MAX_AGE_MS
+#define CALYPSO_WLANRECONNECT_LEASE_MAX_AGE_MS 3600000
+#endif
+
+/**
+ * @brief Time to wait after restarting the network processor to change the IPv4 address method (ms).
+ */
+#ifndef CALYPSO_WLANRECONNECT_RESTART_DELAY_MS
+#define CALYPSO_WLANRECONNECT_RESTART_DELAY_MS 1000
+#endif
+
+/**
+ * @brief Connection paths used by Calypso_WLANReconnect_Connect().
+ */
+typedef enum Calypso_WLANReconnect_Path_t
+{
+    Calypso_WLANReconnect_Path_BSSID,
+    Calypso_WLANReconnect_Path_StaticIP,
+    Calypso_WLANReconnect_Path_Scan,
+    Calypso_WLANReconnect_Path_NumberOfValues
+} Calypso_WLANReconnect_Path_t;
+
+/**
+ * @brief Parameters of the last successful connection.
+ */
+typedef struct Calypso_WLANReconnect_Cache_t
+{
+    ATWLAN_ConnectionArguments_t connection;        /**< Connection arguments (BSSID is empty if unknown) */
+    bool leaseValid;                                /**< The following lease parameters are valid */
+    uint32_t leaseTick;                             /**< Time at which the address has been acquired (WE_GetTick()) */
+    char ipAddress[16];                             /**< Leased IPv4 address */
+    char subnetMask[16];                            /**< Subnet mask */
+    char gatewayAddress[16];                        /**< Gateway address */
+    char dnsAddress[16];                            /**< DNS server address */
+} Calypso_WLANReconnect_Cache_t;
+
+/**
+ * @brief Statistics of a connection path.
+ */
+typedef struct Calypso_WLANReconnect_PathStatistics_t
+{
+    uint32_t attempts;                  /**< Number of times the path has been tried */
+    uint32_t successes;                 /**< Number of times the path has resulted in an IPv4 address */
+    uint32_t lastTimeToIpMs;            /**< Time to IP of the last successful connection via this path (ms) */
+    uint32_t totalTimeToIpMs;           /**< Sum of time to IP of all successful connections via this path (ms) */
+} Calypso_WLANReconnect_PathStatistics_t;
+
+/**
+ * @brief Statistics as returned by Calypso_WLANReconnect_GetStatistics().
+ */
+typedef struct Calypso_WLANReconnect_Statistics_t
+{
+    Calypso_WLANReconnect_PathStatistics_t paths[Calypso_WLANReconnect_Path_NumberOfValues];
+} Calypso_WLANReconnect_Statistics_t;
+
+extern void Calypso_WLANReconnect_Init(void);
+extern bool Calypso_WLANReconnect_Connect(const ATWLAN_ConnectionArguments_t *connectArgs,
+                                          uint32_t timeoutMs,
+                                          Calypso_WLANReconnect_Path_t *pPath);
+extern void Calypso_WLANReconnect_HandleEvent(ATEvent_t event, char **pEventArguments);
+extern bool Calypso_WLANReconnect_IsIPAcquired(void);
+extern void Calypso_WLANReconnect_GetCache(Calypso_WLANReconnect_Cache_t *cache);
+extern void Calypso_WLANReconnect_SetCache(const Calypso_WLANReconnect_Cache_t *cache);
+extern void Calypso_WLANReconnect_GetStatistics(Calypso_WLANReconnect_Statistics_t *statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_WLANRECONNECT_H_INCLUDED
@@ -0,0 +1,485 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso streaming WLAN scan implementation.
+ */
+
+#include <string.h>
+
+#include "Calypso_WLANScan.h"
+#include "Calypso.h"
+#include "../global/global.h"
+
+#if (CALYPSO_WLANSCAN_HASH_SIZE & (CALYPSO_WLANSCAN_HASH_SIZE - 1)) != 0
+#error "CALYPSO_WLANSCAN_HASH_SIZE must be a power of two"
+#endif
+
+#if CALYPSO_WLANSCAN_HASH_SIZE <= CALYPSO_WLANSCAN_TABLE_SIZE
+#error "CALYPSO_WLANSCAN_HASH_SIZE must be larger than CALYPSO_WLANSCAN_TABLE_SIZE"
+#endif
+
+/**
+ * @brief Marks an unused slot of the hash table.
+ */
+#define CALYPSO_WLANSCAN_HASH_EMPTY 0xFFFF
+
+/**
+ * @brief Error code returned by the module if no scan results are available yet.
+ */
+#define CALYPSO_WLANSCAN_ERROR_EAGAIN (-2073)
+
+static void Calypso_WLANScan_OnScanEntry(const ATWLAN_ScanEntry_t *scanEntry, void *context);
+static uint16_t Calypso_WLANScan_HashBSSID(const uint8_t bssid[6]);
+static uint16_t Calypso_WLANScan_FindSlot(const uint8_t bssid[6]);
+static void Calypso_WLANScan_Remove(uint16_t index);
+static uint16_t Calypso_WLANScan_GetOldest(void);
+static int8_t Calypso_WLANScan_HexDigit(char c);
+
+/**
+ * @brief Access point entries (densely packed, first Calypso_WLANScan_count entries are used).
+ */
+static Calypso_WLANScan_Entry_t Calypso_WLANScan_entries[CALYPSO_WLANSCAN_TABLE_SIZE];
+
+/**
+ * @brief Number of used entries in Calypso_WLANScan_entries.
+ */
+static volatile uint16_t Calypso_WLANScan_count = 0;
+
+/**
+ * @brief Open addressing hash table (linear probing) mapping BSSIDs to indices in Calypso_WLANScan_entries.
+ */
+static uint16_t Calypso_WLANScan_hashTable[CALYPSO_WLANSCAN_HASH_SIZE];
+
+/**
+ * @brief Statistics.
+ */
+static Calypso_WLANScan_Statistics_t Calypso_WLANScan_statistics;
+
+/**
+ * @brief Initializes (clears) the BSSID table.
+ */
+void Calypso_WLANScan_Init(void)
+{
+    Calypso_WLANScan_count = 0;
+    memset(Calypso_WLANScan_entries, 0, sizeof(Calypso_WLANScan_entries));
+    for (uint16_t i = 0; i < CALYPSO_WLANSCAN_HASH_SIZE; i++)
+    {
+        Calypso_WLANScan_hashTable[i] = CALYPSO_WLANSCAN_HASH_EMPTY;
+    }
+    memset(&Calypso_WLANScan_statistics, 0, sizeof(Calypso_WLANScan_statistics));
+}
+
+/**
+ * @brief Performs a WLAN scan and merges the results into the BSSID table.
+ *
+ * Requests the module's scan results in pages of CALYPSO_WLANSCAN_PAGE_SIZE entries until the
+ * module returns less entries than requested or ATWLAN_SCAN_MAX_ENTRIES entries have been read.
+ * If the module has no scan results yet, the scan is retried after CALYPSO_WLANSCAN_RETRY_DELAY_MS.
+ * Entries that haven't been seen for CALYPSO_WLANSCAN_MAX_AGE_MS are removed afterwards.
+ *
+ * @param[out] pNumReceived Number of scan entries received from the module (optional, may be NULL)
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_WLANScan_Scan(uint16_t *pNumReceived)
+{
+    uint16_t numReceived = 0;
+    uint8_t retries = 0;
+    uint8_t index = 0;
+    bool ret = true;
+
+    while (index < ATWLAN_SCAN_MAX_ENTRIES)
+    {
+        uint8_t count = ATWLAN_SCAN_MAX_ENTRIES - index;
+        if (count > CALYPSO_WLANSCAN_PAGE_SIZE)
+        {
+            count = CALYPSO_WLANSCAN_PAGE_SIZE;
+        }
+
+        uint8_t numEntries = 0;
+        Calypso_WLANScan_statistics.requests++;
+        if (!ATWLAN_ScanStreamed(index, count, Calypso_WLANScan_OnScanEntry, NULL, &numEntries))
+        {
+            if ((0 == index) && (retries < CALYPSO_WLANSCAN_MAX_RETRIES) && (CALYPSO_WLANSCAN_ERROR_EAGAIN == Calypso_GetLastError(NULL)))
+            {
+                /* No scan results available yet - the module has started scanning */
+                retries++;
+                WE_Delay(CALYPSO_WLANSCAN_RETRY_DELAY_MS);
+                continue;
+            }
+
+            /* Failing to read further pages is not an error (there may be no more entries) */
+            ret = (0 != index);
+            numReceived += numEntries;
+            break;
+        }
+
+        numReceived += numEntries;
+        if (numEntries < count)
+        {
+            break;
+        }
+        index += count;
+    }
+
+    if (ret)
+    {
+        Calypso_WLANScan_statistics.scans++;
+    }
+
+    Calypso_WLANScan_AgeOut(CALYPSO_WLANSCAN_MAX_AGE_MS);
+
+    if (NULL != pNumReceived)
+    {
+        *pNumReceived = numReceived;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Removes all entries that haven't been seen for the supplied time.
+ *
+ * @param[in] maxAgeMs Max. age of entries (ms)
+ */
+void Calypso_WLANScan_AgeOut(uint32_t maxAgeMs)
+{
+    uint32_t now = WE_GetTick();
+
+    /* Iterate backwards, as Calypso_WLANScan_Remove() moves the last entry to the removed position */
+    for (uint16_t i = Calypso_WLANScan_count; i > 0; i--)
+    {
+        if ((uint32_t) (now - Calypso_WLANScan_entries[i - 1].lastSeen) > maxAgeMs)
+        {
+            Calypso_WLANScan_Remove(i - 1);
+            Calypso_WLANScan_statistics.agedOut++;
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of access points in the BSSID table.
+ *
+ * @return Number of entries
+ */
+uint16_t Calypso_WLANScan_GetCount(void)
+{
+    return Calypso_WLANScan_count;
+}
+
+/**
+ * @brief Returns an entry of the BSSID table.
+ *
+ * Note that the order of entries changes when entries are removed.
+ *
+ * @param[in] index Index of entry (0 to Calypso_WLANScan_GetCount() - 1)
+ * @param[out] entry The entry
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_WLANScan_GetEntry(uint16_t index, Calypso_WLANScan_Entry_t *entry)
+{
+    if ((NULL == entry) || (index >= Calypso_WLANScan_count))
+    {
+        return false;
+    }
+
+    memcpy(entry, &Calypso_WLANScan_entries[index], sizeof(Calypso_WLANScan_Entry_t));
+    return true;
+}
+
+/**
+ * @brief Looks up an access point in the BSSID table.
+ *
+ * @param[in] BSSID BSSID as string (format "xx:xx:xx:xx:xx:xx")
+ * @param[out] entry The entry (optional, may be NULL)
+ *
+ * @return true if the access point is contained in the table, false otherwise
+ */
+bool Calypso_WLANScan_FindEntry(const char *BSSID, Calypso_WLANScan_Entry_t *entry)
+{
+    uint8_t macAddress[6];
+    if (!Calypso_WLANScan_ParseBSSID(BSSID, macAddress))
+    {
+        return false;
+    }
+
+    uint16_t slot = Calypso_WLANScan_FindSlot(macAddress);
+    if (CALYPSO_WLANSCAN_HASH_EMPTY == Calypso_WLANScan_hashTable[slot])
+    {
+        return false;
+    }
+
+    if (NULL != entry)
+    {
+        memcpy(entry, &Calypso_WLANScan_entries[Calypso_WLANScan_hashTable[slot]], sizeof(Calypso_WLANScan_Entry_t));
+    }
+    return true;
+}
+
+/**
+ * @brief Converts a BSSID string (format "xx:xx:xx:xx:xx:xx") to a MAC address.
+ *
+ * @param[in] BSSID BSSID as string
+ * @param[out] macAddress MAC address
+ *
+ * @return true if successful, false otherwise
+ */
+bool Calypso_WLANScan_ParseBSSID(const char *BSSID, uint8_t macAddress[6])
+{
+    if ((NULL == BSSID) || (NULL == macAddress))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        int8_t high = Calypso_WLANScan_HexDigit(BSSID[0]);
+        int8_t low = (high < 0) ? -1 : Calypso_WLANScan_HexDigit(BSSID[1]);
+        if (low < 0)
+        {
+            return false;
+        }
+        macAddress[i] = (uint8_t) ((high << 4) | low);
+        BSSID += 2;
+
+        if (i < 5)
+        {
+            if (':' != *BSSID)
+            {
+                return false;
+            }
+            BSSID++;
+        }
+    }
+
+    return ('\0' == *BSSID);
+}
+
+/**
+ * @brief Returns statistics.
+ *
+ * @param[out] statistics Statistics
+ */
+void Calypso_WLANScan_GetStatistics(Calypso_WLANScan_Statistics_t *statistics)
+{
+    if (NULL != statistics)
+    {
+        memcpy(statistics, &Calypso_WLANScan_statistics, sizeof(Calypso_WLANScan_Statistics_t));
+    }
+}
+
+/**
+ * @brief Scan entry callback - merges a received scan entry into the BSSID table.
+ *
+ * Called from interrupt context while the response to AT+wlanScan is received.
+ *
+ * @param[in] scanEntry Received scan entry
+ * @param[in] context Unused
+ */
+static void Calypso_WLANScan_OnScanEntry(const ATWLAN_ScanEntry_t *scanEntry, void *context)
+{
+    (void) context;
+
+    uint8_t macAddress[6];
+
+    Calypso_WLANScan_statistics.received++;
+
+    if (!Calypso_WLANScan_ParseBSSID(scanEntry->BSSID, macAddress))
+    {
+        return;
+    }
+
+    uint32_t now = WE_GetTick();
+    Calypso_WLANScan_Entry_t *entry;
+    uint16_t slot = Calypso_WLANScan_FindSlot(macAddress);
+
+    if (CALYPSO_WLANSCAN_HASH_EMPTY != Calypso_WLANScan_hashTable[slot])
+    {
+        entry = &Calypso_WLANScan_entries[Calypso_WLANScan_hashTable[slot]];
+        entry->RSSIFiltered += ((int16_t) (scanEntry->RSSI * 16) - entry->RSSIFiltered) / (1 << CALYPSO_WLANSCAN_RSSI_SMOOTHING_SHIFT);
+        if (entry->seenCount < UINT16_MAX)
+        {
+            entry->seenCount++;
+        }
+    }
+    else
+    {
+        if (Calypso_WLANScan_count >= CALYPSO_WLANSCAN_TABLE_SIZE)
+        {
+            /* Table full - replace the least recently seen access point */
+            Calypso_WLANScan_Remove(Calypso_WLANScan_GetOldest());
+            Calypso_WLANScan_statistics.replaced++;
+            slot = Calypso_WLANScan_FindSlot(macAddress);
+        }
+
+        uint16_t index = Calypso_WLANScan_count;
+        entry = &Calypso_WLANScan_entries[index];
+        memset(entry, 0, sizeof(Calypso_WLANScan_Entry_t));
+        memcpy(entry->BSSID, macAddress, sizeof(macAddress));
+        entry->RSSIFiltered = (int16_t) (scanEntry->RSSI * 16);
+        entry->seenCount = 1;
+        entry->firstSeen = now;
+        Calypso_WLANScan_hashTable[slot] = index;
+        Calypso_WLANScan_count = index + 1;
+        Calypso_WLANScan_statistics.added++;
+    }
+
+    strncpy(entry->SSID, scanEntry->SSID, sizeof(entry->SSID));
+    entry->SSID[sizeof(entry->SSID) - 1] = '\0';
+    entry->channel = scanEntry->channel;
+    entry->RSSI = scanEntry->RSSI;
+    entry->RSSISmoothed = (int8_t) ((entry->RSSIFiltered - 8) / 16);
+    entry->hiddenSsidEnabled = scanEntry->hiddenSsidEnabled;
+    entry->cipher = scanEntry->cipher;
+    entry->keyManagementMethod = scanEntry->keyManagementMethod;
+    entry->securityType = scanEntry->securityType;
+    entry->lastSeen = now;
+}
+
+/**
+ * @brief Computes the home slot of a BSSID in the hash table (FNV-1a).
+ *
+ * @param[in] bssid MAC address
+ *
+ * @return Home slot
+ */
+static uint16_t Calypso_WLANScan_HashBSSID(const uint8_t bssid[6])
+{
+    uint32_t hash = 2166136261UL;
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        hash ^= bssid[i];
+        hash *= 16777619UL;
+    }
+    return (uint16_t) (hash & (CALYPSO_WLANSCAN_HASH_SIZE - 1));
+}
+
+/**
+ * @brief Looks up a BSSID in the hash table.
+ *
+ * @param[in] bssid MAC address
+ *
+ * @return Slot containing the BSSID or (if not found) the empty slot where it would be inserted
+ */
+static uint16_t Calypso_WLANScan_FindSlot(const uint8_t bssid[6])
+{
+    uint16_t slot = Calypso_WLANScan_HashBSSID(bssid);
+    while (CALYPSO_WLANSCAN_HASH_EMPTY != Calypso_WLANScan_hashTable[slot])
+    {
+        if (0 == memcmp(Calypso_WLANScan_entries[Calypso_WLANScan_hashTable[slot]].BSSID, bssid, 6))
+        {
+            break;
+        }
+        slot = (slot + 1) & (CALYPSO_WLANSCAN_HASH_SIZE - 1);
+    }
+    return slot;
+}
+
+/**
+ * @brief Removes an entry from the BSSID table.
+ *
+ * The hash table slot is released using backward shift deletion (no tombstones) and the last
+ * entry is moved to the freed position to keep the entries densely packed.
+ *
+ * @param[in] index Index of entry to be removed
+ */
+static void Calypso_WLANScan_Remove(uint16_t index)
+{
+    uint16_t mask = CALYPSO_WLANSCAN_HASH_SIZE - 1;
+    uint16_t hole = Calypso_WLANScan_FindSlot(Calypso_WLANScan_entries[index].BSSID);
+    uint16_t slot = hole;
+
+    Calypso_WLANScan_hashTable[hole] = CALYPSO_WLANSCAN_HASH_EMPTY;
+    while (true)
+    {
+        slot = (slot + 1) & mask;
+        if (CALYPSO_WLANSCAN_HASH_EMPTY == Calypso_WLANScan_hashTable[slot])
+        {
+            break;
+        }
+
+        /* Move the entry to the hole unless its home slot lies cyclically in (hole, slot] */
+        uint16_t home = Calypso_WLANScan_HashBSSID(Calypso_WLANScan_entries[Calypso_WLANScan_hashTable[slot]].BSSID);
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            Calypso_WLANScan_hashTable[hole] = Calypso_WLANScan_hashTable[slot];
+            Calypso_WLANScan_hashTable[slot] = CALYPSO_WLANSCAN_HASH_EMPTY;
+            hole = slot;
+        }
+    }
+
+    uint16_t last = Calypso_WLANScan_count - 1;
+    if (index != last)
+    {
+        memcpy(&Calypso_WLANScan_entries[index], &Calypso_WLANScan_entries[last], sizeof(Calypso_WLANScan_Entry_t));
+        Calypso_WLANScan_hashTable[Calypso_WLANScan_FindSlot(Calypso_WLANScan_entries[index].BSSID)] = index;
+    }
+    Calypso_WLANScan_count = last;
+}
+
+/**
+ * @brief Returns the index of the least recently seen entry.
+ *
+ * @return Index of entry
+ */
+static uint16_t Calypso_WLANScan_GetOldest(void)
+{
+    uint32_t now = WE_GetTick();
+    uint16_t oldest = 0;
+    for (uint16_t i = 1; i < Calypso_WLANScan_count; i++)
+    {
+        if ((uint32_t) (now - Calypso_WLANScan_entries[i].lastSeen) > (uint32_t) (now - Calypso_WLANScan_entries[oldest].lastSeen))
+        {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+/**
+ * @brief Converts a hexadecimal digit to its value.
+ *
+ * @param[in] c Character
+ *
+ * @return Value of digit or -1 if the character is not a hexadecimal digit
+ */
+static int8_t Calypso_WLANScan_HexDigit(char c)
+{
+    if ((c >= '0') && (c <= '9'))
+    {
+        return (int8_t) (c - '0');
+    }
+    if ((c >= 'a') && (c <= 'f'))
+    {
+        return (int8_t) (c - 'a' + 10);
+    }
+    if ((c >= 'A') && (c <= 'F'))
+    {
+        return (int8_t) (c - 'A' + 10);
+    }
+    return -1;
+}
@@ -0,0 +1,151 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+/**
+ * @file
+ * @brief Calypso streaming WLAN scan header file.
+ *
+ * Collects WLAN scan results in a table indexed by BSSID. Scan entries are parsed line by
+ * line while the module's response is received (see ATWLAN_ScanStreamed()), so the number of
+ * access points is neither limited by the response buffer nor by a caller-provided array.
+ *
+ * - Calypso_WLANScan_Scan() pages through the module's scan result list (max.
+ *   ATWLAN_SCAN_MAX_ENTRIES entries) in requests of CALYPSO_WLANSCAN_PAGE_SIZE entries.
+ * - Entries of access points seen in multiple scans are merged. The RSSI is smoothed using an
+ *   exponential moving average (see CALYPSO_WLANSCAN_RSSI_SMOOTHING_SHIFT).
+ * - Entries not seen for longer than CALYPSO_WLANSCAN_MAX_AGE_MS are removed after each scan.
+ *   If the table is full, the least recently seen entry is replaced.
+ *
+ * Calling Calypso_WLANScan_Scan() repeatedly (e.g. site survey) accumulates all access points
+ * seen within the max. age, which may be far more than the module reports per scan.
+ */
+
+#ifndef CALYPSO_WLANSCAN_H_INCLUDED
+#define CALYPSO_WLANSCAN_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ATCommands/ATWLAN.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Max. number of access points in the BSSID table.
+ */
+#ifndef CALYPSO_WLANSCAN_TABLE_SIZE
+#define CALYPSO_WLANSCAN_TABLE_SIZE 32
+#endif
+
+/**
+ * @brief Size of hash table used to look up BSSIDs (must be a power of two and larger than CALYPSO_WLANSCAN_TABLE_SIZE).
+ */
+#ifndef CALYPSO_WLANSCAN_HASH_SIZE
+#define CALYPSO_WLANSCAN_HASH_SIZE 64
+#endif
+
+/**
+ * @brief Number of scan entries requested per AT+wlanScan command.
+ */
+#ifndef CALYPSO_WLANSCAN_PAGE_SIZE
+#define CALYPSO_WLANSCAN_PAGE_SIZE 10
+#endif
+
+/**
+ * @brief Time after which access points that haven't been seen are removed from the table (ms).
+ */
+#ifndef CALYPSO_WLANSCAN_MAX_AGE_MS
+#define CALYPSO_WLANSCAN_MAX_AGE_MS 60000
+#endif
+
+/**
+ * @brief RSSI smoothing factor: new = old + (RSSI - old) / 2^CALYPSO_WLANSCAN_RSSI_SMOOTHING_SHIFT.
+ */
+#ifndef CALYPSO_WLANSCAN_RSSI_SMOOTHING_SHIFT
+#define CALYPSO_WLANSCAN_RSSI_SMOOTHING_SHIFT 2
+#endif
+
+/**
+ * @brief Max. number of retries if the module has no scan results yet (SL_ERROR_WLAN_GET_NETWORK_LIST_EAGAIN).
+ */
+#ifndef CALYPSO_WLANSCAN_MAX_RETRIES
+#define CALYPSO_WLANSCAN_MAX_RETRIES 3
+#endif
+
+/**
+ * @brief Delay before retrying a scan if the module has no scan results yet (ms).
+ */
+#ifndef CALYPSO_WLANSCAN_RETRY_DELAY_MS
+#define CALYPSO_WLANSCAN_RETRY_DELAY_MS 1000
+#endif
+
+/**
+ * @brief Access point entry of the BSSID table.
+ */
+typedef struct Calypso_WLANScan_Entry_t
+{
+    uint8_t BSSID[6];                               /**< BSSID (MAC address of the access point) */
+    char SSID[ATWLAN_SSID_MAX_LENGTH];              /**< SSID */
+    uint8_t channel;                                /**< Channel */
+    int8_t RSSI;                                    /**< RSSI of the last scan (dBm) */
+    int8_t RSSISmoothed;                            /**< Smoothed RSSI (dBm) */
+    int16_t RSSIFiltered;                           /**< Internal: smoothed RSSI (1/16 dBm) */
+    uint8_t hiddenSsidEnabled;                      /**< Hidden SSID */
+    ATWLAN_ScanCipher_t cipher;                     /**< Cipher */
+    ATWLAN_ScanKeyManagement_t keyManagementMethod; /**< Key management method */
+    ATWLAN_ScanSecurityType_t securityType;         /**< Security type */
+    uint16_t seenCount;                             /**< Number of scans that have reported the access point */
+    uint32_t firstSeen;                             /**< Time at which the access point has been seen first (ms) */
+    uint32_t lastSeen;                              /**< Time at which the access point has been seen last (ms) */
+} Calypso_WLANScan_Entry_t;
+
+/**
+ * @brief Statistics as returned by Calypso_WLANScan_GetStatistics().
+ */
+typedef struct Calypso_WLANScan_Statistics_t
+{
+    uint32_t scans;                     /**< Number of completed scans */
+    uint32_t requests;                  /**< Number of AT+wlanScan requests */
+    uint32_t received;                  /**< Number of received scan entries */
+    uint32_t added;                     /**< Number of access points added to the table */
+    uint32_t replaced;                  /**< Number of access points dropped because the table was full */
+    uint32_t agedOut;                   /**< Number of access points removed because they haven't been seen */
+} Calypso_WLANScan_Statistics_t;
+
+extern void Calypso_WLANScan_Init(void);
+extern bool Calypso_WLANScan_Scan(uint16_t *pNumReceived);
+extern void Calypso_WLANScan_AgeOut(uint32_t maxAgeMs);
+extern uint16_t Calypso_WLANScan_GetCount(void);
+extern bool Calypso_WLANScan_GetEntry(uint16_t index, Calypso_WLANScan_Entry_t *entry);
+extern bool Calypso_WLANScan_FindEntry(const char *BSSID, Calypso_WLANScan_Entry_t *entry);
+extern bool Calypso_WLANScan_ParseBSSID(const char *BSSID, uint8_t macAddress[6]);
+extern void Calypso_WLANScan_GetStatistics(Calypso_WLANScan_Statistics_t *statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALYPSO_WLANSCAN_H_INCLUDED
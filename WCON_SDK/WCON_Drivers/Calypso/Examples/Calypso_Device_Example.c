@@ -48,11 +48,14 @@ void Calypso_Device_Example()
         return;
     }
 
+    /* Measure the time from reset until the module is ready for operation */
+    uint32_t bootStartTick = WE_GetTick();
     Calypso_PinReset();
-
-    Calypso_Examples_WaitForStartup(5000);
-
-    WE_Delay(1000);
+    if (Calypso_Examples_WaitForStartup(5000))
+    {
+        printf("Calypso ready after %lu ms\r\n", WE_GetTick() - bootStartTick);
+    }
+    (void) bootStartTick;
 
     bool ret = false;
 
@@ -71,12 +74,12 @@ void Calypso_Device_Example()
     ret = ATDevice_Stop(250);
     Calypso_Examples_Print("Stop NWP", ret);
 
-    WE_Delay(500);
+    Calypso_Examples_Delay(500);
 
     ret = ATDevice_Start();
     Calypso_Examples_Print("Start NWP", ret);
 
-    WE_Delay(500);
+    Calypso_Examples_Delay(500);
 
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
@@ -129,7 +132,7 @@ void Calypso_Device_Example()
                deviceValue.general.time.second);
     }
 
-    WE_Delay(100);
+    Calypso_Examples_Delay(100);
 
     deviceValue.general.time.hour++;
     deviceValue.general.time.year = 2021;
@@ -137,7 +140,7 @@ void Calypso_Device_Example()
     ret = ATDevice_Set(ATDevice_GetId_General, ATDevice_GetGeneral_Time, &deviceValue);
     Calypso_Examples_Print("Set device time", ret);
 
-    WE_Delay(100);
+    Calypso_Examples_Delay(100);
 
     ret = ATDevice_Get(ATDevice_GetId_General, ATDevice_GetGeneral_Time, &deviceValue);
     Calypso_Examples_Print("Get device time", ret);
@@ -145,7 +148,7 @@ void Calypso_Device_Example()
     ret = ATDevice_Sleep(2);
     Calypso_Examples_Print("Sleep", ret);
 
-    WE_Delay(3000);
+    Calypso_Examples_Delay(3000);
 
     Calypso_Deinit();
 }
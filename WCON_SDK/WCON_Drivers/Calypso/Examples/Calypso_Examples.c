@@ -38,6 +38,8 @@
 #include <Calypso/Calypso.h>
 
 #include <Calypso/ATCommands/ATEvent.h>
+#include <Calypso/Calypso_MQTTRouter.h>
+#include <Calypso/Calypso_WLANReconnect.h>
 
 #include "Calypso_Device_Example.h"
 #include "Calypso_Provisioning_Example.h"
@@ -81,12 +83,7 @@ const char *Calypso_Examples_wlanKey = "calypsowlan";
 /**
  * @brief Contains information on last startup event (if any)
  */
-ATEvent_Startup_t Calypso_Examples_startupEvent = {0};
-
-/**
- * @brief Is set to true when a startup event is received
- */
-bool Calypso_Examples_startupEventReceived = false;
+ATEvent_StartupCopy_t Calypso_Examples_startupEvent = {0};
 
 /**
  * @brief Is set to true when an IPv4 acquired event is received
@@ -98,12 +95,7 @@ bool Calypso_Examples_ip4Acquired = false;
  */
 bool Calypso_Examples_WaitForStartup(uint32_t timeoutMs)
 {
-    uint32_t t0 = WE_GetTick();
-    Calypso_Examples_startupEventReceived = false;
-    while (false == Calypso_Examples_startupEventReceived && (WE_GetTick() - t0) < timeoutMs)
-    {
-    }
-    return Calypso_Examples_startupEventReceived;
+    return Calypso_WaitForStartup(timeoutMs);
 }
 
 /**
@@ -115,10 +107,26 @@ bool Calypso_Examples_WaitForIPv4Acquired(uint32_t timeoutMs)
     Calypso_Examples_ip4Acquired = false;
     while (false == Calypso_Examples_ip4Acquired && (WE_GetTick() - t0) < timeoutMs)
     {
+        WE_Poll();
     }
     return Calypso_Examples_ip4Acquired;
 }
 
+/**
+ * @brief Waits for the supplied time while executing event callbacks deferred to the main loop
+ * (if CALYPSO_EVENT_QUEUE_SIZE > 0).
+ */
+void Calypso_Examples_Delay(uint32_t delayMs)
+{
+    uint32_t t0 = WE_GetTick();
+    do
+    {
+        WE_Poll();
+        WE_Delay(1);
+    }
+    while ((WE_GetTick() - t0) < delayMs);
+}
+
 /**
  * @brief Runs Calypso examples.
  *
@@ -160,6 +168,8 @@ void Calypso_Examples(void)
 
     while (1)
     {
+        /* Execute event callbacks deferred to the main loop (if CALYPSO_EVENT_QUEUE_SIZE > 0) */
+        WE_Poll();
         WE_Delay(500);
     }
 }
@@ -195,7 +205,10 @@ void Calypso_Examples_EventCallback(char* eventText)
     switch (event)
     {
     case ATEvent_Startup:
-        if (ATEvent_ParseStartUpEvent(&eventText, &Calypso_Examples_startupEvent))
+    {
+        ATEvent_Startup_t startupEvent;
+        if (ATEvent_ParseStartUpEvent(&eventText, &startupEvent) &&
+            ATEvent_CopyStartUpEvent(&startupEvent, &Calypso_Examples_startupEvent))
         {
             printf("Startup event received. "
                     "Article nr: %s, "
@@ -209,13 +222,19 @@ void Calypso_Examples_EventCallback(char* eventText)
                     Calypso_Examples_startupEvent.firmwareVersion[1],
                     Calypso_Examples_startupEvent.firmwareVersion[2]);
         }
-        Calypso_Examples_startupEventReceived = true;
         break;
+    }
 
     case ATEvent_NetappIP4Acquired:
+        Calypso_WLANReconnect_HandleEvent(event, &eventText);
         Calypso_Examples_ip4Acquired = true;
         break;
 
+    case ATEvent_WlanConnect:
+    case ATEvent_WlanDisconnect:
+        Calypso_WLANReconnect_HandleEvent(event, &eventText);
+        break;
+
     case ATEvent_WakeUp:
     case ATEvent_Ping:
     case ATEvent_SocketTxFailed:
@@ -234,8 +253,6 @@ void Calypso_Examples_EventCallback(char* eventText)
     case ATEvent_Invalid:
     case ATEvent_GeneralResetRequest:
     case ATEvent_GeneralError:
-    case ATEvent_WlanConnect:
-    case ATEvent_WlanDisconnect:
     case ATEvent_WlanStaAdded:
     case ATEvent_WlanStaRemoved:
     case ATEvent_WlanProvisioningStatus:
@@ -247,8 +264,11 @@ void Calypso_Examples_EventCallback(char* eventText)
     case ATEvent_NetappIPv4Lost:
     case ATEvent_NetappDHCPIPv4AcquireTimeout:
     case ATEvent_NetappIPv6Lost:
-    case ATEvent_MQTTOperation:
     case ATEvent_MQTTRecv:
+        Calypso_MQTTRouter_HandleEvent(event, &eventText);
+        break;
+
+    case ATEvent_MQTTOperation:
     case ATEvent_MQTTDisconnect:
     case ATEvent_FileListEntry:
     case ATEvent_HTTPGet:
@@ -46,14 +46,14 @@ extern const WE_Parity_t Calypso_Examples_parity;
 extern const char *Calypso_Examples_wlanSSID;
 extern const char *Calypso_Examples_wlanKey;
 
-extern ATEvent_Startup_t Calypso_Examples_startupEvent;
-extern bool Calypso_Examples_startupEventReceived;
+extern ATEvent_StartupCopy_t Calypso_Examples_startupEvent;
 extern bool Calypso_Examples_ip4Acquired;
 
 extern void Calypso_Examples(void);
 extern void Calypso_Examples_Print(char* str, bool success);
 extern bool Calypso_Examples_WaitForStartup(uint32_t timeoutMs);
 extern bool Calypso_Examples_WaitForIPv4Acquired(uint32_t timeoutMs);
+extern void Calypso_Examples_Delay(uint32_t delayMs);
 extern void Calypso_Examples_EventCallback(char* eventText);
 
 #ifdef __cplusplus
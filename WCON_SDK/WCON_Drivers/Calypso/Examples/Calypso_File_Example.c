@@ -55,7 +55,7 @@ void Calypso_File_Example(void)
 
     Calypso_PinReset();
 
-    WE_Delay(2000);
+    Calypso_WaitForStartup(5000);
 
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
@@ -150,17 +150,18 @@ void Calypso_File_Example_EventCallback(char* eventText)
     {
     case ATEvent_FileListEntry:
     {
-        ATFile_FileListEntry_t fileListEntry;
+        ATFile_FileListEntryView_t fileListEntry;
         if (ATEvent_ParseFileListEntryEvent(&eventText, &fileListEntry))
         {
             char propertiesStr[256] = {0};
             ATFile_PrintFileProperties(fileListEntry.properties, propertiesStr, sizeof(propertiesStr));
             printf("File list entry: "
-                   "Name = \"%s\", "
+                   "Name = \"%.*s\", "
                    "max. size = %lu, "
                    "properties = \"%s\", "
                    "blocks = %lu\r\n",
-                   fileListEntry.fileName,
+                   fileListEntry.fileName.length,
+                   fileListEntry.fileName.data,
                    fileListEntry.maxFileSize,
                    propertiesStr,
                    fileListEntry.allocatedBlocks);
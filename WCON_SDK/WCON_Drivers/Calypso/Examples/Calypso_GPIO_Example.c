@@ -50,8 +50,6 @@ void Calypso_GPIO_Example(void)
 
 	Calypso_Examples_WaitForStartup(5000);
 
-	WE_Delay(1000);
-
 	ATGPIO_GPIO_t gpio;
 	bool ret;
 
@@ -102,7 +100,7 @@ void Calypso_GPIO_Example(void)
 			printf("GPIO1 level is %s\r\n", gpio.parameters.input.state == ATGPIO_GPIOState_High ? "high" : "low");
 		}
 
-		WE_Delay(1000);
+		Calypso_Examples_Delay(1000);
 	}
 
 	/* Configure GPIO2 as PWM output with 100 ms period (and store configuration
@@ -115,7 +113,7 @@ void Calypso_GPIO_Example(void)
 	gpio.parameters.pwm.ratio = 0;
 	ret = ATGPIO_Set(&gpio, true);
 	Calypso_Examples_Print("Set GPIO2 = PWM", ret);
-	WE_Delay(1000);
+	Calypso_Examples_Delay(1000);
 
 	/* Increase ratio by 10% every second */
 	for (uint8_t ratio = 10; ratio <= 100; ratio += 10)
@@ -133,7 +131,7 @@ void Calypso_GPIO_Example(void)
 				   gpio.parameters.pwm.period,
 				   gpio.parameters.pwm.ratio);
 		}
-		WE_Delay(1000);
+		Calypso_Examples_Delay(1000);
 	}
 
 	/* Disable all GPIOs */
@@ -75,8 +75,6 @@ void Calypso_HTTP_Client_Example(void)
 
     Calypso_Examples_WaitForStartup(5000);
 
-    WE_Delay(1000);
-
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
      * Calypso_firmwareVersionPatch for later use. */
@@ -103,7 +101,7 @@ void Calypso_HTTP_Client_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -115,7 +113,7 @@ void Calypso_HTTP_Client_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     char hostWithPrefix[128] = "";
     if (secure)
@@ -72,8 +72,6 @@ void Calypso_HTTP_Server_Example(void)
 
     Calypso_Examples_WaitForStartup(5000);
 
-    WE_Delay(1000);
-
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
      * Calypso_firmwareVersionPatch for later use. */
@@ -100,7 +98,7 @@ void Calypso_HTTP_Server_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -112,12 +110,14 @@ void Calypso_HTTP_Server_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
 
     printf("Will now wait for asynchronous events until receiving HTTP POST request with id=\"quit\".\r\n");
     while (!quitRequested)
     {
+        WE_Poll();
+
         if (getRequestReceived)
         {
             /* An HTTP GET request has been received. */
@@ -160,7 +160,9 @@ void Calypso_HTTP_Example_EventCallback(char* eventText)
     {
         if (!getRequestReceived)
         {
-            if (ATEvent_ParseHttpGetEvent(&eventText, getRequestId, sizeof(getRequestId)))
+            Calypso_StringView_t id;
+            if (ATEvent_ParseHttpGetEvent(&eventText, &id) &&
+                Calypso_ViewToString(getRequestId, id, sizeof(getRequestId)))
             {
                 printf("Received HTTP GET request with id=\"%s\"\r\n", getRequestId);
 
@@ -182,13 +184,16 @@ void Calypso_HTTP_Example_EventCallback(char* eventText)
 
     case ATEvent_CustomHTTPPost:
     {
-        char id[64];
-        char value[1024];
-        if (ATEvent_ParseCustomHTTPPostEvent(&eventText, id, value, sizeof(id), sizeof(value)))
+        ATEvent_CustomHTTPPost_t postEvent;
+        if (ATEvent_ParseCustomHTTPPostEvent(&eventText, &postEvent))
         {
-            printf("Received HTTP POST event containing id=\"%s\" and value=\"%s\"\r\n", id, value);
+            printf("Received HTTP POST event containing id=\"%.*s\" and value=\"%.*s\"\r\n",
+                   postEvent.id.length,
+                   postEvent.id.data,
+                   postEvent.value.length,
+                   postEvent.value.data);
 
-            if (0 == strcmp(id, "quit"))
+            if (Calypso_ViewEquals(postEvent.id, "quit"))
             {
                 quitRequested = true;
             }
@@ -37,6 +37,7 @@
 #include <Calypso/ATCommands/ATNetCfg.h>
 #include <Calypso/ATCommands/ATSocket.h>
 #include <Calypso/ATCommands/ATWLAN.h>
+#include <Calypso/Calypso_MQTTRouter.h>
 
 #include "Calypso_Examples.h"
 
@@ -50,6 +51,21 @@ static const char *mqttServerAddress = "192.168.178.57";
  */
 static const uint16_t mqttServerPort = 1883;
 
+/**
+ * @brief Is called by the MQTT dispatcher for messages received on subscribed "kitchen/..." topics.
+ *
+ * @param[in] message Received message
+ * @param[in] context Context pointer passed when subscribing (unused)
+ */
+static void Calypso_MQTT_Example_KitchenHandler(const ATEvent_MQTTRcvd_t *message, void *context)
+{
+    printf("MQTT message received on topic \"%.*s\": %.*s\r\n",
+           message->topic.length,
+           message->topic.data,
+           message->data.length,
+           message->data.data);
+}
+
 /**
  * @brief MQTT example.
  */
@@ -68,8 +84,6 @@ void Calypso_MQTT_Example(void)
 
     Calypso_Examples_WaitForStartup(5000);
 
-    WE_Delay(1000);
-
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
      * Calypso_firmwareVersionPatch for later use. */
@@ -96,7 +110,7 @@ void Calypso_MQTT_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -108,7 +122,7 @@ void Calypso_MQTT_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
 
     /* Create MQTT client */
@@ -143,7 +157,7 @@ void Calypso_MQTT_Example(void)
     ret = ATMQTT_Connect(mqttIndex);
     Calypso_Examples_Print("Connect to MQTT broker", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     /* Publish some MQTT topics */
     char *message = "10.4 deg";
@@ -160,15 +174,16 @@ void Calypso_MQTT_Example(void)
 
     /* Subscribe to the above topics, then unsubscribe from "kitchen/temp" */
 
-    ret = ATMQTT_Subscribe(mqttIndex, 2, topics);
+    Calypso_MQTTRouter_Init();
+    ret = Calypso_MQTTRouter_Subscribe(mqttIndex, 2, topics, Calypso_MQTT_Example_KitchenHandler, NULL);
     Calypso_Examples_Print("MQTT subscribe", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
-    ret = ATMQTT_Unsubscribe(mqttIndex, "kitchen/temp", "", "", "");
+    ret = Calypso_MQTTRouter_Unsubscribe(mqttIndex, "kitchen/temp", Calypso_MQTT_Example_KitchenHandler);
     Calypso_Examples_Print("MQTT unsubscribe", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
 
     /* Disconnect and delete MQTT client */
@@ -176,7 +191,7 @@ void Calypso_MQTT_Example(void)
     ret = ATMQTT_Disconnect(mqttIndex);
     Calypso_Examples_Print("MQTT disconnect", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     ret = ATMQTT_Delete(mqttIndex);
     Calypso_Examples_Print("MQTT delete", ret);
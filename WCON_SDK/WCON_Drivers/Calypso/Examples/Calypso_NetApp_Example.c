@@ -36,6 +36,7 @@
 #include <Calypso/ATCommands/ATNetApp.h>
 #include <Calypso/ATCommands/ATNetCfg.h>
 #include <Calypso/ATCommands/ATWLAN.h>
+#include <Calypso/Calypso_DNSCache.h>
 
 #include "Calypso_Examples.h"
 
@@ -59,8 +60,6 @@ void Calypso_NetApp_Example(void)
 
     Calypso_Examples_WaitForStartup(5000);
 
-    WE_Delay(1000);
-
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
      * Calypso_firmwareVersionPatch for later use. */
@@ -87,7 +86,7 @@ void Calypso_NetApp_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -99,7 +98,7 @@ void Calypso_NetApp_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     /* Get IPv4 configuration (station) */
     ATNetCfg_IPv4Config_t ipV4Config;
@@ -121,6 +120,17 @@ void Calypso_NetApp_Example(void)
     Calypso_Examples_Print("Get host by name", ret);
     printf("IP lookup result: host=\"%s\", IP=\"%s\"\r\n", lookupResult.hostName, lookupResult.hostAddress);
 
+    /* Cached host / IP lookup example (second lookup is answered from the cache) */
+    Calypso_DNSCache_Init();
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        ret = Calypso_DNSCache_GetHostByName("www.google.com", ATSocket_Family_INET, &lookupResult);
+        Calypso_Examples_Print("Get host by name (cached)", ret);
+    }
+    Calypso_DNSCache_Statistics_t dnsCacheStatistics;
+    Calypso_DNSCache_GetStatistics(&dnsCacheStatistics);
+    printf("DNS cache: %lu hits, %lu misses\r\n", dnsCacheStatistics.hits, dnsCacheStatistics.misses);
+
 
     /* SNTP client example */
     ret = ATNetApp_StartApplications(ATNetApp_Application_SntpClient);
@@ -144,7 +154,7 @@ void Calypso_NetApp_Example(void)
     ret = ATNetApp_Set(ATNetApp_Application_SntpClient, ATNetApp_SntpOption_Servers, &value);
     Calypso_Examples_Print("Set SNTP servers", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     ret = ATNetApp_UpdateTime();
     Calypso_Examples_Print("Update device time", ret);
@@ -165,7 +175,7 @@ void Calypso_NetApp_Example(void)
     ret = ATNetApp_StopApplications(ATNetApp_Application_SntpClient);
     Calypso_Examples_Print("Disable SNTP client", ret);
 
-    WE_Delay(500);
+    Calypso_Examples_Delay(500);
 
 
     /* Ping the gateway. Ping response is reported in the form of events. */
@@ -184,6 +194,7 @@ void Calypso_NetApp_Example(void)
     /* Wait for all ping responses requested above to arrive */
     while (nrOfPingResponsesRemaining > 0)
     {
+        WE_Poll();
     }
 
     Calypso_Deinit();
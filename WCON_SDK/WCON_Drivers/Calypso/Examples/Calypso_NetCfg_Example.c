@@ -54,7 +54,7 @@ void Calypso_NetCfg_Example(void)
 
     Calypso_PinReset();
 
-    WE_Delay(2000);
+    Calypso_WaitForStartup(5000);
 
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
@@ -69,7 +69,7 @@ void Calypso_NetCfg_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -81,14 +81,14 @@ void Calypso_NetCfg_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
 
     /* Set interface modes */
     ret = ATNetCfg_SetInterfaceModes(ATNetCfg_InterfaceMode_IPv6StationLocal | ATNetCfg_InterfaceMode_DisableFastRenew);
     Calypso_Examples_Print("Set interface modes", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
 
     /* Set MAC address */
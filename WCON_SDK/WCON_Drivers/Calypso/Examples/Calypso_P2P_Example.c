@@ -84,7 +84,7 @@ static bool p2pServerConnectionAccepted = false;
 /**
  * @brief Last TCP server accept event (filled in when a client connects to the server). Used in TCP server example.
  */
-static ATEvent_SocketTCPAccept_t p2pServerAcceptEvent = {0};
+static ATEvent_SocketTCPAcceptCopy_t p2pServerAcceptEvent = {0};
 
 /**
  * @brief Is set to true when the TCP client has established a connection to the server. Used in TCP client example.
@@ -94,7 +94,7 @@ static bool p2pClientConnectionEstablished = false;
 /**
  * @brief Last TCP client connect event (filled in when the client has established a connection to the server). Used in TCP client example.
  */
-static ATEvent_SocketTCPConnect_t p2pClientConnectEvent = {0};
+static ATEvent_SocketTCPConnectCopy_t p2pClientConnectEvent = {0};
 
 /**
  * @brief Is set to true when a TCP connection has been established. Used in TCP server and client examples.
@@ -127,7 +127,7 @@ void Calypso_P2P_Example(void)
 
     Calypso_PinReset();
 
-    WE_Delay(2000);
+    Calypso_WaitForStartup(5000);
 
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
@@ -176,6 +176,8 @@ void Calypso_P2P_Example(void)
         uint8_t numScanEntries;
         while (!p2pDeviceFound && !p2pConnectFail)
         {
+            WE_Poll();
+
             ret = ATWLAN_Scan(0, 5, scanEntries, &numScanEntries);
             Calypso_Examples_Print("Scan for P2P devices", ret);
 
@@ -189,14 +191,16 @@ void Calypso_P2P_Example(void)
                 }
             }
 
-            WE_Delay(1000);
+            Calypso_Examples_Delay(1000);
         }
 
         /* Wait for P2P request event (or until connection attempt fails / times out) */
         uint32_t t = WE_GetTick();
         while (!p2pRequestReceived && !p2pConnectFail)
         {
-            WE_Delay(100);
+            WE_Poll();
+
+            Calypso_Examples_Delay(100);
 
             if (WE_GetTick() - t > p2pConnectTimeoutMs)
             {
@@ -211,7 +215,9 @@ void Calypso_P2P_Example(void)
         t = WE_GetTick();
         while (!p2pConnected && !p2pConnectFail)
         {
-            WE_Delay(100);
+            WE_Poll();
+
+            Calypso_Examples_Delay(100);
 
             if (WE_GetTick() - t > p2pConnectTimeoutMs)
             {
@@ -275,6 +281,8 @@ void Calypso_P2P_Example(void)
             bool firstRun = true;
             while (p2pConnected)
             {
+                WE_Poll();
+
                 if (p2pServerConnectionAccepted)
                 {
                     /* The peer has connected to the server */
@@ -328,7 +336,7 @@ void Calypso_P2P_Example(void)
                     }
                 }
 
-                WE_Delay(100);
+                Calypso_Examples_Delay(100);
             }
 
             ATWLAN_Disconnect();
@@ -372,18 +380,26 @@ void Calypso_P2P_Example_EventCallback(char* eventText)
         break;
 
     case ATEvent_SocketTCPConnect:
-        if (ATEvent_ParseSocketTCPConnectEvent(&eventText, &p2pClientConnectEvent))
+    {
+        ATEvent_SocketTCPConnect_t connectEvent;
+        if (ATEvent_ParseSocketTCPConnectEvent(&eventText, &connectEvent) &&
+            ATEvent_CopySocketTCPConnectEvent(&connectEvent, &p2pClientConnectEvent))
         {
             p2pClientConnectionEstablished = true;
         }
         break;
+    }
 
     case ATEvent_SocketTCPAccept:
-        if (ATEvent_ParseSocketTCPAcceptEvent(&eventText, &p2pServerAcceptEvent))
+    {
+        ATEvent_SocketTCPAccept_t acceptEvent;
+        if (ATEvent_ParseSocketTCPAcceptEvent(&eventText, &acceptEvent) &&
+            ATEvent_CopySocketTCPAcceptEvent(&acceptEvent, &p2pServerAcceptEvent))
         {
             p2pServerConnectionAccepted = true;
         }
         break;
+    }
 
     case ATEvent_SocketRcvd:
     case ATEvent_SocketRcvdFrom:
@@ -469,8 +485,10 @@ void Calypso_P2P_Example_EventCallback(char* eventText)
  */
 void Calypso_P2P_Example_OnDataReceived(ATEvent_SocketRcvd_t *rcvdEvent)
 {
-    memcpy(p2pExampleReceiveBuffer, rcvdEvent->data, rcvdEvent->length);
-    p2pExampleReceiveBuffer[rcvdEvent->length] = '\0';
+    if (!Calypso_ViewToString(p2pExampleReceiveBuffer, rcvdEvent->data, sizeof(p2pExampleReceiveBuffer)))
+    {
+        return;
+    }
     printf("RECEIVED %s\r\n", p2pExampleReceiveBuffer);
 
     p2pExampleWaitingForData = false;
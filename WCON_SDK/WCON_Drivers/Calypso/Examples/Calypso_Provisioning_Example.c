@@ -52,8 +52,6 @@ void Calypso_Provisioning_Example()
 
     Calypso_Examples_WaitForStartup(10000);
 
-    WE_Delay(1000);
-
     bool ret = false;
 
     /* Uncomment the following lines to activate factory reset (takes up to 90s) */
@@ -75,6 +73,7 @@ void Calypso_Provisioning_Example()
 
     while (true)
     {
+        WE_Poll();
     }
 
     Calypso_Deinit();
@@ -85,7 +85,7 @@ static bool tcpServerConnectionAccepted = false;
 /**
  * @brief Last TCP server accept event (filled in when a client connects to the server). Used in TCP server example.
  */
-static ATEvent_SocketTCPAccept_t tcpServerAcceptEvent = {0};
+static ATEvent_SocketTCPAcceptCopy_t tcpServerAcceptEvent = {0};
 
 /**
  * @brief Is set to true when the TCP client has established a connection to the server. Used in TCP client example.
@@ -95,7 +95,7 @@ static bool tcpClientConnectionEstablished = false;
 /**
  * @brief Last TCP client connect event (filled in when the client has established a connection to the server). Used in TCP client example.
  */
-static ATEvent_SocketTCPConnect_t tcpClientConnectEvent = {0};
+static ATEvent_SocketTCPConnectCopy_t tcpClientConnectEvent = {0};
 
 /**
  * @brief Is set to true when a TCP connection has been established. Used in TCP server and client examples.
@@ -139,7 +139,7 @@ void Calypso_TCPServer_Example(void)
 
     Calypso_PinReset();
 
-    WE_Delay(2000);
+    Calypso_WaitForStartup(5000);
 
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
@@ -154,7 +154,7 @@ void Calypso_TCPServer_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -166,7 +166,7 @@ void Calypso_TCPServer_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     /* Set static IPv4 configuration for server */
     ATNetCfg_IPv4Config_t newIpV4Config = {0};
@@ -362,7 +362,7 @@ void Calypso_TCPServer_Example(void)
         strcpy(value.sntp.servers[2], "");
         ret = ATNetApp_Set(ATNetApp_Application_SntpClient, ATNetApp_SntpOption_Servers, &value);
         Calypso_Examples_Print("Set SNTP server address", ret);
-        WE_Delay(2000);
+        Calypso_Examples_Delay(2000);
         ret = ATNetApp_UpdateTime();
         Calypso_Examples_Print("Update device time", ret);
         ATDevice_Value_t deviceValue;
@@ -395,6 +395,8 @@ void Calypso_TCPServer_Example(void)
 
     while (true)
     {
+        WE_Poll();
+
         if (tcpServerConnectionAccepted)
         {
             /* A client has connected to the server */
@@ -423,7 +425,7 @@ void Calypso_TCPServer_Example(void)
             }
         }
 
-        WE_Delay(250);
+        Calypso_Examples_Delay(250);
     }
 
     Calypso_Deinit();
@@ -450,7 +452,7 @@ void Calypso_TCPClient_Example(void)
 
     Calypso_PinReset();
 
-    WE_Delay(2000);
+    Calypso_WaitForStartup(5000);
 
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
@@ -465,7 +467,7 @@ void Calypso_TCPClient_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -477,7 +479,7 @@ void Calypso_TCPClient_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     /* Set static IPv4 configuration for client */
     ATNetCfg_IPv4Config_t newIpV4Config = {0};
@@ -607,7 +609,7 @@ void Calypso_TCPClient_Example(void)
         strcpy(value.sntp.servers[2], "");
         ret = ATNetApp_Set(ATNetApp_Application_SntpClient, ATNetApp_SntpOption_Servers, &value);
         Calypso_Examples_Print("Set SNTP server address", ret);
-        WE_Delay(2000);
+        Calypso_Examples_Delay(2000);
         ret = ATNetApp_UpdateTime();
         Calypso_Examples_Print("Update device time", ret);
         ATDevice_Value_t deviceValue;
@@ -634,6 +636,8 @@ void Calypso_TCPClient_Example(void)
 
     while (true)
     {
+        WE_Poll();
+
         if (tcpClientConnectionEstablished)
         {
             /* Connection to server has been established */
@@ -659,7 +663,7 @@ void Calypso_TCPClient_Example(void)
                           &bytesSent);
         }
 
-        WE_Delay(250);
+        Calypso_Examples_Delay(250);
     }
 
     Calypso_Deinit();
@@ -686,7 +690,7 @@ void Calypso_UDPReceive_Example(void)
 
     Calypso_PinReset();
 
-    WE_Delay(2000);
+    Calypso_WaitForStartup(5000);
 
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
@@ -701,7 +705,7 @@ void Calypso_UDPReceive_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -713,7 +717,7 @@ void Calypso_UDPReceive_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     /* Set static IPv4 configuration (using server address) */
     ATNetCfg_IPv4Config_t newIpV4Config = {0};
@@ -759,6 +763,8 @@ void Calypso_UDPReceive_Example(void)
 
     while (true)
     {
+        WE_Poll();
+
         if (socketExampleWaitingForData)
         {
             /* NOP */
@@ -771,7 +777,7 @@ void Calypso_UDPReceive_Example(void)
             ATSocket_ReceiveFrom(socketID, socketDescriptorClient, Calypso_DataFormat_Binary, CALYPSO_MAX_PAYLOAD_SIZE);
         }
 
-        WE_Delay(250);
+        Calypso_Examples_Delay(250);
     }
 
     Calypso_Deinit();
@@ -798,7 +804,7 @@ void Calypso_UDPTransmit_Example(void)
 
     Calypso_PinReset();
 
-    WE_Delay(2000);
+    Calypso_WaitForStartup(5000);
 
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
@@ -813,7 +819,7 @@ void Calypso_UDPTransmit_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -825,7 +831,7 @@ void Calypso_UDPTransmit_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     /* Set static IPv4 configuration (using client address) */
     ATNetCfg_IPv4Config_t newIpV4Config = {0};
@@ -871,6 +877,8 @@ void Calypso_UDPTransmit_Example(void)
 
     while (true)
     {
+        WE_Poll();
+
         /* A 16bit counter value (converted to ASCII) is sent to the peer every 250ms */
         static uint16_t counter = 0;
         char data[8];
@@ -884,7 +892,7 @@ void Calypso_UDPTransmit_Example(void)
                         data,
                         &bytesSent);
 
-        WE_Delay(250);
+        Calypso_Examples_Delay(250);
     }
 
     Calypso_Deinit();
@@ -919,18 +927,26 @@ void Calypso_Socket_Example_EventCallback(char* eventText)
         break;
 
     case ATEvent_SocketTCPConnect:
-        if (ATEvent_ParseSocketTCPConnectEvent(&eventText, &tcpClientConnectEvent))
+    {
+        ATEvent_SocketTCPConnect_t connectEvent;
+        if (ATEvent_ParseSocketTCPConnectEvent(&eventText, &connectEvent) &&
+            ATEvent_CopySocketTCPConnectEvent(&connectEvent, &tcpClientConnectEvent))
         {
             tcpClientConnectionEstablished = true;
         }
         break;
+    }
 
     case ATEvent_SocketTCPAccept:
-        if (ATEvent_ParseSocketTCPAcceptEvent(&eventText, &tcpServerAcceptEvent))
+    {
+        ATEvent_SocketTCPAccept_t acceptEvent;
+        if (ATEvent_ParseSocketTCPAcceptEvent(&eventText, &acceptEvent) &&
+            ATEvent_CopySocketTCPAcceptEvent(&acceptEvent, &tcpServerAcceptEvent))
         {
             tcpServerConnectionAccepted = true;
         }
         break;
+    }
 
     case ATEvent_SocketRcvd:
     case ATEvent_SocketRcvdFrom:
@@ -992,8 +1008,10 @@ void Calypso_Socket_Example_EventCallback(char* eventText)
  */
 void Calypso_Socket_Example_OnDataReceived(ATEvent_SocketRcvd_t *rcvdEvent)
 {
-    memcpy(socketExampleReceiveBuffer, rcvdEvent->data, rcvdEvent->length);
-    socketExampleReceiveBuffer[rcvdEvent->length] = '\0';
+    if (!Calypso_ViewToString(socketExampleReceiveBuffer, rcvdEvent->data, sizeof(socketExampleReceiveBuffer)))
+    {
+        return;
+    }
     printf("RECEIVED %s\r\n", socketExampleReceiveBuffer);
 
     socketExampleWaitingForData = false;
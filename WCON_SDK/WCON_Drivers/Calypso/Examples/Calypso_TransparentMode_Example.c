@@ -35,6 +35,7 @@
 #include <Calypso/ATCommands/ATDevice.h>
 #include <Calypso/ATCommands/ATNetCfg.h>
 #include <Calypso/ATCommands/ATWLAN.h>
+#include <Calypso/Calypso_TransparentMode.h>
 
 #include "Calypso_Examples.h"
 
@@ -95,34 +96,6 @@ static bool transparentModeExamplePowerSave = false;
  */
 static uint16_t transparentModeExampleRxTimeoutMs = 500;
 
-/**
- * @brief Is set to true when a complete line has been received (terminated
- * with transparentModeExampleEtx1/2)
- *
- * The received text is stored in transparentModeExampleRxBuffer and
- * has length transparentModeExampleBytesReceived.
- */
-static bool transparentModeExampleLineReceived = false;
-
-/**
- * @brief Buffer storing received bytes (last received line)
- */
-static uint8_t transparentModeExampleRxBuffer[CALYPSO_TRANSPARENT_MODE_EXAMPLE_MAX_PAYLOAD_SIZE + 1];
-
-/**
- * @brief Number of bytes received (length of text in transparentModeExampleRxBuffer)
- */
-static uint16_t transparentModeExampleBytesReceived = 0;
-
-/**
- * @brief Timestamp (tick) of last received byte.
- * Is used to check timeout when waiting for incoming data.
- * Is initialized to time of last request sent.
- */
-static uint32_t transparentModeExampleLastByteReceivedTimestamp = 0;
-
-static void Calypso_TransparentModeExampleByteHandler(uint8_t byte);
-
 /**
  * @brief Transparent mode example.
  *
@@ -152,8 +125,6 @@ void Calypso_TransparentMode_Example(void)
 
     Calypso_Examples_WaitForStartup(5000);
 
-    WE_Delay(1000);
-
     /* Get version info. This retrieves Calypso's firmware version (amongst other version info) and
      * stores the firmware version in Calypso_firmwareVersionMajor, Calypso_firmwareVersionMinor and
      * Calypso_firmwareVersionPatch for later use. */
@@ -243,121 +214,72 @@ void Calypso_TransparentMode_Example(void)
     ret = ATDevice_Set(ATDevice_GetId_TransparentMode, ATDevice_GetTransparentMode_DisableCertificateStore, &deviceValue);
     Calypso_Examples_Print("Set disable certificate store", ret);
 
-    memset(&deviceValue, 0, sizeof(deviceValue));
-    deviceValue.uart.transparentTrigger = transparentModeExampleTrigger;
-    ret = ATDevice_Set(ATDevice_GetId_UART, ATDevice_GetUart_TransparentTrigger, &deviceValue);
-    Calypso_Examples_Print("Set transparent trigger", ret);
-    memset(&deviceValue, 0, sizeof(deviceValue));
-    deviceValue.uart.transparentTimeoutMs = transparentModeExampleTriggerTimeoutMs;
-    ret = ATDevice_Set(ATDevice_GetId_UART, ATDevice_GetUart_TransparentTimeout, &deviceValue);
-    Calypso_Examples_Print("Set transparent timeout", ret);
-    memset(&deviceValue, 0, sizeof(deviceValue));
-    deviceValue.uart.transparentETX[0] = transparentModeExampleEtx1;
-    deviceValue.uart.transparentETX[1] = transparentModeExampleEtx2;
-    ret = ATDevice_Set(ATDevice_GetId_UART, ATDevice_GetUart_TransparentETX, &deviceValue);
-    Calypso_Examples_Print("Set transparent ETX", ret);
-
-
-    /* Set app mode pins to enable transparent mode after reset */
-    ret = Calypso_SetApplicationModePins(Calypso_ApplicationMode_TransparentMode);
-    Calypso_Examples_Print("Set app mode pins to transparent mode", ret);
-
-
-    /* Reset Calypso (will enter transparent mode after restart) */
-    ret = Calypso_PinReset();
-    Calypso_Examples_Print("Reset Calypso", ret);
-
-    /* Must wait for startup */
-    WE_Delay(2000);
+    /* Set app mode pins, reset Calypso (will enter transparent mode after restart) and start the
+     * data pump. The UART trigger settings (trigger, timeout, ETX) are written before the restart. */
+    Calypso_TransparentMode_Settings_t settings;
+    settings.trigger = transparentModeExampleTrigger;
+    settings.timeoutMs = transparentModeExampleTriggerTimeoutMs;
+    settings.etx[0] = transparentModeExampleEtx1;
+    settings.etx[1] = transparentModeExampleEtx2;
+    settings.powerSave = transparentModeExamplePowerSave;
+    ret = Calypso_TransparentMode_Start(&settings, true, 2000);
+    Calypso_Examples_Print("Start transparent mode", ret);
 
     /* Wait for connection of WLAN and socket (wait for status pins to turn high) */
-    printf("Will now wait for STATUS_IND_0 pin to turn high (WLAN connected)...\r\n");
-    while (WE_Pin_Level_Low == Calypso_GetPinLevel(Calypso_Pin_StatusInd0))
+    printf("Will now wait for STATUS_IND_0 and STATUS_IND_1 pins to turn high (WLAN and socket connected)...\r\n");
+    while (!Calypso_TransparentMode_WaitForConnection(1000))
     {
     }
-    Calypso_Examples_Print("Wait for STATUS_IND_0 pin to turn high", true);
-
-    printf("Will now wait for STATUS_IND_1 pin to turn high (socket connected)...\r\n");
-    while (WE_Pin_Level_Low == Calypso_GetPinLevel(Calypso_Pin_StatusInd1))
-    {
-    }
-    Calypso_Examples_Print("Wait for STATUS_IND_1 pin to turn high", true);
-
+    Calypso_Examples_Print("Wait for connection", true);
 
     char payload[CALYPSO_TRANSPARENT_MODE_EXAMPLE_MAX_PAYLOAD_SIZE];
-    transparentModeExampleBytesReceived = 0;
-    transparentModeExampleLineReceived = false;
-
-    /* Set byte received callback. This circumvents the SDK's regular processing of
-     * incoming data (which the SDK would interpret as AT commands / responses) and
-     * instead calls the custom callback for every byte received. */
-    Calypso_SetByteRxCallback(Calypso_TransparentModeExampleByteHandler);
-
+    uint8_t rxBuffer[CALYPSO_TRANSPARENT_MODE_EXAMPLE_MAX_PAYLOAD_SIZE + 1];
     uint16_t counter = 0;
 
     /* Start data transmission. In this example, it is assumed that the peer will
-     * send a response for each line sent by this device. Additionally, it is assumed
-     * that the response is terminated the same way as the request (i.e. one or two
-     * ETX characters). If the response is not terminated using the ETX character(s),
-     * it is assumed that all data has been received if a timeout is reached. */
+     * send a response for each line sent by this device. All data received until
+     * transparentModeExampleRxTimeoutMs is printed. */
     while (true)
     {
         sprintf(payload, "Hello Calypso (%u)!", counter++);
 
-        /* Reset tick value to check for rx timeout */
-        transparentModeExampleLastByteReceivedTimestamp = WE_GetTick();
-
-        if (transparentModeExamplePowerSave)
-        {
-            /* Wake up Calypso so that it can forward the data that we are about to send */
-            Calypso_PinWakeUp();
-
-            /* Guard interval is required before sending data (wake-up signal is HIGH for 5ms + 5ms delay = 10ms in total)  */
-            WE_Delay(5);
-        }
-
-        /* Transmit payload (plain data, directly written to UART) */
-        Calypso_Transmit(payload, strlen(payload));
-
-        /* Transmit ETX character(s), if enabled */
-        if (0 != (transparentModeExampleTrigger & ATDevice_TransparentModeUartTrigger_OneETX) ||
-                0 != (transparentModeExampleTrigger & ATDevice_TransparentModeUartTrigger_TwoETX))
-        {
-            Calypso_Transmit(&transparentModeExampleEtx1, 1);
-        }
-        if (0 != (transparentModeExampleTrigger & ATDevice_TransparentModeUartTrigger_TwoETX))
-        {
-            Calypso_Transmit(&transparentModeExampleEtx2, 1);
-        }
+        /* Transmit payload followed by the ETX character(s) (if enabled). Is sent via DMA,
+         * the function returns immediately. */
+        Calypso_TransparentMode_WritePacket((uint8_t *) payload, strlen(payload));
 
-        /* Wait until either a complete line has been received (ETX character(s) have been
-         * detected) or no bytes have been received for transparentModeExampleRxTimeoutMs
-         * milliseconds. */
-        while (!transparentModeExampleLineReceived &&
-                (WE_GetTick() - transparentModeExampleLastByteReceivedTimestamp) < transparentModeExampleRxTimeoutMs)
+        /* Collect response */
+        uint16_t bytesReceived = 0;
+        uint32_t t0 = WE_GetTick();
+        while ((WE_GetTick() - t0) < transparentModeExampleRxTimeoutMs &&
+                bytesReceived < CALYPSO_TRANSPARENT_MODE_EXAMPLE_MAX_PAYLOAD_SIZE)
         {
+            bytesReceived += Calypso_TransparentMode_Read(&rxBuffer[bytesReceived], CALYPSO_TRANSPARENT_MODE_EXAMPLE_MAX_PAYLOAD_SIZE - bytesReceived);
         }
 
         /* Print received text (if any) */
-        if (transparentModeExampleBytesReceived > 0)
+        if (bytesReceived > 0)
         {
-            transparentModeExampleRxBuffer[transparentModeExampleBytesReceived] = '\0';
-            printf("Received \"%s\"\r\n", transparentModeExampleRxBuffer);
+            rxBuffer[bytesReceived] = '\0';
+            printf("Received \"%s\"\r\n", rxBuffer);
         }
 
-        transparentModeExampleBytesReceived = 0;
-        transparentModeExampleLineReceived = false;
+        /* Print throughput counters */
+        Calypso_TransparentMode_Statistics_t statistics;
+        Calypso_TransparentMode_GetStatistics(&statistics);
+        printf("Sent %lu bytes, received %lu bytes, dropped %lu bytes in %lu ms\r\n",
+               (unsigned long) statistics.bytesSent,
+               (unsigned long) statistics.bytesReceived,
+               (unsigned long) statistics.bytesDropped,
+               (unsigned long) statistics.elapsedMs);
 
         /* 1s delay */
         WE_Delay(1000);
 
         /* Check if still connected */
-        if (WE_Pin_Level_Low == Calypso_GetPinLevel(Calypso_Pin_StatusInd0) ||
-            WE_Pin_Level_Low == Calypso_GetPinLevel(Calypso_Pin_StatusInd1))
+        if (!Calypso_TransparentMode_IsConnected())
         {
             printf("ERROR: Connection to peer lost (WLAN or socket disconnected). Will now wait for reconnect.\r\n");
-            while (WE_Pin_Level_Low == Calypso_GetPinLevel(Calypso_Pin_StatusInd0) ||
-                   WE_Pin_Level_Low == Calypso_GetPinLevel(Calypso_Pin_StatusInd1))
+            while (!Calypso_TransparentMode_WaitForConnection(1000))
             {
             }
             printf("Reconnected!\r\n");
@@ -367,45 +289,6 @@ void Calypso_TransparentMode_Example(void)
         }
     }
 
+    Calypso_TransparentMode_Stop(1000);
     Calypso_Deinit();
 }
-
-/**
- * @brief Is called when a byte has been received in transparent mode.
- */
-void Calypso_TransparentModeExampleByteHandler(uint8_t byte)
-{
-    if (transparentModeExampleLineReceived)
-    {
-        /* Ignore all received data until the previous line has been read */
-        return;
-    }
-
-    /* Store current tick value for checking timeout (see Calypso_TransparentMode_Example()) */
-    transparentModeExampleLastByteReceivedTimestamp = WE_GetTick();
-
-    if (transparentModeExampleBytesReceived < CALYPSO_TRANSPARENT_MODE_EXAMPLE_MAX_PAYLOAD_SIZE)
-    {
-        /* Store received byte in rx buffer */
-        transparentModeExampleRxBuffer[transparentModeExampleBytesReceived] = byte;
-        transparentModeExampleBytesReceived++;
-
-        /* Check if line is complete and set flag if so */
-        if (0 != (transparentModeExampleTrigger & ATDevice_TransparentModeUartTrigger_OneETX))
-        {
-            if (byte == transparentModeExampleEtx1)
-            {
-                transparentModeExampleLineReceived = true;
-            }
-        }
-        else if (0 != (transparentModeExampleTrigger & ATDevice_TransparentModeUartTrigger_TwoETX) &&
-                transparentModeExampleBytesReceived > 1)
-        {
-            if (byte == transparentModeExampleEtx2 &&
-                    transparentModeExampleRxBuffer[transparentModeExampleBytesReceived - 2] == transparentModeExampleEtx1)
-            {
-                transparentModeExampleLineReceived = true;
-            }
-        }
-    }
-}
@@ -34,6 +34,8 @@
 
 #include <Calypso/ATCommands/ATDevice.h>
 #include <Calypso/ATCommands/ATWLAN.h>
+#include <Calypso/Calypso_WLANReconnect.h>
+#include <Calypso/Calypso_WLANScan.h>
 
 #include "Calypso_Examples.h"
 
@@ -51,7 +53,7 @@ void Calypso_WLAN_Example(void)
 
     Calypso_PinReset();
 
-    WE_Delay(2000);
+    Calypso_WaitForStartup(5000);
 
     bool ret = false;
 
@@ -68,7 +70,7 @@ void Calypso_WLAN_Example(void)
     ret = ATDevice_Restart(0);
     Calypso_Examples_Print("Restart network processor", ret);
 
-    WE_Delay(1000);
+    Calypso_Examples_Delay(1000);
 
     ATWLAN_ScanEntry_t scanEntries[15];
     uint8_t numEntries;
@@ -77,12 +79,33 @@ void Calypso_WLAN_Example(void)
      * second scan should return the discovered networks */
     ATWLAN_Scan(0, 15, scanEntries, &numEntries);
 
-    WE_Delay(200);
+    Calypso_Examples_Delay(200);
 
     ret = ATWLAN_Scan(0, 15, scanEntries, &numEntries);
     Calypso_Examples_Print("Scan WLAN networks", ret);
 
-    WE_Delay(200);
+    Calypso_Examples_Delay(200);
+
+    /* Streaming scan - the results of multiple scans are collected in a table indexed by BSSID */
+    Calypso_WLANScan_Init();
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        uint16_t numReceived;
+        ret = Calypso_WLANScan_Scan(&numReceived);
+        Calypso_Examples_Print("Scan WLAN networks (streamed)", ret);
+        Calypso_Examples_Delay(1000);
+    }
+
+    for (uint16_t i = 0; i < Calypso_WLANScan_GetCount(); i++)
+    {
+        Calypso_WLANScan_Entry_t entry;
+        if (Calypso_WLANScan_GetEntry(i, &entry))
+        {
+            printf("%02x:%02x:%02x:%02x:%02x:%02x ch %u RSSI %d dBm (avg. %d dBm, seen %u times) %s\r\n",
+                   entry.BSSID[0], entry.BSSID[1], entry.BSSID[2], entry.BSSID[3], entry.BSSID[4], entry.BSSID[5],
+                   entry.channel, entry.RSSI, entry.RSSISmoothed, entry.seenCount, entry.SSID);
+        }
+    }
 
     /* Connect to WLAN */
     ATWLAN_ConnectionArguments_t connectArgs;
@@ -94,12 +117,39 @@ void Calypso_WLAN_Example(void)
     ret = ATWLAN_Connect(connectArgs);
     Calypso_Examples_Print("Connect to WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     ret = ATWLAN_Disconnect();
     Calypso_Examples_Print("Disconnect from WLAN", ret);
 
-    WE_Delay(500);
+    Calypso_Examples_Delay(500);
+
+
+    /* Connect using the fast reconnect manager - the first connection scans for the network,
+     * the second connection uses the recorded access point (BSSID) */
+    Calypso_WLANReconnect_Init();
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        Calypso_WLANReconnect_Path_t path;
+        ret = Calypso_WLANReconnect_Connect(&connectArgs, 10000, &path);
+        Calypso_Examples_Print("Connect to WLAN (fast reconnect)", ret);
+
+        ret = ATWLAN_Disconnect();
+        Calypso_Examples_Print("Disconnect from WLAN", ret);
+
+        Calypso_Examples_Delay(500);
+    }
+
+    Calypso_WLANReconnect_Statistics_t reconnectStatistics;
+    Calypso_WLANReconnect_GetStatistics(&reconnectStatistics);
+    for (uint8_t i = 0; i < Calypso_WLANReconnect_Path_NumberOfValues; i++)
+    {
+        printf("Reconnect path %u: %lu of %lu attempts successful, last time to IP %lu ms\r\n",
+               i,
+               reconnectStatistics.paths[i].successes,
+               reconnectStatistics.paths[i].attempts,
+               reconnectStatistics.paths[i].lastTimeToIpMs);
+    }
 
 
     /* Set connection policy to AUTO */
@@ -115,12 +165,12 @@ void Calypso_WLAN_Example(void)
     ret = ATWLAN_AddProfile(profile, &profileIndex);
     Calypso_Examples_Print("Add WLAN profile", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     ret = ATWLAN_Disconnect();
     Calypso_Examples_Print("Disconnect from WLAN", ret);
 
-    WE_Delay(2000);
+    Calypso_Examples_Delay(2000);
 
     ret = ATDevice_Reboot();
     Calypso_Examples_Print("Reboot", ret);
@@ -130,7 +180,7 @@ void Calypso_WLAN_Example(void)
     ret = ATWLAN_GetProfile(profileIndex, &profile);
     Calypso_Examples_Print("Get WLAN profile", ret);
 
-    WE_Delay(500);
+    Calypso_Examples_Delay(500);
 
     ret = ATWLAN_DeleteProfile(profileIndex);
     Calypso_Examples_Print("Delete WLAN profile", ret);
@@ -0,0 +1,614 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Automatic channel selection for Thyone-I and the proprietary radio modules source file.
+ */
+
+#include "ChannelSelection.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../global/global.h"
+
+#define MSG_SWITCH        0xD0
+#define MSG_PROBE         0xD1
+#define MSG_SEARCH        0xD2
+#define MSG_BEACON        0xD3
+#define MSG_SWITCH_LENGTH 5
+#define MSG_BEACON_LENGTH 2
+
+#define COST_INVALID 0xFFFF
+
+typedef struct ChannelSelection_Channel_t
+{
+    uint8_t channel;
+    bool measured;
+    uint16_t failEwma;              /* TX failure rate in per mille */
+    uint16_t interferenceEwma;      /* interference level in per mille */
+} ChannelSelection_Channel_t;
+
+/**************************************
+ *          Static variables          *
+ **************************************/
+
+static ChannelSelection_Interface_t interface = { NULL, NULL };
+static ChannelSelection_Role_t role = ChannelSelection_Role_Node;
+static ChannelSelection_Channel_t channelList[CHANNELSELECTION_MAX_CHANNELS];
+static uint8_t channelCount = 0;
+static uint8_t currentChannel = 0;
+static int currentIndex = -1;
+static int probeIndex = 0;
+static uint32_t lastProbeTick = 0;
+static uint32_t lastSwitchTick = 0;
+static uint8_t switchSeq = 0;
+
+/* statistics of the channel that is currently measured */
+static uint16_t txCount = 0;
+static uint16_t txFailCount = 0;
+static volatile uint16_t rxForeignCount = 0;   /* written in the RX callback */
+static volatile uint32_t rxForeignLevelSum = 0; /* written in the RX callback */
+static volatile bool probing = false;
+
+/* pending channel switch */
+static volatile bool switchPending = false;
+static volatile uint8_t switchChannel = 0;
+static volatile uint32_t switchTick = 0;
+static volatile int lastSwitchSeq = -1;
+
+/* search for the coordinator after it has been lost (node) */
+static uint8_t txFailStreak = 0;
+static volatile bool scanning = false;
+static int scanIndex = -1;
+static uint32_t scanTick = 0;
+static volatile int beaconChannel = -1;        /* written in the RX callback */
+
+/* search message received, to be answered from ChannelSelection_Process (coordinator) */
+static volatile bool searchReceived = false;
+
+/**************************************
+ *         Static functions           *
+ **************************************/
+
+/**
+ * @brief Get the index of a channel in the candidate list
+ */
+static int FindChannel(uint8_t channel)
+{
+    int i = 0;
+    for (i = 0; i < channelCount; i++)
+    {
+        if (channelList[i].channel == channel)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Moving average with a weight of 1/8 for the new sample
+ */
+static uint16_t Ewma(uint16_t average, uint16_t sample)
+{
+    return (uint16_t)((7 * (uint32_t)average + sample) / 8);
+}
+
+/**
+ * @brief Reset the statistics of the measured channel
+ */
+static void ResetCounters(void)
+{
+    txCount = 0;
+    txFailCount = 0;
+    rxForeignCount = 0;
+    rxForeignLevelSum = 0;
+}
+
+/**
+ * @brief Add the collected statistics to the scores of a channel
+ */
+static void FoldCounters(int index)
+{
+    if (index < 0)
+    {
+        ResetCounters();
+        return;
+    }
+
+    ChannelSelection_Channel_t* entry = &channelList[index];
+    uint16_t rxCount = rxForeignCount;
+    uint32_t levelSum = rxForeignLevelSum;
+    uint16_t interference = (rxCount > 0) ? (uint16_t)(levelSum / rxCount) : 0;
+
+    if (!entry->measured)
+    {
+        entry->failEwma = (txCount > 0) ? (uint16_t)((uint32_t)txFailCount * 1000 / txCount) : 0;
+        entry->interferenceEwma = interference;
+        entry->measured = true;
+    }
+    else
+    {
+        if (txCount > 0)
+        {
+            entry->failEwma = Ewma(entry->failEwma, (uint16_t)((uint32_t)txFailCount * 1000 / txCount));
+        }
+        entry->interferenceEwma = Ewma(entry->interferenceEwma, interference);
+    }
+    ResetCounters();
+}
+
+/**
+ * @brief Cost of a channel in per mille (lower is better)
+ */
+static uint16_t Cost(int index)
+{
+    if ((index < 0) || !channelList[index].measured)
+    {
+        return COST_INVALID;
+    }
+    return (channelList[index].failEwma + channelList[index].interferenceEwma) / 2;
+}
+
+/**
+ * @brief Measure a candidate channel (coordinator only)
+ */
+static void Probe(int index)
+{
+    uint8_t probe = MSG_PROBE;
+    int i = 0;
+
+    if (false == interface.setChannel(channelList[index].channel))
+    {
+        return;
+    }
+    ResetCounters();
+    probing = true;
+
+    for (i = 0; i < CHANNELSELECTION_PROBE_FRAMES; i++)
+    {
+        ChannelSelection_ReportTx(interface.transmitBroadcast(&probe, 1));
+    }
+    /* listen for other networks */
+    WE_Delay(CHANNELSELECTION_PROBE_DWELL);
+
+    probing = false;
+    FoldCounters(index);
+
+    if (false == interface.setChannel(currentChannel))
+    {
+        fprintf(stdout, "Return to channel %u failed\n", currentChannel);
+    }
+}
+
+/**
+ * @brief Transmit the announcement of the pending channel switch (coordinator only)
+ *
+ * @return true if the announcement has been transmitted,
+ *         false if the switch is due
+ */
+static bool TransmitSwitch(void)
+{
+    uint8_t msg[MSG_SWITCH_LENGTH];
+
+    /* each announcement carries the remaining time */
+    int32_t remaining = (int32_t)(switchTick - WE_GetTick());
+    if (remaining <= 0)
+    {
+        return false;
+    }
+    msg[0] = MSG_SWITCH;
+    msg[1] = switchSeq;
+    msg[2] = switchChannel;
+    msg[3] = (uint8_t)remaining;
+    msg[4] = (uint8_t)(remaining >> 8);
+    interface.transmitBroadcast(msg, sizeof(msg));
+    return true;
+}
+
+/**
+ * @brief Announce a channel switch to all nodes (coordinator only)
+ */
+static void AnnounceSwitch(uint8_t channel)
+{
+    int i = 0;
+
+    switchSeq++;
+    switchChannel = channel;
+    switchTick = WE_GetTick() + CHANNELSELECTION_SWITCH_DELAY;
+    switchPending = true;
+
+    for (i = 0; i < CHANNELSELECTION_SWITCH_REPEAT; i++)
+    {
+        if (!TransmitSwitch())
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Answer the search of a lost node with the channel of the network (coordinator only)
+ *
+ * While a switch is pending, the node gets the announcement instead, so it follows the switch.
+ */
+static void AnswerSearch(void)
+{
+    uint8_t msg[MSG_BEACON_LENGTH];
+
+    if (switchPending && TransmitSwitch())
+    {
+        return;
+    }
+    msg[0] = MSG_BEACON;
+    msg[1] = currentChannel;
+    interface.transmitBroadcast(msg, sizeof(msg));
+}
+
+/**
+ * @brief Continue on a channel after a switch or after the coordinator has been found (node)
+ */
+static void UseChannel(uint8_t channel, uint32_t now)
+{
+    currentChannel = channel;
+    currentIndex = FindChannel(channel);
+    lastProbeTick = now;
+    scanning = false;
+    txFailStreak = 0;
+    ResetCounters();
+}
+
+/**
+ * @brief Search the candidate channels for the coordinator (node only)
+ */
+static void Scan(uint32_t now)
+{
+    int found = beaconChannel;
+
+    if (found >= 0)
+    {
+        beaconChannel = -1;
+        /* the beacon might have been received shortly before leaving the scanned channel */
+        if ((scanIndex < 0) || (channelList[scanIndex].channel != (uint8_t)found))
+        {
+            if (false == interface.setChannel((uint8_t)found))
+            {
+                return;
+            }
+        }
+        fprintf(stdout, "Found coordinator on channel %u\n", (uint8_t)found);
+        UseChannel((uint8_t)found, now);
+        return;
+    }
+
+    if (now - scanTick < CHANNELSELECTION_SCAN_DWELL)
+    {
+        return;
+    }
+    scanTick = now;
+    scanIndex = (scanIndex + 1) % channelCount;
+    if (interface.setChannel(channelList[scanIndex].channel))
+    {
+        uint8_t search = MSG_SEARCH;
+        interface.transmitBroadcast(&search, 1);
+    }
+}
+
+/**************************************
+ *         Global functions           *
+ **************************************/
+
+/**
+ * @brief Initialize the channel selection
+ *
+ * @param[in] role: coordinator (probes and decides) or node (follows)
+ * @param[in] channels: candidate channels
+ * @param[in] channel_count: number of candidate channels
+ * @param[in] current_channel: channel the module is currently using
+ * @param[in] iface: module specific functions
+ *
+ * @return true if initialization succeeded,
+ *         false otherwise
+ */
+bool ChannelSelection_Init(ChannelSelection_Role_t role_, const uint8_t* channels, uint8_t channel_count, uint8_t current_channel, const ChannelSelection_Interface_t* iface)
+{
+    int i = 0;
+
+    if ((iface == NULL) || (iface->setChannel == NULL) || (iface->transmitBroadcast == NULL) ||
+        (channels == NULL) || (channel_count == 0) || (channel_count > CHANNELSELECTION_MAX_CHANNELS))
+    {
+        return false;
+    }
+
+    interface = *iface;
+    role = role_;
+    channelCount = channel_count;
+    memset(channelList, 0, sizeof(channelList));
+    for (i = 0; i < channel_count; i++)
+    {
+        channelList[i].channel = channels[i];
+    }
+    currentChannel = current_channel;
+    currentIndex = FindChannel(current_channel);
+    probeIndex = 0;
+    lastProbeTick = WE_GetTick();
+    lastSwitchTick = lastProbeTick - CHANNELSELECTION_MIN_SWITCH_INTERVAL;
+    switchPending = false;
+    lastSwitchSeq = -1;
+    probing = false;
+    txFailStreak = 0;
+    scanning = false;
+    beaconChannel = -1;
+    searchReceived = false;
+    ResetCounters();
+    return true;
+}
+
+/**
+ * @brief Report the result of a transmission on the current channel
+ *
+ * @param[in] success: false if the module reported a failed transmission (e.g. channel busy)
+ */
+void ChannelSelection_ReportTx(bool success)
+{
+    if (txCount < 0xFFFF)
+    {
+        txCount++;
+        if (!success)
+        {
+            txFailCount++;
+        }
+    }
+
+    /* a node that keeps failing has probably missed a channel switch */
+    if ((role == ChannelSelection_Role_Node) && !scanning)
+    {
+        if (success)
+        {
+            txFailStreak = 0;
+        }
+        else if (++txFailStreak >= CHANNELSELECTION_LOST_TX_FAILURES)
+        {
+            ChannelSelection_Rescan();
+        }
+    }
+}
+
+/**
+ * @brief Report a received frame, call from the RX callback of the driver
+ *
+ * @param[in] rssi: RSSI of the frame
+ * @param[in] own_network: true if the frame belongs to the own network (no interference)
+ */
+void ChannelSelection_ReportRx(int8_t rssi, bool own_network)
+{
+    if (own_network && !probing)
+    {
+        return;
+    }
+
+    int32_t level = ((int32_t)rssi - CHANNELSELECTION_RSSI_FLOOR) * 1000 / (CHANNELSELECTION_RSSI_CEILING - CHANNELSELECTION_RSSI_FLOOR);
+    if (level < 0)
+    {
+        level = 0;
+    }
+    else if (level > 1000)
+    {
+        level = 1000;
+    }
+
+    if (rxForeignCount < 0xFFFF)
+    {
+        rxForeignCount++;
+        rxForeignLevelSum += (uint32_t)level;
+    }
+}
+
+/**
+ * @brief Handle a received packet, call from the RX callback of the driver
+ *
+ * @param[in] payload: pointer to the received packet
+ * @param[in] length: length of the received packet
+ *
+ * @return true if the packet belongs to the channel selection,
+ *         false otherwise
+ */
+bool ChannelSelection_HandleRx(uint8_t* payload, uint16_t length)
+{
+    if ((length == 1) && (payload[0] == MSG_PROBE))
+    {
+        return true;
+    }
+
+    if ((length == 1) && (payload[0] == MSG_SEARCH))
+    {
+        if (role == ChannelSelection_Role_Coordinator)
+        {
+            searchReceived = true;
+        }
+        return true;
+    }
+
+    if ((length == MSG_BEACON_LENGTH) && (payload[0] == MSG_BEACON))
+    {
+        if ((role == ChannelSelection_Role_Node) && scanning)
+        {
+            beaconChannel = payload[1];
+        }
+        return true;
+    }
+
+    if ((length != MSG_SWITCH_LENGTH) || (payload[0] != MSG_SWITCH))
+    {
+        return false;
+    }
+
+    /* nodes follow the first announcement of each switch */
+    if ((role == ChannelSelection_Role_Node) && (payload[1] != lastSwitchSeq))
+    {
+        lastSwitchSeq = payload[1];
+        switchChannel = payload[2];
+        switchTick = WE_GetTick() + ((uint16_t)payload[3] | ((uint16_t)payload[4] << 8));
+        switchPending = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Update the scores, probe the channels and perform pending switches
+ *
+ * Call this function cyclically from the main loop.
+ */
+void ChannelSelection_Process(void)
+{
+    uint32_t now = WE_GetTick();
+
+    if (searchReceived)
+    {
+        searchReceived = false;
+        AnswerSearch();
+    }
+
+    if (switchPending)
+    {
+        if ((int32_t)(now - switchTick) >= 0)
+        {
+            switchPending = false;
+            if (interface.setChannel(switchChannel))
+            {
+                fprintf(stdout, "Switched from channel %u to %u\n", currentChannel, switchChannel);
+                UseChannel(switchChannel, now);
+                lastSwitchTick = now;
+            }
+        }
+        return;
+    }
+
+    if (scanning)
+    {
+        Scan(now);
+        return;
+    }
+
+    if (now - lastProbeTick < CHANNELSELECTION_PROBE_INTERVAL)
+    {
+        return;
+    }
+    lastProbeTick = now;
+
+    /* rate the current channel by the traffic since the last interval */
+    FoldCounters(currentIndex);
+
+    if ((role != ChannelSelection_Role_Coordinator) || (channelCount < 2))
+    {
+        return;
+    }
+
+    /* probe the next candidate channel */
+    do
+    {
+        probeIndex = (probeIndex + 1) % channelCount;
+    } while (probeIndex == currentIndex);
+    Probe(probeIndex);
+
+    /* move the network if another channel is clearly better */
+    int best = -1;
+    int i = 0;
+    for (i = 0; i < channelCount; i++)
+    {
+        if ((Cost(i) != COST_INVALID) && ((best < 0) || (Cost(i) < Cost(best))))
+        {
+            best = i;
+        }
+    }
+    if ((best >= 0) && (best != currentIndex) &&
+        ((Cost(currentIndex) == COST_INVALID) || (Cost(currentIndex) >= Cost(best) + CHANNELSELECTION_HYSTERESIS)) &&
+        (WE_GetTick() - lastSwitchTick >= CHANNELSELECTION_MIN_SWITCH_INTERVAL))
+    {
+        AnnounceSwitch(channelList[best].channel);
+    }
+}
+
+/**
+ * @brief Search the candidate channels for the coordinator (node only)
+ *
+ * Called automatically after CHANNELSELECTION_LOST_TX_FAILURES consecutive failed
+ * transmissions. Applications that detect the loss of the coordinator otherwise
+ * (e.g. missing replies) can start the search themselves.
+ */
+void ChannelSelection_Rescan(void)
+{
+    if ((role != ChannelSelection_Role_Node) || scanning)
+    {
+        return;
+    }
+    beaconChannel = -1;
+    scanIndex = currentIndex;
+    scanTick = WE_GetTick() - CHANNELSELECTION_SCAN_DWELL;
+    scanning = true;
+}
+
+/**
+ * @brief Check if the node is searching for the coordinator
+ *
+ * @return true if the candidate channels are being scanned,
+ *         false otherwise
+ */
+bool ChannelSelection_IsScanning(void)
+{
+    return scanning;
+}
+
+/**
+ * @brief Get the channel currently used
+ *
+ * @return channel
+ */
+uint8_t ChannelSelection_GetChannel(void)
+{
+    return currentChannel;
+}
+
+/**
+ * @brief Get the cost of a candidate channel
+ *
+ * @param[in] channel: channel
+ * @param[out] cost: cost in per mille (0: free, 1000: unusable)
+ *
+ * @return true if the channel has been measured,
+ *         false otherwise
+ */
+bool ChannelSelection_GetCost(uint8_t channel, uint16_t* cost)
+{
+    int index = FindChannel(channel);
+    if (Cost(index) == COST_INVALID)
+    {
+        return false;
+    }
+    *cost = Cost(index);
+    return true;
+}
@@ -0,0 +1,139 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Automatic channel selection for Thyone-I and the proprietary radio modules header file.
+ *
+ * A per-channel quality score is kept as exponentially weighted moving average (EWMA) of
+ * - the TX failure rate (failed TX complete / DATA_CNF, e.g. channel busy with CCA/LBT) and
+ * - the interference level (RSSI of frames received from other networks).
+ *
+ * The current channel is rated by the regular traffic. The coordinator additionally probes
+ * the other candidate channels one by one: it switches to the channel, transmits a few probe
+ * frames and listens for a short dwell time. If another channel is clearly better, the
+ * coordinator announces the switch to all nodes with a broadcast message and all nodes
+ * change the channel at the same time.
+ *
+ * The announcements are not acknowledged. A node that missed all of them notices the loss of
+ * the coordinator by CHANNELSELECTION_LOST_TX_FAILURES consecutive failed transmissions (as
+ * reported by ChannelSelection_ReportTx) or by a call of ChannelSelection_Rescan. It then scans
+ * the candidate channels: on each channel it broadcasts a search message and listens for
+ * CHANNELSELECTION_SCAN_DWELL ms. The coordinator answers with a beacon containing its channel
+ * (or with the pending switch announcement), and the node continues on that channel.
+ *
+ * The module specific functions are passed at initialization, e.g.
+ * ThyoneI_SetRFChannelRuntime or TarvosIII_SetVolatile_Channel and a broadcast transmit
+ * function (ThyoneI_TransmitBroadcast, TarvosIII_Transmit with broadcast destination).
+ *
+ * Switch message: marker (1 byte, 0xD0), sequence number (1 byte), new channel (1 byte), delay in ms (2 bytes, little endian)
+ * Search message: marker (1 byte, 0xD2)
+ * Beacon message: marker (1 byte, 0xD3), channel of the coordinator (1 byte)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CHANNELSELECTION_H_INCLUDED
+#define CHANNELSELECTION_H_INCLUDED
+
+#define CHANNELSELECTION_MAX_CHANNELS 16
+
+/* interval between two probes of the candidate channels in ms */
+#ifndef CHANNELSELECTION_PROBE_INTERVAL
+#define CHANNELSELECTION_PROBE_INTERVAL 10000
+#endif
+
+/* number of probe frames and listening time per probe */
+#ifndef CHANNELSELECTION_PROBE_FRAMES
+#define CHANNELSELECTION_PROBE_FRAMES 3
+#endif
+#ifndef CHANNELSELECTION_PROBE_DWELL
+#define CHANNELSELECTION_PROBE_DWELL 50
+#endif
+
+/* improvement of the cost (in per mille) required to move the network to another channel */
+#ifndef CHANNELSELECTION_HYSTERESIS
+#define CHANNELSELECTION_HYSTERESIS 150
+#endif
+
+/* minimum time between two channel switches in ms */
+#ifndef CHANNELSELECTION_MIN_SWITCH_INTERVAL
+#define CHANNELSELECTION_MIN_SWITCH_INTERVAL 60000
+#endif
+
+/* delay between the switch announcement and the switch in ms, and number of announcements */
+#ifndef CHANNELSELECTION_SWITCH_DELAY
+#define CHANNELSELECTION_SWITCH_DELAY 500
+#endif
+#ifndef CHANNELSELECTION_SWITCH_REPEAT
+#define CHANNELSELECTION_SWITCH_REPEAT 3
+#endif
+
+/* number of consecutive failed transmissions after which a node scans for the coordinator */
+#ifndef CHANNELSELECTION_LOST_TX_FAILURES
+#define CHANNELSELECTION_LOST_TX_FAILURES 5
+#endif
+
+/* listening time per channel when scanning for the coordinator in ms */
+#ifndef CHANNELSELECTION_SCAN_DWELL
+#define CHANNELSELECTION_SCAN_DWELL 200
+#endif
+
+/* RSSI range mapped to an interference level of 0..1000 per mille */
+#define CHANNELSELECTION_RSSI_FLOOR   -100
+#define CHANNELSELECTION_RSSI_CEILING -40
+
+typedef enum ChannelSelection_Role_t
+{
+    ChannelSelection_Role_Node = 0x00,          /* follows the switch messages */
+    ChannelSelection_Role_Coordinator = 0x01,   /* probes the channels and decides about switches */
+} ChannelSelection_Role_t;
+
+typedef struct ChannelSelection_Interface_t
+{
+    bool (*setChannel)(uint8_t channel);                    /* e.g. ThyoneI_SetRFChannelRuntime */
+    bool (*transmitBroadcast)(uint8_t* payload, uint16_t length);
+} ChannelSelection_Interface_t;
+
+extern bool ChannelSelection_Init(ChannelSelection_Role_t role, const uint8_t* channels, uint8_t channel_count, uint8_t current_channel, const ChannelSelection_Interface_t* iface);
+extern void ChannelSelection_ReportTx(bool success);
+extern void ChannelSelection_ReportRx(int8_t rssi, bool own_network);
+extern bool ChannelSelection_HandleRx(uint8_t* payload, uint16_t length);
+extern void ChannelSelection_Process(void);
+extern void ChannelSelection_Rescan(void);
+extern bool ChannelSelection_IsScanning(void);
+extern uint8_t ChannelSelection_GetChannel(void);
+extern bool ChannelSelection_GetCost(uint8_t channel, uint16_t* cost);
+
+#endif // CHANNELSELECTION_H_INCLUDED
+
+#ifdef __cplusplus
+}
+#endif
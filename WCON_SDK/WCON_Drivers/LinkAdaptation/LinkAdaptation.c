@@ -0,0 +1,445 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Adaptive TX power and RF profile per link for the proprietary radio modules source file.
+ */
+
+#include "LinkAdaptation.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../global/global.h"
+
+#if (LINKADAPTATION_RX_QUEUE_LENGTH & (LINKADAPTATION_RX_QUEUE_LENGTH - 1)) != 0
+#error "LINKADAPTATION_RX_QUEUE_LENGTH must be a power of two"
+#endif
+
+#define POWER_INVALID   0x7FFF
+#define PROFILE_INVALID 0xFFFF
+
+typedef struct LinkAdaptation_Link_t
+{
+    uint32_t address;
+    bool used;
+    uint32_t lastTick;
+    bool pathLossValid;
+    int16_t pathLoss;           /* path loss in 1/16 dB */
+    uint8_t level;
+    uint16_t successes;         /* successful transmissions since the last level change */
+    uint8_t failures;           /* failed transmissions in a row */
+    uint8_t penalty;            /* extra margin in dB */
+    uint8_t penaltyCredit;      /* successful transmissions since the last penalty decay */
+} LinkAdaptation_Link_t;
+
+typedef struct LinkAdaptation_RxReport_t
+{
+    uint32_t address;
+    int8_t rssi;
+    int8_t peerTXPower;
+} LinkAdaptation_RxReport_t;
+
+/**************************************
+ *          Static variables          *
+ **************************************/
+
+static LinkAdaptation_Interface_t interface = { NULL, NULL, NULL, NULL };
+static LinkAdaptation_Level_t ladder[LINKADAPTATION_MAX_LEVELS];
+static uint8_t levelCount = 0;
+static LinkAdaptation_Link_t links[LINKADAPTATION_MAX_LINKS];
+
+/* settings of the module */
+static int16_t appliedPower = POWER_INVALID;
+static uint16_t appliedProfile = PROFILE_INVALID;
+static uint32_t lastProfileTick = 0;
+
+/* RSSI reports from the UART interrupt, processed in LinkAdaptation_Process */
+static LinkAdaptation_RxReport_t rxQueue[LINKADAPTATION_RX_QUEUE_LENGTH];
+static volatile uint8_t rxQueueHead = 0;      /* written by ReportRx only */
+static volatile uint8_t rxQueueTail = 0;      /* written by Process only */
+
+/**************************************
+ *         Static functions           *
+ **************************************/
+
+/**
+ * @brief Find the state of a link, optionally allocate it
+ */
+static LinkAdaptation_Link_t* GetLink(uint32_t address, bool create)
+{
+    LinkAdaptation_Link_t* candidate = NULL;
+    int i = 0;
+
+    for (i = 0; i < LINKADAPTATION_MAX_LINKS; i++)
+    {
+        if (links[i].used && (links[i].address == address))
+        {
+            return &links[i];
+        }
+    }
+
+    if (!create)
+    {
+        return NULL;
+    }
+
+    /* take a free entry or replace the least recently used link */
+    for (i = 0; i < LINKADAPTATION_MAX_LINKS; i++)
+    {
+        LinkAdaptation_Link_t* link = &links[i];
+        if (!link->used)
+        {
+            candidate = link;
+            break;
+        }
+        if ((candidate == NULL) || ((int32_t)(link->lastTick - candidate->lastTick) < 0))
+        {
+            candidate = link;
+        }
+    }
+
+    /* new links start at the most robust level */
+    memset(candidate, 0, sizeof(LinkAdaptation_Link_t));
+    candidate->used = true;
+    candidate->address = address;
+    candidate->lastTick = WE_GetTick();
+    return candidate;
+}
+
+/**
+ * @brief Predicted margin of a level in dB
+ */
+static int16_t Margin(const LinkAdaptation_Link_t* link, uint8_t level)
+{
+    return (int16_t)(ladder[level].txPower - ladder[level].sensitivity) - (link->pathLoss / 16);
+}
+
+/**
+ * @brief Change the level of a link
+ */
+static void SetLevel(LinkAdaptation_Link_t* link, uint8_t level)
+{
+    if (level != link->level)
+    {
+        link->level = level;
+        link->successes = 0;
+    }
+}
+
+/**
+ * @brief Select the level of a link according to its path loss
+ */
+static void Evaluate(LinkAdaptation_Link_t* link)
+{
+    if (!link->pathLossValid)
+    {
+        return;
+    }
+
+    /* most efficient level that keeps the target margin */
+    int16_t target = LINKADAPTATION_TARGET_MARGIN + link->penalty;
+    int best = 0;
+    int i = 0;
+    for (i = levelCount - 1; i > 0; i--)
+    {
+        if (Margin(link, i) >= target)
+        {
+            best = i;
+            break;
+        }
+    }
+
+    if (best < link->level)
+    {
+        /* path loss increased, drop immediately */
+        SetLevel(link, best);
+    }
+    else if ((best > link->level) && (link->successes >= LINKADAPTATION_PROBATION))
+    {
+        /* step up one level at a time */
+        SetLevel(link, link->level + 1);
+    }
+}
+
+/**
+ * @brief TX power for a link with the RF profile that is currently in use
+ */
+static int8_t TXPower(const LinkAdaptation_Link_t* link)
+{
+    int i = 0;
+
+    if ((interface.setRfProfile == NULL) || (ladder[link->level].profile == appliedProfile))
+    {
+        return ladder[link->level].txPower;
+    }
+
+    /* the module has not switched to the profile of the link yet, use the most robust level of the current profile */
+    for (i = 0; i < levelCount; i++)
+    {
+        if (ladder[i].profile == appliedProfile)
+        {
+            return ladder[i].txPower;
+        }
+    }
+    return ladder[link->level].txPower;
+}
+
+/**
+ * @brief Switch the module to the RF profile of the most robust level that any link needs
+ */
+static void UpdateProfile(void)
+{
+    uint8_t level = 0xFF;
+    int i = 0;
+
+    if ((interface.setRfProfile == NULL) || (WE_GetTick() - lastProfileTick < LINKADAPTATION_MIN_PROFILE_INTERVAL))
+    {
+        return;
+    }
+
+    for (i = 0; i < LINKADAPTATION_MAX_LINKS; i++)
+    {
+        if (links[i].used && (links[i].level < level))
+        {
+            level = links[i].level;
+        }
+    }
+    if ((level == 0xFF) || (ladder[level].profile == appliedProfile))
+    {
+        return;
+    }
+
+    /* the profile is stored in flash and takes effect after a reset, which also restores the default TX power */
+    lastProfileTick = WE_GetTick();
+    appliedPower = POWER_INVALID;
+    if (!interface.setRfProfile(ladder[level].profile) || !interface.reset())
+    {
+        fprintf(stdout, "Set RF profile %u failed\n", ladder[level].profile);
+        appliedProfile = PROFILE_INVALID;
+        return;
+    }
+    appliedProfile = ladder[level].profile;
+}
+
+/**
+ * @brief Add an RSSI report to the path loss of a link
+ */
+static void HandleRxReport(const LinkAdaptation_RxReport_t* report)
+{
+    LinkAdaptation_Link_t* link = GetLink(report->address, true);
+    int16_t pathLoss = (int16_t)(((int16_t)report->peerTXPower - report->rssi) * 16);
+
+    if (!link->pathLossValid)
+    {
+        link->pathLoss = pathLoss;
+        link->pathLossValid = true;
+    }
+    else
+    {
+        /* moving average with a weight of 1/4 for the new sample */
+        link->pathLoss = (int16_t)(link->pathLoss + (pathLoss - link->pathLoss) / 4);
+    }
+    link->lastTick = WE_GetTick();
+    Evaluate(link);
+}
+
+/**************************************
+ *         Global functions           *
+ **************************************/
+
+/**
+ * @brief Initialize the link adaptation
+ *
+ * @param[in] levels: ladder of settings, from the most robust to the most efficient
+ * @param[in] level_count: number of levels
+ * @param[in] iface: module specific functions
+ *
+ * @return true if initialization succeeded,
+ *         false otherwise
+ */
+bool LinkAdaptation_Init(const LinkAdaptation_Level_t* levels, uint8_t level_count, const LinkAdaptation_Interface_t* iface)
+{
+    if ((iface == NULL) || (iface->setTXPower == NULL) || (levels == NULL) ||
+        (level_count == 0) || (level_count > LINKADAPTATION_MAX_LEVELS) ||
+        ((iface->setRfProfile != NULL) && (iface->reset == NULL)))
+    {
+        return false;
+    }
+
+    interface = *iface;
+    memcpy(ladder, levels, level_count * sizeof(LinkAdaptation_Level_t));
+    levelCount = level_count;
+    memset(links, 0, sizeof(links));
+    appliedPower = POWER_INVALID;
+
+    /* start with the profile of the module, so that it is not written without need */
+    appliedProfile = ladder[0].profile;
+    if (interface.getRfProfile != NULL)
+    {
+        uint8_t profile;
+        if (!interface.getRfProfile(&profile))
+        {
+            return false;
+        }
+        appliedProfile = profile;
+    }
+    lastProfileTick = WE_GetTick() - LINKADAPTATION_MIN_PROFILE_INTERVAL;
+    rxQueueHead = 0;
+    rxQueueTail = 0;
+    return true;
+}
+
+/**
+ * @brief Report the RSSI of a packet received from a link, call from the RX callback of the driver
+ *
+ * @param[in] address: address of the link
+ * @param[in] rssi: RSSI of the packet
+ * @param[in] peer_txpower: TX power used by the peer in dBm
+ */
+void LinkAdaptation_ReportRx(uint32_t address, int8_t rssi, int8_t peer_txpower)
+{
+    uint8_t head = rxQueueHead;
+    if ((uint8_t)(head - rxQueueTail) < LINKADAPTATION_RX_QUEUE_LENGTH)
+    {
+        LinkAdaptation_RxReport_t* report = &rxQueue[head & (LINKADAPTATION_RX_QUEUE_LENGTH - 1)];
+        report->address = address;
+        report->rssi = rssi;
+        report->peerTXPower = peer_txpower;
+        rxQueueHead = head + 1;
+    }
+    /* else: queue full, the report is dropped */
+}
+
+/**
+ * @brief Report the result of a transmission to a link
+ *
+ * @param[in] address: address of the link
+ * @param[in] success: true if the packet has been delivered
+ */
+void LinkAdaptation_ReportTx(uint32_t address, bool success)
+{
+    LinkAdaptation_Link_t* link = GetLink(address, true);
+    link->lastTick = WE_GetTick();
+
+    if (success)
+    {
+        link->failures = 0;
+        if (link->successes < 0xFFFF)
+        {
+            link->successes++;
+        }
+        if ((link->penalty > 0) && (++link->penaltyCredit >= LINKADAPTATION_PROBATION))
+        {
+            link->penalty--;
+            link->penaltyCredit = 0;
+        }
+        Evaluate(link);
+        return;
+    }
+
+    link->successes = 0;
+    link->penaltyCredit = 0;
+    if (++link->failures < LINKADAPTATION_BACKOFF_FAILURES)
+    {
+        return;
+    }
+
+    /* back off quickly and require more margin for the next step up */
+    link->failures = 0;
+    SetLevel(link, (link->level > LINKADAPTATION_BACKOFF_STEPS) ? (link->level - LINKADAPTATION_BACKOFF_STEPS) : 0);
+    link->penalty += LINKADAPTATION_PENALTY_STEP;
+    if (link->penalty > LINKADAPTATION_MAX_PENALTY)
+    {
+        link->penalty = LINKADAPTATION_MAX_PENALTY;
+    }
+}
+
+/**
+ * @brief Apply the TX power of a link to the module, call before transmitting to the link
+ *
+ * The TX power is only written if it differs from the current setting of the module.
+ * The RF profile is not changed here, see LinkAdaptation_Process().
+ *
+ * @param[in] address: address of the link
+ *
+ * @return true if the settings have been applied,
+ *         false otherwise
+ */
+bool LinkAdaptation_Apply(uint32_t address)
+{
+    LinkAdaptation_Link_t* link = GetLink(address, true);
+    int8_t txPower = TXPower(link);
+    link->lastTick = WE_GetTick();
+
+    if (appliedPower != txPower)
+    {
+        if (!interface.setTXPower((uint8_t)txPower))
+        {
+            fprintf(stdout, "Set TX power %d failed\n", txPower);
+            appliedPower = POWER_INVALID;
+            return false;
+        }
+        appliedPower = txPower;
+    }
+    return true;
+}
+
+/**
+ * @brief Process the RSSI reports and update the RF profile of the module
+ *
+ * Call this function cyclically from the main loop, but not while a transmission is in
+ * progress, as a profile change resets the module.
+ */
+void LinkAdaptation_Process(void)
+{
+    while (rxQueueTail != rxQueueHead)
+    {
+        HandleRxReport(&rxQueue[rxQueueTail & (LINKADAPTATION_RX_QUEUE_LENGTH - 1)]);
+        rxQueueTail++;
+    }
+    UpdateProfile();
+}
+
+/**
+ * @brief Get the current level of a link
+ *
+ * @param[in] address: address of the link
+ * @param[out] level: index of the level in the ladder
+ *
+ * @return true if the link is known,
+ *         false otherwise
+ */
+bool LinkAdaptation_GetLevel(uint32_t address, uint8_t* level)
+{
+    LinkAdaptation_Link_t* link = GetLink(address, false);
+    if (link == NULL)
+    {
+        return false;
+    }
+    *level = link->level;
+    return true;
+}
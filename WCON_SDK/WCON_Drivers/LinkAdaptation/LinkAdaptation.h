@@ -0,0 +1,144 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Adaptive TX power and RF profile per link for the proprietary radio modules header file.
+ *
+ * The application defines a ladder of levels, ordered from the most robust setting
+ * (slowest RF profile, highest TX power) to the most efficient one (fastest RF profile,
+ * lowest TX power). For each link (identified by a 32 bit address) the path loss is
+ * estimated from the RSSI of received packets and the delivery of transmitted packets is
+ * tracked.
+ *
+ * - The link steps up one level at a time to the most efficient level whose predicted
+ *   margin (TX power - path loss - sensitivity) stays above LINKADAPTATION_TARGET_MARGIN,
+ *   after LINKADAPTATION_PROBATION successful transmissions at the current level.
+ * - The link drops directly to the level that satisfies the margin if the path loss rises,
+ *   and backs off LINKADAPTATION_BACKOFF_STEPS levels after LINKADAPTATION_BACKOFF_FAILURES
+ *   failed transmissions in a row. Each back off raises the target margin of the link,
+ *   the extra margin decays with successful transmissions.
+ *
+ * The TX power is set per transmission with a volatile setter. The RF profile is a setting
+ * of the module, not of a link: LinkAdaptation_Process() switches the module to the profile
+ * of the most robust level that any link needs. While a link needs a different profile than
+ * the one in use, it transmits at the highest TX power of the ladder for the profile in use.
+ *
+ * Usage:
+ * - Call LinkAdaptation_Init() with the ladder and the module specific functions, e.g.
+ *   TarvosIII_SetVolatile_TXPower, TarvosIII_SetDefaultRFProfile, TarvosIII_GetDefaultRFProfile
+ *   and TarvosIII_Reset. setRfProfile may be NULL to adapt the TX power only.
+ * - Call LinkAdaptation_ReportRx() from the RX callback of the driver.
+ * - Call LinkAdaptation_Apply() before and LinkAdaptation_ReportTx() after each
+ *   transmission to the link.
+ * - Call LinkAdaptation_Process() cyclically from the main loop.
+ *
+ * Note: The RF profile of the Tarvos family is stored in flash and only takes effect after a
+ * reset of the module. Each profile change therefore writes the flash and resets the module,
+ * and profile changes are limited to one per LINKADAPTATION_MIN_PROFILE_INTERVAL.
+ * Note: Both ends of a link have to use the same RF profile. Profile adaptation therefore
+ * requires that the peer follows the profile changes (e.g. by a message of the application
+ * sent from setRfProfile before switching).
+ * Note: Thyone-I is not supported, as it has no volatile TX power setting.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef LINKADAPTATION_H_INCLUDED
+#define LINKADAPTATION_H_INCLUDED
+
+#define LINKADAPTATION_MAX_LEVELS 16
+
+/* number of links that are tracked, the least recently used link is replaced */
+#ifndef LINKADAPTATION_MAX_LINKS
+#define LINKADAPTATION_MAX_LINKS 8
+#endif
+
+/* required margin above the sensitivity in dB */
+#ifndef LINKADAPTATION_TARGET_MARGIN
+#define LINKADAPTATION_TARGET_MARGIN 10
+#endif
+
+/* number of successful transmissions before stepping up one level */
+#ifndef LINKADAPTATION_PROBATION
+#define LINKADAPTATION_PROBATION 8
+#endif
+
+/* number of failed transmissions in a row that trigger a back off */
+#ifndef LINKADAPTATION_BACKOFF_FAILURES
+#define LINKADAPTATION_BACKOFF_FAILURES 2
+#endif
+
+/* number of levels to go back on a back off */
+#ifndef LINKADAPTATION_BACKOFF_STEPS
+#define LINKADAPTATION_BACKOFF_STEPS 2
+#endif
+
+/* extra margin in dB added on each back off (decays by 1 dB per LINKADAPTATION_PROBATION successes) */
+#define LINKADAPTATION_PENALTY_STEP 3
+#define LINKADAPTATION_MAX_PENALTY  12
+
+/* minimum time in ms between two RF profile changes of the module (each one writes the flash and resets the module) */
+#ifndef LINKADAPTATION_MIN_PROFILE_INTERVAL
+#define LINKADAPTATION_MIN_PROFILE_INTERVAL 600000
+#endif
+
+/* number of RSSI reports that can be queued between two calls of LinkAdaptation_Process */
+#ifndef LINKADAPTATION_RX_QUEUE_LENGTH
+#define LINKADAPTATION_RX_QUEUE_LENGTH 8
+#endif
+
+typedef struct LinkAdaptation_Level_t
+{
+    uint8_t profile;        /* RF profile */
+    int8_t txPower;         /* TX power in dBm */
+    int8_t sensitivity;     /* sensitivity of the RF profile in dBm */
+} LinkAdaptation_Level_t;
+
+typedef struct LinkAdaptation_Interface_t
+{
+    bool (*setTXPower)(uint8_t power);          /* e.g. TarvosIII_SetVolatile_TXPower */
+    bool (*setRfProfile)(uint8_t profile);      /* e.g. TarvosIII_SetDefaultRFProfile, may be NULL */
+    bool (*getRfProfile)(uint8_t* profile);     /* e.g. TarvosIII_GetDefaultRFProfile, may be NULL if the module runs the profile of the first level */
+    bool (*reset)(void);                        /* e.g. TarvosIII_Reset, required if setRfProfile is set */
+} LinkAdaptation_Interface_t;
+
+extern bool LinkAdaptation_Init(const LinkAdaptation_Level_t* levels, uint8_t level_count, const LinkAdaptation_Interface_t* iface);
+extern void LinkAdaptation_ReportRx(uint32_t address, int8_t rssi, int8_t peer_txpower);
+extern void LinkAdaptation_ReportTx(uint32_t address, bool success);
+extern bool LinkAdaptation_Apply(uint32_t address);
+extern void LinkAdaptation_Process(void);
+extern bool LinkAdaptation_GetLevel(uint32_t address, uint8_t* level);
+
+#endif // LINKADAPTATION_H_INCLUDED
+
+#ifdef __cplusplus
+}
+#endif
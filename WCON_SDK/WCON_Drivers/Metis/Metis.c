@@ -42,6 +42,8 @@ typedef enum Metis_Pin_t
 } Metis_Pin_t;
 
 #define CMD_WAIT_TIME 500
+#define READY_POLL_TIME 20
+#define CONFIGURE_MAX_READ_LENGTH 64
 #define CNFINVALID 255
 #define MAX_PAYLOAD_LENGTH 255
 #define TXPOWERINVALID -128
@@ -141,6 +143,7 @@ static uint8_t checksum = 0;
 static uint8_t RxByteCounter = 0;
 static uint8_t BytesToReceive = 0;                      /* read buffer for next available byte */
 static uint8_t RxBuffer[sizeof(Metis_CMD_Frame_t)];     /* data buffer for RX */
+static uint8_t TxBuffer[sizeof(Metis_CMD_Frame_t)];     /* data buffer for TX */
 static Metis_RxCallback RxCallback;                     /* callback function */
 
 /**************************************
@@ -251,46 +254,17 @@ static void HandleRxPacket(uint8_t *packetData)
          * Data[1] contains length of parameter, which is depending on usersetting
          * On success mode responds with usersetting, length of parameter and parameter
          */
-        switch(RxPacket.Data[0])
-        {
-        /* usersettings with value length of 1 byte */
-        case(Metis_USERSETTING_MEMPOSITION_UART_CMD_OUT_ENABLE):
-        case(Metis_USERSETTING_MEMPOSITION_APP_AES_ENABLE):
-        case(Metis_USERSETTING_MEMPOSITION_DEFAULTRFTXPOWER):
-        case(Metis_USERSETTING_MEMPOSITION_RSSI_ENABLE):
-        case(Metis_USERSETTING_MEMPOSITION_MODE_PRESELECT):
+
+        /* check if correct memory range was read (single usersetting or block read by Metis_GetMultiple()) */
+        if((usConfirmation.memoryPosition == RxPacket.Data[0]) && (usConfirmation.lengthGetRequest == RxPacket.Data[1]))
         {
-            /* check if correct usersetting was changed and if length corresponds to usersetting */
-            if((usConfirmation.memoryPosition == RxPacket.Data[0]) && (usConfirmation.lengthGetRequest == RxPacket.Data[1]))
-            {
-                cmdConfirmation.status = CMD_Status_Success;
-            }
-            else
-            {
-                cmdConfirmation.status = CMD_Status_Failed;
-            }
-            cmdConfirmation.cmd = RxPacket.Cmd;
+            cmdConfirmation.status = CMD_Status_Success;
         }
-        break;
-        /* usersettings with value length of 2 byte*/
-        case(Metis_USERSETTING_MEMPOSITION_CFG_FLAGS):
+        else
         {
-            /* check if correct usersetting was changed and if length corresponds to usersetting */
-            if((usConfirmation.memoryPosition == RxPacket.Data[0]) && (usConfirmation.lengthGetRequest == RxPacket.Data[1]))
-            {
-                cmdConfirmation.status = CMD_Status_Success;
-            }
-            else
-            {
-                cmdConfirmation.status = CMD_Status_Failed;
-            }
-            cmdConfirmation.cmd = RxPacket.Cmd;
-        }
-        break;
-
-        default:
-            break;
+            cmdConfirmation.status = CMD_Status_Failed;
         }
+        cmdConfirmation.cmd = RxPacket.Cmd;
     }
     break;
 
@@ -428,7 +402,7 @@ static bool Wait4CNF(int max_time_ms, uint8_t expectedCmdConfirmation, Metis_CMD
 /**
  * @brief Function to add the checksum at the end of the data packet
  */
-static bool FillChecksum(uint8_t* array, uint8_t length)
+static bool FillChecksum(uint8_t* array, uint16_t length)
 {
     bool ret = false;
 
@@ -449,6 +423,35 @@ static bool FillChecksum(uint8_t* array, uint8_t length)
     return ret;
 }
 
+/**
+ * @brief Function that waits until the module is ready for operation after power-up or reset.
+ *
+ * The module doesn't send a "ready for operation" message, so it is polled with
+ * firmware version requests until it answers or the timeout expires.
+ */
+static bool WaitForReady(uint16_t max_time_ms)
+{
+    uint8_t CMD_ARRAY[4];
+    CMD_ARRAY[0] = CMD_STX;
+    CMD_ARRAY[1] = METIS_CMD_GET_FWRELEASE;
+    CMD_ARRAY[2] = 0;
+    if(false == FillChecksum(CMD_ARRAY,sizeof(CMD_ARRAY)))
+    {
+        return false;
+    }
+
+    uint32_t t0 = WE_GetTick();
+    while ((WE_GetTick() - t0) < max_time_ms)
+    {
+        WE_UART_Transmit(CMD_ARRAY,sizeof(CMD_ARRAY));
+        if (Wait4CNF(READY_POLL_TIME, METIS_CMD_GET_FWRELEASE_CNF, CMD_Status_Success, true))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 
 /**************************************
  *         Global functions           *
@@ -551,98 +554,40 @@ bool Metis_Init(uint32_t baudrate,
     WE_SetPin(Metis_pins[Metis_Pin_Reset], WE_Pin_Level_High);
     
     WE_UART_Init(baudrate, flow_control, WE_Parity_None, false);
-    WE_Delay(1000);
-
-    /* set recommended settings as described in the manual section 5.1 */
 
-    /* enable uartOutEnable to print out received frames
-     * Setting is written to flash so write only if necessary
-     */
-    uint8_t uartEnable;
-    bool ret = Metis_GetUartOutEnable(&uartEnable);
-    if(uartEnable != 1)
+    /* wait for the module to finish booting */
+    if(false == WaitForReady(METIS_BOOT_TIMEOUT))
     {
-        WE_Delay(50);
-        if(Metis_SetUartOutEnable(1))
-        {
-            WE_Delay(50);
-        }
-        else
-        {
-            fprintf(stdout, "Set UART_CMD_OUT_MODE failed\n");
-            Metis_Deinit();
-            return false;
-        }
-    }
-
-    /* enable rssi to be added to received frames
-     * Setting is written to flash so write only if necessary
-     */
-    uint8_t rssi;
-    ret = Metis_GetRSSIEnable(&rssi);
-    if(rssi != rssi_enable)
-    {
-        WE_Delay(50);
-        if(Metis_SetRSSIEnable(rssi_enable ? 1 : 0))
-        {
-            WE_Delay(50);
-        }
-        else
-        {
-            fprintf(stdout, "Set RSSI failed\n");
-            Metis_Deinit();
-            return false;
-        }
-    }
-
-    /* disable AES encryption
-     * Setting is written to flash so write only if necessary
-     */
-    uint8_t aesEnable;
-    ret = Metis_GetAESEnable(&aesEnable);
-    if(aesEnable != 0)
-    {
-        WE_Delay(50);
-        if(Metis_SetAESEnable(0))
-        {
-            WE_Delay(50);
-        }
-        else
-        {
-            fprintf(stdout, "Set AESEnable failed\n");
-            Metis_Deinit();
-            return false;
-        }
+        fprintf(stdout, "Module not ready\n");
+        Metis_Deinit();
+        return false;
     }
 
-    /* set mode preselect
-     * Setting is written to flash so write only if necessary
+    /* set recommended settings as described in the manual section 5.1:
+     * - enable uartOutEnable to print out received frames
+     * - enable rssi to be added to received frames (if requested)
+     * - disable AES encryption
+     * - set mode preselect
+     * Settings are written to flash, so Metis_Configure() writes only the ones that differ
+     * and resets the module only if necessary
      */
-    uint8_t modePreselect;
-    ret = Metis_GetModePreselect(&modePreselect);
-    if(modePreselect != mode)
-    {
-        WE_Delay(50);
-        if(Metis_SetModePreselect(mode))
-        {
-            WE_Delay(50);
-        }
-        else
-        {
-            fprintf(stdout, "Set mode preselect failed\n");
-            Metis_Deinit();
-            return false;
-        }
-    }
-
-    /* Reset module to apply changes */
-    if(Metis_Reset())
-    {
-        WE_Delay(300);
-    }
-    else
+    Metis_Configuration_t config[4];
+    config[0].usersetting = Metis_USERSETTING_MEMPOSITION_UART_CMD_OUT_ENABLE;
+    config[0].value[0] = 1;
+    config[0].value_length = 1;
+    config[1].usersetting = Metis_USERSETTING_MEMPOSITION_RSSI_ENABLE;
+    config[1].value[0] = rssi_enable ? 1 : 0;
+    config[1].value_length = 1;
+    config[2].usersetting = Metis_USERSETTING_MEMPOSITION_APP_AES_ENABLE;
+    config[2].value[0] = 0;
+    config[2].value_length = 1;
+    config[3].usersetting = Metis_USERSETTING_MEMPOSITION_MODE_PRESELECT;
+    config[3].value[0] = (uint8_t)mode;
+    config[3].value_length = 1;
+
+    if(false == Metis_Configure(config, sizeof(config) / sizeof(config[0]), false))
     {
-        fprintf(stdout, "Reset failed\n");
+        fprintf(stdout, "Configure failed\n");
         Metis_Deinit();
         return false;
     }
@@ -681,7 +626,8 @@ bool Metis_PinReset()
     WE_Delay(5);
     WE_SetPin(Metis_pins[Metis_Pin_Reset], WE_Pin_Level_High);
 
-    return true;
+    /* wait for the module to be ready for operation */
+    return WaitForReady(METIS_BOOT_TIMEOUT);
 }
 
 /**
@@ -704,8 +650,11 @@ bool Metis_Reset()
         /* now send CMD_ARRAY */
         WE_UART_Transmit(CMD_ARRAY,sizeof(CMD_ARRAY));
 
-        /* wait for cnf */
-        return Wait4CNF(CMD_WAIT_TIME, METIS_CMD_RESET_CNF, CMD_Status_Success, true);
+        /* wait for cnf, then wait for the module to be ready for operation */
+        if (Wait4CNF(CMD_WAIT_TIME, METIS_CMD_RESET_CNF, CMD_Status_Success, true))
+        {
+            return WaitForReady(METIS_BOOT_TIMEOUT);
+        }
     }
     return ret;
 }
@@ -897,18 +846,24 @@ bool Metis_Set(Metis_UserSettings_t us, uint8_t* value, uint8_t length)
 {
     bool ret = false;
 
+    if(length > (MAX_PAYLOAD_LENGTH - 2))
+    {
+        return false;
+    }
+
     /* fill CMD_ARRAY packet */
-    uint8_t CMD_ARRAY[length + 6];
+    uint8_t *CMD_ARRAY = TxBuffer;
+    uint16_t CMD_ARRAY_LENGTH = length + 6;
     CMD_ARRAY[0] = CMD_STX;
     CMD_ARRAY[1] = METIS_CMD_SET_REQ;
     CMD_ARRAY[2] = (2 + length);
     CMD_ARRAY[3] = us;
     CMD_ARRAY[4] = length;
     memcpy(&CMD_ARRAY[5],value,length);
-    if(FillChecksum(CMD_ARRAY,sizeof(CMD_ARRAY)))
+    if(FillChecksum(CMD_ARRAY,CMD_ARRAY_LENGTH))
     {
         /* now send CMD_ARRAY */
-        WE_UART_Transmit(CMD_ARRAY,sizeof(CMD_ARRAY));
+        WE_UART_Transmit(CMD_ARRAY,CMD_ARRAY_LENGTH);
 
         /* wait for cnf */
         ret = Wait4CNF(CMD_WAIT_TIME, METIS_CMD_SET_CNF, CMD_Status_Success, true);
@@ -1219,15 +1174,16 @@ bool Metis_Transmit(uint8_t* payload)
 
 
     /* fill CMD_ARRAY packet */
-    uint8_t CMD_ARRAY[length + 4];
+    uint8_t *CMD_ARRAY = TxBuffer;
+    uint16_t CMD_ARRAY_LENGTH = length + 4;
     CMD_ARRAY[0] = CMD_STX;
     CMD_ARRAY[1] = METIS_CMD_DATA_REQ;
     CMD_ARRAY[2] = length;
     memcpy(&CMD_ARRAY[3],&payload[1],length);
-    if(FillChecksum(CMD_ARRAY,sizeof(CMD_ARRAY)))
+    if(FillChecksum(CMD_ARRAY,CMD_ARRAY_LENGTH))
     {
         /* now send CMD_ARRAY */
-        WE_UART_Transmit(CMD_ARRAY,sizeof(CMD_ARRAY));
+        WE_UART_Transmit(CMD_ARRAY,CMD_ARRAY_LENGTH);
 
         /* wait for cnf */
         ret = Wait4CNF(CMD_WAIT_TIME, METIS_CMD_DATA_CNF, CMD_Status_Success, true);
@@ -1238,6 +1194,11 @@ bool Metis_Transmit(uint8_t* payload)
 /**
  * @brief Configure the Metis
  *
+ * The current values are read in as few blocks as possible using Metis_GetMultiple()
+ * and compared to the requested configuration. Only the user settings that differ are
+ * written and the module is reset only if at least one setting has been updated
+ * (or a factory reset has been performed).
+ *
  * @param[in] config: pointer to the configuration struct
  * @param[in] config_length: length of the configuration struct
  * @param[in] factory_reset: apply a factory reset before or not
@@ -1248,8 +1209,19 @@ bool Metis_Transmit(uint8_t* payload)
 bool Metis_Configure(Metis_Configuration_t* config, uint8_t config_length, bool factory_reset)
 {
     int i = 0;
-    uint8_t help_length;
-    uint8_t help[METIS_MAX_USERSETTING_LENGTH];
+    bool reset_required = false;
+    uint8_t done[32];                               /* one bit per config entry that has been checked */
+    uint8_t block[CONFIGURE_MAX_READ_LENGTH];
+    uint8_t block_length;
+
+    for(i=0; i<config_length; i++)
+    {
+        if((config[i].value_length == 0) || (config[i].value_length > METIS_MAX_USERSETTING_LENGTH))
+        {
+            /* error, invalid length */
+            return false;
+        }
+    }
 
     if(factory_reset)
     {
@@ -1259,42 +1231,87 @@ bool Metis_Configure(Metis_Configuration_t* config, uint8_t config_length, bool
             /* error */
             return false;
         }
+
+        /* the module reboots after the factory reset, wait until it answers again */
+        if(false == WaitForReady(METIS_BOOT_TIMEOUT))
+        {
+            /* error */
+            return false;
+        }
+        reset_required = true;
     }
-    WE_Delay(500);
 
     /* now check all settings and update them if necessary */
-    for(i=0; i<config_length; i++)
+    memset(done, 0, sizeof(done));
+    while (1)
     {
-        /* read current value */
-        if(false == Metis_Get(config[i].usersetting, help, &help_length))
+        /* the block to be read starts at the lowest memory position that has not been checked yet */
+        uint16_t block_start = 0x100;
+        for(i=0; i<config_length; i++)
+        {
+            if((0 == (done[i >> 3] & (1 << (i & 7)))) && ((uint16_t)config[i].usersetting < block_start))
+            {
+                block_start = config[i].usersetting;
+            }
+        }
+        if(block_start == 0x100)
+        {
+            /* all settings have been checked */
+            break;
+        }
+
+        /* extend the block to all remaining settings that fit into a single read */
+        uint16_t block_end = block_start;
+        for(i=0; i<config_length; i++)
+        {
+            uint16_t end = (uint16_t)config[i].usersetting + config[i].value_length;
+            if((0 == (done[i >> 3] & (1 << (i & 7)))) && (end - block_start <= CONFIGURE_MAX_READ_LENGTH) && (end > block_end))
+            {
+                block_end = end;
+            }
+        }
+
+        /* read current values of the whole block at once */
+        if(false == Metis_GetMultiple(block_start, block_end - block_start, block, &block_length))
         {
             /* error */
             return false;
         }
-        WE_Delay(200);
-
-        /* check the value read out */
-        if(help_length != config[i].value_length)
+        if(block_length != block_end - block_start)
         {
             /* error, length does not match */
             return false;
         }
-        if(memcmp(help,config[i].value,config[i].value_length) != 0)
+
+        /* write the settings in this block that are not up to date */
+        for(i=0; i<config_length; i++)
         {
-            /* read value is not up to date, thus write the new value */
-            if(false == Metis_Set(config[i].usersetting, config[i].value, config[i].value_length))
+            uint16_t end = (uint16_t)config[i].usersetting + config[i].value_length;
+            if((0 != (done[i >> 3] & (1 << (i & 7)))) || (config[i].usersetting < block_start) || (end > block_end))
+            {
+                continue;
+            }
+            done[i >> 3] |= (1 << (i & 7));
+
+            if(memcmp(&block[config[i].usersetting - block_start],config[i].value,config[i].value_length) != 0)
             {
-                /* error */
-                return false;
+                if(false == Metis_Set(config[i].usersetting, config[i].value, config[i].value_length))
+                {
+                    /* error */
+                    return false;
+                }
+                reset_required = true;
             }
         }
-        WE_Delay(200);
     }
 
-    /* reset to take effect of the updated parameters */
-    if(false == Metis_PinReset())
+    if(reset_required)
     {
-        return false;
+        /* reset to take effect of the updated parameters */
+        if(false == Metis_Reset())
+        {
+            return false;
+        }
     }
     return true;
 }
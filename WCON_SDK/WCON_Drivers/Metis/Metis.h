@@ -55,6 +55,11 @@ extern "C" {
  */
 #define METIS_MAX_USERSETTING_LENGTH 4
 
+/**
+ * Max. time (ms) to wait for the module to become ready after power-up or reset.
+ */
+#define METIS_BOOT_TIMEOUT (uint16_t)1000
+
 /**
  * @brief Enumeration for wM-Bus mode.
  *
@@ -152,7 +152,11 @@ int main(void)
     WE_GetDriverVersion(driverVersion);
     printf("Wuerth Elektronik eiSos Wireless Connectivity SDK version %d.%d.%d\r\n", driverVersion[0], driverVersion[1], driverVersion[2]);
 
+    /* measure the time from cold start until the module is ready for operation */
+    uint32_t bootStartTick = WE_GetTick();
     Metis_Init(9600, WE_FlowControl_NoFlowControl, MBus_Frequency_868, MBus_Mode_868_S2, true, RxCallback);
+    printf("Metis ready after %lu ms\r\n", WE_GetTick() - bootStartTick);
+    (void) bootStartTick;
 
     while (1)
     {
@@ -170,9 +174,7 @@ int main(void)
         WE_Delay(500);
 
         ret = Metis_PinReset();
-        WE_Delay(500);
 
         ret = Metis_Reset();
-        WE_Delay(500);
     }
 }
@@ -0,0 +1,429 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Fragmentation and reassembly layer for the proprietary radio modules source file.
+ */
+
+#include "Fragmentation.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../global/global.h"
+
+#if (FRAGMENTATION_MAX_MESSAGE_LENGTH > (FRAGMENTATION_MAX_FRAGMENTS * FRAGMENTATION_MAX_FRAGMENT_PAYLOAD))
+#error "FRAGMENTATION_MAX_MESSAGE_LENGTH exceeds the maximum number of fragments"
+#endif
+
+#define TYPE_MARKER      0xF0
+#define TYPE_MASK        0x0F
+#define TYPE_DATA        0x00      /* fragment */
+#define TYPE_DATA_ACKREQ 0x01      /* last fragment of a burst, requests an acknowledgement */
+#define TYPE_ACK         0x02      /* selective acknowledgement */
+
+#define ACK_LENGTH 6
+
+typedef struct Fragmentation_RxSlot_t
+{
+    bool used;
+    volatile bool complete;         /* all fragments received */
+    volatile bool ackPending;       /* acknowledgement has been requested */
+    volatile bool delivered;        /* message has been handed to the callback */
+    uint8_t network_id;             /* source of the message */
+    uint8_t address_lsb;
+    uint8_t address_msb;
+    uint8_t msgId;
+    uint8_t count;
+    volatile uint32_t bitmap;       /* received fragments */
+    uint16_t length;
+    uint32_t lastTick;
+    uint8_t data[FRAGMENTATION_MAX_MESSAGE_LENGTH];
+} Fragmentation_RxSlot_t;
+
+/**************************************
+ *          Static variables          *
+ **************************************/
+
+static Fragmentation_Transmit_t Transmit = NULL;
+static void(*RxCallback)(uint8_t*,uint16_t,uint8_t,uint8_t,uint8_t) = NULL;
+static uint8_t rfChannel = 0;
+
+static uint8_t txMsgId = 0;
+static volatile bool txActive = false;
+static volatile bool txAckReceived = false;
+static volatile uint32_t txAckBitmap = 0;
+static uint8_t txFrame[FRAGMENTATION_HEADER_LENGTH + FRAGMENTATION_MAX_FRAGMENT_PAYLOAD];
+
+static Fragmentation_RxSlot_t rxSlots[FRAGMENTATION_RX_SLOTS];
+
+/**************************************
+ *         Static functions           *
+ **************************************/
+
+/**
+ * @brief Get the bitmap with one bit set per fragment of a message
+ */
+static uint32_t AllFragments(uint8_t count)
+{
+    return (count >= 32) ? 0xFFFFFFFF : ((1UL << count) - 1);
+}
+
+/**
+ * @brief Find the reassembly slot for the source or allocate a new one
+ */
+static Fragmentation_RxSlot_t* GetRxSlot(uint8_t network_id, uint8_t address_lsb, uint8_t address_msb)
+{
+    Fragmentation_RxSlot_t* candidate = NULL;
+    uint32_t now = WE_GetTick();
+    int i = 0;
+
+    for (i = 0; i < FRAGMENTATION_RX_SLOTS; i++)
+    {
+        Fragmentation_RxSlot_t* slot = &rxSlots[i];
+        if (slot->used && (slot->network_id == network_id) && (slot->address_lsb == address_lsb) && (slot->address_msb == address_msb))
+        {
+            return slot;
+        }
+    }
+
+    /* prefer a free slot, otherwise reuse a delivered or timed out incomplete slot */
+    for (i = 0; i < FRAGMENTATION_RX_SLOTS; i++)
+    {
+        Fragmentation_RxSlot_t* slot = &rxSlots[i];
+        if (!slot->used)
+        {
+            candidate = slot;
+            break;
+        }
+        if ((slot->delivered || (!slot->complete && (now - slot->lastTick > FRAGMENTATION_RX_TIMEOUT))) &&
+            ((candidate == NULL) || (slot->lastTick < candidate->lastTick)))
+        {
+            candidate = slot;
+        }
+    }
+
+    if (candidate != NULL)
+    {
+        candidate->used = false;
+        candidate->network_id = network_id;
+        candidate->address_lsb = address_lsb;
+        candidate->address_msb = address_msb;
+    }
+    return candidate;
+}
+
+/**
+ * @brief Put a received fragment into its reassembly slot
+ */
+static void HandleFragment(uint8_t type, uint8_t msgId, uint8_t index, uint8_t count, uint8_t* data, uint8_t length,
+                           uint8_t network_id, uint8_t address_lsb, uint8_t address_msb)
+{
+    uint16_t offset = (uint16_t)index * FRAGMENTATION_MAX_FRAGMENT_PAYLOAD;
+
+    /* check the fragment */
+    if ((count == 0) || (count > FRAGMENTATION_MAX_FRAGMENTS) || (index >= count) ||
+        ((index < count - 1) && (length != FRAGMENTATION_MAX_FRAGMENT_PAYLOAD)) ||
+        (length > FRAGMENTATION_MAX_FRAGMENT_PAYLOAD) ||
+        (offset + length > FRAGMENTATION_MAX_MESSAGE_LENGTH))
+    {
+        return;
+    }
+
+    Fragmentation_RxSlot_t* slot = GetRxSlot(network_id, address_lsb, address_msb);
+    if (slot == NULL)
+    {
+        /* no reassembly buffer available, the sender will repeat the fragments */
+        return;
+    }
+
+    if (!slot->used || (slot->msgId != msgId) || (slot->count != count))
+    {
+        if (slot->used && slot->complete && !slot->delivered)
+        {
+            /* previous message has not been handed to the application yet */
+            return;
+        }
+        /* start a new message */
+        slot->used = true;
+        slot->complete = false;
+        slot->ackPending = false;
+        slot->delivered = false;
+        slot->msgId = msgId;
+        slot->count = count;
+        slot->bitmap = 0;
+        slot->length = 0;
+    }
+    slot->lastTick = WE_GetTick();
+
+    if (!slot->complete)
+    {
+        memcpy(&slot->data[offset], data, length);
+        if (index == count - 1)
+        {
+            slot->length = offset + length;
+        }
+        slot->bitmap |= (1UL << index);
+        if (slot->bitmap == AllFragments(count))
+        {
+            slot->complete = true;
+        }
+    }
+
+    if (type == TYPE_DATA_ACKREQ)
+    {
+        slot->ackPending = true;
+    }
+}
+
+/**************************************
+ *         Global functions           *
+ **************************************/
+
+/**
+ * @brief Initialize the fragmentation layer
+ *
+ * @param[in] channel: RF channel used for all fragments and acknowledgements
+ * @param[in] transmit: Transmit_Extended function of the module (e.g. TarvosIII_Transmit_Extended)
+ * @param[in] RXcb: callback function for reassembled messages
+ *
+ * @return true if initialization succeeded,
+ *         false otherwise
+ */
+bool Fragmentation_Init(uint8_t channel, Fragmentation_Transmit_t transmit, void(*RXcb)(uint8_t*,uint16_t,uint8_t,uint8_t,uint8_t))
+{
+    if (transmit == NULL)
+    {
+        return false;
+    }
+
+    rfChannel = channel;
+    Transmit = transmit;
+    RxCallback = RXcb;
+    txActive = false;
+    memset(rxSlots, 0, sizeof(rxSlots));
+    return true;
+}
+
+/**
+ * @brief Transmit a message of up to FRAGMENTATION_MAX_MESSAGE_LENGTH bytes
+ *
+ * All missing fragments are transmitted back to back, the last one of each burst requests
+ * a selective acknowledgement. The function returns as soon as all fragments have been
+ * acknowledged or FRAGMENTATION_MAX_ROUNDS bursts have been sent.
+ *
+ * @param[in] data: pointer to the message
+ * @param[in] length: length of the message
+ * @param[in] dest_network_id: destination network ID
+ * @param[in] dest_address_lsb: destination address lsb
+ * @param[in] dest_address_msb: destination address msb
+ *
+ * @return true if the message has been acknowledged completely,
+ *         false otherwise
+ */
+bool Fragmentation_Send(uint8_t* data, uint16_t length, uint8_t dest_network_id, uint8_t dest_address_lsb, uint8_t dest_address_msb)
+{
+    if (Transmit == NULL)
+    {
+        return false;
+    }
+
+    if ((length == 0) || (length > FRAGMENTATION_MAX_MESSAGE_LENGTH))
+    {
+        fprintf(stdout, "Data exceeds maximal message length\n");
+        return false;
+    }
+
+    uint8_t count = (length + FRAGMENTATION_MAX_FRAGMENT_PAYLOAD - 1) / FRAGMENTATION_MAX_FRAGMENT_PAYLOAD;
+    uint32_t all = AllFragments(count);
+    bool probe = false;
+    int round = 0;
+
+    txMsgId++;
+    txAckBitmap = 0;
+    txActive = true;
+
+    for (round = 0; round < FRAGMENTATION_MAX_ROUNDS; round++)
+    {
+        uint32_t missing = all & ~txAckBitmap;
+        uint8_t last = 0;
+        uint8_t i = 0;
+
+        for (i = 0; i < count; i++)
+        {
+            if (0 != (missing & (1UL << i)))
+            {
+                last = i;
+            }
+        }
+
+        txAckReceived = false;
+        for (i = 0; i < count; i++)
+        {
+            /* without acknowledgement of the previous burst, only repeat its last fragment to request the bitmap */
+            if ((0 == (missing & (1UL << i))) || (probe && (i != last)))
+            {
+                continue;
+            }
+
+            uint16_t offset = (uint16_t)i * FRAGMENTATION_MAX_FRAGMENT_PAYLOAD;
+            uint8_t fragment_length = (i == count - 1) ? (uint8_t)(length - offset) : FRAGMENTATION_MAX_FRAGMENT_PAYLOAD;
+            txFrame[0] = TYPE_MARKER | ((i == last) ? TYPE_DATA_ACKREQ : TYPE_DATA);
+            txFrame[1] = txMsgId;
+            txFrame[2] = i;
+            txFrame[3] = count;
+            memcpy(&txFrame[FRAGMENTATION_HEADER_LENGTH], &data[offset], fragment_length);
+
+            if (false == Transmit(txFrame, FRAGMENTATION_HEADER_LENGTH + fragment_length, rfChannel, dest_network_id, dest_address_lsb, dest_address_msb))
+            {
+                txActive = false;
+                return false;
+            }
+        }
+
+        /* wait for the selective acknowledgement */
+        uint32_t t0 = WE_GetTick();
+        while (1)
+        {
+            /* keep serving the receiving side (acknowledgements of incoming messages) */
+            Fragmentation_Process();
+            if (txAckReceived || (WE_GetTick() - t0 > FRAGMENTATION_ACK_TIMEOUT))
+            {
+                break;
+            }
+            WE_Delay(1);
+        }
+
+        if ((txAckBitmap & all) == all)
+        {
+            txActive = false;
+            return true;
+        }
+        probe = !txAckReceived;
+    }
+
+    txActive = false;
+    fprintf(stdout, "Message not acknowledged\n");
+    return false;
+}
+
+/**
+ * @brief Handle a received packet
+ *
+ * Call this function from the RX callback of the driver.
+ *
+ * @param[in] payload: pointer to the received packet
+ * @param[in] length: length of the received packet
+ * @param[in] src_network_id: source network ID
+ * @param[in] src_address_lsb: source address lsb
+ * @param[in] src_address_msb: source address msb
+ *
+ * @return true if the packet belongs to the fragmentation layer,
+ *         false otherwise
+ */
+bool Fragmentation_HandleRx(uint8_t* payload, uint8_t length, uint8_t src_network_id, uint8_t src_address_lsb, uint8_t src_address_msb)
+{
+    if ((length < FRAGMENTATION_HEADER_LENGTH) || ((payload[0] & ~TYPE_MASK) != TYPE_MARKER))
+    {
+        return false;
+    }
+
+    switch (payload[0] & TYPE_MASK)
+    {
+    case TYPE_DATA:
+    case TYPE_DATA_ACKREQ:
+    {
+        HandleFragment(payload[0] & TYPE_MASK, payload[1], payload[2], payload[3],
+                       &payload[FRAGMENTATION_HEADER_LENGTH], length - FRAGMENTATION_HEADER_LENGTH,
+                       src_network_id, src_address_lsb, src_address_msb);
+    }
+    break;
+
+    case TYPE_ACK:
+    {
+        if ((length == ACK_LENGTH) && txActive && (payload[1] == txMsgId))
+        {
+            txAckBitmap |= ((uint32_t)payload[2] | ((uint32_t)payload[3] << 8) | ((uint32_t)payload[4] << 16) | ((uint32_t)payload[5] << 24));
+            txAckReceived = true;
+        }
+    }
+    break;
+
+    default:
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Send pending acknowledgements and hand completed messages to the callback
+ *
+ * Call this function cyclically from the main loop.
+ */
+void Fragmentation_Process(void)
+{
+    uint32_t now = WE_GetTick();
+    int i = 0;
+
+    for (i = 0; i < FRAGMENTATION_RX_SLOTS; i++)
+    {
+        Fragmentation_RxSlot_t* slot = &rxSlots[i];
+        if (!slot->used)
+        {
+            continue;
+        }
+
+        if (slot->ackPending && (Transmit != NULL))
+        {
+            uint8_t ack[ACK_LENGTH];
+            uint32_t bitmap = slot->bitmap;
+            slot->ackPending = false;
+            ack[0] = TYPE_MARKER | TYPE_ACK;
+            ack[1] = slot->msgId;
+            ack[2] = (uint8_t)bitmap;
+            ack[3] = (uint8_t)(bitmap >> 8);
+            ack[4] = (uint8_t)(bitmap >> 16);
+            ack[5] = (uint8_t)(bitmap >> 24);
+            Transmit(ack, sizeof(ack), rfChannel, slot->network_id, slot->address_lsb, slot->address_msb);
+        }
+
+        if (slot->complete && !slot->delivered)
+        {
+            if (RxCallback != NULL)
+            {
+                RxCallback(slot->data, slot->length, slot->network_id, slot->address_lsb, slot->address_msb);
+            }
+            /* release the slot only after the callback has returned, as the RX interrupt
+             * starts reassembling the next message into slot->data as soon as it is set */
+            slot->delivered = true;
+        }
+        else if (!slot->complete && (now - slot->lastTick > FRAGMENTATION_RX_TIMEOUT))
+        {
+            /* discard incomplete message */
+            slot->used = false;
+        }
+    }
+}
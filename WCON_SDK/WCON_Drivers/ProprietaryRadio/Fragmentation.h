@@ -0,0 +1,105 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Fragmentation and reassembly layer for the proprietary radio modules header file.
+ *
+ * Messages larger than the maximum payload of TarvosIII_Transmit_Extended (and the
+ * corresponding functions of TelestoIII, ThebeII and ThemistoI) are split into fragments
+ * with a 4 byte header. The fragments of a message are transmitted back to back, the last
+ * one requests a selective acknowledgement (bitmap of the received fragments), and only the
+ * missing fragments are repeated.
+ *
+ * Usage:
+ * - Call Fragmentation_Init() with the Transmit_Extended function of the module.
+ * - Call Fragmentation_HandleRx() from the RX callback of the driver. It returns false
+ *   for packets that do not belong to the fragmentation layer.
+ * - Call Fragmentation_Process() cyclically from the main loop. It sends the acknowledgements
+ *   and hands the reassembled messages to the callback.
+ * - Call Fragmentation_Send() to transmit a message (blocking).
+ *
+ * Fragment header: type (1 byte, 0xF0 | type), message id (1 byte), fragment index (1 byte), fragment count (1 byte)
+ * Acknowledgement: type (1 byte, 0xF2), message id (1 byte), bitmap of the received fragments (4 bytes, little endian)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef FRAGMENTATION_H_INCLUDED
+#define FRAGMENTATION_H_INCLUDED
+
+#define FRAGMENTATION_HEADER_LENGTH 4
+
+/* maximum payload per fragment, TarvosIII_Transmit_Extended accepts up to 224 bytes */
+#ifndef FRAGMENTATION_MAX_FRAGMENT_PAYLOAD
+#define FRAGMENTATION_MAX_FRAGMENT_PAYLOAD (224 - FRAGMENTATION_HEADER_LENGTH)
+#endif
+
+/* maximum number of fragments per message, limited by the 32 bit acknowledgement bitmap */
+#define FRAGMENTATION_MAX_FRAGMENTS 32
+
+/* size of each reassembly buffer */
+#ifndef FRAGMENTATION_MAX_MESSAGE_LENGTH
+#define FRAGMENTATION_MAX_MESSAGE_LENGTH 4096
+#endif
+
+/* number of messages (from different sources) that can be reassembled simultaneously */
+#ifndef FRAGMENTATION_RX_SLOTS
+#define FRAGMENTATION_RX_SLOTS 2
+#endif
+
+/* time to wait for the acknowledgement of a burst of fragments in ms */
+#ifndef FRAGMENTATION_ACK_TIMEOUT
+#define FRAGMENTATION_ACK_TIMEOUT 200
+#endif
+
+/* maximum number of bursts per message (first transmission plus repetitions) */
+#ifndef FRAGMENTATION_MAX_ROUNDS
+#define FRAGMENTATION_MAX_ROUNDS 8
+#endif
+
+/* time after which an incomplete message is discarded in ms */
+#ifndef FRAGMENTATION_RX_TIMEOUT
+#define FRAGMENTATION_RX_TIMEOUT 5000
+#endif
+
+/* signature of TarvosIII_Transmit_Extended, TelestoIII_Transmit_Extended, ThebeII_Transmit_Extended and ThemistoI_Transmit_Extended */
+typedef bool (*Fragmentation_Transmit_t)(uint8_t* payload, uint8_t length, uint8_t channel, uint8_t dest_network_id, uint8_t dest_address_lsb, uint8_t dest_address_msb);
+
+extern bool Fragmentation_Init(uint8_t channel, Fragmentation_Transmit_t transmit, void(*RXcb)(uint8_t*,uint16_t,uint8_t,uint8_t,uint8_t));
+extern bool Fragmentation_Send(uint8_t* data, uint16_t length, uint8_t dest_network_id, uint8_t dest_address_lsb, uint8_t dest_address_msb);
+extern bool Fragmentation_HandleRx(uint8_t* payload, uint8_t length, uint8_t src_network_id, uint8_t src_address_lsb, uint8_t src_address_msb);
+extern void Fragmentation_Process(void);
+
+#endif // FRAGMENTATION_H_INCLUDED
+
+#ifdef __cplusplus
+}
+#endif
@@ -689,12 +689,8 @@ bool ProteusE_Init(uint32_t baudrate,
     WE_UART_Init(baudrate, flowControl, WE_Parity_None, true);
     WE_Delay(10);
 
-    /* reset module */
-    if (ProteusE_PinReset())
-    {
-        WE_Delay(PROTEUSE_BOOT_DURATION);
-    }
-    else
+    /* reset module, it is ready for operation as soon as ProteusE_PinReset() returns */
+    if (false == ProteusE_PinReset())
     {
         fprintf(stdout, "Pin reset failed\n");
         ProteusE_Deinit();
@@ -709,7 +705,6 @@ bool ProteusE_Init(uint32_t baudrate,
     {
         fprintf(stdout, "Proteus-e driver version %d.%d.%d\n", driverVersion[0], driverVersion[1], driverVersion[2]);
     }
-    WE_Delay(100);
 
     return true;
 }
@@ -757,7 +752,9 @@ bool ProteusE_PinReset()
 
     if (operationMode == ProteusE_OperationMode_TransparentMode)
     {
-        /* transparent mode is ready (the module doesn't send a "ready for operation" message in transparent mode) */
+        /* the module doesn't send a "ready for operation" message in transparent mode,
+         * so wait for the boot duration specified in the manual instead */
+        WE_Delay(PROTEUSE_BOOT_DURATION);
         return true;
     }
 
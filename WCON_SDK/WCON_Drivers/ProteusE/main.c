@@ -91,10 +91,14 @@ void CommandModeExample()
     callbackConfig.gpioRemoteConfigCb = GpioRemoteConfigCallback;
     callbackConfig.errorCb = ErrorCallback;
 
+    /* measure the time from cold start until the module is ready for operation */
+    uint32_t bootStartTick = WE_GetTick();
     ProteusE_Init(PROTEUSE_DEFAULT_BAUDRATE,
                   WE_FlowControl_NoFlowControl,
                   ProteusE_OperationMode_CommandMode,
                   callbackConfig);
+    printf("Proteus-e ready after %lu ms\r\n", WE_GetTick() - bootStartTick);
+    (void) bootStartTick;
 
 //    printf("Performing factory reset\n");
 //    bool ret = ProteusE_FactoryReset();
@@ -117,25 +121,21 @@ void CommandModeExample()
     memset(fwVersion, 0, sizeof(fwVersion));
     ProteusE_GetFWVersion(fwVersion);
     printf("Firmware version is %u.%u.%u\n", fwVersion[2], fwVersion[1], fwVersion[0]);
-    WE_Delay(500);
 
     uint8_t mac[8];
     memset(mac, 0, sizeof(mac));
     ProteusE_GetMAC(mac);
     printf("MAC is 0x%02x%02x%02x%02x%02x%02x%02x%02x\n", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], mac[6], mac[7]);
-    WE_Delay(500);
 
     uint8_t btMac[6];
     memset(btMac, 0, sizeof(btMac));
     ProteusE_GetBTMAC(btMac);
     printf("BTMAC is 0x%02x%02x%02x%02x%02x%02x\n", btMac[0], btMac[1], btMac[2], btMac[3], btMac[4], btMac[5]);
-    WE_Delay(500);
 
     uint8_t serialNr[3];
     memset(serialNr, 0, sizeof(serialNr));
     ProteusE_GetSerialNumber(serialNr);
     printf("Serial number is 0x%02x%02x%02x\n", serialNr[2], serialNr[1], serialNr[0]);
-    WE_Delay(500);
 
     while (1)
     {
@@ -249,6 +249,10 @@ static uint8_t checksum = 0;
 static uint16_t rxByteCounter = 0;
 static uint16_t bytesToReceive = 0;
 static uint8_t rxBuffer[MAX_RX_PACKET_LENGTH]; /* For UART RX from module */
+#if PROTEUSIII_EVENT_QUEUE_SIZE > 0
+static WE_EventQueue_t eventQueue; /* Packets waiting for their callbacks to be executed by WE_Poll() */
+static uint32_t eventQueueBuffer[PROTEUSIII_EVENT_QUEUE_SIZE / 4];
+#endif
 
 /**************************************
  *         Static functions           *
@@ -265,112 +269,42 @@ static void ClearReceiveBuffers()
     }
 }
 
-static void HandleRxPacket(uint8_t *pRxBuffer)
+/**
+ * @brief Executes the callback (if any) for a received indication or response packet.
+ *
+ * Is called by HandleRxPacket() in interrupt context or, if the event queue is enabled
+ * (see PROTEUSIII_EVENT_QUEUE_SIZE), by WE_Poll() in main loop context.
+ *
+ * @param[in] packet Received packet
+ * @param[in] length Length of packet
+ */
+static void ExecuteCallbacks(uint8_t *packet, uint16_t length)
 {
-    ProteusIII_CMD_Confirmation_t cmdConfirmation;
-    cmdConfirmation.cmd = CNFINVALID;
-    cmdConfirmation.status = CMD_Status_Invalid;
-
-    uint16_t cmdLength = (uint16_t)(pRxBuffer[CMD_POSITION_LENGTH_LSB]+(pRxBuffer[CMD_POSITION_LENGTH_MSB]<<8));
-    memcpy(&rxPacket[0], pRxBuffer, cmdLength + LENGTH_CMD_OVERHEAD);
-
-    switch (rxPacket[CMD_POSITION_CMD])
-    {
-    case PROTEUSIII_CMD_GETDEVICES_CNF:
-    {
-        cmdConfirmation.cmd = rxPacket[CMD_POSITION_CMD];
-        cmdConfirmation.status = rxPacket[CMD_POSITION_DATA];
-        if((cmdConfirmation.status == CMD_Status_Success) && (ProteusIII_getDevicesP != NULL))
-        {
-            uint8_t size = rxPacket[CMD_POSITION_DATA+1];
-
-            if (size >= PROTEUSIII_MAX_NUMBER_OF_DEVICES)
-            {
-                size = PROTEUSIII_MAX_NUMBER_OF_DEVICES;
-            }
-            ProteusIII_getDevicesP->numberOfDevices = size;
-
-            int i;
-            int len = CMD_POSITION_DATA+2;
-            for(i=0; i<ProteusIII_getDevicesP->numberOfDevices; i++)
-            {
-                memcpy(&ProteusIII_getDevicesP->devices[i].btmac[0], &rxPacket[len], 6);
-                ProteusIII_getDevicesP->devices[i].rssi = rxPacket[len+6];
-                ProteusIII_getDevicesP->devices[i].txPower = rxPacket[len+7];
-                ProteusIII_getDevicesP->devices[i].deviceNameLength = rxPacket[len+8];
-                memcpy(&ProteusIII_getDevicesP->devices[i].deviceName[0], &rxPacket[len+9], ProteusIII_getDevicesP->devices[i].deviceNameLength);
-                len += (9 + ProteusIII_getDevicesP->devices[i].deviceNameLength);
-            }
-        }
-        break;
-    }
-    case PROTEUSIII_CMD_RESET_CNF:
-    case PROTEUSIII_CMD_SCANSTART_CNF:
-    case PROTEUSIII_CMD_SCANSTOP_CNF:
-    case PROTEUSIII_CMD_GET_CNF:
-    case PROTEUSIII_CMD_SET_CNF:
-    case PROTEUSIII_CMD_SETBEACON_CNF:
-    case PROTEUSIII_CMD_PASSKEY_CNF:
-    case PROTEUSIII_CMD_PHYUPDATE_CNF:
-    case PROTEUSIII_CMD_CONNECT_CNF:
-    case PROTEUSIII_CMD_DATA_CNF:
-    case PROTEUSIII_CMD_DISCONNECT_CNF:
-    case PROTEUSIII_CMD_FACTORYRESET_CNF:
-    case PROTEUSIII_CMD_SLEEP_CNF:
-    case PROTEUSIII_CMD_UART_DISABLE_CNF:
-    case PROTEUSIII_CMD_UART_ENABLE_IND:
-    case PROTEUSIII_CMD_GPIO_LOCAL_WRITECONFIG_CNF:
-    case PROTEUSIII_CMD_GPIO_LOCAL_READCONFIG_CNF:
-    case PROTEUSIII_CMD_GPIO_LOCAL_WRITE_CNF:
-    case PROTEUSIII_CMD_GPIO_LOCAL_READ_CNF:
-    case PROTEUSIII_CMD_GPIO_REMOTE_WRITECONFIG_CNF:
-    case PROTEUSIII_CMD_GPIO_REMOTE_READCONFIG_CNF:
-    case PROTEUSIII_CMD_GPIO_REMOTE_WRITE_CNF:
-    case PROTEUSIII_CMD_GPIO_REMOTE_READ_CNF:
-    case PROTEUSIII_CMD_GET_BONDS_CNF:
-    case PROTEUSIII_CMD_DELETE_BONDS_CNF:
-    case PROTEUSIII_CMD_ALLOWUNBONDEDCONNECTIONS_CNF:
-    case PROTEUSIII_CMD_TXCOMPLETE_RSP:
-    {
-        cmdConfirmation.cmd = rxPacket[CMD_POSITION_CMD];
-        cmdConfirmation.status = rxPacket[CMD_POSITION_DATA];
-        break;
-    }
+    (void) length;
 
-    case PROTEUSIII_CMD_GETSTATE_CNF:
+    switch (packet[CMD_POSITION_CMD])
     {
-        cmdConfirmation.cmd = rxPacket[CMD_POSITION_CMD];
-        /* GETSTATE_CNF has no status field*/
-        cmdConfirmation.status = CMD_Status_NoStatus;
-        break;
-    }
-
     case PROTEUSIII_CMD_CHANNELOPEN_RSP:
     {
         /* Payload of CHANNELOPEN_RSP: Status (1 byte), BTMAC (6 byte), Max Payload (1byte)*/
-        bleState = ProteusIII_DriverState_BLE_ChannelOpen;
         if(callbacks.channelOpenCb != NULL)
         {
-            callbacks.channelOpenCb(&rxPacket[CMD_POSITION_DATA+1], (uint16_t)rxPacket[CMD_POSITION_DATA + 7]);
+            callbacks.channelOpenCb(&packet[CMD_POSITION_DATA+1], (uint16_t)packet[CMD_POSITION_DATA + 7]);
         }
         break;
     }
 
     case PROTEUSIII_CMD_CONNECT_IND:
     {
-        bool success = rxPacket[CMD_POSITION_DATA] == CMD_Status_Success;
-        if (success)
-        {
-            bleState = ProteusIII_DriverState_BLE_Connected;
-        }
         if (callbacks.connectCb != NULL)
         {
-            uint8_t packetLength = ((uint16_t) rxPacket[CMD_POSITION_LENGTH_LSB] << 0) |
-                                   ((uint16_t) rxPacket[CMD_POSITION_LENGTH_MSB] << 8);
+            bool success = packet[CMD_POSITION_DATA] == CMD_Status_Success;
+            uint8_t packetLength = ((uint16_t) packet[CMD_POSITION_LENGTH_LSB] << 0) |
+                                   ((uint16_t) packet[CMD_POSITION_LENGTH_MSB] << 8);
             uint8_t btMac[6];
             if (packetLength >= 7)
             {
-                memcpy(btMac, rxPacket + CMD_POSITION_DATA + 1, 6);
+                memcpy(btMac, packet + CMD_POSITION_DATA + 1, 6);
             }
             else
             {
@@ -384,11 +318,10 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
 
     case PROTEUSIII_CMD_DISCONNECT_IND:
     {
-        bleState = ProteusIII_DriverState_BLE_Invalid;
         if(callbacks.disconnectCb != NULL)
         {
             ProteusIII_DisconnectReason_t reason = ProteusIII_DisconnectReason_Unknown;
-            switch (rxPacket[CMD_POSITION_DATA])
+            switch (packet[CMD_POSITION_DATA])
             {
             case 0x08:
                 reason = ProteusIII_DisconnectReason_ConnectionTimeout;
@@ -423,12 +356,12 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     {
         if (callbacks.rxCb != NULL)
         {
-            uint16_t payloadLength = (((uint16_t) rxPacket[CMD_POSITION_LENGTH_LSB] << 0) |
-                                      ((uint16_t) rxPacket[CMD_POSITION_LENGTH_MSB] << 8)) - 7;
-            callbacks.rxCb(&rxPacket[CMD_POSITION_DATA + 7],
+            uint16_t payloadLength = (((uint16_t) packet[CMD_POSITION_LENGTH_LSB] << 0) |
+                                      ((uint16_t) packet[CMD_POSITION_LENGTH_MSB] << 8)) - 7;
+            callbacks.rxCb(&packet[CMD_POSITION_DATA + 7],
                            payloadLength,
-                           &rxPacket[CMD_POSITION_DATA],
-                           rxPacket[CMD_POSITION_DATA + 6]);
+                           &packet[CMD_POSITION_DATA],
+                           packet[CMD_POSITION_DATA + 6]);
         }
         break;
     }
@@ -438,12 +371,12 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     {
         if (callbacks.beaconRxCb != NULL)
         {
-            uint16_t payloadLength = (((uint16_t) rxPacket[CMD_POSITION_LENGTH_LSB] << 0) |
-                                      ((uint16_t) rxPacket[CMD_POSITION_LENGTH_MSB] << 8)) - 7;
-            callbacks.beaconRxCb(&rxPacket[CMD_POSITION_DATA + 7],
+            uint16_t payloadLength = (((uint16_t) packet[CMD_POSITION_LENGTH_LSB] << 0) |
+                                      ((uint16_t) packet[CMD_POSITION_LENGTH_MSB] << 8)) - 7;
+            callbacks.beaconRxCb(&packet[CMD_POSITION_DATA + 7],
                                  payloadLength,
-                                 &rxPacket[CMD_POSITION_DATA],
-                                 rxPacket[CMD_POSITION_DATA + 6]);
+                                 &packet[CMD_POSITION_DATA],
+                                 packet[CMD_POSITION_DATA + 6]);
         }
         break;
     }
@@ -451,13 +384,13 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     case PROTEUSIII_CMD_RSSI_IND:
         if (callbacks.rssiCb != NULL)
         {
-            uint16_t packetLength = (((uint16_t) rxPacket[CMD_POSITION_LENGTH_LSB] << 0) |
-                                     ((uint16_t) rxPacket[CMD_POSITION_LENGTH_MSB] << 8));
+            uint16_t packetLength = (((uint16_t) packet[CMD_POSITION_LENGTH_LSB] << 0) |
+                                     ((uint16_t) packet[CMD_POSITION_LENGTH_MSB] << 8));
             if (packetLength >= 8)
             {
-                callbacks.rssiCb(&rxPacket[CMD_POSITION_DATA],
-                                 rxPacket[CMD_POSITION_DATA + 6],
-                                 rxPacket[CMD_POSITION_DATA + 7]);
+                callbacks.rssiCb(&packet[CMD_POSITION_DATA],
+                                 packet[CMD_POSITION_DATA + 6],
+                                 packet[CMD_POSITION_DATA + 7]);
             }
         }
         break;
@@ -466,7 +399,7 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     {
         if (callbacks.securityCb != NULL)
         {
-            callbacks.securityCb(&rxPacket[CMD_POSITION_DATA+1],rxPacket[CMD_POSITION_DATA]);
+            callbacks.securityCb(&packet[CMD_POSITION_DATA+1],packet[CMD_POSITION_DATA]);
         }
         break;
     }
@@ -475,7 +408,7 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     {
         if (callbacks.passkeyCb != NULL)
         {
-            callbacks.passkeyCb(&rxPacket[CMD_POSITION_DATA+1]);
+            callbacks.passkeyCb(&packet[CMD_POSITION_DATA+1]);
         }
         break;
     }
@@ -484,7 +417,7 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     {
         if(callbacks.displayPasskeyCb != NULL)
         {
-            callbacks.displayPasskeyCb((ProteusIII_DisplayPasskeyAction_t)rxPacket[CMD_POSITION_DATA],&rxPacket[CMD_POSITION_DATA+1],&rxPacket[CMD_POSITION_DATA+7]);
+            callbacks.displayPasskeyCb((ProteusIII_DisplayPasskeyAction_t)packet[CMD_POSITION_DATA],&packet[CMD_POSITION_DATA+1],&packet[CMD_POSITION_DATA+7]);
         }
         break;
     }
@@ -493,13 +426,13 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     {
         if (callbacks.phyUpdateCb != NULL)
         {
-            bool success = rxPacket[CMD_POSITION_DATA] == CMD_Status_Success;
-            uint8_t packetLength = ((uint16_t) rxPacket[CMD_POSITION_LENGTH_LSB] << 0) |
-                                   ((uint16_t) rxPacket[CMD_POSITION_LENGTH_MSB] << 8);
+            bool success = packet[CMD_POSITION_DATA] == CMD_Status_Success;
+            uint8_t packetLength = ((uint16_t) packet[CMD_POSITION_LENGTH_LSB] << 0) |
+                                   ((uint16_t) packet[CMD_POSITION_LENGTH_MSB] << 8);
             uint8_t btMac[6];
             if (packetLength >= 9)
             {
-                memcpy(btMac, rxPacket + CMD_POSITION_DATA + 3, 6);
+                memcpy(btMac, packet + CMD_POSITION_DATA + 3, 6);
             }
             else
             {
@@ -508,8 +441,8 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
             }
             callbacks.phyUpdateCb(success,
                                   btMac,
-                                  (ProteusIII_Phy_t)rxPacket[CMD_POSITION_DATA+1],
-                                  (ProteusIII_Phy_t)rxPacket[CMD_POSITION_DATA+2]);
+                                  (ProteusIII_Phy_t)packet[CMD_POSITION_DATA+1],
+                                  (ProteusIII_Phy_t)packet[CMD_POSITION_DATA+2]);
         }
         break;
     }
@@ -525,18 +458,18 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     case PROTEUSIII_CMD_GPIO_REMOTE_WRITE_IND:
         if (callbacks.gpioWriteCb != NULL)
         {
-            uint8_t packetLength = ((uint16_t) rxPacket[CMD_POSITION_LENGTH_LSB] << 0) |
-                                   ((uint16_t) rxPacket[CMD_POSITION_LENGTH_MSB] << 8);
+            uint8_t packetLength = ((uint16_t) packet[CMD_POSITION_LENGTH_LSB] << 0) |
+                                   ((uint16_t) packet[CMD_POSITION_LENGTH_MSB] << 8);
             uint8_t pos = 0;
             while (pos < packetLength)
             {
-                uint8_t blockLength = rxPacket[CMD_POSITION_DATA + pos] + 1;
+                uint8_t blockLength = packet[CMD_POSITION_DATA + pos] + 1;
 
                 /* Note that the gpioId parameter is of type uint8_t instead of ProteusIII_GPIO_t, as the
                  * remote device may support other GPIOs than this device. */
-                uint8_t gpioId = rxPacket[CMD_POSITION_DATA + 1 + pos];
-                uint8_t value = rxPacket[CMD_POSITION_DATA + 2 + pos];
-                callbacks.gpioWriteCb(PROTEUSIII_CMD_GPIO_REMOTE_WRITE_IND == rxPacket[CMD_POSITION_CMD], gpioId, value);
+                uint8_t gpioId = packet[CMD_POSITION_DATA + 1 + pos];
+                uint8_t value = packet[CMD_POSITION_DATA + 2 + pos];
+                callbacks.gpioWriteCb(PROTEUSIII_CMD_GPIO_REMOTE_WRITE_IND == packet[CMD_POSITION_CMD], gpioId, value);
 
                 pos += blockLength;
             }
@@ -546,16 +479,16 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     case PROTEUSIII_CMD_GPIO_REMOTE_WRITECONFIG_IND:
         if (callbacks.gpioRemoteConfigCb != NULL)
         {
-            uint8_t packetLength = ((uint16_t) rxPacket[CMD_POSITION_LENGTH_LSB] << 0) |
-                                   ((uint16_t) rxPacket[CMD_POSITION_LENGTH_MSB] << 8);
+            uint8_t packetLength = ((uint16_t) packet[CMD_POSITION_LENGTH_LSB] << 0) |
+                                   ((uint16_t) packet[CMD_POSITION_LENGTH_MSB] << 8);
             uint8_t pos = 0;
             while (pos < packetLength)
             {
-                uint8_t blockLength = rxPacket[CMD_POSITION_DATA + pos] + 1;
+                uint8_t blockLength = packet[CMD_POSITION_DATA + pos] + 1;
 
-                uint8_t gpioId = rxPacket[CMD_POSITION_DATA + 1 + pos];
-                uint8_t function = rxPacket[CMD_POSITION_DATA + 2 + pos];
-                uint8_t *value = rxPacket + CMD_POSITION_DATA + 3 + pos;
+                uint8_t gpioId = packet[CMD_POSITION_DATA + 1 + pos];
+                uint8_t function = packet[CMD_POSITION_DATA + 2 + pos];
+                uint8_t *value = packet + CMD_POSITION_DATA + 3 + pos;
 
                 ProteusIII_GPIOConfigBlock_t gpioConfig = {0};
                 gpioConfig.gpioId = (ProteusIII_GPIO_t) gpioId;
@@ -588,10 +521,139 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
     case PROTEUSIII_CMD_ERROR_IND:
         if (callbacks.errorCb != NULL)
         {
-            callbacks.errorCb(rxPacket[CMD_POSITION_DATA]);
+            callbacks.errorCb(packet[CMD_POSITION_DATA]);
         }
         break;
 
+    default:
+    {
+        /* no callback */
+        break;
+    }
+    }
+}
+
+static void HandleRxPacket(uint8_t *pRxBuffer)
+{
+    ProteusIII_CMD_Confirmation_t cmdConfirmation;
+    cmdConfirmation.cmd = CNFINVALID;
+    cmdConfirmation.status = CMD_Status_Invalid;
+    bool executeCallbacks = false;
+
+    uint16_t cmdLength = (uint16_t)(pRxBuffer[CMD_POSITION_LENGTH_LSB]+(pRxBuffer[CMD_POSITION_LENGTH_MSB]<<8));
+    memcpy(&rxPacket[0], pRxBuffer, cmdLength + LENGTH_CMD_OVERHEAD);
+
+    switch (rxPacket[CMD_POSITION_CMD])
+    {
+    case PROTEUSIII_CMD_GETDEVICES_CNF:
+    {
+        cmdConfirmation.cmd = rxPacket[CMD_POSITION_CMD];
+        cmdConfirmation.status = rxPacket[CMD_POSITION_DATA];
+        if((cmdConfirmation.status == CMD_Status_Success) && (ProteusIII_getDevicesP != NULL))
+        {
+            uint8_t size = rxPacket[CMD_POSITION_DATA+1];
+
+            if (size >= PROTEUSIII_MAX_NUMBER_OF_DEVICES)
+            {
+                size = PROTEUSIII_MAX_NUMBER_OF_DEVICES;
+            }
+            ProteusIII_getDevicesP->numberOfDevices = size;
+
+            int i;
+            int len = CMD_POSITION_DATA+2;
+            for(i=0; i<ProteusIII_getDevicesP->numberOfDevices; i++)
+            {
+                memcpy(&ProteusIII_getDevicesP->devices[i].btmac[0], &rxPacket[len], 6);
+                ProteusIII_getDevicesP->devices[i].rssi = rxPacket[len+6];
+                ProteusIII_getDevicesP->devices[i].txPower = rxPacket[len+7];
+                ProteusIII_getDevicesP->devices[i].deviceNameLength = rxPacket[len+8];
+                memcpy(&ProteusIII_getDevicesP->devices[i].deviceName[0], &rxPacket[len+9], ProteusIII_getDevicesP->devices[i].deviceNameLength);
+                len += (9 + ProteusIII_getDevicesP->devices[i].deviceNameLength);
+            }
+        }
+        break;
+    }
+    case PROTEUSIII_CMD_RESET_CNF:
+    case PROTEUSIII_CMD_SCANSTART_CNF:
+    case PROTEUSIII_CMD_SCANSTOP_CNF:
+    case PROTEUSIII_CMD_GET_CNF:
+    case PROTEUSIII_CMD_SET_CNF:
+    case PROTEUSIII_CMD_SETBEACON_CNF:
+    case PROTEUSIII_CMD_PASSKEY_CNF:
+    case PROTEUSIII_CMD_PHYUPDATE_CNF:
+    case PROTEUSIII_CMD_CONNECT_CNF:
+    case PROTEUSIII_CMD_DATA_CNF:
+    case PROTEUSIII_CMD_DISCONNECT_CNF:
+    case PROTEUSIII_CMD_FACTORYRESET_CNF:
+    case PROTEUSIII_CMD_SLEEP_CNF:
+    case PROTEUSIII_CMD_UART_DISABLE_CNF:
+    case PROTEUSIII_CMD_UART_ENABLE_IND:
+    case PROTEUSIII_CMD_GPIO_LOCAL_WRITECONFIG_CNF:
+    case PROTEUSIII_CMD_GPIO_LOCAL_READCONFIG_CNF:
+    case PROTEUSIII_CMD_GPIO_LOCAL_WRITE_CNF:
+    case PROTEUSIII_CMD_GPIO_LOCAL_READ_CNF:
+    case PROTEUSIII_CMD_GPIO_REMOTE_WRITECONFIG_CNF:
+    case PROTEUSIII_CMD_GPIO_REMOTE_READCONFIG_CNF:
+    case PROTEUSIII_CMD_GPIO_REMOTE_WRITE_CNF:
+    case PROTEUSIII_CMD_GPIO_REMOTE_READ_CNF:
+    case PROTEUSIII_CMD_GET_BONDS_CNF:
+    case PROTEUSIII_CMD_DELETE_BONDS_CNF:
+    case PROTEUSIII_CMD_ALLOWUNBONDEDCONNECTIONS_CNF:
+    case PROTEUSIII_CMD_TXCOMPLETE_RSP:
+    {
+        cmdConfirmation.cmd = rxPacket[CMD_POSITION_CMD];
+        cmdConfirmation.status = rxPacket[CMD_POSITION_DATA];
+        break;
+    }
+
+    case PROTEUSIII_CMD_GETSTATE_CNF:
+    {
+        cmdConfirmation.cmd = rxPacket[CMD_POSITION_CMD];
+        /* GETSTATE_CNF has no status field*/
+        cmdConfirmation.status = CMD_Status_NoStatus;
+        break;
+    }
+
+    case PROTEUSIII_CMD_CHANNELOPEN_RSP:
+    {
+        bleState = ProteusIII_DriverState_BLE_ChannelOpen;
+        executeCallbacks = true;
+        break;
+    }
+
+    case PROTEUSIII_CMD_CONNECT_IND:
+    {
+        if (rxPacket[CMD_POSITION_DATA] == CMD_Status_Success)
+        {
+            bleState = ProteusIII_DriverState_BLE_Connected;
+        }
+        executeCallbacks = true;
+        break;
+    }
+
+    case PROTEUSIII_CMD_DISCONNECT_IND:
+    {
+        bleState = ProteusIII_DriverState_BLE_Invalid;
+        executeCallbacks = true;
+        break;
+    }
+
+    case PROTEUSIII_CMD_DATA_IND:
+    case PROTEUSIII_CMD_BEACON_IND:
+    case PROTEUSIII_CMD_BEACON_RSP:
+    case PROTEUSIII_CMD_RSSI_IND:
+    case PROTEUSIII_CMD_SECURITY_IND:
+    case PROTEUSIII_CMD_PASSKEY_IND:
+    case PROTEUSIII_CMD_DISPLAY_PASSKEY_IND:
+    case PROTEUSIII_CMD_PHYUPDATE_IND:
+    case PROTEUSIII_CMD_SLEEP_IND:
+    case PROTEUSIII_CMD_GPIO_LOCAL_WRITE_IND:
+    case PROTEUSIII_CMD_GPIO_REMOTE_WRITE_IND:
+    case PROTEUSIII_CMD_GPIO_REMOTE_WRITECONFIG_IND:
+    case PROTEUSIII_CMD_ERROR_IND:
+        executeCallbacks = true;
+        break;
+
     default:
     {
         /* invalid*/
@@ -609,6 +671,16 @@ static void HandleRxPacket(uint8_t *pRxBuffer)
             break;
         }
     }
+
+    if (executeCallbacks)
+    {
+#if PROTEUSIII_EVENT_QUEUE_SIZE > 0
+        /* Defer callback to main loop (see WE_Poll()) */
+        WE_EventQueue_Push(&eventQueue, rxPacket, cmdLength + LENGTH_CMD_OVERHEAD);
+#else
+        ExecuteCallbacks(rxPacket, cmdLength + LENGTH_CMD_OVERHEAD);
+#endif
+    }
 }
 
 void ProteusIII_HandleRxByte(uint8_t receivedByte)
@@ -798,15 +870,18 @@ bool ProteusIII_Init(uint32_t baudrate,
     callbacks = callbackConfig;
     byteRxCallback = ProteusIII_HandleRxByte;
 
+#if PROTEUSIII_EVENT_QUEUE_SIZE > 0
+    if (!WE_EventQueue_Init(&eventQueue, (uint8_t *) eventQueueBuffer, sizeof(eventQueueBuffer), ExecuteCallbacks))
+    {
+        return false;
+    }
+#endif
+
     WE_UART_Init(baudrate, flowControl, WE_Parity_None, true);
     WE_Delay(10);
 
-    /* reset module */
-    if (ProteusIII_PinReset())
-    {
-        WE_Delay(PROTEUSIII_BOOT_DURATION);
-    }
-    else
+    /* reset module, it is ready for operation as soon as ProteusIII_PinReset() returns */
+    if (false == ProteusIII_PinReset())
     {
         fprintf(stdout, "Pin reset failed\n");
         ProteusIII_Deinit();
@@ -822,7 +897,6 @@ bool ProteusIII_Init(uint32_t baudrate,
     {
         fprintf(stdout, "ProteusIII driver version %d.%d.%d\n", driverVersion[0], driverVersion[1], driverVersion[2]);
     }
-    WE_Delay(100);
 
     return true;
 }
@@ -850,9 +924,26 @@ bool ProteusIII_Deinit()
     /* make sure any bytes remaining in receive buffer are discarded */
     ClearReceiveBuffers();
 
+#if PROTEUSIII_EVENT_QUEUE_SIZE > 0
+    /* discard packets whose callbacks have not been executed yet */
+    WE_EventQueue_Clear(&eventQueue);
+#endif
+
     return true;
 }
 
+#if PROTEUSIII_EVENT_QUEUE_SIZE > 0
+/**
+ * @brief Returns the statistics of the event queue (queue depth, dropped packets, dispatch latency).
+ *
+ * @param[out] stats Event queue statistics
+ */
+void ProteusIII_GetEventQueueStats(WE_EventQueue_Stats_t *stats)
+{
+    WE_EventQueue_GetStats(&eventQueue, stats);
+}
+#endif
+
 /**
  * @brief Wake up the ProteusIII from sleep by pin.
  *
@@ -925,7 +1016,9 @@ bool ProteusIII_PinReset()
 
     if (operationMode == ProteusIII_OperationMode_PeripheralOnlyMode)
     {
-        /* peripheral only mode is ready (the module doesn't send a "ready for operation" message in peripheral only mode) */
+        /* the module doesn't send a "ready for operation" message in peripheral only mode,
+         * so wait for the boot duration specified in the manual instead */
+        WE_Delay(PROTEUSIII_BOOT_DURATION);
         return true;
     }
 
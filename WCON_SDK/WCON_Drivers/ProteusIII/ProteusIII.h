@@ -62,6 +62,16 @@ extern "C" {
  * support more devices. */
 #define PROTEUSIII_MAX_BOND_DEVICES (uint8_t)20
 
+/* Size of the queue used to defer callbacks to the main loop (bytes, multiple of 4).
+ * If 0 (default), the callbacks are executed in interrupt context. Otherwise, received
+ * packets are added to a queue of this size and the callbacks are executed by WE_Poll(),
+ * which must then be called from the application's main loop. Each packet occupies
+ * WE_EVENT_QUEUE_RECORD_SIZE(packet length) bytes, packets which don't fit are dropped
+ * (see ProteusIII_GetEventQueueStats()). */
+#ifndef PROTEUSIII_EVENT_QUEUE_SIZE
+#define PROTEUSIII_EVENT_QUEUE_SIZE 0
+#endif
+
 typedef enum ProteusIII_OperationMode_t
 {
     ProteusIII_OperationMode_CommandMode,
@@ -449,6 +459,8 @@ typedef void (*ProteusIII_ByteRxCallback)(uint8_t receivedByte);
  * Please note that code in callbacks should be kept simple, as the callback
  * functions are called from ISRs. For this reason, it is also not possible
  * to send requests to the Proteus-III directly from inside a callback.
+ * Both restrictions don't apply if the callbacks are deferred to the main loop
+ * (see PROTEUSIII_EVENT_QUEUE_SIZE).
  */
 typedef struct ProteusIII_CallbackConfig_t
 {
@@ -473,6 +485,9 @@ extern bool ProteusIII_Init(uint32_t baudrate,
                             ProteusIII_OperationMode_t opMode,
                             ProteusIII_CallbackConfig_t callbackConfig);
 extern bool ProteusIII_Deinit(void);
+#if PROTEUSIII_EVENT_QUEUE_SIZE > 0
+extern void ProteusIII_GetEventQueueStats(WE_EventQueue_Stats_t *stats);
+#endif
 
 extern bool ProteusIII_GetState(ProteusIII_ModuleState_t *moduleStateP);
 
@@ -0,0 +1,291 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Sniffer capture pipeline source file.
+ */
+
+#include "SnifferCapture.h"
+
+#include <string.h>
+
+#include "../global/global.h"
+
+#if ((SNIFFERCAPTURE_BUFFER_SIZE & (SNIFFERCAPTURE_BUFFER_SIZE - 1)) != 0) || (SNIFFERCAPTURE_BUFFER_SIZE > 32768)
+#error "SNIFFERCAPTURE_BUFFER_SIZE must be a power of two and not larger than 32768"
+#endif
+
+#define BUFFER_MASK (SNIFFERCAPTURE_BUFFER_SIZE - 1)
+
+#define STREAM_VERSION 1
+#define RECORD_SYNC_0  0xA5
+#define RECORD_SYNC_1  0x5A
+
+/* prevents the compiler from moving buffer accesses across index updates */
+#define COMPILER_BARRIER() __asm volatile ("" ::: "memory")
+
+/**************************************
+ *          Static variables          *
+ **************************************/
+
+static uint8_t buffer[SNIFFERCAPTURE_BUFFER_SIZE];
+static volatile uint16_t head = 0;                /* written by the producer only (free running) */
+static volatile uint16_t tail = 0;                /* written by the consumer only (free running) */
+static uint16_t droppedSinceLastRecord = 0;       /* accessed by the producer only */
+static volatile uint32_t droppedTotal = 0;        /* written by the producer only */
+
+/**************************************
+ *         Static functions           *
+ **************************************/
+
+/**
+ * @brief Write one byte to the ring buffer without publishing it
+ */
+static inline void PutByte(uint16_t* pos, uint8_t byte, uint8_t* checksum)
+{
+    buffer[*pos & BUFFER_MASK] = byte;
+    *checksum ^= byte;
+    (*pos)++;
+}
+
+/**
+ * @brief Write a 16 bit value (little endian) to the ring buffer without publishing it
+ */
+static inline void PutUint16(uint16_t* pos, uint16_t value, uint8_t* checksum)
+{
+    PutByte(pos, (uint8_t)value, checksum);
+    PutByte(pos, (uint8_t)(value >> 8), checksum);
+}
+
+/**
+ * @brief Write a 32 bit value (little endian) to the ring buffer without publishing it
+ */
+static inline void PutUint32(uint16_t* pos, uint32_t value, uint8_t* checksum)
+{
+    PutUint16(pos, (uint16_t)value, checksum);
+    PutUint16(pos, (uint16_t)(value >> 16), checksum);
+}
+
+/**
+ * @brief Hand the queued data to the sink or the file in contiguous chunks
+ */
+static uint16_t Drain(void(*sink)(const uint8_t*,uint16_t), FILE* file)
+{
+    uint16_t drained = 0;
+
+    while (1)
+    {
+        uint16_t pos = tail;
+        uint16_t pending = (uint16_t)(head - pos);
+        if (pending == 0)
+        {
+            break;
+        }
+        COMPILER_BARRIER();
+
+        /* limit the chunk to the end of the buffer */
+        uint16_t offset = pos & BUFFER_MASK;
+        uint16_t chunk = SNIFFERCAPTURE_BUFFER_SIZE - offset;
+        if (chunk > pending)
+        {
+            chunk = pending;
+        }
+
+        if (sink != NULL)
+        {
+            sink(&buffer[offset], chunk);
+        }
+        else
+        {
+            chunk = (uint16_t)fwrite(&buffer[offset], 1, chunk, file);
+            if (chunk == 0)
+            {
+                /* file error, keep the data in the buffer */
+                break;
+            }
+        }
+
+        COMPILER_BARRIER();
+        tail = pos + chunk;
+        drained += chunk;
+    }
+    return drained;
+}
+
+/**************************************
+ *         Global functions           *
+ **************************************/
+
+/**
+ * @brief Initialize the capture pipeline and queue the stream header
+ *
+ * Note: Must be called before the first call of SnifferCapture_Push.
+ *
+ * @param[in] source: module that captures the packets
+ */
+void SnifferCapture_Init(SnifferCapture_Source_t source)
+{
+    uint8_t checksum = 0;
+    uint16_t pos = 0;
+
+    droppedSinceLastRecord = 0;
+    droppedTotal = 0;
+    tail = 0;
+
+    PutByte(&pos, 'W', &checksum);
+    PutByte(&pos, 'E', &checksum);
+    PutByte(&pos, 'S', &checksum);
+    PutByte(&pos, 'C', &checksum);
+    PutByte(&pos, STREAM_VERSION, &checksum);
+    PutByte(&pos, (uint8_t)source, &checksum);
+    PutUint16(&pos, 0, &checksum);
+
+    COMPILER_BARRIER();
+    head = pos;
+}
+
+/**
+ * @brief Stamp a captured packet and queue it as record
+ *
+ * This function is intended to be called from the RX callback of the driver.
+ * It does not block. If the ring buffer is full, the packet is dropped and
+ * counted in the next record.
+ *
+ * @param[in] payload: pointer to the captured packet
+ * @param[in] payload_length: length of the captured packet
+ * @param[in] source_address: source address of the packet
+ * @param[in] rssi: RSSI of the packet
+ *
+ * @return true if the packet has been queued,
+ *         false otherwise
+ */
+bool SnifferCapture_Push(uint8_t* payload, uint16_t payload_length, uint32_t source_address, int8_t rssi)
+{
+    /* take the timestamp first, so that it is as close to the reception as possible */
+    uint32_t timestamp = WE_GetTickMicroseconds();
+
+    uint16_t pos = head;
+    uint16_t record_length = SNIFFERCAPTURE_RECORD_OVERHEAD + payload_length;
+    if ((payload_length > SNIFFERCAPTURE_MAX_PAYLOAD_LENGTH) ||
+        (record_length > (uint16_t)(SNIFFERCAPTURE_BUFFER_SIZE - (uint16_t)(pos - tail))))
+    {
+        /* record does not fit into the buffer */
+        if (droppedSinceLastRecord < 0xFFFF)
+        {
+            droppedSinceLastRecord++;
+        }
+        droppedTotal++;
+        return false;
+    }
+
+    uint8_t checksum = 0;
+    PutByte(&pos, RECORD_SYNC_0, &checksum);
+    PutByte(&pos, RECORD_SYNC_1, &checksum);
+    checksum = 0;
+    PutByte(&pos, (uint8_t)payload_length, &checksum);
+    PutByte(&pos, (uint8_t)rssi, &checksum);
+    PutUint16(&pos, droppedSinceLastRecord, &checksum);
+    PutUint32(&pos, timestamp, &checksum);
+    PutUint32(&pos, source_address, &checksum);
+
+    /* copy the payload in at most two chunks */
+    uint16_t offset = pos & BUFFER_MASK;
+    uint16_t first = SNIFFERCAPTURE_BUFFER_SIZE - offset;
+    if (first > payload_length)
+    {
+        first = payload_length;
+    }
+    memcpy(&buffer[offset], payload, first);
+    memcpy(&buffer[0], payload + first, payload_length - first);
+    int i = 0;
+    for (i = 0; i < payload_length; i++)
+    {
+        checksum ^= payload[i];
+    }
+    pos += payload_length;
+    buffer[pos & BUFFER_MASK] = checksum;
+    pos++;
+
+    /* publish the record */
+    COMPILER_BARRIER();
+    head = pos;
+    droppedSinceLastRecord = 0;
+    return true;
+}
+
+/**
+ * @brief Forward the queued record stream to a sink (e.g. a UART transmit function)
+ *
+ * Note: The sink is called with contiguous chunks of the ring buffer and must consume them completely.
+ *
+ * @param[in] sink: function that consumes the data
+ *
+ * @return number of bytes forwarded
+ */
+uint16_t SnifferCapture_Drain(void(*sink)(const uint8_t*,uint16_t))
+{
+    if (sink == NULL)
+    {
+        return 0;
+    }
+    return Drain(sink, NULL);
+}
+
+/**
+ * @brief Write the queued record stream to a file (e.g. stdout redirected to the debug UART)
+ *
+ * @param[in] file: file to write to
+ *
+ * @return number of bytes written
+ */
+uint16_t SnifferCapture_DrainToFile(FILE* file)
+{
+    if (file == NULL)
+    {
+        return 0;
+    }
+    return Drain(NULL, file);
+}
+
+/**
+ * @brief Get the number of bytes waiting to be drained
+ *
+ * @return number of queued bytes
+ */
+uint16_t SnifferCapture_GetPendingBytes(void)
+{
+    return (uint16_t)(head - tail);
+}
+
+/**
+ * @brief Get the number of packets that have been dropped since SnifferCapture_Init
+ *
+ * @return number of dropped packets
+ */
+uint32_t SnifferCapture_GetDroppedCount(void)
+{
+    return droppedTotal;
+}
@@ -0,0 +1,90 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Sniffer capture pipeline header file.
+ *
+ * Packets captured in sniffer mode (e.g. TarvosIII_EnableSnifferMode() or
+ * ThyoneI_OperatingMode_Sniffer) are stamped with WE_GetTickMicroseconds(),
+ * serialized into a binary record stream and queued into a lock-free ring buffer.
+ *
+ * Usage:
+ * - Call SnifferCapture_Init() before the module is initialized.
+ * - Call SnifferCapture_Push() from the RX callback of the driver (UART interrupt context).
+ * - Call SnifferCapture_Drain() or SnifferCapture_DrainToFile() from the main loop to
+ *   forward the record stream to a UART or a file.
+ *
+ * SnifferCapture_Push() must only be called from a single context (producer) and the
+ * drain functions must only be called from a single other context (consumer).
+ *
+ * Stream format (all values little endian):
+ * - Stream header (8 bytes): magic "WESC", version (1 byte), source (1 byte, SnifferCapture_Source_t), reserved (2 bytes)
+ * - Record (15 + payload length bytes): sync 0xA5 0x5A, payload length (1 byte), RSSI (1 byte, signed),
+ *   number of records dropped before this record (2 bytes), timestamp in microseconds (4 bytes, wraps after 2^32 us),
+ *   source address (4 bytes), payload, checksum (XOR of all record bytes following the sync bytes)
+ *
+ * The stream can be decoded on the host using Tools/SnifferCapture/sniffer_reader.py.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SNIFFERCAPTURE_H_INCLUDED
+#define SNIFFERCAPTURE_H_INCLUDED
+
+/* size of the ring buffer in bytes, must be a power of two and not larger than 32768 */
+#ifndef SNIFFERCAPTURE_BUFFER_SIZE
+#define SNIFFERCAPTURE_BUFFER_SIZE 2048
+#endif
+
+#define SNIFFERCAPTURE_STREAM_HEADER_LENGTH 8
+#define SNIFFERCAPTURE_RECORD_OVERHEAD      15
+#define SNIFFERCAPTURE_MAX_PAYLOAD_LENGTH   255
+
+typedef enum SnifferCapture_Source_t
+{
+    SnifferCapture_Source_Unknown = 0x00,
+    SnifferCapture_Source_ThyoneI = 0x01,
+    SnifferCapture_Source_ProprietaryRadio = 0x02,    /* TarvosIII, TelestoIII, ThebeII, ThemistoI */
+} SnifferCapture_Source_t;
+
+extern void SnifferCapture_Init(SnifferCapture_Source_t source);
+extern bool SnifferCapture_Push(uint8_t* payload, uint16_t payload_length, uint32_t source_address, int8_t rssi);
+extern uint16_t SnifferCapture_Drain(void(*sink)(const uint8_t*,uint16_t));
+extern uint16_t SnifferCapture_DrainToFile(FILE* file);
+extern uint16_t SnifferCapture_GetPendingBytes(void);
+extern uint32_t SnifferCapture_GetDroppedCount(void);
+
+#endif // SNIFFERCAPTURE_H_INCLUDED
+
+#ifdef __cplusplus
+}
+#endif
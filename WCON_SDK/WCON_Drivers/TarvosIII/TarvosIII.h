@@ -42,6 +42,9 @@ extern "C" {
 #define TARVOSIII_BROADCASTADDRESS 0xFF
 #define TARVOSIII_MAX_USERSETTING_LENGTH 4
 
+#define TARVOSIII_MIN_RFCHANNEL 100
+#define TARVOSIII_MAX_RFCHANNEL 140
+
 #define TARVOSIII_DEFAULT_BAUDRATE (uint32_t)115200
 
 typedef enum TarvosIII_AddressMode_t
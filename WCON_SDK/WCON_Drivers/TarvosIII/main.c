@@ -71,7 +71,11 @@ int main(void)
     WE_GetDriverVersion(driverVersion);
     printf("Wuerth Elektronik eiSos Wireless Connectivity SDK version %d.%d.%d\r\n", driverVersion[0], driverVersion[1], driverVersion[2]);
 
+    /* measure the time from cold start until the module is ready for operation */
+    uint32_t bootStartTick = WE_GetTick();
     TarvosIII_Init(TARVOSIII_DEFAULT_BAUDRATE, WE_FlowControl_NoFlowControl, AddressMode_0, RxCallback);
+    printf("Tarvos-III ready after %lu ms\r\n", WE_GetTick() - bootStartTick);
+    (void) bootStartTick;
 
     while (1)
     {
@@ -90,6 +94,5 @@ int main(void)
         WE_Delay(500);
 
         ret = TarvosIII_PinReset();
-        WE_Delay(500);
     }
 }
@@ -42,6 +42,9 @@ extern "C" {
 #define TELESTOIII_BROADCASTADDRESS 0xFF
 #define TELESTOIII_MAX_USERSETTING_LENGTH 4
 
+#define TELESTOIII_MIN_RFCHANNEL 201
+#define TELESTOIII_MAX_RFCHANNEL 251
+
 typedef enum TelestoIII_AddressMode_t
 {
     AddressMode_0 = 0x00,
@@ -129,6 +132,8 @@ extern bool TelestoIII_SetVolatile_DestNetID(uint8_t destnetid);
 extern bool TelestoIII_SetVolatile_TXPower(uint8_t power);
 extern bool TelestoIII_SetVolatile_Channel(uint8_t channel);
 
+extern bool TelestoIII_Ping();
+
 #endif // TELESTOIII_H_INCLUDED
 
 #ifdef __cplusplus
@@ -0,0 +1,643 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Sliding window reliable unicast transport for the Thyone-I source file.
+ */
+
+#include "ReliableTransport.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../global/global.h"
+
+#if (RELIABLETRANSPORT_WINDOW_SIZE < 2) || (RELIABLETRANSPORT_WINDOW_SIZE > 32) || ((RELIABLETRANSPORT_WINDOW_SIZE & (RELIABLETRANSPORT_WINDOW_SIZE - 1)) != 0)
+#error "RELIABLETRANSPORT_WINDOW_SIZE must be a power of two between 2 and 32"
+#endif
+
+#if (RELIABLETRANSPORT_RX_QUEUE_LENGTH & (RELIABLETRANSPORT_RX_QUEUE_LENGTH - 1)) != 0
+#error "RELIABLETRANSPORT_RX_QUEUE_LENGTH must be a power of two"
+#endif
+
+#define WINDOW_MASK (RELIABLETRANSPORT_WINDOW_SIZE - 1)
+#define FRAME_LENGTH (RELIABLETRANSPORT_HEADER_LENGTH + RELIABLETRANSPORT_MAX_PAYLOAD_LENGTH)
+
+#define TYPE_MASK     0xF0
+#define TYPE_MARKER   0xE0
+#define TYPE_DATA     0xE0      /* data packet */
+#define TYPE_ACK      0xE1      /* cumulative and selective acknowledgement */
+#define TYPE_DATA_SYN 0xE2      /* data packet, sent until the peer acknowledged the start of the stream */
+
+#define ACK_LENGTH 6
+
+/* number of packets acknowledged after a gap before the missing packet is repeated without waiting for the timeout */
+#define FAST_RETRANSMIT_THRESHOLD 2
+
+typedef struct ReliableTransport_TxSlot_t
+{
+    bool acked;
+    bool retransmitted;             /* no RTT samples are taken from repeated packets */
+    uint8_t retries;
+    uint16_t length;                /* length of the frame including header */
+    uint32_t sentTick;
+    uint8_t frame[FRAME_LENGTH];
+} ReliableTransport_TxSlot_t;
+
+typedef struct ReliableTransport_RxSlot_t
+{
+    bool filled;
+    uint8_t seq;
+    uint16_t length;
+    uint8_t data[RELIABLETRANSPORT_MAX_PAYLOAD_LENGTH];
+} ReliableTransport_RxSlot_t;
+
+typedef struct ReliableTransport_Peer_t
+{
+    bool used;
+    uint32_t address;
+    uint32_t lastTick;
+
+    /* transmit direction */
+    uint8_t txBase;                 /* oldest unacknowledged sequence number */
+    uint8_t txNext;                 /* next sequence number to be used */
+    bool synAcked;                  /* peer acknowledged the start of the stream */
+    uint8_t failures;
+    int32_t srtt;                   /* smoothed round trip time in ms, negative if no sample yet */
+    int32_t rttvar;                 /* round trip time variation in ms */
+    uint32_t rto;                   /* retransmission timeout in ms */
+    ReliableTransport_TxSlot_t tx[RELIABLETRANSPORT_WINDOW_SIZE];
+
+    /* receive direction */
+    bool rxSynced;
+    bool ackPending;
+    uint8_t rxNext;                 /* next expected sequence number */
+    ReliableTransport_RxSlot_t rx[RELIABLETRANSPORT_WINDOW_SIZE];
+} ReliableTransport_Peer_t;
+
+typedef struct ReliableTransport_RxFrame_t
+{
+    uint32_t address;
+    uint16_t length;
+    uint8_t data[FRAME_LENGTH];
+} ReliableTransport_RxFrame_t;
+
+/**************************************
+ *          Static variables          *
+ **************************************/
+
+static ReliableTransport_Transmit_t Transmit = NULL;
+static void(*RxCallback)(uint8_t*,uint16_t,uint32_t) = NULL;
+
+static ReliableTransport_Peer_t peers[RELIABLETRANSPORT_MAX_PEERS];
+
+/* frames received in the UART interrupt, processed in ReliableTransport_Process */
+static ReliableTransport_RxFrame_t rxQueue[RELIABLETRANSPORT_RX_QUEUE_LENGTH];
+static volatile uint8_t rxQueueHead = 0;      /* written by HandleRx only */
+static volatile uint8_t rxQueueTail = 0;      /* written by Process only */
+
+/**************************************
+ *         Static functions           *
+ **************************************/
+
+/**
+ * @brief Check if a peer has no transfer in progress in either direction
+ */
+static bool IsIdle(ReliableTransport_Peer_t* peer, uint32_t now)
+{
+    int i = 0;
+
+    if ((peer->txBase != peer->txNext) || peer->ackPending || (now - peer->lastTick < RELIABLETRANSPORT_PEER_IDLE_TIMEOUT))
+    {
+        return false;
+    }
+    for (i = 0; i < RELIABLETRANSPORT_WINDOW_SIZE; i++)
+    {
+        if (peer->rx[i].filled)
+        {
+            /* reassembly of the received stream in progress */
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Find the state of a peer, optionally allocate it
+ */
+static ReliableTransport_Peer_t* GetPeer(uint32_t address, bool create)
+{
+    ReliableTransport_Peer_t* candidate = NULL;
+    uint32_t now = WE_GetTick();
+    int i = 0;
+
+    for (i = 0; i < RELIABLETRANSPORT_MAX_PEERS; i++)
+    {
+        if (peers[i].used && (peers[i].address == address))
+        {
+            return &peers[i];
+        }
+    }
+
+    if (!create)
+    {
+        return NULL;
+    }
+
+    /* take a free entry or replace the least recently used idle peer */
+    for (i = 0; i < RELIABLETRANSPORT_MAX_PEERS; i++)
+    {
+        ReliableTransport_Peer_t* peer = &peers[i];
+        if (!peer->used)
+        {
+            candidate = peer;
+            break;
+        }
+        if (IsIdle(peer, now) && ((candidate == NULL) || ((int32_t)(peer->lastTick - candidate->lastTick) < 0)))
+        {
+            candidate = peer;
+        }
+    }
+
+    if (candidate != NULL)
+    {
+        memset(candidate, 0, sizeof(ReliableTransport_Peer_t));
+        candidate->used = true;
+        candidate->address = address;
+        candidate->lastTick = now;
+        /* start with a varying sequence number, so that packets of a previous stream are not taken for new ones */
+        candidate->txBase = (uint8_t)candidate->lastTick;
+        candidate->txNext = candidate->txBase;
+        candidate->srtt = -1;
+        candidate->rto = RELIABLETRANSPORT_INITIAL_RTO;
+    }
+    return candidate;
+}
+
+/**
+ * @brief Transmit (or repeat) the packet of a slot
+ */
+static void TransmitSlot(ReliableTransport_Peer_t* peer, ReliableTransport_TxSlot_t* slot)
+{
+    if (!peer->synAcked)
+    {
+        slot->frame[0] = TYPE_DATA_SYN;
+    }
+    else
+    {
+        slot->frame[0] = TYPE_DATA;
+    }
+    slot->sentTick = WE_GetTick();
+
+    /* a failed transmission is repeated after the retransmission timeout */
+    Transmit(peer->address, slot->frame, slot->length);
+}
+
+/**
+ * @brief Update the round trip time estimation and the retransmission timeout
+ */
+static void UpdateRTO(ReliableTransport_Peer_t* peer, int32_t rtt)
+{
+    if (peer->srtt < 0)
+    {
+        peer->srtt = rtt;
+        peer->rttvar = rtt / 2;
+    }
+    else
+    {
+        int32_t delta = (peer->srtt > rtt) ? (peer->srtt - rtt) : (rtt - peer->srtt);
+        peer->rttvar = (3 * peer->rttvar + delta) / 4;
+        peer->srtt = (7 * peer->srtt + rtt) / 8;
+    }
+
+    uint32_t rto = (uint32_t)(peer->srtt + ((4 * peer->rttvar > 1) ? (4 * peer->rttvar) : 1));
+    if (rto < RELIABLETRANSPORT_MIN_RTO)
+    {
+        rto = RELIABLETRANSPORT_MIN_RTO;
+    }
+    else if (rto > RELIABLETRANSPORT_MAX_RTO)
+    {
+        rto = RELIABLETRANSPORT_MAX_RTO;
+    }
+    peer->rto = rto;
+}
+
+/**
+ * @brief Drop all unacknowledged packets of a peer
+ */
+static void AbortTx(ReliableTransport_Peer_t* peer)
+{
+    fprintf(stdout, "Transfer to 0x%08lx aborted\n", (unsigned long)peer->address);
+    /* skip two windows, so that the peer does not wait for the dropped packets but restarts the stream */
+    peer->txNext += 2 * RELIABLETRANSPORT_WINDOW_SIZE;
+    peer->txBase = peer->txNext;
+    peer->synAcked = false;
+    peer->failures++;
+    peer->srtt = -1;
+    peer->rto = RELIABLETRANSPORT_INITIAL_RTO;
+}
+
+/**
+ * @brief Send the acknowledgement for the received packets
+ */
+static void SendAck(ReliableTransport_Peer_t* peer)
+{
+    uint8_t ack[ACK_LENGTH];
+    uint32_t bitmap = 0;
+    int i = 0;
+
+    for (i = 0; i < RELIABLETRANSPORT_WINDOW_SIZE - 1; i++)
+    {
+        uint8_t seq = (uint8_t)(peer->rxNext + 1 + i);
+        ReliableTransport_RxSlot_t* slot = &peer->rx[seq & WINDOW_MASK];
+        if (slot->filled && (slot->seq == seq))
+        {
+            bitmap |= (1UL << i);
+        }
+    }
+
+    ack[0] = TYPE_ACK;
+    ack[1] = peer->rxNext;
+    ack[2] = (uint8_t)bitmap;
+    ack[3] = (uint8_t)(bitmap >> 8);
+    ack[4] = (uint8_t)(bitmap >> 16);
+    ack[5] = (uint8_t)(bitmap >> 24);
+    peer->ackPending = false;
+    Transmit(peer->address, ack, sizeof(ack));
+}
+
+/**
+ * @brief Store a received data packet and deliver all packets that are in order
+ */
+static void HandleData(ReliableTransport_Peer_t* peer, uint8_t type, uint8_t seq, uint8_t* data, uint16_t length)
+{
+    if ((type == TYPE_DATA_SYN) &&
+        (!peer->rxSynced || ((uint8_t)(seq - peer->rxNext + RELIABLETRANSPORT_WINDOW_SIZE) >= 2 * RELIABLETRANSPORT_WINDOW_SIZE)))
+    {
+        /* start of a new stream */
+        memset(peer->rx, 0, sizeof(peer->rx));
+        peer->rxNext = seq;
+        peer->rxSynced = true;
+    }
+
+    if (!peer->rxSynced)
+    {
+        /* wait for the start of the stream */
+        return;
+    }
+
+    if ((uint8_t)(seq - peer->rxNext) < RELIABLETRANSPORT_WINDOW_SIZE)
+    {
+        ReliableTransport_RxSlot_t* slot = &peer->rx[seq & WINDOW_MASK];
+        if (!slot->filled)
+        {
+            memcpy(slot->data, data, length);
+            slot->length = length;
+            slot->seq = seq;
+            slot->filled = true;
+        }
+    }
+    /* acknowledge duplicates as well, the previous acknowledgement may have been lost */
+    peer->ackPending = true;
+
+    /* deliver in order */
+    while (1)
+    {
+        ReliableTransport_RxSlot_t* slot = &peer->rx[peer->rxNext & WINDOW_MASK];
+        if (!slot->filled || (slot->seq != peer->rxNext))
+        {
+            break;
+        }
+        if (RxCallback != NULL)
+        {
+            RxCallback(slot->data, slot->length, peer->address);
+        }
+        slot->filled = false;
+        peer->rxNext++;
+    }
+}
+
+/**
+ * @brief Mark the acknowledged packets and move the send window
+ */
+static void HandleAck(ReliableTransport_Peer_t* peer, uint8_t cumAck, uint32_t bitmap)
+{
+    uint8_t outstanding = (uint8_t)(peer->txNext - peer->txBase);
+    uint8_t ackedUpTo = (uint8_t)(cumAck - peer->txBase);
+    uint32_t now = WE_GetTick();
+    uint8_t i = 0;
+
+    if (ackedUpTo > outstanding)
+    {
+        /* outdated acknowledgement (previous stream or already moved window) */
+        return;
+    }
+    peer->synAcked = true;
+
+    for (i = 0; i < outstanding; i++)
+    {
+        ReliableTransport_TxSlot_t* slot = &peer->tx[(uint8_t)(peer->txBase + i) & WINDOW_MASK];
+        bool acked = (i < ackedUpTo);
+        if (!acked && (i > ackedUpTo))
+        {
+            acked = (0 != (bitmap & (1UL << (i - ackedUpTo - 1))));
+        }
+        if (acked && !slot->acked)
+        {
+            slot->acked = true;
+            if (!slot->retransmitted)
+            {
+                UpdateRTO(peer, (int32_t)(now - slot->sentTick));
+            }
+        }
+    }
+
+    /* fast retransmit of the first missing packet if later packets have been received */
+    if (ackedUpTo < outstanding)
+    {
+        ReliableTransport_TxSlot_t* gap = &peer->tx[(uint8_t)(peer->txBase + ackedUpTo) & WINDOW_MASK];
+        int later = 0;
+        for (i = ackedUpTo + 1; i < outstanding; i++)
+        {
+            if (peer->tx[(uint8_t)(peer->txBase + i) & WINDOW_MASK].acked)
+            {
+                later++;
+            }
+        }
+        if (!gap->acked && !gap->retransmitted && (later >= FAST_RETRANSMIT_THRESHOLD))
+        {
+            gap->retransmitted = true;
+            gap->retries++;
+            TransmitSlot(peer, gap);
+        }
+    }
+
+    /* move the window */
+    while ((peer->txBase != peer->txNext) && peer->tx[peer->txBase & WINDOW_MASK].acked)
+    {
+        peer->txBase++;
+    }
+}
+
+/**
+ * @brief Handle a frame taken from the receive queue
+ */
+static void HandleFrame(ReliableTransport_RxFrame_t* frame)
+{
+    ReliableTransport_Peer_t* peer = NULL;
+    uint8_t type = frame->data[0];
+
+    if (type == TYPE_ACK)
+    {
+        peer = GetPeer(frame->address, false);
+        if ((peer != NULL) && (frame->length == ACK_LENGTH))
+        {
+            uint32_t bitmap = (uint32_t)frame->data[2] | ((uint32_t)frame->data[3] << 8) | ((uint32_t)frame->data[4] << 16) | ((uint32_t)frame->data[5] << 24);
+            HandleAck(peer, frame->data[1], bitmap);
+        }
+    }
+    else
+    {
+        peer = GetPeer(frame->address, true);
+        if (peer != NULL)
+        {
+            HandleData(peer, type, frame->data[1], &frame->data[RELIABLETRANSPORT_HEADER_LENGTH], frame->length - RELIABLETRANSPORT_HEADER_LENGTH);
+        }
+    }
+
+    if (peer != NULL)
+    {
+        peer->lastTick = WE_GetTick();
+    }
+}
+
+/**************************************
+ *         Global functions           *
+ **************************************/
+
+/**
+ * @brief Initialize the reliable transport
+ *
+ * @param[in] transmit: unicast transmit function of the module (ThyoneI_TransmitUnicastExtended)
+ * @param[in] RXcb: callback function for received packets (in order, without duplicates)
+ *
+ * @return true if initialization succeeded,
+ *         false otherwise
+ */
+bool ReliableTransport_Init(ReliableTransport_Transmit_t transmit, void(*RXcb)(uint8_t*,uint16_t,uint32_t))
+{
+    if (transmit == NULL)
+    {
+        return false;
+    }
+
+    Transmit = transmit;
+    RxCallback = RXcb;
+    memset(peers, 0, sizeof(peers));
+    rxQueueHead = 0;
+    rxQueueTail = 0;
+    return true;
+}
+
+/**
+ * @brief Queue a packet for reliable transmission to a peer and transmit it
+ *
+ * The function does not wait for the acknowledgement. It returns false if the
+ * send window of the peer is full, call ReliableTransport_Process and try again.
+ *
+ * @param[in] address: address of the peer
+ * @param[in] payloadP: pointer to the data to transmit
+ * @param[in] length: length of the data to transmit
+ *
+ * @return true if the packet has been queued,
+ *         false otherwise
+ */
+bool ReliableTransport_Send(uint32_t address, uint8_t* payloadP, uint16_t length)
+{
+    if ((Transmit == NULL) || (length == 0) || (length > RELIABLETRANSPORT_MAX_PAYLOAD_LENGTH))
+    {
+        return false;
+    }
+
+    ReliableTransport_Peer_t* peer = GetPeer(address, true);
+    if (peer == NULL)
+    {
+        return false;
+    }
+
+    if ((uint8_t)(peer->txNext - peer->txBase) >= RELIABLETRANSPORT_WINDOW_SIZE)
+    {
+        /* send window is full */
+        return false;
+    }
+
+    ReliableTransport_TxSlot_t* slot = &peer->tx[peer->txNext & WINDOW_MASK];
+    slot->acked = false;
+    slot->retransmitted = false;
+    slot->retries = 0;
+    slot->length = RELIABLETRANSPORT_HEADER_LENGTH + length;
+    slot->frame[1] = peer->txNext;
+    memcpy(&slot->frame[RELIABLETRANSPORT_HEADER_LENGTH], payloadP, length);
+    peer->txNext++;
+    peer->lastTick = WE_GetTick();
+
+    TransmitSlot(peer, slot);
+    return true;
+}
+
+/**
+ * @brief Wait until all packets to a peer have been acknowledged
+ *
+ * @param[in] address: address of the peer
+ * @param[in] timeout_ms: maximum time to wait in ms
+ *
+ * @return true if all packets have been acknowledged,
+ *         false otherwise
+ */
+bool ReliableTransport_Flush(uint32_t address, uint32_t timeout_ms)
+{
+    ReliableTransport_Peer_t* peer = GetPeer(address, false);
+    if (peer == NULL)
+    {
+        return true;
+    }
+
+    uint8_t failures = peer->failures;
+    uint32_t t0 = WE_GetTick();
+    while (peer->txBase != peer->txNext)
+    {
+        if (WE_GetTick() - t0 > timeout_ms)
+        {
+            return false;
+        }
+        ReliableTransport_Process();
+    }
+    return (failures == peer->failures);
+}
+
+/**
+ * @brief Handle a received packet
+ *
+ * Call this function from the RX callback of the driver. The frame is only queued here
+ * and processed in ReliableTransport_Process.
+ *
+ * @param[in] payloadP: pointer to the received packet
+ * @param[in] length: length of the received packet
+ * @param[in] sourceAddress: address of the sender
+ *
+ * @return true if the packet belongs to the reliable transport,
+ *         false otherwise
+ */
+bool ReliableTransport_HandleRx(uint8_t* payloadP, uint16_t length, uint32_t sourceAddress)
+{
+    if ((length < RELIABLETRANSPORT_HEADER_LENGTH) || ((payloadP[0] & TYPE_MASK) != TYPE_MARKER) || (payloadP[0] > TYPE_DATA_SYN))
+    {
+        return false;
+    }
+
+    uint8_t head = rxQueueHead;
+    if ((length <= FRAME_LENGTH) && ((uint8_t)(head - rxQueueTail) < RELIABLETRANSPORT_RX_QUEUE_LENGTH))
+    {
+        ReliableTransport_RxFrame_t* frame = &rxQueue[head & (RELIABLETRANSPORT_RX_QUEUE_LENGTH - 1)];
+        frame->address = sourceAddress;
+        frame->length = length;
+        memcpy(frame->data, payloadP, length);
+        rxQueueHead = head + 1;
+    }
+    /* else: queue full, the frame is dropped and repeated by the sender */
+    return true;
+}
+
+/**
+ * @brief Process received frames, send acknowledgements and repeat timed out packets
+ *
+ * Call this function cyclically from the main loop.
+ */
+void ReliableTransport_Process(void)
+{
+    int i = 0;
+
+    while (rxQueueTail != rxQueueHead)
+    {
+        HandleFrame(&rxQueue[rxQueueTail & (RELIABLETRANSPORT_RX_QUEUE_LENGTH - 1)]);
+        rxQueueTail++;
+    }
+
+    uint32_t now = WE_GetTick();
+    for (i = 0; i < RELIABLETRANSPORT_MAX_PEERS; i++)
+    {
+        ReliableTransport_Peer_t* peer = &peers[i];
+        if (!peer->used)
+        {
+            continue;
+        }
+
+        if (peer->ackPending)
+        {
+            SendAck(peer);
+        }
+
+        /* repeat the packets whose retransmission timeout expired */
+        bool backoff = false;
+        uint8_t seq = 0;
+        for (seq = peer->txBase; seq != peer->txNext; seq++)
+        {
+            ReliableTransport_TxSlot_t* slot = &peer->tx[seq & WINDOW_MASK];
+            if (slot->acked || (now - slot->sentTick < peer->rto))
+            {
+                continue;
+            }
+            if (slot->retries >= RELIABLETRANSPORT_MAX_RETRIES)
+            {
+                AbortTx(peer);
+                break;
+            }
+            slot->retries++;
+            slot->retransmitted = true;
+            backoff = true;
+            TransmitSlot(peer, slot);
+        }
+
+        if (backoff)
+        {
+            /* exponential backoff, once per timeout event */
+            peer->rto = (peer->rto * 2 > RELIABLETRANSPORT_MAX_RTO) ? RELIABLETRANSPORT_MAX_RTO : (peer->rto * 2);
+        }
+    }
+}
+
+/**
+ * @brief Get the current retransmission timeout of a peer
+ *
+ * @param[in] address: address of the peer
+ *
+ * @return retransmission timeout in ms, 0 if the peer is unknown
+ */
+uint32_t ReliableTransport_GetRTO(uint32_t address)
+{
+    ReliableTransport_Peer_t* peer = GetPeer(address, false);
+    return (peer != NULL) ? peer->rto : 0;
+}
@@ -0,0 +1,116 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Sliding window reliable unicast transport for the Thyone-I header file.
+ *
+ * Each peer (identified by its 32 bit address) gets a send window of
+ * RELIABLETRANSPORT_WINDOW_SIZE packets with 8 bit sequence numbers. Packets are
+ * acknowledged end to end by ACK frames in reverse direction, which carry the next
+ * expected sequence number (cumulative) and a bitmap of the packets received out of
+ * order (selective). Unacknowledged packets are repeated after a retransmission
+ * timeout that adapts to the measured round trip time.
+ *
+ * Usage:
+ * - Call ReliableTransport_Init() with ThyoneI_TransmitUnicastExtended.
+ * - Call ReliableTransport_HandleRx() from the RX callback of the driver. It returns
+ *   false for packets that do not belong to the transport.
+ * - Call ReliableTransport_Process() cyclically from the main loop.
+ * - Call ReliableTransport_Send() to queue a packet and ReliableTransport_Flush() to
+ *   wait until all packets to a peer have been acknowledged.
+ *
+ * If all RELIABLETRANSPORT_MAX_PEERS entries are in use, a new peer only replaces a peer
+ * that has nothing in flight in either direction and has been silent for
+ * RELIABLETRANSPORT_PEER_IDLE_TIMEOUT. Otherwise its frames are dropped (and repeated by
+ * the sender) and ReliableTransport_Send() returns false. A sender that resumes after its
+ * entry has been replaced gets one aborted transfer and then restarts the stream.
+ *
+ * Data frame: type (1 byte, 0xE0 or 0xE2 for the first packets of a stream), sequence number (1 byte), payload
+ * ACK frame: type (1 byte, 0xE1), next expected sequence number (1 byte), bitmap of the following packets (4 bytes, little endian)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RELIABLETRANSPORT_H_INCLUDED
+#define RELIABLETRANSPORT_H_INCLUDED
+
+#define RELIABLETRANSPORT_HEADER_LENGTH 2
+
+/* maximum payload per packet, ThyoneI_TransmitUnicastExtended accepts up to 220 bytes */
+#ifndef RELIABLETRANSPORT_MAX_PAYLOAD_LENGTH
+#define RELIABLETRANSPORT_MAX_PAYLOAD_LENGTH (220 - RELIABLETRANSPORT_HEADER_LENGTH)
+#endif
+
+/* number of unacknowledged packets per peer (2..32) */
+#ifndef RELIABLETRANSPORT_WINDOW_SIZE
+#define RELIABLETRANSPORT_WINDOW_SIZE 4
+#endif
+
+/* number of peers with simultaneous transfers */
+#ifndef RELIABLETRANSPORT_MAX_PEERS
+#define RELIABLETRANSPORT_MAX_PEERS 2
+#endif
+
+/* time in ms without traffic after which an idle peer may be replaced by a new one */
+#ifndef RELIABLETRANSPORT_PEER_IDLE_TIMEOUT
+#define RELIABLETRANSPORT_PEER_IDLE_TIMEOUT (2 * RELIABLETRANSPORT_MAX_RTO)
+#endif
+
+/* number of received frames that can be queued between two calls of ReliableTransport_Process */
+#ifndef RELIABLETRANSPORT_RX_QUEUE_LENGTH
+#define RELIABLETRANSPORT_RX_QUEUE_LENGTH 4
+#endif
+
+/* retransmission timeout limits in ms */
+#define RELIABLETRANSPORT_INITIAL_RTO 200
+#define RELIABLETRANSPORT_MIN_RTO     20
+#define RELIABLETRANSPORT_MAX_RTO     2000
+
+/* number of retransmissions of a packet before the transfer to the peer is aborted */
+#ifndef RELIABLETRANSPORT_MAX_RETRIES
+#define RELIABLETRANSPORT_MAX_RETRIES 8
+#endif
+
+/* signature of ThyoneI_TransmitUnicastExtended */
+typedef bool (*ReliableTransport_Transmit_t)(uint32_t address, uint8_t* payloadP, uint16_t length);
+
+extern bool ReliableTransport_Init(ReliableTransport_Transmit_t transmit, void(*RXcb)(uint8_t*,uint16_t,uint32_t));
+extern bool ReliableTransport_Send(uint32_t address, uint8_t* payloadP, uint16_t length);
+extern bool ReliableTransport_Flush(uint32_t address, uint32_t timeout_ms);
+extern bool ReliableTransport_HandleRx(uint8_t* payloadP, uint16_t length, uint32_t sourceAddress);
+extern void ReliableTransport_Process(void);
+extern uint32_t ReliableTransport_GetRTO(uint32_t address);
+
+#endif // RELIABLETRANSPORT_H_INCLUDED
+
+#ifdef __cplusplus
+}
+#endif
@@ -473,12 +473,8 @@ bool ThyoneI_Init(uint32_t baudrate, WE_FlowControl_t flow_control, void(*RXcb)(
     WE_UART_Init(baudrate, flow_control, WE_Parity_None, true);
     WE_Delay(10);
 
-    /* reset module */
-    if(ThyoneI_PinReset())
-    {
-        WE_Delay(THYONEI_BOOT_DURATION);
-    }
-    else
+    /* reset module, it is ready for operation as soon as the START_IND has been received */
+    if(false == ThyoneI_PinReset())
     {
         fprintf(stdout, "Pin reset failed\n");
         ThyoneI_Deinit();
@@ -490,7 +486,6 @@ bool ThyoneI_Init(uint32_t baudrate, WE_FlowControl_t flow_control, void(*RXcb)(
     {
         fprintf(stdout, "ThyoneI driver version %d.%d.%d\n", driverVersion[0], driverVersion[1], driverVersion[2]);
     }
-    WE_Delay(100);
 
     return true;
 }
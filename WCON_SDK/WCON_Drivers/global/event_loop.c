@@ -0,0 +1,328 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Run-to-completion event loop for callbacks deferred from interrupt context.
+ */
+
+#include "event_loop.h"
+
+#include <string.h>
+
+#include "global.h"
+
+/**
+ * @brief Value of the record header's length field marking the end of the used part of the
+ * ring buffer (the next record starts at the beginning of the buffer).
+ */
+#define WE_EVENT_QUEUE_WRAP 0xFFFF
+
+/**
+ * @brief Header stored in front of each record.
+ */
+typedef struct WE_EventQueue_RecordHeader_t
+{
+    uint16_t length;                        /**< Length of record data or WE_EVENT_QUEUE_WRAP */
+    uint16_t reserved;
+    uint32_t timestamp;                     /**< Time at which the record has been added (microseconds) */
+} WE_EventQueue_RecordHeader_t;
+
+/**
+ * @brief First of the queues polled by WE_Poll().
+ */
+static WE_EventQueue_t *WE_eventQueues = NULL;
+
+/**
+ * @brief Is set to true while WE_Poll() is running (prevents nested dispatching, e.g. if a
+ * handler calls WE_Poll()).
+ */
+static bool WE_eventLoopPolling = false;
+
+static bool WE_EventQueue_Release(WE_EventQueue_t *queue, bool dispatch);
+
+/**
+ * @brief Initializes an event queue and adds it to the queues polled by WE_Poll().
+ *
+ * Must not be called while the producer (interrupt) might add records to the queue.
+ *
+ * @param[in] queue Queue to be initialized
+ * @param[in] buffer Buffer holding the queued records (must be 4 byte aligned, see WE_EVENT_QUEUE_RECORD_SIZE())
+ * @param[in] size Size of buffer (must be a multiple of 4)
+ * @param[in] handler Handler called by WE_Poll() for each record
+ *
+ * @return true if successful, false otherwise
+ */
+bool WE_EventQueue_Init(WE_EventQueue_t *queue, uint8_t *buffer, uint16_t size, WE_EventHandler_t handler)
+{
+    if ((NULL == buffer) ||
+            (NULL == handler) ||
+            (0 != ((uintptr_t) buffer & 3)) ||
+            (0 != (size & 3)) ||
+            (size < 2 * sizeof(WE_EventQueue_RecordHeader_t)))
+    {
+        return false;
+    }
+
+    WE_EventQueue_t *q = WE_eventQueues;
+    while ((NULL != q) && (q != queue))
+    {
+        q = q->next;
+    }
+
+    queue->buffer = buffer;
+    queue->size = size;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->handler = handler;
+    queue->pushed = 0;
+    queue->dropped = 0;
+    queue->maxDepth = 0;
+    queue->dispatched = 0;
+    queue->maxLatencyUs = 0;
+    queue->totalLatencyUs = 0;
+    queue->maxDispatchTimeUs = 0;
+
+    if (NULL == q)
+    {
+        /* Not yet polled by WE_Poll() */
+        queue->next = WE_eventQueues;
+        WE_eventQueues = queue;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Discards all records which have not been dispatched yet (consumer side, i.e. must be
+ * called from main loop context).
+ *
+ * @param[in] queue Event queue
+ */
+void WE_EventQueue_Clear(WE_EventQueue_t *queue)
+{
+    if (NULL == queue->buffer)
+    {
+        return;
+    }
+    while (WE_EventQueue_Release(queue, false))
+    {
+    }
+}
+
+/**
+ * @brief Adds a record to an event queue (producer side, i.e. is to be called from a single
+ * interrupt context only).
+ *
+ * The data is copied to the queue. The record is dropped if the queue is full.
+ *
+ * @param[in] queue Event queue
+ * @param[in] data Record data
+ * @param[in] length Record length
+ *
+ * @return true if successful, false if the record has been dropped
+ */
+bool WE_EventQueue_Push(WE_EventQueue_t *queue, const uint8_t *data, uint16_t length)
+{
+    if (NULL == queue->buffer)
+    {
+        return false;
+    }
+
+    uint32_t recordSize = WE_EVENT_QUEUE_RECORD_SIZE((uint32_t) length);
+    uint16_t head = queue->head;
+    uint16_t tail = queue->tail;
+    uint16_t pos;
+
+    /* The queue is empty if head == tail, so a record must never fill the remaining space completely */
+    if (head >= tail)
+    {
+        uint32_t remaining = queue->size - head;
+        if ((remaining > recordSize) || ((remaining == recordSize) && (0 != tail)))
+        {
+            pos = head;
+        }
+        else if (tail > recordSize)
+        {
+            /* Not enough space at end of buffer - continue at start of buffer. If there is no space
+             * for a header at the end, the consumer skips the remaining bytes without a marker. */
+            if (remaining >= sizeof(WE_EventQueue_RecordHeader_t))
+            {
+                ((WE_EventQueue_RecordHeader_t *) &queue->buffer[head])->length = WE_EVENT_QUEUE_WRAP;
+            }
+            pos = 0;
+        }
+        else
+        {
+            queue->dropped++;
+            return false;
+        }
+    }
+    else if ((uint32_t) (tail - head) > recordSize)
+    {
+        pos = head;
+    }
+    else
+    {
+        queue->dropped++;
+        return false;
+    }
+
+    WE_EventQueue_RecordHeader_t *header = (WE_EventQueue_RecordHeader_t *) &queue->buffer[pos];
+    header->length = length;
+    header->timestamp = WE_GetTickMicroseconds();
+    memcpy(&queue->buffer[pos + sizeof(WE_EventQueue_RecordHeader_t)], data, length);
+
+    pos += recordSize;
+    if (pos == queue->size)
+    {
+        pos = 0;
+    }
+
+    /* Make sure the record is complete before it is published to the consumer */
+    __DMB();
+    queue->head = pos;
+
+    queue->pushed++;
+    uint16_t depth = (uint16_t) (queue->pushed - queue->dispatched);
+    if (depth > queue->maxDepth)
+    {
+        queue->maxDepth = depth;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns the statistics of an event queue (queue depth, dispatch latency).
+ *
+ * @param[in] queue Event queue
+ * @param[out] stats Statistics
+ */
+void WE_EventQueue_GetStats(WE_EventQueue_t *queue, WE_EventQueue_Stats_t *stats)
+{
+    stats->pushed = queue->pushed;
+    stats->dropped = queue->dropped;
+    stats->dispatched = queue->dispatched;
+    stats->depth = (uint16_t) (stats->pushed - stats->dispatched);
+    stats->maxDepth = queue->maxDepth;
+    stats->maxLatencyUs = queue->maxLatencyUs;
+    stats->averageLatencyUs = (0 == stats->dispatched) ? 0 : (uint32_t) (queue->totalLatencyUs / stats->dispatched);
+    stats->maxDispatchTimeUs = queue->maxDispatchTimeUs;
+}
+
+/**
+ * @brief Removes the oldest record from an event queue, dispatching it to the queue's handler
+ * if requested.
+ *
+ * @param[in] queue Event queue
+ * @param[in] dispatch Call the queue's handler for the record (otherwise the record is discarded)
+ *
+ * @return true if a record has been removed, false if the queue is empty
+ */
+static bool WE_EventQueue_Release(WE_EventQueue_t *queue, bool dispatch)
+{
+    uint16_t tail = queue->tail;
+    if (tail == queue->head)
+    {
+        return false;
+    }
+
+    /* Make sure the record is read after the write position */
+    __DMB();
+
+    if ((queue->size - tail < sizeof(WE_EventQueue_RecordHeader_t)) ||
+            (WE_EVENT_QUEUE_WRAP == ((WE_EventQueue_RecordHeader_t *) &queue->buffer[tail])->length))
+    {
+        tail = 0;
+    }
+
+    WE_EventQueue_RecordHeader_t *header = (WE_EventQueue_RecordHeader_t *) &queue->buffer[tail];
+    uint16_t length = header->length;
+
+    if (dispatch)
+    {
+        uint32_t start = WE_GetTickMicroseconds();
+        uint32_t latency = start - header->timestamp;
+        queue->handler(&queue->buffer[tail + sizeof(WE_EventQueue_RecordHeader_t)], length);
+        uint32_t dispatchTime = WE_GetTickMicroseconds() - start;
+
+        if (latency > queue->maxLatencyUs)
+        {
+            queue->maxLatencyUs = latency;
+        }
+        queue->totalLatencyUs += latency;
+        if (dispatchTime > queue->maxDispatchTimeUs)
+        {
+            queue->maxDispatchTimeUs = dispatchTime;
+        }
+    }
+
+    tail += WE_EVENT_QUEUE_RECORD_SIZE((uint32_t) length);
+    if (tail == queue->size)
+    {
+        tail = 0;
+    }
+
+    /* Make sure the handler is done with the record before its space is released to the producer */
+    __DMB();
+    queue->tail = tail;
+    queue->dispatched++;
+
+    return true;
+}
+
+/**
+ * @brief Dispatches queued records of all event queues to their handlers (run-to-completion).
+ *
+ * Is to be called from the application's main loop and from every loop waiting for a state
+ * change made by a handler (see event_loop.h). Dispatches the records which have been
+ * queued at the time of the call - records added while dispatching are handled by the next
+ * call. Must not be called from interrupt context. Nested calls (from within a handler) return
+ * immediately.
+ *
+ * @return true if at least one record has been dispatched, false otherwise
+ */
+bool WE_Poll(void)
+{
+    if (WE_eventLoopPolling)
+    {
+        return false;
+    }
+    WE_eventLoopPolling = true;
+
+    bool dispatched = false;
+    for (WE_EventQueue_t *queue = WE_eventQueues; NULL != queue; queue = queue->next)
+    {
+        uint32_t pending = queue->pushed - queue->dispatched;
+        for (; pending > 0 && WE_EventQueue_Release(queue, true); pending--)
+        {
+            dispatched = true;
+        }
+    }
+
+    WE_eventLoopPolling = false;
+    return dispatched;
+}
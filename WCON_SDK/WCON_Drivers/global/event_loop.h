@@ -0,0 +1,133 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Run-to-completion event loop for callbacks deferred from interrupt context.
+ *
+ * Data received from the radio modules is parsed in interrupt context (PendSV if DMA is used,
+ * the UART interrupt otherwise). Instead of calling the application's callbacks directly from
+ * there, a driver may push the parsed lines or frames to an event queue. The queued records are
+ * dispatched to the queue's handler by WE_Poll(), which is to be called from the application's
+ * main loop. Each handler runs to completion before the next record is dispatched, so slow
+ * callbacks no longer delay reception of further data.
+ *
+ * As the handlers are only executed by WE_Poll(), every loop waiting for a state change made by a
+ * handler (e.g. a flag set by the event callback) must call WE_Poll() while waiting - in the
+ * application as well as in the drivers. Consequently, handlers may be executed from within
+ * blocking driver functions that wait for events. Such functions must not be called from within
+ * a handler, as nested calls of WE_Poll() return immediately.
+ *
+ * Each queue is a lock-free single producer (interrupt) / single consumer (main loop) ring buffer
+ * of variable length records. Records are stored contiguously, so handlers get a pointer to the
+ * complete line or frame, which remains valid (and may be modified) until the handler returns.
+ */
+
+#ifndef GLOBAL_EVENT_LOOP_H_INCLUDED
+#define GLOBAL_EVENT_LOOP_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Size of the header stored in front of each record in an event queue.
+ */
+#define WE_EVENT_QUEUE_RECORD_HEADER_SIZE 8
+
+/**
+ * @brief Returns the number of bytes occupied in an event queue by a record of the given length.
+ *
+ * Can be used to determine the buffer size required for queueing a number of records.
+ */
+#define WE_EVENT_QUEUE_RECORD_SIZE(length) ((WE_EVENT_QUEUE_RECORD_HEADER_SIZE + (length) + 3) & ~3)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Handler for records of an event queue (called by WE_Poll() in main loop context).
+ *
+ * @param[in] data Record data (may be modified by the handler)
+ * @param[in] length Record length
+ */
+typedef void (*WE_EventHandler_t)(uint8_t *data, uint16_t length);
+
+/**
+ * @brief Statistics of an event queue.
+ *
+ * @see WE_EventQueue_GetStats()
+ */
+typedef struct WE_EventQueue_Stats_t
+{
+    uint32_t pushed;                        /**< Number of records added to the queue */
+    uint32_t dropped;                       /**< Number of records dropped because the queue was full */
+    uint32_t dispatched;                    /**< Number of records dispatched to the handler (or discarded by WE_EventQueue_Clear()) */
+    uint16_t depth;                         /**< Number of records currently in the queue */
+    uint16_t maxDepth;                      /**< Max. number of records in the queue */
+    uint32_t maxLatencyUs;                  /**< Max. time between adding and dispatching a record (microseconds) */
+    uint32_t averageLatencyUs;              /**< Average time between adding and dispatching a record (microseconds) */
+    uint32_t maxDispatchTimeUs;             /**< Max. time spent in the handler for a single record (microseconds) */
+} WE_EventQueue_Stats_t;
+
+/**
+ * @brief Event queue (see WE_EventQueue_Init()).
+ *
+ * The fields are written either by the producer (interrupt) or by the consumer (main loop),
+ * never by both. Must not be accessed directly.
+ */
+typedef struct WE_EventQueue_t
+{
+    uint8_t *buffer;                        /**< Ring buffer holding the records */
+    uint16_t size;                          /**< Size of ring buffer */
+    volatile uint16_t head;                 /**< Write position (producer) */
+    volatile uint16_t tail;                 /**< Read position (consumer) */
+    WE_EventHandler_t handler;              /**< Handler called for each record */
+    struct WE_EventQueue_t *next;           /**< Next queue polled by WE_Poll() */
+
+    /* Producer statistics */
+    volatile uint32_t pushed;
+    uint32_t dropped;
+    uint16_t maxDepth;
+
+    /* Consumer statistics */
+    volatile uint32_t dispatched;
+    uint32_t maxLatencyUs;
+    uint64_t totalLatencyUs;
+    uint32_t maxDispatchTimeUs;
+} WE_EventQueue_t;
+
+extern bool WE_EventQueue_Init(WE_EventQueue_t *queue, uint8_t *buffer, uint16_t size, WE_EventHandler_t handler);
+extern void WE_EventQueue_Clear(WE_EventQueue_t *queue);
+extern bool WE_EventQueue_Push(WE_EventQueue_t *queue, const uint8_t *data, uint16_t length);
+extern void WE_EventQueue_GetStats(WE_EventQueue_t *queue, WE_EventQueue_Stats_t *stats);
+extern bool WE_Poll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GLOBAL_EVENT_LOOP_H_INCLUDED */
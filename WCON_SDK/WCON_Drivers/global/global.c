@@ -49,6 +49,8 @@ WE_Parity_t WE_uartParity = WE_Parity_None;
 bool WE_dmaEnabled = false;
 uint8_t WE_dmaRxBuffer[WE_DMA_RX_BUFFER_SIZE];
 size_t WE_dmaLastReadPos = 0;
+void (*WE_uartTransmitDmaCompleteCallback)(void) = NULL;
+void (*WE_uartRxBlockCallback)(uint8_t *data, size_t size) = NULL;
 
 #define NUM_GPIO_PORTS 4
 static GPIO_TypeDef *gpioPorts[NUM_GPIO_PORTS] = {GPIOA, GPIOB, GPIOC, GPIOH};
@@ -58,6 +60,9 @@ static GPIO_TypeDef *gpioPorts[NUM_GPIO_PORTS] = {GPIOA, GPIOB, GPIOC, GPIOH};
 
 void WE_Platform_Init(void)
 {
+    /* Paint the unused part of the stack to be able to determine the stack's high-water mark */
+    WE_StackMonitor_Init();
+
     /* Reset of all peripherals, Initializes the Flash interface and the Systick. */
     HAL_Init();
 
@@ -87,6 +92,10 @@ HAL_StatusTypeDef UartTransmitInternal(USART_TypeDef *hUart, const uint8_t *data
 
 void WE_UART_Transmit(const uint8_t *data, uint16_t length)
 {
+    /* Do not interleave with a running DMA transmission */
+    while (WE_UART_IsTransmitDmaBusy())
+    {
+    }
     UartTransmitInternal(WE_uartWireless, data, length);
 }
 
@@ -97,6 +106,12 @@ void WE_UART_Transmit(const uint8_t *data, uint16_t length)
  */
 void OnDmaDataReceived(uint8_t* data, size_t size)
 {
+    if (NULL != WE_uartRxBlockCallback)
+    {
+        WE_uartRxBlockCallback(data, size);
+        return;
+    }
+
     for (; size > 0; size--, data++)
     {
         WE_UART_HandleRxByte(*data);
@@ -42,6 +42,9 @@
 #include "global_F4xx.h"
 #endif
 
+#include "event_loop.h"
+#include "stack_monitor.h"
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -168,6 +171,34 @@ extern void WE_UART_HandleRxByte(uint8_t receivedByte);
  */
 extern void WE_UART_Transmit(const uint8_t *data, uint16_t length);
 
+/**
+ * @brief Start transmitting data via UART using DMA.
+ *
+ * Returns immediately. The data must not be modified until the transfer is complete.
+ *
+ * @param[in] data Pointer to data buffer (data to be sent)
+ * @param[in] length Number of bytes to be sent
+ *
+ * @return true if the transfer has been started, false if a transfer is still in progress
+ */
+extern bool WE_UART_TransmitDma(const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Checks if a DMA transmission started with WE_UART_TransmitDma() is in progress.
+ */
+extern bool WE_UART_IsTransmitDmaBusy(void);
+
+/**
+ * @brief Optional callback which is executed (in interrupt context) when a DMA transmission is complete.
+ */
+extern void (*WE_uartTransmitDmaCompleteCallback)(void);
+
+/**
+ * @brief Optional callback which is executed for blocks of bytes received via DMA.
+ * If set, WE_UART_HandleRxByte() is not called for bytes received via DMA.
+ */
+extern void (*WE_uartRxBlockCallback)(uint8_t *data, size_t size);
+
 /**
  * @brief Is called in case of a critical HAL error.
  */
@@ -247,6 +278,7 @@ extern uint32_t WE_GetTick();
  * @brief Returns current tick value (in microseconds).
  *
  * Note that WE_MICROSECOND_TICK needs to be defined to enable microsecond timer resolution.
+ * The value wraps around after 2^32 microseconds (~71.6 minutes) on all platforms.
  *
  * @return Current tick value (in microseconds)
  */
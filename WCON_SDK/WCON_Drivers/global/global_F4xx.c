@@ -34,6 +34,16 @@
 
 #include "global.h"
 
+/**
+ * @brief Is set to true if the DMA stream for transmitting data has been initialized.
+ */
+static bool txDmaInitialized = false;
+
+/**
+ * @brief Is set to true while a DMA transmission is in progress.
+ */
+static volatile bool txDmaBusy = false;
+
 #ifdef WE_MICROSECOND_TICK
 /**
  * @brief Number of data watchpoint trigger (DWT) ticks per microsecond (used for microsecond resolution delay/measurements).
@@ -264,6 +274,8 @@ void WE_UART_DeInit()
         return;
     }
 
+    WE_DMA_TxDeInit();
+
     if (WE_dmaEnabled)
     {
         WE_DMA_DeInit();
@@ -369,6 +381,110 @@ void DMA2_Stream2_IRQHandler(void)
     /* Other events can be implemented if required. */
 }
 
+void WE_DMA_TxInit()
+{
+    /* USART1 TX uses DMA2 stream 7, channel 4 */
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA2);
+
+    NVIC_SetPriority(DMA2_Stream7_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), WE_PRIORITY_DMA_RX, 0));
+    NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+
+    LL_DMA_SetChannelSelection(DMA2, LL_DMA_STREAM_7, LL_DMA_CHANNEL_4);
+    LL_DMA_SetDataTransferDirection(DMA2, LL_DMA_STREAM_7, LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+    LL_DMA_SetStreamPriorityLevel(DMA2, LL_DMA_STREAM_7, LL_DMA_PRIORITY_LOW);
+    LL_DMA_SetMode(DMA2, LL_DMA_STREAM_7, LL_DMA_MODE_NORMAL);
+    LL_DMA_SetPeriphIncMode(DMA2, LL_DMA_STREAM_7, LL_DMA_PERIPH_NOINCREMENT);
+    LL_DMA_SetMemoryIncMode(DMA2, LL_DMA_STREAM_7, LL_DMA_MEMORY_INCREMENT);
+    LL_DMA_SetPeriphSize(DMA2, LL_DMA_STREAM_7, LL_DMA_PDATAALIGN_BYTE);
+    LL_DMA_SetMemorySize(DMA2, LL_DMA_STREAM_7, LL_DMA_MDATAALIGN_BYTE);
+    LL_DMA_DisableFifoMode(DMA2, LL_DMA_STREAM_7);
+    LL_DMA_SetPeriphAddress(DMA2, LL_DMA_STREAM_7, (uint32_t) &USART1->DR);
+
+    LL_DMA_EnableIT_TC(DMA2, LL_DMA_STREAM_7);
+    LL_USART_EnableDMAReq_TX(WE_uartWireless);
+
+    txDmaBusy = false;
+    txDmaInitialized = true;
+}
+
+void WE_DMA_TxDeInit()
+{
+    if (!txDmaInitialized)
+    {
+        return;
+    }
+
+    LL_DMA_DisableStream(DMA2, LL_DMA_STREAM_7);
+    LL_DMA_DisableIT_TC(DMA2, LL_DMA_STREAM_7);
+    LL_USART_DisableDMAReq_TX(WE_uartWireless);
+    NVIC_DisableIRQ(DMA2_Stream7_IRQn);
+    if (!WE_dmaEnabled)
+    {
+        /* Clock is still used by the receive stream if DMA is enabled */
+        LL_AHB1_GRP1_DisableClock(LL_AHB1_GRP1_PERIPH_DMA2);
+    }
+
+    txDmaBusy = false;
+    txDmaInitialized = false;
+}
+
+bool WE_UART_TransmitDma(const uint8_t *data, uint16_t length)
+{
+    if (txDmaBusy)
+    {
+        return false;
+    }
+    if (0 == length)
+    {
+        return true;
+    }
+    if (!txDmaInitialized)
+    {
+        WE_DMA_TxInit();
+    }
+
+    LL_DMA_DisableStream(DMA2, LL_DMA_STREAM_7);
+    while (LL_DMA_IsEnabledStream(DMA2, LL_DMA_STREAM_7))
+    {
+    }
+    LL_DMA_ClearFlag_TC7(DMA2);
+    LL_DMA_ClearFlag_HT7(DMA2);
+    LL_DMA_ClearFlag_TE7(DMA2);
+    LL_DMA_ClearFlag_DME7(DMA2);
+    LL_DMA_ClearFlag_FE7(DMA2);
+    LL_DMA_SetMemoryAddress(DMA2, LL_DMA_STREAM_7, (uint32_t) data);
+    LL_DMA_SetDataLength(DMA2, LL_DMA_STREAM_7, length);
+    txDmaBusy = true;
+    LL_DMA_EnableStream(DMA2, LL_DMA_STREAM_7);
+    return true;
+}
+
+bool WE_UART_IsTransmitDmaBusy(void)
+{
+    return txDmaBusy;
+}
+
+/**
+ * @brief Interrupt handler for data transmitted to wireless module via DMA.
+ *
+ * Is only used if WE_UART_TransmitDma() has been used.
+ */
+void DMA2_Stream7_IRQHandler(void)
+{
+    if (LL_DMA_IsEnabledIT_TC(DMA2, LL_DMA_STREAM_7) &&
+            LL_DMA_IsActiveFlag_TC7(DMA2))
+    {
+        /* DMA transmit complete */
+
+        LL_DMA_ClearFlag_TC7(DMA2);
+        txDmaBusy = false;
+        if (NULL != WE_uartTransmitDmaCompleteCallback)
+        {
+            WE_uartTransmitDmaCompleteCallback();
+        }
+    }
+}
+
 #ifdef WE_MICROSECOND_TICK
 void WE_DelayMicroseconds(uint32_t sleepForUsec)
 {
@@ -379,7 +495,26 @@ void WE_DelayMicroseconds(uint32_t sleepForUsec)
 
 uint32_t WE_GetTickMicroseconds()
 {
-    return DWT->CYCCNT / dwtTicksPerMicrosecond;
+    /* The cycle counter wraps after 2^32 / HCLK (~51 s at 84 MHz), so it can't be used
+     * as a timestamp directly. Instead, the millisecond tick is extended with the elapsed
+     * part of the current SysTick period, which yields a counter that wraps after 2^32 us.
+     * Assumes the default 1 kHz HAL tick. */
+    uint32_t ms;
+    uint32_t val;
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+
+    uint32_t load = SysTick->LOAD + 1;
+    if ((0 != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) && (val > (load / 2)))
+    {
+        /* SysTick has reloaded but its interrupt has not been serviced yet (e.g. when
+         * called from a higher priority interrupt or with interrupts disabled) */
+        ms++;
+    }
+    return ms * 1000 + ((load - 1 - val) * 1000) / load;
 }
 #endif /* WE_MICROSECOND_TICK */
 
@@ -58,6 +58,8 @@ extern void WE_UART_Init(uint32_t baudrate,
 extern void WE_UART_DeInit();
 extern void WE_DMA_Init();
 extern void WE_DMA_DeInit();
+extern void WE_DMA_TxInit();
+extern void WE_DMA_TxDeInit();
 
 
 #ifdef __cplusplus
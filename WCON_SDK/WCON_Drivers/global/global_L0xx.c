@@ -34,6 +34,16 @@
 
 #include "global.h"
 
+/**
+ * @brief Is set to true if the DMA channel for transmitting data has been initialized.
+ */
+static bool txDmaInitialized = false;
+
+/**
+ * @brief Is set to true while a DMA transmission is in progress.
+ */
+static volatile bool txDmaBusy = false;
+
 void WE_SystemClock_Config(void)
 {
     RCC_OscInitTypeDef RCC_OscInitStruct = {0};
@@ -228,6 +238,8 @@ void WE_UART_DeInit()
         return;
     }
 
+    WE_DMA_TxDeInit();
+
     if (WE_dmaEnabled)
     {
         WE_DMA_DeInit();
@@ -302,13 +314,109 @@ void WE_DMA_DeInit()
     WE_dmaLastReadPos = 0;
 }
 
+void WE_DMA_TxInit()
+{
+    /* USART1 TX uses DMA1 channel 2 (shares the interrupt with the receive channel 3) */
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+    NVIC_SetPriority(DMA1_Channel2_3_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), WE_PRIORITY_DMA_RX, 0));
+    NVIC_EnableIRQ(DMA1_Channel2_3_IRQn);
+
+    LL_DMA_SetPeriphRequest(DMA1, LL_DMA_CHANNEL_2, LL_DMA_REQUEST_3);
+    LL_DMA_SetDataTransferDirection(DMA1, LL_DMA_CHANNEL_2, LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+    LL_DMA_SetChannelPriorityLevel(DMA1, LL_DMA_CHANNEL_2, LL_DMA_PRIORITY_LOW);
+    LL_DMA_SetMode(DMA1, LL_DMA_CHANNEL_2, LL_DMA_MODE_NORMAL);
+    LL_DMA_SetPeriphIncMode(DMA1, LL_DMA_CHANNEL_2, LL_DMA_PERIPH_NOINCREMENT);
+    LL_DMA_SetMemoryIncMode(DMA1, LL_DMA_CHANNEL_2, LL_DMA_MEMORY_INCREMENT);
+    LL_DMA_SetPeriphSize(DMA1, LL_DMA_CHANNEL_2, LL_DMA_PDATAALIGN_BYTE);
+    LL_DMA_SetMemorySize(DMA1, LL_DMA_CHANNEL_2, LL_DMA_MDATAALIGN_BYTE);
+    LL_DMA_SetPeriphAddress(DMA1, LL_DMA_CHANNEL_2, (uint32_t) &USART1->TDR);
+
+    LL_DMA_EnableIT_TC(DMA1, LL_DMA_CHANNEL_2);
+    LL_USART_EnableDMAReq_TX(WE_uartWireless);
+
+    txDmaBusy = false;
+    txDmaInitialized = true;
+}
+
+void WE_DMA_TxDeInit()
+{
+    if (!txDmaInitialized)
+    {
+        return;
+    }
+
+    LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_2);
+    LL_DMA_DisableIT_TC(DMA1, LL_DMA_CHANNEL_2);
+    LL_USART_DisableDMAReq_TX(WE_uartWireless);
+    if (!WE_dmaEnabled)
+    {
+        /* Interrupt and clock are still used by the receive channel if DMA is enabled */
+        NVIC_DisableIRQ(DMA1_Channel2_3_IRQn);
+        LL_AHB1_GRP1_DisableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+    }
+
+    txDmaBusy = false;
+    txDmaInitialized = false;
+}
+
+bool WE_UART_TransmitDma(const uint8_t *data, uint16_t length)
+{
+    if (txDmaBusy)
+    {
+        return false;
+    }
+    if (0 == length)
+    {
+        return true;
+    }
+    if (!txDmaInitialized)
+    {
+        WE_DMA_TxInit();
+    }
+
+    LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_2);
+    LL_DMA_ClearFlag_TC2(DMA1);
+    LL_DMA_SetMemoryAddress(DMA1, LL_DMA_CHANNEL_2, (uint32_t) data);
+    LL_DMA_SetDataLength(DMA1, LL_DMA_CHANNEL_2, length);
+    txDmaBusy = true;
+    LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_2);
+    return true;
+}
+
+bool WE_UART_IsTransmitDmaBusy(void)
+{
+    return txDmaBusy;
+}
+
 /**
- * @brief Interrupt handler for data received from wireless module via DMA.
+ * @brief Interrupt handler for DMA channels 2 (data transmitted to wireless module)
+ * and 3 (data received from wireless module).
  *
- * Is only used if DMA is enabled.
+ * Is only used if DMA is enabled or WE_UART_TransmitDma() has been used.
  */
 void DMA1_Channel2_3_IRQHandler(void)
 {
+    if (txDmaInitialized &&
+            LL_DMA_IsEnabledIT_TC(DMA1, LL_DMA_CHANNEL_2) &&
+            LL_DMA_IsActiveFlag_TC2(DMA1))
+    {
+        /* DMA transmit complete */
+
+        LL_DMA_ClearFlag_TC2(DMA1);
+        LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_2);
+        txDmaBusy = false;
+        if (NULL != WE_uartTransmitDmaCompleteCallback)
+        {
+            WE_uartTransmitDmaCompleteCallback();
+        }
+    }
+
+    if (WE_dmaWirelessRx == NULL)
+    {
+        return;
+    }
+
     if (LL_DMA_IsEnabledIT_HT(WE_dmaWirelessRx, WE_dmaWirelessRxStream) &&
             LL_DMA_IsActiveFlag_HT3(WE_dmaWirelessRx))
     {
@@ -0,0 +1,116 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Stack high-water monitor (stack painting).
+ */
+
+#include "stack_monitor.h"
+
+#include "global.h"
+
+/**
+ * @brief End of RAM / initial value of main stack pointer (defined in linker script).
+ */
+extern uint32_t _estack;
+
+/**
+ * @brief Size of the region reserved for the stack (defined in linker script, the symbol's
+ * address is the value).
+ */
+extern uint32_t _Min_Stack_Size;
+
+/**
+ * @brief Lowest word of the stack region reserved by the linker script.
+ */
+#define WE_STACK_MONITOR_BOTTOM ((uint32_t *) ((uint8_t *) &_estack - (size_t) &_Min_Stack_Size))
+
+/**
+ * @brief Is set to true as soon as the stack has been painted.
+ */
+static bool WE_stackPainted = false;
+
+/**
+ * @brief Paints the unused part of the stack region reserved by the linker script.
+ *
+ * Is called by WE_Platform_Init(). Should be called as early as possible, as the high-water mark
+ * only covers stack usage after the call.
+ */
+void WE_StackMonitor_Init(void)
+{
+    uint32_t *end = (uint32_t *) (uintptr_t) (__get_MSP() - WE_STACK_MONITOR_MARGIN);
+
+    for (uint32_t *p = WE_STACK_MONITOR_BOTTOM; p < end; p++)
+    {
+        *p = WE_STACK_MONITOR_PATTERN;
+    }
+
+    WE_stackPainted = true;
+}
+
+/**
+ * @brief Returns the current stack usage and the high-water mark of the stack.
+ *
+ * The high-water mark is only available if WE_StackMonitor_Init() has been called before
+ * (otherwise it equals the current usage). Searching for the mark takes some time (up to one read
+ * per word of the stack region), so it is recommended to call this function from the main loop
+ * (e.g. periodically or before entering low power mode) rather than from interrupt context.
+ *
+ * @param[out] report Stack usage report
+ */
+void WE_StackMonitor_GetReport(WE_StackMonitor_Report_t *report)
+{
+    uint32_t *top = &_estack;
+    uint32_t *bottom = WE_STACK_MONITOR_BOTTOM;
+
+    report->stackSize = (size_t) &_Min_Stack_Size;
+    report->currentUsage = (uint8_t *) top - (uint8_t *) (uintptr_t) __get_MSP();
+    report->maxUsage = report->currentUsage;
+    report->overflow = report->currentUsage > report->stackSize;
+
+    if (!WE_stackPainted)
+    {
+        return;
+    }
+
+    uint32_t *p = bottom;
+    while (p < top && *p == WE_STACK_MONITOR_PATTERN)
+    {
+        p++;
+    }
+
+    if (p == bottom)
+    {
+        /* Lowest word has been overwritten - stack might have grown into the heap */
+        report->overflow = true;
+    }
+
+    size_t usage = (uint8_t *) top - (uint8_t *) p;
+    if (usage > report->maxUsage)
+    {
+        report->maxUsage = usage;
+    }
+}
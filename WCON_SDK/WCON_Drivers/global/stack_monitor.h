@@ -0,0 +1,82 @@
+/*
+ ***************************************************************************************************
+ * This file is part of WIRELESS CONNECTIVITY SDK for STM32:
+ *
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+ * EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+ * TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+ * MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+ * WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+ * RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+ * COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+ * WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+ * FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+ * THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+ *
+ * COPYRIGHT (c) 2022 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ ***************************************************************************************************
+ */
+
+/**
+ * @file
+ * @brief Stack high-water monitor (stack painting).
+ *
+ * The SDK's projects are bare-metal, i.e. main() and all interrupt handlers use the main stack
+ * (MSP) located at the end of RAM (_estack). The region reserved for the stack by the linker
+ * script (_Min_Stack_Size bytes below _estack) is painted with a known pattern at startup.
+ * The high-water mark is determined by searching for the lowest word that has been
+ * overwritten. As interrupts are stacked on top of the interrupted code, the high-water mark
+ * covers the deepest call chain of the main loop plus the deepest interrupt nesting.
+ *
+ * The per-function stack frames reported by the compiler (-fstack-usage, see
+ * Tools/StackUsage) can be used to find the functions responsible for a high mark.
+ */
+
+#ifndef GLOBAL_STACK_MONITOR_H_INCLUDED
+#define GLOBAL_STACK_MONITOR_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Pattern used to paint the unused part of the stack.
+ */
+#define WE_STACK_MONITOR_PATTERN 0xA5A5A5A5
+
+/**
+ * @brief Number of bytes below the current stack pointer which are left untouched when painting.
+ */
+#define WE_STACK_MONITOR_MARGIN 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Stack usage of the application.
+ *
+ * @see WE_StackMonitor_GetReport()
+ */
+typedef struct WE_StackMonitor_Report_t
+{
+    size_t stackSize;                       /**< Size of stack region reserved by linker script (_Min_Stack_Size) */
+    size_t currentUsage;                    /**< Number of bytes currently used */
+    size_t maxUsage;                        /**< High-water mark (max. number of bytes used since WE_StackMonitor_Init()) */
+    bool overflow;                          /**< Stack has grown beyond the reserved region (maxUsage is not reliable) */
+} WE_StackMonitor_Report_t;
+
+extern void WE_StackMonitor_Init(void);
+extern void WE_StackMonitor_GetReport(WE_StackMonitor_Report_t *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GLOBAL_STACK_MONITOR_H_INCLUDED */